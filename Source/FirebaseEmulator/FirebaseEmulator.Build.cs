@@ -0,0 +1,28 @@
+using UnrealBuildTool;
+
+public class FirebaseEmulator : ModuleRules
+{
+	public FirebaseEmulator(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+				"CoreUObject",
+				"Json"
+			}
+		);
+
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Engine",
+				"HTTP",
+				"HTTPServer",
+				"FirebasePlugin"
+			}
+		);
+	}
+}
@@ -0,0 +1,392 @@
+// Copyright. All Rights Reserved.
+
+#include "FirebaseEmulatorAuth.h"
+#include "Misc/Base64.h"
+#include "Misc/Guid.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+
+namespace FirebaseEmulatorAuth
+{
+	FString Base64Url(const FString& Text)
+	{
+		FTCHARToUTF8 Utf8(*Text, Text.Len());
+		FString Encoded = FBase64::Encode(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+		Encoded.ReplaceCharInline(TEXT('+'), TEXT('-'));
+		Encoded.ReplaceCharInline(TEXT('/'), TEXT('_'));
+		while (Encoded.EndsWith(TEXT("=")))
+		{
+			Encoded.LeftChopInline(1);
+		}
+		return Encoded;
+	}
+
+	FString ToJson(const TSharedRef<FJsonObject>& Object)
+	{
+		FString Json;
+		TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Json);
+		FJsonSerializer::Serialize(Object, Writer);
+		return Json;
+	}
+
+	FString GetString(const TSharedPtr<FJsonObject>& Object, const TCHAR* Field)
+	{
+		FString Value;
+		if (Object.IsValid())
+		{
+			Object->TryGetStringField(Field, Value);
+		}
+		return Value;
+	}
+
+	int64 NowMs()
+	{
+		return int64((FDateTime::UtcNow() - FDateTime(1970, 1, 1)).GetTotalMilliseconds());
+	}
+
+	FString NewId()
+	{
+		return FGuid::NewGuid().ToString(EGuidFormats::Digits).ToLower();
+	}
+}
+
+int32 FFirebaseEmulatorAuth::Handle(FStringView Method, const TSharedPtr<FJsonObject>& Request, TSharedPtr<FJsonObject>& OutResponse)
+{
+	if (Method == TEXT("accounts:signUp"))
+	{
+		return SignUp(Request, OutResponse);
+	}
+	if (Method == TEXT("accounts:signInWithPassword"))
+	{
+		return SignInWithPassword(Request, OutResponse);
+	}
+	if (Method == TEXT("token"))
+	{
+		return RefreshToken(Request, OutResponse);
+	}
+	if (Method == TEXT("accounts:sendOobCode"))
+	{
+		return SendOobCode(Request, OutResponse);
+	}
+	if (Method == TEXT("accounts:update"))
+	{
+		return Update(Request, OutResponse);
+	}
+	if (Method == TEXT("accounts:delete"))
+	{
+		return Delete(Request, OutResponse);
+	}
+	if (Method == TEXT("accounts:lookup"))
+	{
+		return Lookup(Request, OutResponse);
+	}
+
+	OutResponse = MakeShared<FJsonObject>();
+	TSharedRef<FJsonObject> ErrorObject = MakeShared<FJsonObject>();
+	ErrorObject->SetNumberField(TEXT("code"), 404);
+	ErrorObject->SetStringField(TEXT("message"), FString::Printf(TEXT("Method %.*s is not emulated"), Method.Len(), Method.GetData()));
+	OutResponse->SetObjectField(TEXT("error"), ErrorObject);
+	return 404;
+}
+
+void FFirebaseEmulatorAuth::Reset()
+{
+	Accounts.Reset();
+	LocalIdByEmail.Reset();
+	LocalIdByIdToken.Reset();
+	LocalIdByRefreshToken.Reset();
+}
+
+int32 FFirebaseEmulatorAuth::Error(const TCHAR* Message, TSharedPtr<FJsonObject>& OutResponse)
+{
+	TSharedRef<FJsonObject> Detail = MakeShared<FJsonObject>();
+	Detail->SetStringField(TEXT("message"), Message);
+	Detail->SetStringField(TEXT("domain"), TEXT("global"));
+	Detail->SetStringField(TEXT("reason"), TEXT("invalid"));
+
+	TSharedRef<FJsonObject> ErrorObject = MakeShared<FJsonObject>();
+	ErrorObject->SetNumberField(TEXT("code"), 400);
+	ErrorObject->SetStringField(TEXT("message"), Message);
+	ErrorObject->SetArrayField(TEXT("errors"), { MakeShared<FJsonValueObject>(Detail) });
+
+	OutResponse = MakeShared<FJsonObject>();
+	OutResponse->SetObjectField(TEXT("error"), ErrorObject);
+	return 400;
+}
+
+FString FFirebaseEmulatorAuth::MakeIdToken(const FAccount& Account)
+{
+	const int64 Now = FirebaseEmulatorAuth::NowMs() / 1000;
+
+	TSharedRef<FJsonObject> Claims = MakeShared<FJsonObject>();
+	Claims->SetStringField(TEXT("iss"), FString::Printf(TEXT("https://securetoken.google.com/%s"), *ProjectId));
+	Claims->SetStringField(TEXT("aud"), ProjectId);
+	Claims->SetNumberField(TEXT("auth_time"), double(Now));
+	Claims->SetStringField(TEXT("user_id"), Account.LocalId);
+	Claims->SetStringField(TEXT("sub"), Account.LocalId);
+	Claims->SetNumberField(TEXT("iat"), double(Now));
+	Claims->SetNumberField(TEXT("exp"), double(Now + ExpiresInSeconds));
+	if (!Account.Email.IsEmpty())
+	{
+		Claims->SetStringField(TEXT("email"), Account.Email);
+		Claims->SetBoolField(TEXT("email_verified"), Account.bEmailVerified);
+	}
+	// Keeps tokens issued within the same second distinct
+	Claims->SetNumberField(TEXT("jti"), double(++TokenCounter));
+
+	static const FString Header = FirebaseEmulatorAuth::Base64Url(TEXT("{\"alg\":\"none\",\"typ\":\"JWT\"}"));
+	return Header + TEXT(".") + FirebaseEmulatorAuth::Base64Url(FirebaseEmulatorAuth::ToJson(Claims)) + TEXT(".");
+}
+
+void FFirebaseEmulatorAuth::IssueTokens(const FAccount& Account, const TSharedPtr<FJsonObject>& OutResponse)
+{
+	const FString IdToken = MakeIdToken(Account);
+	const FString RefreshTokenValue = FirebaseEmulatorAuth::NewId();
+	LocalIdByIdToken.Add(IdToken, Account.LocalId);
+	LocalIdByRefreshToken.Add(RefreshTokenValue, Account.LocalId);
+
+	OutResponse->SetStringField(TEXT("idToken"), IdToken);
+	OutResponse->SetStringField(TEXT("refreshToken"), RefreshTokenValue);
+	OutResponse->SetStringField(TEXT("expiresIn"), LexToString(ExpiresInSeconds));
+	OutResponse->SetStringField(TEXT("localId"), Account.LocalId);
+	OutResponse->SetStringField(TEXT("email"), Account.Email);
+}
+
+FFirebaseEmulatorAuth::FAccount* FFirebaseEmulatorAuth::FindByIdToken(const TSharedPtr<FJsonObject>& Request, TSharedPtr<FJsonObject>& OutResponse)
+{
+	const FString* LocalId = LocalIdByIdToken.Find(FirebaseEmulatorAuth::GetString(Request, TEXT("idToken")));
+	FAccount* Account = LocalId ? Accounts.Find(*LocalId) : nullptr;
+	if (!Account)
+	{
+		Error(TEXT("INVALID_ID_TOKEN"), OutResponse);
+	}
+	return Account;
+}
+
+int32 FFirebaseEmulatorAuth::SignUp(const TSharedPtr<FJsonObject>& Request, TSharedPtr<FJsonObject>& OutResponse)
+{
+	const FString Email = FirebaseEmulatorAuth::GetString(Request, TEXT("email")).ToLower();
+	const FString Password = FirebaseEmulatorAuth::GetString(Request, TEXT("password"));
+
+	if (!Email.IsEmpty())
+	{
+		if (!Email.Contains(TEXT("@")))
+		{
+			return Error(TEXT("INVALID_EMAIL"), OutResponse);
+		}
+		if (LocalIdByEmail.Contains(Email))
+		{
+			return Error(TEXT("EMAIL_EXISTS"), OutResponse);
+		}
+		if (Password.Len() < 6)
+		{
+			return Error(TEXT("WEAK_PASSWORD : Password should be at least 6 characters"), OutResponse);
+		}
+	}
+
+	FAccount Account;
+	Account.LocalId = FirebaseEmulatorAuth::NewId().Left(28);
+	Account.Email = Email;
+	Account.Password = Password;
+	Account.CreatedAtMs = FirebaseEmulatorAuth::NowMs();
+	if (!Email.IsEmpty())
+	{
+		LocalIdByEmail.Add(Email, Account.LocalId);
+	}
+	Accounts.Add(Account.LocalId, Account);
+
+	OutResponse = MakeShared<FJsonObject>();
+	OutResponse->SetStringField(TEXT("kind"), TEXT("identitytoolkit#SignupNewUserResponse"));
+	IssueTokens(Account, OutResponse);
+	return 200;
+}
+
+int32 FFirebaseEmulatorAuth::SignInWithPassword(const TSharedPtr<FJsonObject>& Request, TSharedPtr<FJsonObject>& OutResponse)
+{
+	const FString Email = FirebaseEmulatorAuth::GetString(Request, TEXT("email")).ToLower();
+	const FString* LocalId = LocalIdByEmail.Find(Email);
+	const FAccount* Account = LocalId ? Accounts.Find(*LocalId) : nullptr;
+	if (!Account)
+	{
+		return Error(TEXT("EMAIL_NOT_FOUND"), OutResponse);
+	}
+	if (!Account->Password.Equals(FirebaseEmulatorAuth::GetString(Request, TEXT("password")), ESearchCase::CaseSensitive))
+	{
+		return Error(TEXT("INVALID_PASSWORD"), OutResponse);
+	}
+
+	OutResponse = MakeShared<FJsonObject>();
+	OutResponse->SetStringField(TEXT("kind"), TEXT("identitytoolkit#VerifyPasswordResponse"));
+	OutResponse->SetStringField(TEXT("displayName"), Account->DisplayName);
+	OutResponse->SetBoolField(TEXT("registered"), true);
+	IssueTokens(*Account, OutResponse);
+	return 200;
+}
+
+int32 FFirebaseEmulatorAuth::RefreshToken(const TSharedPtr<FJsonObject>& Request, TSharedPtr<FJsonObject>& OutResponse)
+{
+	const FString Token = FirebaseEmulatorAuth::GetString(Request, TEXT("refresh_token"));
+	const FString* LocalId = LocalIdByRefreshToken.Find(Token);
+	const FAccount* Account = LocalId ? Accounts.Find(*LocalId) : nullptr;
+	if (!Account)
+	{
+		return Error(TEXT("INVALID_REFRESH_TOKEN"), OutResponse);
+	}
+
+	const FString IdToken = MakeIdToken(*Account);
+	LocalIdByIdToken.Add(IdToken, Account->LocalId);
+
+	// The securetoken API answers in snake_case
+	OutResponse = MakeShared<FJsonObject>();
+	OutResponse->SetStringField(TEXT("access_token"), IdToken);
+	OutResponse->SetStringField(TEXT("expires_in"), LexToString(ExpiresInSeconds));
+	OutResponse->SetStringField(TEXT("token_type"), TEXT("Bearer"));
+	OutResponse->SetStringField(TEXT("refresh_token"), Token);
+	OutResponse->SetStringField(TEXT("id_token"), IdToken);
+	OutResponse->SetStringField(TEXT("user_id"), Account->LocalId);
+	OutResponse->SetStringField(TEXT("project_id"), ProjectId);
+	return 200;
+}
+
+int32 FFirebaseEmulatorAuth::SendOobCode(const TSharedPtr<FJsonObject>& Request, TSharedPtr<FJsonObject>& OutResponse)
+{
+	// Nothing is mailed; the call only has to succeed for a known account
+	const FString RequestType = FirebaseEmulatorAuth::GetString(Request, TEXT("requestType"));
+	FString Email;
+	if (RequestType == TEXT("VERIFY_EMAIL"))
+	{
+		const FAccount* Account = FindByIdToken(Request, OutResponse);
+		if (!Account)
+		{
+			return 400;
+		}
+		Email = Account->Email;
+	}
+	else
+	{
+		Email = FirebaseEmulatorAuth::GetString(Request, TEXT("email")).ToLower();
+		if (!LocalIdByEmail.Contains(Email))
+		{
+			return Error(TEXT("EMAIL_NOT_FOUND"), OutResponse);
+		}
+	}
+
+	OutResponse = MakeShared<FJsonObject>();
+	OutResponse->SetStringField(TEXT("kind"), TEXT("identitytoolkit#GetOobConfirmationCodeResponse"));
+	OutResponse->SetStringField(TEXT("email"), Email);
+	return 200;
+}
+
+int32 FFirebaseEmulatorAuth::Update(const TSharedPtr<FJsonObject>& Request, TSharedPtr<FJsonObject>& OutResponse)
+{
+	FAccount* Account = FindByIdToken(Request, OutResponse);
+	if (!Account)
+	{
+		return 400;
+	}
+
+	FString Value;
+	if (Request->TryGetStringField(TEXT("email"), Value))
+	{
+		Value = Value.ToLower();
+		const FString* Owner = LocalIdByEmail.Find(Value);
+		if (Owner && *Owner != Account->LocalId)
+		{
+			return Error(TEXT("EMAIL_EXISTS"), OutResponse);
+		}
+		LocalIdByEmail.Remove(Account->Email);
+		LocalIdByEmail.Add(Value, Account->LocalId);
+		Account->Email = Value;
+		Account->bEmailVerified = false;
+	}
+	if (Request->TryGetStringField(TEXT("password"), Value))
+	{
+		if (Value.Len() < 6)
+		{
+			return Error(TEXT("WEAK_PASSWORD : Password should be at least 6 characters"), OutResponse);
+		}
+		Account->Password = Value;
+	}
+	if (Request->TryGetStringField(TEXT("displayName"), Value))
+	{
+		Account->DisplayName = Value;
+	}
+	if (Request->TryGetStringField(TEXT("photoUrl"), Value))
+	{
+		Account->PhotoUrl = Value;
+	}
+
+	OutResponse = MakeShared<FJsonObject>();
+	OutResponse->SetStringField(TEXT("kind"), TEXT("identitytoolkit#SetAccountInfoResponse"));
+	OutResponse->SetStringField(TEXT("displayName"), Account->DisplayName);
+	OutResponse->SetStringField(TEXT("photoUrl"), Account->PhotoUrl);
+	OutResponse->SetBoolField(TEXT("emailVerified"), Account->bEmailVerified);
+
+	bool bReturnSecureToken = false;
+	if (Request->TryGetBoolField(TEXT("returnSecureToken"), bReturnSecureToken) && bReturnSecureToken)
+	{
+		IssueTokens(*Account, OutResponse);
+	}
+	else
+	{
+		OutResponse->SetStringField(TEXT("localId"), Account->LocalId);
+		OutResponse->SetStringField(TEXT("email"), Account->Email);
+	}
+	return 200;
+}
+
+int32 FFirebaseEmulatorAuth::Delete(const TSharedPtr<FJsonObject>& Request, TSharedPtr<FJsonObject>& OutResponse)
+{
+	const FAccount* Account = FindByIdToken(Request, OutResponse);
+	if (!Account)
+	{
+		return 400;
+	}
+
+	const FString LocalId = Account->LocalId;
+	LocalIdByEmail.Remove(Account->Email);
+	Accounts.Remove(LocalId);
+
+	// Tokens of the deleted account stop working
+	for (auto It = LocalIdByIdToken.CreateIterator(); It; ++It)
+	{
+		if (It.Value() == LocalId)
+		{
+			It.RemoveCurrent();
+		}
+	}
+	for (auto It = LocalIdByRefreshToken.CreateIterator(); It; ++It)
+	{
+		if (It.Value() == LocalId)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	OutResponse = MakeShared<FJsonObject>();
+	OutResponse->SetStringField(TEXT("kind"), TEXT("identitytoolkit#DeleteAccountResponse"));
+	return 200;
+}
+
+int32 FFirebaseEmulatorAuth::Lookup(const TSharedPtr<FJsonObject>& Request, TSharedPtr<FJsonObject>& OutResponse)
+{
+	const FAccount* Account = FindByIdToken(Request, OutResponse);
+	if (!Account)
+	{
+		return 400;
+	}
+
+	TSharedRef<FJsonObject> User = MakeShared<FJsonObject>();
+	User->SetStringField(TEXT("localId"), Account->LocalId);
+	User->SetStringField(TEXT("email"), Account->Email);
+	User->SetBoolField(TEXT("emailVerified"), Account->bEmailVerified);
+	User->SetStringField(TEXT("displayName"), Account->DisplayName);
+	User->SetStringField(TEXT("photoUrl"), Account->PhotoUrl);
+	User->SetStringField(TEXT("createdAt"), LexToString(Account->CreatedAtMs));
+
+	OutResponse = MakeShared<FJsonObject>();
+	OutResponse->SetStringField(TEXT("kind"), TEXT("identitytoolkit#GetAccountInfoResponse"));
+	OutResponse->SetArrayField(TEXT("users"), { MakeShared<FJsonValueObject>(User) });
+	return 200;
+}
@@ -0,0 +1,629 @@
+// Copyright. All Rights Reserved.
+
+#include "FirebaseEmulatorDatabase.h"
+#include "FirebaseJsonWriter.h"
+#include "FirebaseDatabase.h"
+#include "Dom/JsonObject.h"
+#include "Misc/SecureHash.h"
+#include "Misc/Base64.h"
+
+namespace FirebaseEmulatorDatabase
+{
+	void SplitPath(FStringView Path, TArray<FStringView, TInlineAllocator<16>>& OutSegments)
+	{
+		int32 Start = 0;
+		for (int32 Index = 0; Index <= Path.Len(); ++Index)
+		{
+			if (Index == Path.Len() || Path[Index] == TEXT('/'))
+			{
+				if (Index > Start)
+				{
+					OutSegments.Add(Path.Mid(Start, Index - Start));
+				}
+				Start = Index + 1;
+			}
+		}
+	}
+
+	/** Key as an array index (no sign, no leading zeros), or INDEX_NONE */
+	int32 ParseIndexKey(const FString& Key)
+	{
+		if (Key.IsEmpty() || Key.Len() > 9 || (Key.Len() > 1 && Key[0] == TEXT('0')))
+		{
+			return INDEX_NONE;
+		}
+		int32 Index = 0;
+		for (const TCHAR Character : Key)
+		{
+			if (Character < TEXT('0') || Character > TEXT('9'))
+			{
+				return INDEX_NONE;
+			}
+			Index = Index * 10 + (Character - TEXT('0'));
+		}
+		return Index;
+	}
+
+	using FNodePtr = TSharedPtr<FFirebaseEmulatorNode>;
+
+	double GetNowMs()
+	{
+		return FMath::FloorToDouble((FDateTime::UtcNow() - FDateTime(1970, 1, 1)).GetTotalMilliseconds());
+	}
+
+	FNodePtr MakeLeaf(const TSharedPtr<FJsonValue>& Value)
+	{
+		FNodePtr Node = MakeShared<FFirebaseEmulatorNode>();
+		Node->Leaf = Value;
+		return Node;
+	}
+
+	/** An object with no children is not stored */
+	FNodePtr KeepIfNotEmpty(const FNodePtr& Object)
+	{
+		return Object->Children.Num() > 0 ? Object : FNodePtr();
+	}
+
+	FString ToKey(FUtf8StringView Key)
+	{
+		FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Key.GetData()), Key.Len());
+		return FString(Converted.Length(), Converted.Get());
+	}
+
+	/** Convert a parsed request body to stored form: no nulls, no empty objects, arrays as index-keyed objects */
+	FNodePtr Normalize(const FFirebaseJsonTape::FValue& Value, double NowMs)
+	{
+		if (!Value.IsValid())
+		{
+			return nullptr;
+		}
+
+		switch (Value.GetType())
+		{
+		case EFirebaseJsonTapeType::True:
+		case EFirebaseJsonTapeType::False:
+			return MakeLeaf(MakeShared<FJsonValueBoolean>(Value.AsBool()));
+
+		case EFirebaseJsonTapeType::Number:
+			return MakeLeaf(MakeShared<FJsonValueNumber>(Value.AsNumber()));
+
+		case EFirebaseJsonTapeType::String:
+			return MakeLeaf(MakeShared<FJsonValueString>(Value.AsString()));
+
+		case EFirebaseJsonTapeType::Array:
+			{
+				FNodePtr Object = MakeShared<FFirebaseEmulatorNode>();
+				int32 Index = 0;
+				Value.ForEachElement([&Object, &Index, NowMs](const FFirebaseJsonTape::FValue& Element)
+				{
+					if (FNodePtr Child = Normalize(Element, NowMs))
+					{
+						Object->Children.Add(LexToString(Index), Child);
+					}
+					++Index;
+					return true;
+				});
+				return KeepIfNotEmpty(Object);
+			}
+
+		case EFirebaseJsonTapeType::Object:
+			{
+				// Server values and priority wrappers
+				const FFirebaseJsonTape::FValue ServerValue = Value.FindField(UTF8TEXTVIEW(".sv"));
+				if (ServerValue.IsValid() && ServerValue.IsString() && ServerValue.AsUtf8().Equals(UTF8TEXTVIEW("timestamp"), ESearchCase::CaseSensitive))
+				{
+					return MakeLeaf(MakeShared<FJsonValueNumber>(NowMs));
+				}
+				const FFirebaseJsonTape::FValue Wrapped = Value.FindField(UTF8TEXTVIEW(".value"));
+				if (Wrapped.IsValid())
+				{
+					return Normalize(Wrapped, NowMs);
+				}
+
+				FNodePtr Object = MakeShared<FFirebaseEmulatorNode>();
+				Value.ForEachField([&Object, NowMs](FUtf8StringView Key, const FFirebaseJsonTape::FValue& Field)
+				{
+					if (!Key.Equals(UTF8TEXTVIEW(".priority"), ESearchCase::CaseSensitive))
+					{
+						if (FNodePtr Child = Normalize(Field, NowMs))
+						{
+							Object->Children.Add(ToKey(Key), Child);
+						}
+					}
+					return true;
+				});
+				return KeepIfNotEmpty(Object);
+			}
+
+		default:
+			return nullptr;
+		}
+	}
+
+	/** Same as above for values built in C++ */
+	FNodePtr Normalize(const TSharedPtr<FJsonValue>& Value, double NowMs)
+	{
+		if (!Value.IsValid())
+		{
+			return nullptr;
+		}
+
+		switch (Value->Type)
+		{
+		case EJson::Boolean:
+		case EJson::Number:
+		case EJson::String:
+			return MakeLeaf(Value);
+
+		case EJson::Array:
+			{
+				FNodePtr Object = MakeShared<FFirebaseEmulatorNode>();
+				const TArray<TSharedPtr<FJsonValue>>& Elements = Value->AsArray();
+				for (int32 Index = 0; Index < Elements.Num(); ++Index)
+				{
+					if (FNodePtr Child = Normalize(Elements[Index], NowMs))
+					{
+						Object->Children.Add(LexToString(Index), Child);
+					}
+				}
+				return KeepIfNotEmpty(Object);
+			}
+
+		case EJson::Object:
+			{
+				const TSharedPtr<FJsonObject>& Source = Value->AsObject();
+
+				// Server values and priority wrappers
+				if (const TSharedPtr<FJsonValue>* ServerValue = Source->Values.Find(TEXT(".sv")))
+				{
+					if ((*ServerValue)->Type == EJson::String && (*ServerValue)->AsString() == TEXT("timestamp"))
+					{
+						return MakeLeaf(MakeShared<FJsonValueNumber>(NowMs));
+					}
+				}
+				if (const TSharedPtr<FJsonValue>* Wrapped = Source->Values.Find(TEXT(".value")))
+				{
+					return Normalize(*Wrapped, NowMs);
+				}
+
+				FNodePtr Object = MakeShared<FFirebaseEmulatorNode>();
+				for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : Source->Values)
+				{
+					if (Pair.Key == TEXT(".priority"))
+					{
+						continue;
+					}
+					if (FNodePtr Child = Normalize(Pair.Value, NowMs))
+					{
+						Object->Children.Add(Pair.Key, Child);
+					}
+				}
+				return KeepIfNotEmpty(Object);
+			}
+
+		default:
+			return nullptr;
+		}
+	}
+
+	/** Set a normalized value below Node, creating and pruning parents as needed */
+	void SetAt(FNodePtr& Node, TArrayView<const FStringView> Segments, const FNodePtr& Value)
+	{
+		if (Segments.Num() == 0)
+		{
+			Node = Value;
+			return;
+		}
+
+		if (!Node.IsValid() || !Node->IsObject())
+		{
+			if (!Value.IsValid())
+			{
+				// Deleting below a leaf or nothing changes nothing
+				return;
+			}
+			Node = MakeShared<FFirebaseEmulatorNode>();
+		}
+
+		const FString Key(Segments[0]);
+		FNodePtr Child = Node->Children.FindRef(Key);
+		SetAt(Child, Segments.Slice(1, Segments.Num() - 1), Value);
+		if (Child.IsValid())
+		{
+			Node->Children.Add(Key, Child);
+		}
+		else
+		{
+			Node->Children.Remove(Key);
+		}
+
+		if (Node->Children.Num() == 0)
+		{
+			Node.Reset();
+		}
+	}
+
+	/** Whole numbers within 2^53 are written without a fraction, like the server does */
+	void WriteNumber(FFirebaseJsonWriter& Writer, double Number)
+	{
+		if (FMath::Abs(Number) <= 9007199254740992.0 && FMath::RoundToDouble(Number) == Number)
+		{
+			Writer.WriteInt(int64(Number));
+		}
+		else
+		{
+			Writer.WriteDouble(Number);
+		}
+	}
+
+	/** Write a stored value, turning densely index-keyed objects back into arrays */
+	void WriteValue(FFirebaseJsonWriter& Writer, const FFirebaseEmulatorNode* Node)
+	{
+		if (!Node)
+		{
+			Writer.WriteNull();
+			return;
+		}
+
+		if (!Node->IsObject())
+		{
+			switch (Node->Leaf->Type)
+			{
+			case EJson::Boolean:
+				Writer.WriteBool(Node->Leaf->AsBool());
+				return;
+
+			case EJson::Number:
+				WriteNumber(Writer, Node->Leaf->AsNumber());
+				return;
+
+			case EJson::String:
+				Writer.WriteString(Node->Leaf->AsString());
+				return;
+
+			default:
+				Writer.WriteNull();
+				return;
+			}
+		}
+
+		int32 MaxIndex = INDEX_NONE;
+		for (const TPair<FString, FNodePtr>& Pair : Node->Children)
+		{
+			const int32 Index = ParseIndexKey(Pair.Key);
+			if (Index == INDEX_NONE)
+			{
+				MaxIndex = INDEX_NONE;
+				break;
+			}
+			MaxIndex = FMath::Max(MaxIndex, Index);
+		}
+
+		// Same rule as the server: all keys are indices and more than half the slots are used
+		if (MaxIndex != INDEX_NONE && Node->Children.Num() * 2 > MaxIndex + 1)
+		{
+			Writer.BeginArray();
+			for (int32 Index = 0; Index <= MaxIndex; ++Index)
+			{
+				const FNodePtr* Element = Node->Children.Find(LexToString(Index));
+				WriteValue(Writer, Element ? Element->Get() : nullptr);
+			}
+			Writer.EndArray();
+			return;
+		}
+
+		Writer.BeginObject();
+		for (const TPair<FString, FNodePtr>& Pair : Node->Children)
+		{
+			Writer.WriteKey(Pair.Key);
+			WriteValue(Writer, Pair.Value.Get());
+		}
+		Writer.EndObject();
+	}
+
+	/** Value a node is ordered by: its scalar, or a stand-in that only carries the object rank */
+	TSharedPtr<FJsonValue> GetOrderValue(const FFirebaseEmulatorNode* Node)
+	{
+		if (!Node)
+		{
+			return nullptr;
+		}
+		if (!Node->IsObject())
+		{
+			return Node->Leaf;
+		}
+		static const TSharedPtr<FJsonValue> ObjectValue = MakeShared<FJsonValueObject>(MakeShared<FJsonObject>());
+		return ObjectValue;
+	}
+
+	/** Type rank in query order: null, false, true, numbers, strings, objects */
+	int32 GetRank(const TSharedPtr<FJsonValue>& Value)
+	{
+		if (!Value.IsValid())
+		{
+			return 0;
+		}
+		switch (Value->Type)
+		{
+		case EJson::Boolean:
+			return Value->AsBool() ? 2 : 1;
+		case EJson::Number:
+			return 3;
+		case EJson::String:
+			return 4;
+		case EJson::Object:
+		case EJson::Array:
+			return 5;
+		default:
+			return 0;
+		}
+	}
+
+	int32 CompareValues(const TSharedPtr<FJsonValue>& A, const TSharedPtr<FJsonValue>& B)
+	{
+		const int32 RankA = GetRank(A);
+		const int32 RankB = GetRank(B);
+		if (RankA != RankB)
+		{
+			return RankA < RankB ? -1 : 1;
+		}
+		if (RankA == 3)
+		{
+			const double NumberA = A->AsNumber();
+			const double NumberB = B->AsNumber();
+			return NumberA < NumberB ? -1 : (NumberA > NumberB ? 1 : 0);
+		}
+		if (RankA == 4)
+		{
+			return A->AsString().Compare(B->AsString(), ESearchCase::CaseSensitive);
+		}
+		return 0;
+	}
+
+	/** Key order: 32-bit integer keys numerically first, then the rest as strings */
+	int32 CompareKeys(const FString& A, const FString& B)
+	{
+		int64 IntegerA = 0;
+		int64 IntegerB = 0;
+		const bool bIntegerA = LexTryParseString(IntegerA, *A) && IntegerA >= MIN_int32 && IntegerA <= MAX_int32 && LexToString(IntegerA) == A;
+		const bool bIntegerB = LexTryParseString(IntegerB, *B) && IntegerB >= MIN_int32 && IntegerB <= MAX_int32 && LexToString(IntegerB) == B;
+		if (bIntegerA != bIntegerB)
+		{
+			return bIntegerA ? -1 : 1;
+		}
+		if (bIntegerA)
+		{
+			return IntegerA < IntegerB ? -1 : (IntegerA > IntegerB ? 1 : 0);
+		}
+		return A.Compare(B, ESearchCase::CaseSensitive);
+	}
+
+	const FFirebaseEmulatorNode* FindChild(const FFirebaseEmulatorNode* Node, FStringView ChildPath)
+	{
+		TArray<FStringView, TInlineAllocator<16>> Segments;
+		SplitPath(ChildPath, Segments);
+
+		const FFirebaseEmulatorNode* Current = Node;
+		for (const FStringView& Segment : Segments)
+		{
+			if (!Current || !Current->IsObject())
+			{
+				return nullptr;
+			}
+			const FNodePtr* Child = Current->Children.Find(FString(Segment));
+			Current = Child ? Child->Get() : nullptr;
+		}
+		return Current;
+	}
+
+	struct FQueryEntry
+	{
+		const FString* Key;
+		const FFirebaseEmulatorNode* Value;
+		TSharedPtr<FJsonValue> OrderValue;
+	};
+}
+
+bool FFirebaseEmulatorQuery::IsFiltered() const
+{
+	return !OrderBy.IsEmpty() || StartAt.IsValid() || EndAt.IsValid() || EqualTo.IsValid() || LimitToFirst > 0 || LimitToLast > 0;
+}
+
+const FFirebaseEmulatorNode* FFirebaseEmulatorDatabase::Find(FStringView Path) const
+{
+	return FirebaseEmulatorDatabase::FindChild(Root.Get(), Path);
+}
+
+bool FFirebaseEmulatorDatabase::Write(FStringView Path, const FFirebaseEmulatorQuery& Query, FFirebaseJsonWriter& Writer, FString& OutError) const
+{
+	const FFirebaseEmulatorNode* Node = Find(Path);
+	const bool bIsObject = Node && Node->IsObject();
+
+	if (Query.bShallow)
+	{
+		if (Query.IsFiltered())
+		{
+			OutError = TEXT("Mixing 'shallow' and querying parameters is not supported");
+			return false;
+		}
+		if (!bIsObject)
+		{
+			FirebaseEmulatorDatabase::WriteValue(Writer, Node);
+			return true;
+		}
+
+		Writer.BeginObject();
+		for (const TPair<FString, TSharedPtr<FFirebaseEmulatorNode>>& Pair : Node->Children)
+		{
+			Writer.WriteKey(Pair.Key);
+			if (Pair.Value->IsObject())
+			{
+				Writer.WriteBool(true);
+			}
+			else
+			{
+				FirebaseEmulatorDatabase::WriteValue(Writer, Pair.Value.Get());
+			}
+		}
+		Writer.EndObject();
+		return true;
+	}
+
+	if (!Query.IsFiltered())
+	{
+		FirebaseEmulatorDatabase::WriteValue(Writer, Node);
+		return true;
+	}
+
+	if (Query.OrderBy.IsEmpty())
+	{
+		OutError = TEXT("orderBy must be defined when other query parameters are defined");
+		return false;
+	}
+
+	if (!bIsObject)
+	{
+		FirebaseEmulatorDatabase::WriteValue(Writer, Node);
+		return true;
+	}
+
+	const bool bByKey = Query.OrderBy == TEXT("$key");
+	const bool bByValue = Query.OrderBy == TEXT("$value");
+	const bool bByPriority = Query.OrderBy == TEXT("$priority");
+
+	TArray<FirebaseEmulatorDatabase::FQueryEntry> Entries;
+	Entries.Reserve(Node->Children.Num());
+	for (const TPair<FString, TSharedPtr<FFirebaseEmulatorNode>>& Pair : Node->Children)
+	{
+		FirebaseEmulatorDatabase::FQueryEntry& Entry = Entries.AddDefaulted_GetRef();
+		Entry.Key = &Pair.Key;
+		Entry.Value = Pair.Value.Get();
+		if (bByKey)
+		{
+			Entry.OrderValue = MakeShared<FJsonValueString>(Pair.Key);
+		}
+		else if (bByValue)
+		{
+			Entry.OrderValue = FirebaseEmulatorDatabase::GetOrderValue(Entry.Value);
+		}
+		else if (!bByPriority)
+		{
+			Entry.OrderValue = FirebaseEmulatorDatabase::GetOrderValue(FirebaseEmulatorDatabase::FindChild(Entry.Value, Query.OrderBy));
+		}
+	}
+
+	// Compare ordering values; $key uses key order, ties fall back to key order
+	auto CompareEntryTo = [bByKey](const FirebaseEmulatorDatabase::FQueryEntry& Entry, const TSharedPtr<FJsonValue>& Bound)
+	{
+		if (bByKey)
+		{
+			return FirebaseEmulatorDatabase::CompareKeys(*Entry.Key, Bound.IsValid() && Bound->Type == EJson::String ? Bound->AsString() : FString());
+		}
+		return FirebaseEmulatorDatabase::CompareValues(Entry.OrderValue, Bound);
+	};
+
+	Entries.Sort([bByKey](const FirebaseEmulatorDatabase::FQueryEntry& A, const FirebaseEmulatorDatabase::FQueryEntry& B)
+	{
+		const int32 Order = bByKey ? 0 : FirebaseEmulatorDatabase::CompareValues(A.OrderValue, B.OrderValue);
+		return Order != 0 ? Order < 0 : FirebaseEmulatorDatabase::CompareKeys(*A.Key, *B.Key) < 0;
+	});
+
+	Entries.RemoveAll([&Query, &CompareEntryTo](const FirebaseEmulatorDatabase::FQueryEntry& Entry)
+	{
+		return (Query.EqualTo.IsValid() && CompareEntryTo(Entry, Query.EqualTo) != 0)
+			|| (Query.StartAt.IsValid() && CompareEntryTo(Entry, Query.StartAt) < 0)
+			|| (Query.EndAt.IsValid() && CompareEntryTo(Entry, Query.EndAt) > 0);
+	});
+
+	int32 First = 0;
+	int32 Last = Entries.Num();
+	if (Query.LimitToFirst > 0)
+	{
+		Last = FMath::Min(Last, Query.LimitToFirst);
+	}
+	if (Query.LimitToLast > 0)
+	{
+		First = FMath::Max(First, Last - Query.LimitToLast);
+	}
+
+	Writer.BeginObject();
+	for (int32 Index = First; Index < Last; ++Index)
+	{
+		Writer.WriteKey(*Entries[Index].Key);
+		FirebaseEmulatorDatabase::WriteValue(Writer, Entries[Index].Value);
+	}
+	Writer.EndObject();
+	return true;
+}
+
+FString FFirebaseEmulatorDatabase::GetJson(FStringView Path) const
+{
+	FFirebaseJsonWriter Writer;
+	FirebaseEmulatorDatabase::WriteValue(Writer, Find(Path));
+	return Writer.ToString();
+}
+
+void FFirebaseEmulatorDatabase::SetNode(FStringView Path, const TSharedPtr<FFirebaseEmulatorNode>& Node)
+{
+	TArray<FStringView, TInlineAllocator<16>> Segments;
+	FirebaseEmulatorDatabase::SplitPath(Path, Segments);
+	FirebaseEmulatorDatabase::SetAt(Root, Segments, Node);
+	++WriteCount;
+}
+
+void FFirebaseEmulatorDatabase::Set(FStringView Path, const FFirebaseJsonTape::FValue& Value)
+{
+	SetNode(Path, FirebaseEmulatorDatabase::Normalize(Value, FirebaseEmulatorDatabase::GetNowMs()));
+}
+
+void FFirebaseEmulatorDatabase::Set(FStringView Path, const TSharedPtr<FJsonValue>& Value)
+{
+	SetNode(Path, FirebaseEmulatorDatabase::Normalize(Value, FirebaseEmulatorDatabase::GetNowMs()));
+}
+
+bool FFirebaseEmulatorDatabase::Update(FStringView Path, const FFirebaseJsonTape::FValue& Values)
+{
+	if (!Values.IsValid() || !Values.IsObject())
+	{
+		return false;
+	}
+
+	const FString Base(Path);
+	const double NowMs = FirebaseEmulatorDatabase::GetNowMs();
+	Values.ForEachField([this, &Base, NowMs](FUtf8StringView Key, const FFirebaseJsonTape::FValue& Value)
+	{
+		SetNode(Base + TEXT("/") + FirebaseEmulatorDatabase::ToKey(Key), FirebaseEmulatorDatabase::Normalize(Value, NowMs));
+		return true;
+	});
+	return true;
+}
+
+FString FFirebaseEmulatorDatabase::Push(FStringView Path, const FFirebaseJsonTape::FValue& Value)
+{
+	const FString Key = UFirebaseDatabase::GeneratePushId();
+	Set(FString(Path) + TEXT("/") + Key, Value);
+	return Key;
+}
+
+FString FFirebaseEmulatorDatabase::GetETag(FStringView Path) const
+{
+	const FFirebaseEmulatorNode* Node = Find(Path);
+	if (!Node)
+	{
+		return TEXT("null_etag");
+	}
+
+	FFirebaseJsonWriter Writer;
+	FirebaseEmulatorDatabase::WriteValue(Writer, Node);
+	const FUtf8StringView Json = Writer.GetView();
+
+	uint8 Hash[FSHA1::DigestSize];
+	FSHA1::HashBuffer(Json.GetData(), Json.Len(), Hash);
+	return FBase64::Encode(Hash, FSHA1::DigestSize);
+}
+
+void FFirebaseEmulatorDatabase::Reset()
+{
+	Root.Reset();
+	WriteCount = 0;
+}
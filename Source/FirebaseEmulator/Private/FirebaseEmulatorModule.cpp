@@ -0,0 +1,132 @@
+// Copyright. All Rights Reserved.
+
+#include "FirebaseEmulatorModule.h"
+#include "FirebaseLog.h"
+#include "FirebaseEmulatorAuth.h"
+#include "FirebaseEmulatorDatabase.h"
+#include "FirebaseEmulatorServer.h"
+#include "FirebaseSettings.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+
+void FFirebaseEmulatorModule::StartupModule()
+{
+	Database = MakeUnique<FFirebaseEmulatorDatabase>();
+	Auth = MakeUnique<FFirebaseEmulatorAuth>();
+	Server = MakeUnique<FFirebaseEmulatorServer>(*Database, *Auth);
+
+	ConsoleCommands.Add(IConsoleManager::Get().RegisterConsoleCommand(
+		TEXT("Firebase.Emulator.Start"),
+		TEXT("Serve the database and auth REST APIs from memory and point the plugin at them. Usage: Firebase.Emulator.Start [Port=9000]"),
+		FConsoleCommandWithArgsDelegate::CreateLambda([this](const TArray<FString>& Args)
+		{
+			uint32 Port = DefaultPort;
+			if (Args.Num() > 0)
+			{
+				LexFromString(Port, *Args[0]);
+			}
+			Start(Port);
+		})));
+	ConsoleCommands.Add(IConsoleManager::Get().RegisterConsoleCommand(
+		TEXT("Firebase.Emulator.Stop"),
+		TEXT("Stop serving emulator requests"),
+		FConsoleCommandDelegate::CreateRaw(this, &FFirebaseEmulatorModule::Stop)));
+	ConsoleCommands.Add(IConsoleManager::Get().RegisterConsoleCommand(
+		TEXT("Firebase.Emulator.Reset"),
+		TEXT("Clear all emulated data and accounts"),
+		FConsoleCommandDelegate::CreateRaw(this, &FFirebaseEmulatorModule::Reset)));
+
+	// -FirebaseEmulator or -FirebaseEmulator=<port>
+	const TCHAR* CommandLine = FCommandLine::Get();
+	uint32 Port = DefaultPort;
+	if (FParse::Value(CommandLine, TEXT("-FirebaseEmulator="), Port) || FParse::Param(CommandLine, TEXT("FirebaseEmulator")))
+	{
+		Start(Port);
+	}
+}
+
+void FFirebaseEmulatorModule::ShutdownModule()
+{
+	for (IConsoleObject* Command : ConsoleCommands)
+	{
+		IConsoleManager::Get().UnregisterConsoleObject(Command);
+	}
+	ConsoleCommands.Reset();
+
+	Server.Reset();
+	Auth.Reset();
+	Database.Reset();
+}
+
+bool FFirebaseEmulatorModule::Start(uint32 Port, bool bRedirectSettings)
+{
+	if (const UFirebaseSettings* Settings = GetDefault<UFirebaseSettings>(); Settings && !Settings->ProjectId.IsEmpty())
+	{
+		Auth->ProjectId = Settings->ProjectId;
+	}
+
+	if (!Server->Start(Port))
+	{
+		return false;
+	}
+
+	if (bRedirectSettings)
+	{
+		RedirectSettings();
+	}
+	return true;
+}
+
+void FFirebaseEmulatorModule::Stop()
+{
+	Server->Stop();
+}
+
+bool FFirebaseEmulatorModule::IsRunning() const
+{
+	return Server.IsValid() && Server->IsRunning();
+}
+
+FString FFirebaseEmulatorModule::GetDatabaseUrl() const
+{
+	return FString::Printf(TEXT("%s?ns=%s"), *GetAuthUrl(), *Auth->ProjectId);
+}
+
+FString FFirebaseEmulatorModule::GetAuthUrl() const
+{
+	return FString::Printf(TEXT("http://127.0.0.1:%u"), Server->GetPort());
+}
+
+void FFirebaseEmulatorModule::Reset()
+{
+	Database->Reset();
+	Auth->Reset();
+	UE_LOG(LogFirebase, Log, TEXT("Firebase Emulator: Cleared all data and accounts"));
+}
+
+void FFirebaseEmulatorModule::RedirectSettings() const
+{
+	UFirebaseSettings* Settings = GetMutableDefault<UFirebaseSettings>();
+	if (!Settings)
+	{
+		return;
+	}
+
+	// Only in memory: the project's config files keep their live endpoints
+	Settings->DatabaseUrl = GetDatabaseUrl();
+	Settings->AuthEmulatorUrl = GetAuthUrl();
+	if (Settings->ProjectId.IsEmpty())
+	{
+		Settings->ProjectId = Auth->ProjectId;
+	}
+	if (Settings->AndroidApiKey.IsEmpty())
+	{
+		// The emulator accepts any key, but IsAuthenticationConfigured() needs one
+		Settings->AndroidApiKey = TEXT("emulator-api-key");
+	}
+
+	UE_LOG(LogFirebase, Log, TEXT("Firebase Emulator: Database URL is now %s, auth requests go to %s"), *Settings->DatabaseUrl, *Settings->AuthEmulatorUrl);
+}
+
+IMPLEMENT_MODULE(FFirebaseEmulatorModule, FirebaseEmulator)
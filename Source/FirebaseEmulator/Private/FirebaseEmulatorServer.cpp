@@ -0,0 +1,419 @@
+// Copyright. All Rights Reserved.
+
+#include "FirebaseEmulatorServer.h"
+#include "FirebaseLog.h"
+#include "FirebaseEmulatorAuth.h"
+#include "FirebaseEmulatorDatabase.h"
+#include "FirebaseJsonDocument.h"
+#include "FirebaseJsonTape.h"
+#include "FirebaseJsonWriter.h"
+#include "FirebasePayload.h"
+#include "HttpServerModule.h"
+#include "HttpServerRequest.h"
+#include "HttpServerResponse.h"
+#include "IHttpRouter.h"
+#include "GenericPlatform/GenericPlatformHttp.h"
+#include "Misc/EngineVersionComparison.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+
+namespace FirebaseEmulatorServer
+{
+	const TCHAR* AuthPrefixes[] = {
+		TEXT("/identitytoolkit.googleapis.com/v1/"),
+		TEXT("/securetoken.googleapis.com/v1/"),
+	};
+
+	TUniquePtr<FHttpServerResponse> MakeResponse(int32 Code, FUtf8StringView Body, const TCHAR* ContentType = TEXT("application/json; charset=utf-8"))
+	{
+		TUniquePtr<FHttpServerResponse> Response = MakeUnique<FHttpServerResponse>();
+		Response->Code = static_cast<EHttpServerResponseCodes>(Code);
+		Response->Headers.Add(TEXT("content-type"), { ContentType });
+		Response->Headers.Add(TEXT("access-control-allow-origin"), { TEXT("*") });
+		Response->Body.Append(reinterpret_cast<const uint8*>(Body.GetData()), Body.Len());
+		return Response;
+	}
+
+	TUniquePtr<FHttpServerResponse> MakeError(int32 Code, const FString& Message)
+	{
+		FFirebaseJsonWriter Writer;
+		Writer.BeginObject();
+		Writer.WriteKey(FStringView(TEXT("error")));
+		Writer.WriteString(FStringView(Message));
+		Writer.EndObject();
+		return MakeResponse(Code, Writer.GetView());
+	}
+
+	TUniquePtr<FHttpServerResponse> MakeJson(int32 Code, const TSharedPtr<FJsonObject>& Object)
+	{
+		FString Json;
+		TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Json);
+		FJsonSerializer::Serialize(Object.ToSharedRef(), Writer);
+		FTCHARToUTF8 Utf8(*Json, Json.Len());
+		return MakeResponse(Code, FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Utf8.Get()), Utf8.Length()));
+	}
+
+	const FString* FindHeader(const FHttpServerRequest& Request, const TCHAR* Name)
+	{
+		// FString map keys compare case-insensitively, as header names do
+		const TArray<FString>* Values = Request.Headers.Find(Name);
+		return Values && Values->Num() > 0 ? &(*Values)[0] : nullptr;
+	}
+
+	const FString* FindParam(const FHttpServerRequest& Request, const TCHAR* Name)
+	{
+		return Request.QueryParams.Find(Name);
+	}
+
+	/** Query parameter value parsed as JSON, as orderBy/startAt/endAt/equalTo are sent */
+	TSharedPtr<FJsonValue> ParseJsonParam(const FString& Value)
+	{
+		const FString Decoded = FGenericPlatformHttp::UrlDecode(Value);
+		return FFirebaseJsonDocument::Parse(FFirebasePayload::FromString(Decoded))->GetRoot();
+	}
+
+	bool ParseQuery(const FHttpServerRequest& Request, FFirebaseEmulatorQuery& OutQuery, FString& OutError)
+	{
+		if (const FString* OrderBy = FindParam(Request, TEXT("orderBy")))
+		{
+			const TSharedPtr<FJsonValue> Value = ParseJsonParam(*OrderBy);
+			if (!Value.IsValid() || !Value->TryGetString(OutQuery.OrderBy))
+			{
+				OutError = TEXT("orderBy must be a valid JSON encoded path");
+				return false;
+			}
+		}
+
+		const TPair<const TCHAR*, TSharedPtr<FJsonValue>*> Bounds[] = {
+			{ TEXT("startAt"), &OutQuery.StartAt },
+			{ TEXT("endAt"), &OutQuery.EndAt },
+			{ TEXT("equalTo"), &OutQuery.EqualTo },
+		};
+		for (const TPair<const TCHAR*, TSharedPtr<FJsonValue>*>& Bound : Bounds)
+		{
+			if (const FString* Value = FindParam(Request, Bound.Key))
+			{
+				*Bound.Value = ParseJsonParam(*Value);
+				if (!Bound.Value->IsValid())
+				{
+					OutError = FString::Printf(TEXT("Constraint index field must be a JSON primitive: %s"), Bound.Key);
+					return false;
+				}
+			}
+		}
+
+		if (const FString* Limit = FindParam(Request, TEXT("limitToFirst")))
+		{
+			LexFromString(OutQuery.LimitToFirst, **Limit);
+		}
+		if (const FString* Limit = FindParam(Request, TEXT("limitToLast")))
+		{
+			LexFromString(OutQuery.LimitToLast, **Limit);
+		}
+		if (OutQuery.LimitToFirst < 0 || OutQuery.LimitToLast < 0 || (OutQuery.LimitToFirst > 0 && OutQuery.LimitToLast > 0))
+		{
+			OutError = TEXT("limitToFirst and limitToLast must be positive and cannot both be set");
+			return false;
+		}
+
+		if (const FString* Shallow = FindParam(Request, TEXT("shallow")))
+		{
+			OutQuery.bShallow = *Shallow == TEXT("true");
+			if (OutQuery.bShallow && (!OutQuery.OrderBy.IsEmpty() || OutQuery.StartAt.IsValid() || OutQuery.EndAt.IsValid()
+				|| OutQuery.EqualTo.IsValid() || OutQuery.LimitToFirst > 0 || OutQuery.LimitToLast > 0))
+			{
+				OutError = TEXT("Mixing shallow with other query parameters is not allowed");
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/** "/a%20b/c.json" -> "a b/c"; false if the path does not name a .json resource */
+	bool DecodeDatabasePath(const FString& RelativePath, FString& OutPath)
+	{
+		FStringView Path(RelativePath);
+		if (!Path.EndsWith(TEXT(".json")))
+		{
+			return false;
+		}
+		Path.LeftChopInline(5);
+
+		TArray<FString> Segments;
+		FString(Path).ParseIntoArray(Segments, TEXT("/"));
+		for (FString& Segment : Segments)
+		{
+			Segment = FGenericPlatformHttp::UrlDecode(Segment);
+		}
+		OutPath = FString::Join(Segments, TEXT("/"));
+		return true;
+	}
+
+	/** JSON object from a JSON body, or from an application/x-www-form-urlencoded one as securetoken accepts */
+	TSharedPtr<FJsonObject> ParseAuthBody(const TArray<uint8>& Body)
+	{
+		const FFirebasePayload Payload = FFirebasePayload::FromUtf8(FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Body.GetData()), Body.Num()));
+		const FString Text = Payload.ToString().TrimStartAndEnd();
+		if (Text.StartsWith(TEXT("{")))
+		{
+			const TSharedPtr<FJsonValue> Root = FFirebaseJsonDocument::Parse(Payload)->GetRoot();
+			return Root.IsValid() && Root->Type == EJson::Object ? Root->AsObject() : nullptr;
+		}
+
+		TSharedPtr<FJsonObject> Object = MakeShared<FJsonObject>();
+		TArray<FString> Pairs;
+		Text.ParseIntoArray(Pairs, TEXT("&"));
+		for (const FString& Pair : Pairs)
+		{
+			FString Key, Value;
+			if (!Pair.Split(TEXT("="), &Key, &Value))
+			{
+				Key = Pair;
+			}
+			Object->SetStringField(FGenericPlatformHttp::UrlDecode(Key), FGenericPlatformHttp::UrlDecode(Value.Replace(TEXT("+"), TEXT(" "))));
+		}
+		return Object;
+	}
+}
+
+FFirebaseEmulatorServer::FFirebaseEmulatorServer(FFirebaseEmulatorDatabase& InDatabase, FFirebaseEmulatorAuth& InAuth)
+	: Database(InDatabase)
+	, Auth(InAuth)
+{
+}
+
+FFirebaseEmulatorServer::~FFirebaseEmulatorServer()
+{
+	Stop();
+}
+
+bool FFirebaseEmulatorServer::Start(uint32 InPort)
+{
+	Stop();
+
+	TSharedPtr<IHttpRouter> NewRouter = FHttpServerModule::Get().GetHttpRouter(InPort);
+	if (!NewRouter.IsValid())
+	{
+		UE_LOG(LogFirebase, Error, TEXT("Firebase Emulator: Could not listen on port %u"), InPort);
+		return false;
+	}
+
+	// "/" matches every path: the router falls back to the longest bound parent
+	const EHttpServerRequestVerbs Verbs = EHttpServerRequestVerbs::VERB_GET | EHttpServerRequestVerbs::VERB_PUT
+		| EHttpServerRequestVerbs::VERB_POST | EHttpServerRequestVerbs::VERB_PATCH | EHttpServerRequestVerbs::VERB_DELETE;
+#if UE_VERSION_OLDER_THAN(5, 4, 0)
+	RouteHandle = NewRouter->BindRoute(FHttpPath(TEXT("/")), Verbs,
+		[this](const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete) { return HandleRequest(Request, OnComplete); });
+#else
+	RouteHandle = NewRouter->BindRoute(FHttpPath(TEXT("/")), Verbs, FHttpRequestHandler::CreateRaw(this, &FFirebaseEmulatorServer::HandleRequest));
+#endif
+	if (!RouteHandle.IsValid())
+	{
+		UE_LOG(LogFirebase, Error, TEXT("Firebase Emulator: Port %u is already routed by another server"), InPort);
+		return false;
+	}
+
+	Router = NewRouter;
+	Port = InPort;
+	FHttpServerModule::Get().StartAllListeners();
+
+	UE_LOG(LogFirebase, Log, TEXT("Firebase Emulator: Listening on http://127.0.0.1:%u"), Port);
+	return true;
+}
+
+void FFirebaseEmulatorServer::Stop()
+{
+	if (Router.IsValid())
+	{
+		Router->UnbindRoute(RouteHandle);
+		Router.Reset();
+		RouteHandle.Reset();
+		UE_LOG(LogFirebase, Log, TEXT("Firebase Emulator: Stopped serving port %u"), Port);
+	}
+}
+
+bool FFirebaseEmulatorServer::HandleRequest(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+{
+	const FString& RelativePath = Request.RelativePath.GetPath();
+
+	for (const TCHAR* Prefix : FirebaseEmulatorServer::AuthPrefixes)
+	{
+		if (RelativePath.StartsWith(Prefix))
+		{
+			OnComplete(HandleAuth(Request, FStringView(RelativePath).RightChop(FCString::Strlen(Prefix))));
+			return true;
+		}
+	}
+
+	FString Path;
+	if (!FirebaseEmulatorServer::DecodeDatabasePath(RelativePath, Path))
+	{
+		OnComplete(FirebaseEmulatorServer::MakeError(404, TEXT("Not Found: database paths end in .json")));
+		return true;
+	}
+
+	OnComplete(HandleDatabase(Request, Path));
+	return true;
+}
+
+TUniquePtr<FHttpServerResponse> FFirebaseEmulatorServer::HandleDatabase(const FHttpServerRequest& Request, const FString& Path)
+{
+	// The client reads these two to estimate clock skew and connectivity
+	if (Path == TEXT(".info/serverTimeOffset"))
+	{
+		return FirebaseEmulatorServer::MakeResponse(200, UTF8TEXTVIEW("0"));
+	}
+	if (Path == TEXT(".info/connected"))
+	{
+		return FirebaseEmulatorServer::MakeResponse(200, UTF8TEXTVIEW("true"));
+	}
+
+	const FString* ETagRequest = FirebaseEmulatorServer::FindHeader(Request, TEXT("X-Firebase-ETag"));
+	const bool bWantETag = ETagRequest && ETagRequest->Equals(TEXT("true"), ESearchCase::IgnoreCase);
+	const FString* PrintParam = FirebaseEmulatorServer::FindParam(Request, TEXT("print"));
+	const bool bSilent = PrintParam && *PrintParam == TEXT("silent");
+
+	// Conditional writes: If-Match must name the current value
+	if (Request.Verb != EHttpServerRequestVerbs::VERB_GET)
+	{
+		if (const FString* IfMatch = FirebaseEmulatorServer::FindHeader(Request, TEXT("if-match")))
+		{
+			const FString CurrentETag = Database.GetETag(Path);
+			if (*IfMatch != CurrentETag)
+			{
+				TUniquePtr<FHttpServerResponse> Response = FirebaseEmulatorServer::MakeError(412, TEXT("ETag mismatch"));
+				Response->Headers.Add(TEXT("etag"), { CurrentETag });
+				return Response;
+			}
+		}
+	}
+
+	// Bodies are read from a tape rather than FJsonObject, whose keys ignore case
+	FFirebaseJsonTape BodyTape;
+	FFirebaseJsonTape::FValue Body;
+	if (Request.Verb == EHttpServerRequestVerbs::VERB_PUT || Request.Verb == EHttpServerRequestVerbs::VERB_POST || Request.Verb == EHttpServerRequestVerbs::VERB_PATCH)
+	{
+		const FFirebasePayload Payload = FFirebasePayload::FromUtf8(FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Request.Body.GetData()), Request.Body.Num()));
+		if (!BodyTape.Parse(Payload))
+		{
+			return FirebaseEmulatorServer::MakeError(400, TEXT("Invalid data; couldn't parse JSON object, array, or value."));
+		}
+		Body = BodyTape.GetRoot();
+	}
+
+	FFirebaseJsonWriter Writer;
+	switch (Request.Verb)
+	{
+	case EHttpServerRequestVerbs::VERB_GET:
+	{
+		const FString* Accept = FirebaseEmulatorServer::FindHeader(Request, TEXT("accept"));
+		if (Accept && Accept->Contains(TEXT("text/event-stream")))
+		{
+			// The server cannot hold a response open, so a stream carries only the initial
+			// snapshot; a listening client reconnects and receives the current value again.
+			FFirebaseJsonWriter Event;
+			Event.BeginObject();
+			Event.WriteKey(FStringView(TEXT("path")));
+			Event.WriteString(FStringView(TEXT("/")));
+			Event.WriteKey(FStringView(TEXT("data")));
+			FString Error;
+			Database.Write(Path, FFirebaseEmulatorQuery(), Event, Error);
+			Event.EndObject();
+
+			TStringBuilderWithBuffer<UTF8CHAR, 256> Stream;
+			Stream << UTF8TEXTVIEW("event: put\ndata: ") << Event.GetView() << UTF8TEXTVIEW("\n\n");
+			return FirebaseEmulatorServer::MakeResponse(200, Stream.ToView(), TEXT("text/event-stream"));
+		}
+
+		FFirebaseEmulatorQuery Query;
+		FString Error;
+		if (!FirebaseEmulatorServer::ParseQuery(Request, Query, Error) || !Database.Write(Path, Query, Writer, Error))
+		{
+			return FirebaseEmulatorServer::MakeError(400, Error);
+		}
+
+		const FString ETag = Database.GetETag(Path);
+		const FString* IfNoneMatch = FirebaseEmulatorServer::FindHeader(Request, TEXT("if-none-match"));
+		if (IfNoneMatch && *IfNoneMatch == ETag)
+		{
+			TUniquePtr<FHttpServerResponse> Response = FirebaseEmulatorServer::MakeResponse(304, FUtf8StringView());
+			Response->Headers.Add(TEXT("etag"), { ETag });
+			return Response;
+		}
+
+		TUniquePtr<FHttpServerResponse> Response = FirebaseEmulatorServer::MakeResponse(200, Writer.GetView());
+		if (bWantETag)
+		{
+			Response->Headers.Add(TEXT("etag"), { ETag });
+		}
+		return Response;
+	}
+
+	case EHttpServerRequestVerbs::VERB_PUT:
+	{
+		// PUT echoes the stored value, so server timestamps come back resolved
+		Database.Set(Path, Body);
+		FString Error;
+		Database.Write(Path, FFirebaseEmulatorQuery(), Writer, Error);
+		break;
+	}
+
+	case EHttpServerRequestVerbs::VERB_PATCH:
+		if (!Database.Update(Path, Body))
+		{
+			return FirebaseEmulatorServer::MakeError(400, TEXT("Invalid data; PATCH requires a JSON object."));
+		}
+		// PATCH echoes the values it was sent, not the merged node
+		Writer.WriteRawValue(FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Request.Body.GetData()), Request.Body.Num()));
+		break;
+
+	case EHttpServerRequestVerbs::VERB_POST:
+	{
+		const FString Name = Database.Push(Path, Body);
+		Writer.BeginObject();
+		Writer.WriteKey(FStringView(TEXT("name")));
+		Writer.WriteString(FStringView(Name));
+		Writer.EndObject();
+		break;
+	}
+
+	case EHttpServerRequestVerbs::VERB_DELETE:
+		Database.Set(Path, nullptr);
+		Writer.WriteNull();
+		break;
+
+	default:
+		return FirebaseEmulatorServer::MakeError(405, TEXT("Method not allowed"));
+	}
+
+	if (bSilent)
+	{
+		return FirebaseEmulatorServer::MakeResponse(204, FUtf8StringView());
+	}
+
+	TUniquePtr<FHttpServerResponse> Response = FirebaseEmulatorServer::MakeResponse(200, Writer.GetView());
+	if (bWantETag)
+	{
+		Response->Headers.Add(TEXT("etag"), { Database.GetETag(Path) });
+	}
+	return Response;
+}
+
+TUniquePtr<FHttpServerResponse> FFirebaseEmulatorServer::HandleAuth(const FHttpServerRequest& Request, FStringView Method)
+{
+	if (Request.Verb != EHttpServerRequestVerbs::VERB_POST)
+	{
+		return FirebaseEmulatorServer::MakeError(405, TEXT("Auth endpoints only accept POST"));
+	}
+
+	const TSharedPtr<FJsonObject> Body = FirebaseEmulatorServer::ParseAuthBody(Request.Body);
+	if (!Body.IsValid())
+	{
+		return FirebaseEmulatorServer::MakeError(400, TEXT("Invalid JSON payload received."));
+	}
+
+	TSharedPtr<FJsonObject> Response;
+	const int32 Code = Auth.Handle(Method, Body, Response);
+	return FirebaseEmulatorServer::MakeJson(Code, Response);
+}
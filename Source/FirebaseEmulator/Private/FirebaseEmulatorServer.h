@@ -0,0 +1,51 @@
+// Copyright. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HttpRouteHandle.h"
+#include "HttpResultCallback.h"
+
+class FFirebaseEmulatorDatabase;
+class FFirebaseEmulatorAuth;
+class IHttpRouter;
+struct FHttpServerRequest;
+struct FHttpServerResponse;
+
+/**
+ * HTTP front end of the emulator: serves the Realtime Database REST API
+ * ("/<path>.json") and the identitytoolkit/securetoken endpoints
+ * ("/identitytoolkit.googleapis.com/v1/...") from one local port, the
+ * layout FFirebaseUrlBuilder produces when pointed at it.
+ *
+ * Requests are handled on the game thread, where the HTTP server module
+ * ticks its listeners, so the stores need no locking.
+ */
+class FFirebaseEmulatorServer
+{
+public:
+	FFirebaseEmulatorServer(FFirebaseEmulatorDatabase& InDatabase, FFirebaseEmulatorAuth& InAuth);
+	~FFirebaseEmulatorServer();
+
+	/** Bind the routes and start listening; false if the port is unavailable */
+	bool Start(uint32 InPort);
+
+	/** Unbind the routes (the listener itself is shared and stays up) */
+	void Stop();
+
+	bool IsRunning() const { return Router.IsValid(); }
+	uint32 GetPort() const { return Port; }
+
+private:
+	bool HandleRequest(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
+
+	TUniquePtr<FHttpServerResponse> HandleDatabase(const FHttpServerRequest& Request, const FString& Path);
+	TUniquePtr<FHttpServerResponse> HandleAuth(const FHttpServerRequest& Request, FStringView Method);
+
+	FFirebaseEmulatorDatabase& Database;
+	FFirebaseEmulatorAuth& Auth;
+
+	TSharedPtr<IHttpRouter> Router;
+	FHttpRouteHandle RouteHandle;
+	uint32 Port = 0;
+};
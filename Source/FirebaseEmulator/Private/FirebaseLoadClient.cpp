@@ -0,0 +1,267 @@
+// Copyright. All Rights Reserved.
+
+#include "FirebaseLoadClient.h"
+#include "FirebaseJsonWriter.h"
+#include "FirebaseLog.h"
+#include "FirebaseRestAPI.h"
+#include "FirebaseHttpTransport.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Containers/Ticker.h"
+#include "UObject/Package.h"
+
+/**
+ * Decorates the shared HTTP transport for one load client, charging sends
+ * and response handling to it. Responses still in flight when the client
+ * goes away are passed through uncharged.
+ */
+class FFirebaseLoadClientTransport : public IFirebaseHttpTransport, public TSharedFromThis<FFirebaseLoadClientTransport>
+{
+public:
+	explicit FFirebaseLoadClientTransport(FFirebaseLoadClient& InClient)
+		: Client(&InClient)
+		, Inner(FFirebaseHttpModuleTransport::Get())
+	{
+	}
+
+	//~ Begin IFirebaseHttpTransport Interface
+	virtual FFirebaseHttpRequestId Send(FFirebaseHttpRequest&& Request, FFirebaseHttpCallback&& OnComplete) override
+	{
+		if (!Client)
+		{
+			return Inner->Send(MoveTemp(Request), MoveTemp(OnComplete));
+		}
+
+		FFirebaseLoadClient::FCpuScope CpuScope(*Client);
+		Client->BytesSent += Request.Body.Num();
+		return Inner->Send(MoveTemp(Request), [This = AsShared(), OnComplete = MoveTemp(OnComplete)](const FFirebaseHttpResponse& Response)
+		{
+			if (!This->Client)
+			{
+				OnComplete(Response);
+				return;
+			}
+
+			FFirebaseLoadClient::FCpuScope CpuScope(*This->Client);
+			This->Client->BytesReceived += Response.Body.Num();
+			OnComplete(Response);
+		});
+	}
+
+	virtual void Cancel(FFirebaseHttpRequestId RequestId) override
+	{
+		Inner->Cancel(RequestId);
+	}
+	//~ End IFirebaseHttpTransport Interface
+
+	/** Null once the client is destroyed */
+	FFirebaseLoadClient* Client;
+
+private:
+	TSharedRef<IFirebaseHttpTransport> Inner;
+};
+
+FFirebaseLoadClient::FCpuScope::FCpuScope(FFirebaseLoadClient& InClient)
+	: Client(InClient)
+	, StartCycles(Client.CpuScopeDepth++ == 0 ? FPlatformTime::Cycles64() : 0)
+{
+}
+
+FFirebaseLoadClient::FCpuScope::~FCpuScope()
+{
+	if (--Client.CpuScopeDepth == 0)
+	{
+		Client.CpuCycles += FPlatformTime::Cycles64() - StartCycles;
+	}
+}
+
+FFirebaseLoadClient::FFirebaseLoadClient(int32 InIndex, const FString& DatabaseUrl, const FString& AuthUrl)
+	: Index(InIndex)
+	, Transport(MakeShared<FFirebaseLoadClientTransport>(*this))
+{
+	Api = NewObject<UFirebaseRestAPI>(GetTransientPackage());
+	Api->AddToRoot();
+	Api->Initialize(TEXT("load-key"), TEXT("load"), DatabaseUrl);
+	Api->SetAuthEmulator(AuthUrl);
+	Api->SetTransport(Transport);
+}
+
+FFirebaseLoadClient::~FFirebaseLoadClient()
+{
+	Transport->Client = nullptr;
+	if (Api)
+	{
+		Api->RemoveFromRoot();
+		Api->MarkAsGarbage();
+	}
+}
+
+bool FFirebaseLoadClient::IsSignedIn() const
+{
+	return Api->IsSignedIn();
+}
+
+double FFirebaseLoadClient::GetCpuSeconds() const
+{
+	return FPlatformTime::ToSeconds64(CpuCycles);
+}
+
+void FFirebaseLoadClient::Issue(EFirebaseTrafficOp Op, const FString& Path, const FFirebasePayload& Body)
+{
+	FCpuScope CpuScope(*this);
+	Issued[(int32)Op]++;
+
+	// Listeners are not requests; the REST API's own ticker sends their polls
+	if (Op == EFirebaseTrafficOp::Listen)
+	{
+		TWeakPtr<FFirebaseLoadClient> WeakThis = AsShared();
+		Api->StartPolling(Path, nullptr, FFirebaseRestPayloadCallback::CreateLambda([WeakThis](bool bSuccess, const FFirebasePayload&)
+		{
+			TSharedPtr<FFirebaseLoadClient> This = WeakThis.Pin();
+			if (This && bSuccess)
+			{
+				This->Notifications++;
+			}
+		}));
+		return;
+	}
+	if (Op == EFirebaseTrafficOp::StopListen)
+	{
+		Api->StopPolling(Path);
+		return;
+	}
+
+	InFlight++;
+	const double SendTime = FPlatformTime::Seconds();
+	const FString Token = Api->GetIdToken();
+
+	TWeakPtr<FFirebaseLoadClient> WeakThis = AsShared();
+	auto OnDone = [WeakThis, Op, SendTime](bool bSuccess)
+	{
+		if (TSharedPtr<FFirebaseLoadClient> This = WeakThis.Pin())
+		{
+			This->Complete(Op, SendTime, bSuccess);
+		}
+	};
+	const FFirebaseRestPayloadCallback PayloadDone = FFirebaseRestPayloadCallback::CreateLambda([OnDone](bool bSuccess, const FFirebasePayload&) { OnDone(bSuccess); });
+	const FFirebaseRestCallback StringDone = FFirebaseRestCallback::CreateLambda([OnDone](bool bSuccess, const FString&) { OnDone(bSuccess); });
+
+	switch (Op)
+	{
+	case EFirebaseTrafficOp::Get:
+		Api->GetValue(Path, Token, PayloadDone);
+		break;
+	case EFirebaseTrafficOp::Set:
+		Api->SetValue(Path, Body, Token, PayloadDone);
+		break;
+	case EFirebaseTrafficOp::Update:
+		Api->UpdateValue(Path, Body, Token, PayloadDone);
+		break;
+	case EFirebaseTrafficOp::Push:
+		Api->PushValue(Path, Body, Token, PayloadDone);
+		break;
+	case EFirebaseTrafficOp::Delete:
+		Api->DeleteValue(Path, Token, PayloadDone);
+		break;
+	case EFirebaseTrafficOp::Query:
+		Api->QueryOrderByChild(Path, TEXT("$key"), Token, StringDone);
+		break;
+	case EFirebaseTrafficOp::Transaction:
+		Api->GetValue(Path, Token, FFirebaseRestPayloadCallback::CreateLambda([WeakThis, Path, Body, Token, PayloadDone, OnDone](bool bSuccess, const FFirebasePayload&)
+		{
+			TSharedPtr<FFirebaseLoadClient> This = WeakThis.Pin();
+			if (!This || !bSuccess)
+			{
+				OnDone(false);
+				return;
+			}
+			This->Api->SetValue(Path, Body, Token, PayloadDone);
+		}));
+		break;
+	case EFirebaseTrafficOp::Auth:
+		if (Path == TEXT("token") && Api->IsSignedIn())
+		{
+			Api->RefreshIdToken(Api->GetRefreshToken(), StringDone);
+		}
+		else if (Path == TEXT("accounts:lookup") && Api->IsSignedIn())
+		{
+			Api->GetUserData(Token, StringDone);
+		}
+		else
+		{
+			Api->SignInAnonymously(StringDone);
+		}
+		break;
+	default:
+		InFlight--;
+		break;
+	}
+}
+
+void FFirebaseLoadClient::ResetStats()
+{
+	for (int32 OpIndex = 0; OpIndex < (int32)EFirebaseTrafficOp::Num; ++OpIndex)
+	{
+		Latency[OpIndex].Reset();
+		Issued[OpIndex] = 0;
+		Failed[OpIndex] = 0;
+	}
+	CpuCycles = 0;
+	BytesSent = 0;
+	BytesReceived = 0;
+	Notifications = 0;
+}
+
+void FFirebaseLoadClient::Complete(EFirebaseTrafficOp Op, double SendTime, bool bSuccess)
+{
+	InFlight--;
+	Latency[(int32)Op].Record(FPlatformTime::Seconds() - SendTime);
+	Failed[(int32)Op] += bSuccess ? 0 : 1;
+}
+
+FFirebasePayload FFirebaseLoadClient::MakePayload(int32 Bytes)
+{
+	FFirebaseJsonWriter Writer(Bytes + 32);
+	Writer.BeginObject();
+	Writer.WriteKey(FStringView(TEXT("t")));
+	Writer.WriteInt(FDateTime::UtcNow().ToUnixTimestamp());
+	Writer.WriteKey(FStringView(TEXT("blob")));
+	Writer.WriteString(FString::ChrN(FMath::Max(Bytes - 32, 0), TEXT('x')));
+	Writer.EndObject();
+	return Writer.TakePayload();
+}
+
+void FFirebaseLoadClient::Pump(float DeltaTime)
+{
+	// Game thread tasks carry REST callbacks; the core ticker drives HTTP, the emulator's server and the REST API
+	FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+	FTSTicker::GetCoreTicker().Tick(DeltaTime);
+}
+
+void FFirebaseLoadClient::LogSummary(TConstArrayView<TSharedRef<FFirebaseLoadClient>> Clients, double Seconds)
+{
+	UE_LOG(LogFirebase, Display, TEXT("Firebase Load: %d clients, %.1fs"), Clients.Num(), Seconds);
+	UE_LOG(LogFirebase, Display, TEXT("  %-12s %9s %7s %9s %9s %9s %9s %9s"), TEXT("op"), TEXT("calls"), TEXT("failed"), TEXT("calls/s"),
+		TEXT("p50 ms"), TEXT("p90 ms"), TEXT("p99 ms"), TEXT("max ms"));
+
+	for (int32 OpIndex = 0; OpIndex < (int32)EFirebaseTrafficOp::Num; ++OpIndex)
+	{
+		const EFirebaseTrafficOp Op = EFirebaseTrafficOp(OpIndex);
+		FFirebaseLatencyHistogram Merged;
+		int64 Calls = 0;
+		int64 Failures = 0;
+		for (const TSharedRef<FFirebaseLoadClient>& Client : Clients)
+		{
+			Merged.Merge(Client->GetLatency(Op));
+			Calls += Client->GetIssued(Op);
+			Failures += Client->GetFailed(Op);
+		}
+		if (Calls == 0)
+		{
+			continue;
+		}
+
+		const FFirebaseLatencySummary Summary = Merged.Summarize();
+		UE_LOG(LogFirebase, Display, TEXT("  %-12s %9lld %7lld %9.1f %9.2f %9.2f %9.2f %9.2f"), LexToString(Op), Calls, Failures,
+			Seconds > 0.0 ? Calls / Seconds : 0.0, Summary.P50 * 1000.0, Summary.P90 * 1000.0, Summary.P99 * 1000.0, Summary.Max * 1000.0);
+	}
+}
@@ -0,0 +1,96 @@
+// Copyright. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FirebaseLatencyHistogram.h"
+#include "FirebasePayload.h"
+#include "FirebaseTrafficRecorder.h"
+
+class FFirebaseLoadClientTransport;
+class UFirebaseRestAPI;
+
+/**
+ * One simulated plugin client for the load commandlets: its own
+ * UFirebaseRestAPI (and so its own auth session, request pipeline and
+ * listeners) pointed at the emulator, plus per-op latency and outcome counts.
+ *
+ * The client's transport is wrapped so the game-thread time spent issuing
+ * its calls and handling its responses (including listener polls) and the
+ * bytes it moves are charged to it.
+ */
+class FFirebaseLoadClient : public TSharedFromThis<FFirebaseLoadClient>
+{
+public:
+	FFirebaseLoadClient(int32 InIndex, const FString& DatabaseUrl, const FString& AuthUrl);
+	~FFirebaseLoadClient();
+
+	/**
+	 * Issue one call. Database writes send Body; Query reads ordered by key;
+	 * Transaction is a read followed by a write. Auth refreshes or looks up
+	 * the session when the recorded endpoint was "token" or "accounts:lookup"
+	 * and the client is signed in, and signs in anonymously otherwise.
+	 */
+	void Issue(EFirebaseTrafficOp Op, const FString& Path, const FFirebasePayload& Body);
+
+	int32 GetIndex() const { return Index; }
+	int32 GetInFlight() const { return InFlight; }
+	bool IsSignedIn() const;
+
+	/** Seconds of game-thread time spent in this client's calls and responses */
+	double GetCpuSeconds() const;
+
+	int64 GetBytesSent() const { return BytesSent; }
+	int64 GetBytesReceived() const { return BytesReceived; }
+
+	/** Changes delivered to this client's listeners */
+	int64 GetNotifications() const { return Notifications; }
+
+	/** Forget counts, latencies, time and bytes so far, e.g. after a warm-up phase */
+	void ResetStats();
+
+	UFirebaseRestAPI& GetApi() const { return *Api; }
+
+	const FFirebaseLatencyHistogram& GetLatency(EFirebaseTrafficOp Op) const { return Latency[(int32)Op]; }
+	int64 GetIssued(EFirebaseTrafficOp Op) const { return Issued[(int32)Op]; }
+	int64 GetFailed(EFirebaseTrafficOp Op) const { return Failed[(int32)Op]; }
+
+	/** Record payload of roughly Bytes bytes, a JSON object so it is valid for Update too */
+	static FFirebasePayload MakePayload(int32 Bytes);
+
+	/** Let callbacks, HTTP and the emulator's server run once; the commandlets call this in their loop */
+	static void Pump(float DeltaTime);
+
+	/** Log calls, failures, throughput and latency percentiles per op, merged over Clients */
+	static void LogSummary(TConstArrayView<TSharedRef<FFirebaseLoadClient>> Clients, double Seconds);
+
+private:
+	friend class FFirebaseLoadClientTransport;
+
+	/** Charges the enclosed work to the client unless an outer scope already does */
+	struct FCpuScope
+	{
+		explicit FCpuScope(FFirebaseLoadClient& InClient);
+		~FCpuScope();
+
+		FFirebaseLoadClient& Client;
+		uint64 StartCycles;
+	};
+
+	void Complete(EFirebaseTrafficOp Op, double SendTime, bool bSuccess);
+
+	int32 Index = 0;
+	UFirebaseRestAPI* Api = nullptr;
+	TSharedPtr<FFirebaseLoadClientTransport> Transport;
+	int32 InFlight = 0;
+
+	uint64 CpuCycles = 0;
+	int32 CpuScopeDepth = 0;
+	int64 BytesSent = 0;
+	int64 BytesReceived = 0;
+	int64 Notifications = 0;
+
+	FFirebaseLatencyHistogram Latency[(int32)EFirebaseTrafficOp::Num];
+	int64 Issued[(int32)EFirebaseTrafficOp::Num] = {};
+	int64 Failed[(int32)EFirebaseTrafficOp::Num] = {};
+};
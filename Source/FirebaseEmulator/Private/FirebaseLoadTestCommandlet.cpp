@@ -0,0 +1,448 @@
+// Copyright. All Rights Reserved.
+
+#include "FirebaseLoadTestCommandlet.h"
+#include "FirebaseBufferPool.h"
+#include "FirebaseEmulatorDatabase.h"
+#include "FirebaseEmulatorModule.h"
+#include "FirebaseLoadClient.h"
+#include "FirebaseLog.h"
+#include "FirebaseRestAPI.h"
+#include "FirebaseStats.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformProcess.h"
+#include "Math/RandomStream.h"
+#include "Misc/CoreMisc.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace FirebaseLoadTest
+{
+	static constexpr uint32 DefaultPort = 9400;
+
+	// How often process memory and CPU are sampled
+	static constexpr double SampleSeconds = 0.1;
+
+	// Limits on the phases around the measured run
+	static constexpr double SignInTimeoutSeconds = 30.0;
+	static constexpr double DrainTimeoutSeconds = 30.0;
+
+	struct FOpWeight
+	{
+		EFirebaseTrafficOp Op;
+		float Weight;
+	};
+
+	static bool MakeWorkload(const FString& Name, TArray<FOpWeight>& OutMix)
+	{
+		if (Name == TEXT("ReadHeavy"))
+		{
+			OutMix = { { EFirebaseTrafficOp::Get, 90.0f }, { EFirebaseTrafficOp::Set, 5.0f }, { EFirebaseTrafficOp::Update, 5.0f } };
+		}
+		else if (Name == TEXT("WriteHeavy"))
+		{
+			OutMix = { { EFirebaseTrafficOp::Set, 50.0f }, { EFirebaseTrafficOp::Update, 25.0f }, { EFirebaseTrafficOp::Push, 15.0f }, { EFirebaseTrafficOp::Get, 10.0f } };
+		}
+		else if (Name == TEXT("Fanout"))
+		{
+			OutMix = { { EFirebaseTrafficOp::Set, 100.0f } };
+		}
+		else
+		{
+			return false;
+		}
+		return true;
+	}
+
+	/** "Get:70,Set:30"; listener ops are not allowed since the workload manages listeners itself */
+	static bool ParseMix(const FString& Text, TArray<FOpWeight>& OutMix)
+	{
+		TArray<FString> Entries;
+		Text.ParseIntoArray(Entries, TEXT(","));
+		OutMix.Reset();
+
+		for (const FString& Entry : Entries)
+		{
+			FString Name;
+			FString Weight;
+			if (!Entry.Split(TEXT(":"), &Name, &Weight))
+			{
+				return false;
+			}
+
+			int32 OpIndex = 0;
+			while (OpIndex < (int32)EFirebaseTrafficOp::Num && Name.TrimStartAndEnd() != LexToString(EFirebaseTrafficOp(OpIndex)))
+			{
+				++OpIndex;
+			}
+			const EFirebaseTrafficOp Op = EFirebaseTrafficOp(OpIndex);
+			if (Op == EFirebaseTrafficOp::Num || Op == EFirebaseTrafficOp::Listen || Op == EFirebaseTrafficOp::StopListen)
+			{
+				return false;
+			}
+			OutMix.Add({ Op, FMath::Max(FCString::Atof(*Weight), 0.0f) });
+		}
+		return OutMix.Num() > 0;
+	}
+
+	static EFirebaseTrafficOp PickOp(TConstArrayView<FOpWeight> Mix, FRandomStream& Random)
+	{
+		float Total = 0.0f;
+		for (const FOpWeight& Entry : Mix)
+		{
+			Total += Entry.Weight;
+		}
+
+		float Pick = Random.FRand() * Total;
+		for (const FOpWeight& Entry : Mix)
+		{
+			if (Pick < Entry.Weight)
+			{
+				return Entry.Op;
+			}
+			Pick -= Entry.Weight;
+		}
+		return Mix.Last().Op;
+	}
+
+	/** Exponential gap, so each client's calls form a Poisson process */
+	static double NextGap(double Rate, FRandomStream& Random)
+	{
+		return -FMath::Loge(1.0 - FMath::Min(Random.FRand(), 0.999999f)) / Rate;
+	}
+
+	static TSharedPtr<FJsonValue> MakeRecords(const TCHAR* Prefix, int32 Count, int32 Bytes)
+	{
+		TSharedRef<FJsonObject> Records = MakeShared<FJsonObject>();
+		const FString Blob = FString::ChrN(FMath::Max(Bytes - 32, 0), TEXT('x'));
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			TSharedRef<FJsonObject> Record = MakeShared<FJsonObject>();
+			Record->SetNumberField(TEXT("t"), 0);
+			Record->SetStringField(TEXT("blob"), Blob);
+			Records->SetObjectField(FString::Printf(TEXT("%s%d"), Prefix, Index), Record);
+		}
+		return MakeShared<FJsonValueObject>(Records);
+	}
+
+	static double ToMB(double Bytes)
+	{
+		return Bytes / (1024.0 * 1024.0);
+	}
+}
+
+UFirebaseLoadTestCommandlet::UFirebaseLoadTestCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UFirebaseLoadTestCommandlet::Main(const FString& Params)
+{
+	using namespace FirebaseLoadTest;
+
+	int32 NumClients = 16;
+	FString Workload = TEXT("ReadHeavy");
+	FString MixText;
+	double Duration = 30.0;
+	double Rate = 20.0;
+	int32 MaxInFlight = 32;
+	int32 NumKeys = 1000;
+	int32 PayloadBytes = 256;
+	int32 NumListeners = 8;
+	int32 NumWriters = 1;
+	float PollInterval = 1.0f;
+	int32 Seed = 0;
+	uint32 Port = DefaultPort;
+	FString CsvFile;
+	FParse::Value(*Params, TEXT("Clients="), NumClients);
+	FParse::Value(*Params, TEXT("Workload="), Workload);
+	FParse::Value(*Params, TEXT("Mix="), MixText);
+	FParse::Value(*Params, TEXT("Duration="), Duration);
+	FParse::Value(*Params, TEXT("Rate="), Rate);
+	FParse::Value(*Params, TEXT("MaxInFlight="), MaxInFlight);
+	FParse::Value(*Params, TEXT("Keys="), NumKeys);
+	FParse::Value(*Params, TEXT("PayloadBytes="), PayloadBytes);
+	FParse::Value(*Params, TEXT("Listeners="), NumListeners);
+	FParse::Value(*Params, TEXT("Writers="), NumWriters);
+	FParse::Value(*Params, TEXT("PollInterval="), PollInterval);
+	FParse::Value(*Params, TEXT("Seed="), Seed);
+	FParse::Value(*Params, TEXT("Port="), Port);
+	FParse::Value(*Params, TEXT("Csv="), CsvFile);
+	NumClients = FMath::Max(NumClients, 1);
+	Duration = FMath::Max(Duration, 0.0);
+	Rate = FMath::Max(Rate, 0.01);
+	MaxInFlight = FMath::Max(MaxInFlight, 1);
+	NumKeys = FMath::Max(NumKeys, 1);
+	NumListeners = FMath::Max(NumListeners, 1);
+	NumWriters = FMath::Clamp(NumWriters, 1, NumClients);
+
+	TArray<FOpWeight> Mix;
+	if (!MakeWorkload(Workload, Mix))
+	{
+		UE_LOG(LogFirebase, Error, TEXT("Firebase Load: Unknown workload %s; use ReadHeavy, WriteHeavy or Fanout"), *Workload);
+		return 1;
+	}
+	if (!MixText.IsEmpty() && !ParseMix(MixText, Mix))
+	{
+		UE_LOG(LogFirebase, Error, TEXT("Firebase Load: Could not parse -Mix=%s; expected e.g. Get:70,Set:30"), *MixText);
+		return 1;
+	}
+	const bool bFanout = Workload == TEXT("Fanout");
+
+	FFirebaseEmulatorModule& Emulator = FFirebaseEmulatorModule::Get();
+	const bool bStartedEmulator = !Emulator.IsRunning();
+	if (bStartedEmulator && !Emulator.Start(Port, /*bRedirectSettings=*/ false))
+	{
+		UE_LOG(LogFirebase, Error, TEXT("Firebase Load: Could not start the emulator on port %u"), Port);
+		return 1;
+	}
+
+	// Seed straight into the emulator so reads hit real records from the first call
+	Emulator.GetDatabase().Set(TEXT("load/items"), MakeRecords(TEXT("k"), NumKeys, PayloadBytes));
+	if (bFanout)
+	{
+		Emulator.GetDatabase().Set(TEXT("load/fanout"), MakeRecords(TEXT("l"), NumListeners, PayloadBytes));
+	}
+
+	UE_LOG(LogFirebase, Display, TEXT("Firebase Load: %s workload, %d clients at %.1f calls/s for %.0fs, %d keys of %d bytes"),
+		*Workload, NumClients, Rate, Duration, NumKeys, PayloadBytes);
+
+	// Memory before any client exists is the baseline they are charged against
+	const uint64 BaselineMemory = FPlatformMemory::GetStats().UsedPhysical;
+
+	TArray<TSharedRef<FFirebaseLoadClient>> Clients;
+	for (int32 Index = 0; Index < NumClients; ++Index)
+	{
+		TSharedRef<FFirebaseLoadClient> Client = MakeShared<FFirebaseLoadClient>(Index, Emulator.GetDatabaseUrl(), Emulator.GetAuthUrl());
+		if (bFanout)
+		{
+			FFirebasePollingConfig Polling;
+			Polling.InitialIntervalSeconds = PollInterval;
+			Polling.MinIntervalSeconds = PollInterval;
+			Polling.MaxIntervalSeconds = PollInterval;
+			Polling.bPauseWhenOwnerNotRendered = false;
+			Client->GetApi().SetPollingConfig(Polling);
+		}
+		Client->Issue(EFirebaseTrafficOp::Auth, TEXT("accounts:signUp"), FFirebasePayload());
+		Clients.Add(Client);
+	}
+
+	auto CountInFlight = [&Clients]()
+	{
+		int32 InFlight = 0;
+		for (const TSharedRef<FFirebaseLoadClient>& Client : Clients)
+		{
+			InFlight += Client->GetInFlight();
+		}
+		return InFlight;
+	};
+
+	// Every client gets its own session before the clock starts
+	double LastTime = FPlatformTime::Seconds();
+	const double SignInStart = LastTime;
+	while (CountInFlight() > 0 && LastTime - SignInStart < SignInTimeoutSeconds && !IsEngineExitRequested())
+	{
+		const double Now = FPlatformTime::Seconds();
+		FFirebaseLoadClient::Pump(float(Now - LastTime));
+		LastTime = Now;
+		FPlatformProcess::Sleep(0.001f);
+	}
+
+	int32 NumSignedIn = 0;
+	for (const TSharedRef<FFirebaseLoadClient>& Client : Clients)
+	{
+		NumSignedIn += Client->IsSignedIn() ? 1 : 0;
+	}
+	if (NumSignedIn < NumClients)
+	{
+		UE_LOG(LogFirebase, Warning, TEXT("Firebase Load: Only %d of %d clients signed in; the rest run unauthenticated"), NumSignedIn, NumClients);
+	}
+
+	// Fanout: writers update the listened paths, everyone else only listens
+	if (bFanout)
+	{
+		for (int32 Index = NumWriters; Index < NumClients; ++Index)
+		{
+			for (int32 Listener = 0; Listener < NumListeners; ++Listener)
+			{
+				Clients[Index]->Issue(EFirebaseTrafficOp::Listen, FString::Printf(TEXT("load/fanout/l%d"), Listener), FFirebasePayload());
+			}
+		}
+	}
+
+	for (const TSharedRef<FFirebaseLoadClient>& Client : Clients)
+	{
+		Client->ResetStats();
+	}
+
+	const FFirebasePayload Body = FFirebaseLoadClient::MakePayload(PayloadBytes);
+	const int32 NumActive = bFanout ? NumWriters : NumClients;
+
+	TArray<FRandomStream> Randoms;
+	TArray<double> NextCallTime;
+	TArray<int64> Skipped;
+	for (int32 Index = 0; Index < NumActive; ++Index)
+	{
+		FRandomStream& Random = Randoms.Emplace_GetRef(Seed * 7919 + Index);
+		NextCallTime.Add(NextGap(Rate, Random));
+	}
+	Skipped.SetNumZeroed(NumActive);
+
+	FFirebaseRequestMetrics::Get().Reset();
+	uint64 PeakMemory = FPlatformMemory::GetStats().UsedPhysical;
+	double CpuPercentSum = 0.0;
+	int32 NumCpuSamples = 0;
+
+	const double StartTime = FPlatformTime::Seconds();
+	LastTime = StartTime;
+	double LastSample = StartTime;
+	double LoadEnd = 0.0;
+	while (!IsEngineExitRequested())
+	{
+		const double Now = FPlatformTime::Seconds();
+		const double Elapsed = Now - StartTime;
+		const bool bGenerating = Elapsed < Duration;
+
+		for (int32 Index = 0; bGenerating && Index < NumActive; ++Index)
+		{
+			FFirebaseLoadClient& Client = *Clients[Index];
+			FRandomStream& Random = Randoms[Index];
+			while (NextCallTime[Index] <= Elapsed)
+			{
+				NextCallTime[Index] += NextGap(Rate, Random);
+				if (Client.GetInFlight() >= MaxInFlight)
+				{
+					Skipped[Index]++;
+					continue;
+				}
+
+				const EFirebaseTrafficOp Op = PickOp(Mix, Random);
+				FString Path;
+				if (bFanout)
+				{
+					Path = FString::Printf(TEXT("load/fanout/l%d"), Random.RandHelper(NumListeners));
+				}
+				else if (Op == EFirebaseTrafficOp::Push)
+				{
+					Path = FString::Printf(TEXT("load/log/c%d"), Index);
+				}
+				else if (Op == EFirebaseTrafficOp::Query)
+				{
+					Path = TEXT("load/items");
+				}
+				else if (Op == EFirebaseTrafficOp::Auth)
+				{
+					Path = TEXT("token");
+				}
+				else
+				{
+					Path = FString::Printf(TEXT("load/items/k%d"), Random.RandHelper(NumKeys));
+				}
+				Client.Issue(Op, Path, Body);
+			}
+		}
+
+		FFirebaseLoadClient::Pump(float(Now - LastTime));
+		FPlatformTime::UpdateCPUTime(float(Now - LastTime));
+		LastTime = Now;
+
+		if (Now - LastSample >= SampleSeconds)
+		{
+			PeakMemory = FMath::Max(PeakMemory, FPlatformMemory::GetStats().UsedPhysical);
+			CpuPercentSum += FPlatformTime::GetCPUTime().CPUTimePct;
+			NumCpuSamples++;
+			LastSample = Now;
+		}
+
+		if (!bGenerating)
+		{
+			LoadEnd = LoadEnd > 0.0 ? LoadEnd : Now;
+
+			const int32 InFlight = CountInFlight();
+			if (InFlight == 0)
+			{
+				break;
+			}
+			if (Now - LoadEnd > DrainTimeoutSeconds)
+			{
+				UE_LOG(LogFirebase, Warning, TEXT("Firebase Load: Gave up on %d calls still in flight after %.0fs"), InFlight, DrainTimeoutSeconds);
+				break;
+			}
+		}
+
+		FPlatformProcess::Sleep(0.001f);
+	}
+
+	const double Seconds = FPlatformTime::Seconds() - StartTime;
+	const uint64 EndMemory = FPlatformMemory::GetStats().UsedPhysical;
+	PeakMemory = FMath::Max(PeakMemory, EndMemory);
+	const double CpuPercent = NumCpuSamples > 0 ? CpuPercentSum / NumCpuSamples : 0.0;
+
+	FFirebaseLoadClient::LogSummary(Clients, Seconds);
+
+	int64 TotalCalls = 0;
+	int64 TotalNotifications = 0;
+	double TotalCpuSeconds = 0.0;
+	FString Csv = TEXT("client,calls,failed,skipped,p50_ms,p99_ms,cpu_ms,cpu_pct,bytes_sent,bytes_received,notifications\n");
+
+	UE_LOG(LogFirebase, Display, TEXT("  %-6s %8s %7s %8s %8s %9s %7s %10s %10s %9s"), TEXT("client"), TEXT("calls"), TEXT("failed"), TEXT("skipped"),
+		TEXT("p99 ms"), TEXT("cpu ms"), TEXT("cpu %"), TEXT("KB sent"), TEXT("KB recv"), TEXT("notifies"));
+	for (const TSharedRef<FFirebaseLoadClient>& Client : Clients)
+	{
+		FFirebaseLatencyHistogram Merged;
+		int64 Calls = 0;
+		int64 Failures = 0;
+		for (int32 OpIndex = 0; OpIndex < (int32)EFirebaseTrafficOp::Num; ++OpIndex)
+		{
+			const EFirebaseTrafficOp Op = EFirebaseTrafficOp(OpIndex);
+			if (Op != EFirebaseTrafficOp::Listen && Op != EFirebaseTrafficOp::StopListen)
+			{
+				Merged.Merge(Client->GetLatency(Op));
+				Calls += Client->GetIssued(Op);
+				Failures += Client->GetFailed(Op);
+			}
+		}
+
+		const int32 Index = Client->GetIndex();
+		const int64 ClientSkipped = Index < NumActive ? Skipped[Index] : 0;
+		const FFirebaseLatencySummary Summary = Merged.Summarize();
+		const double CpuSeconds = Client->GetCpuSeconds();
+		const double CpuShare = Seconds > 0.0 ? 100.0 * CpuSeconds / Seconds : 0.0;
+		TotalCalls += Calls;
+		TotalNotifications += Client->GetNotifications();
+		TotalCpuSeconds += CpuSeconds;
+
+		UE_LOG(LogFirebase, Display, TEXT("  %-6d %8lld %7lld %8lld %8.2f %9.1f %7.2f %10.1f %10.1f %9lld"), Index, Calls, Failures, ClientSkipped,
+			Summary.P99 * 1000.0, CpuSeconds * 1000.0, CpuShare, Client->GetBytesSent() / 1024.0, Client->GetBytesReceived() / 1024.0, Client->GetNotifications());
+		Csv += FString::Printf(TEXT("%d,%lld,%lld,%lld,%.3f,%.3f,%.3f,%.3f,%lld,%lld,%lld\n"), Index, Calls, Failures, ClientSkipped,
+			Summary.P50 * 1000.0, Summary.P99 * 1000.0, CpuSeconds * 1000.0, CpuShare, Client->GetBytesSent(), Client->GetBytesReceived(), Client->GetNotifications());
+	}
+
+	UE_LOG(LogFirebase, Display, TEXT("Firebase Load: %.1f calls/s overall, %.1f listener notifications/s"),
+		Seconds > 0.0 ? TotalCalls / Seconds : 0.0, Seconds > 0.0 ? TotalNotifications / Seconds : 0.0);
+	UE_LOG(LogFirebase, Display, TEXT("Firebase Load: client work took %.1f ms of game thread per client (%.2f%% of the run); process averaged %.1f%% of a core, %.2f%% per client"),
+		TotalCpuSeconds * 1000.0 / NumClients, Seconds > 0.0 ? 100.0 * TotalCpuSeconds / (Seconds * NumClients) : 0.0, CpuPercent, CpuPercent / NumClients);
+	UE_LOG(LogFirebase, Display, TEXT("Firebase Load: process memory %.1f MB before clients, %.1f MB peak, %.1f MB at end; %.2f MB per client at peak; buffer pool holds %.1f MB"),
+		ToMB(BaselineMemory), ToMB(PeakMemory), ToMB(EndMemory), ToMB(double(PeakMemory - FMath::Min(PeakMemory, BaselineMemory)) / NumClients),
+		ToMB(FFirebaseBufferPool::Get().GetStats().PooledBytes));
+	FFirebaseRequestMetrics::Get().Dump(*GLog);
+
+	if (!CsvFile.IsEmpty() && !FFileHelper::SaveStringToFile(Csv, *CsvFile))
+	{
+		UE_LOG(LogFirebase, Warning, TEXT("Firebase Load: Could not write %s"), *CsvFile);
+	}
+
+	Clients.Reset();
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	if (bStartedEmulator)
+	{
+		Emulator.Stop();
+	}
+	return 0;
+}
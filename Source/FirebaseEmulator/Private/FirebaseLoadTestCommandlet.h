@@ -0,0 +1,46 @@
+// Copyright. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "FirebaseLoadTestCommandlet.generated.h"
+
+/**
+ * Drives a synthetic workload from many independent plugin clients in one
+ * process against the local emulator. Each client has its own
+ * UFirebaseRestAPI, so its own anonymous auth session, request pipeline and
+ * listeners; none of them touch the UFirebaseDatabase / UFirebaseAuth
+ * singletons.
+ *
+ *   UnrealEditor-Cmd <Project> -run=FirebaseLoadTest
+ *     [-Clients=16]          Simulated clients
+ *     [-Workload=ReadHeavy]  ReadHeavy, WriteHeavy or Fanout
+ *     [-Mix=Get:70,Set:30]   Replace the workload's op weights (op names as in LexToString)
+ *     [-Duration=30]         Seconds to generate load for
+ *     [-Rate=20]             Calls per second per client (writers only for Fanout)
+ *     [-MaxInFlight=32]      Calls a client may have outstanding; the schedule skips while at the limit
+ *     [-Keys=1000]           Records the clients share, seeded before the run
+ *     [-PayloadBytes=256]    Size of written records
+ *     [-Listeners=8]         Fanout: paths every client listens to
+ *     [-Writers=1]           Fanout: clients that write those paths; the rest only listen
+ *     [-PollInterval=1]      Fanout: listener polling interval in seconds
+ *     [-Seed=0]              Random stream for op choice and keys
+ *     [-Port=9400]           Emulator port
+ *     [-Csv=<file>]          Also write one row per client
+ *
+ * Prints per-op throughput and latency percentiles over all clients, then
+ * per client: calls, failures, p99, the game-thread time its calls and
+ * responses took, bytes moved and listener notifications. Process CPU and
+ * memory are measured for the whole run and reported per client as well.
+ */
+UCLASS()
+class UFirebaseLoadTestCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UFirebaseLoadTestCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
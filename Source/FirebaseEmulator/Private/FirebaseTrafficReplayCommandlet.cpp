@@ -0,0 +1,187 @@
+// Copyright. All Rights Reserved.
+
+#include "FirebaseTrafficReplayCommandlet.h"
+#include "FirebaseBufferPool.h"
+#include "FirebaseEmulatorModule.h"
+#include "FirebaseLoadClient.h"
+#include "FirebaseLog.h"
+#include "FirebaseStats.h"
+#include "FirebaseTrafficRecorder.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/CoreMisc.h"
+#include "Misc/Parse.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace FirebaseTrafficReplay
+{
+	static constexpr uint32 DefaultPort = 9400;
+
+	// How often process memory is sampled for the peak
+	static constexpr double MemorySampleSeconds = 0.1;
+
+	static double ToMB(uint64 Bytes)
+	{
+		return double(Bytes) / (1024.0 * 1024.0);
+	}
+}
+
+UFirebaseTrafficReplayCommandlet::UFirebaseTrafficReplayCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UFirebaseTrafficReplayCommandlet::Main(const FString& Params)
+{
+	using namespace FirebaseTrafficReplay;
+
+	FString File;
+	if (!FParse::Value(*Params, TEXT("File="), File))
+	{
+		UE_LOG(LogFirebase, Error, TEXT("Firebase Replay: -File=<recording> is required"));
+		return 1;
+	}
+
+	FFirebaseTrafficCapture Capture;
+	if (!Capture.LoadFromFile(File))
+	{
+		UE_LOG(LogFirebase, Error, TEXT("Firebase Replay: Could not read a traffic recording from %s"), *File);
+		return 1;
+	}
+
+	float TimeScale = 1.0f;
+	int32 NumClients = 1;
+	double Spread = 0.0;
+	uint32 Port = DefaultPort;
+	double Timeout = 600.0;
+	FParse::Value(*Params, TEXT("TimeScale="), TimeScale);
+	FParse::Value(*Params, TEXT("Clients="), NumClients);
+	FParse::Value(*Params, TEXT("Spread="), Spread);
+	FParse::Value(*Params, TEXT("Port="), Port);
+	FParse::Value(*Params, TEXT("Timeout="), Timeout);
+	const bool bIsolate = FParse::Param(*Params, TEXT("Isolate"));
+	TimeScale = FMath::Max(TimeScale, 0.0f);
+	NumClients = FMath::Max(NumClients, 1);
+
+	FFirebaseEmulatorModule& Emulator = FFirebaseEmulatorModule::Get();
+	const bool bStartedEmulator = !Emulator.IsRunning();
+	if (bStartedEmulator && !Emulator.Start(Port, /*bRedirectSettings=*/ false))
+	{
+		UE_LOG(LogFirebase, Error, TEXT("Firebase Replay: Could not start the emulator on port %u"), Port);
+		return 1;
+	}
+
+	UE_LOG(LogFirebase, Display, TEXT("Firebase Replay: %d calls over %.1fs from %s, %d clients, time scale %.2f"),
+		Capture.Events.Num(), Capture.GetDuration(), *File, NumClients, TimeScale);
+
+	TArray<TSharedRef<FFirebaseLoadClient>> Clients;
+	TArray<TArray<FString>> ClientPaths;
+	for (int32 Index = 0; Index < NumClients; ++Index)
+	{
+		Clients.Add(MakeShared<FFirebaseLoadClient>(Index, Emulator.GetDatabaseUrl(), Emulator.GetAuthUrl()));
+
+		TArray<FString>& Paths = ClientPaths.Emplace_GetRef(Capture.Paths);
+		if (bIsolate)
+		{
+			for (FString& Path : Paths)
+			{
+				Path = FString::Printf(TEXT("clients/%d/%s"), Index, *Path);
+			}
+		}
+	}
+
+	// One synthesized body per recorded size
+	TMap<uint32, FFirebasePayload> Bodies;
+	for (const FFirebaseTrafficEvent& Event : Capture.Events)
+	{
+		if (Event.Bytes > 0 && !Bodies.Contains(Event.Bytes))
+		{
+			Bodies.Add(Event.Bytes, FFirebaseLoadClient::MakePayload(Event.Bytes));
+		}
+	}
+
+	FFirebaseRequestMetrics::Get().Reset();
+	const uint64 StartMemory = FPlatformMemory::GetStats().UsedPhysical;
+	uint64 PeakMemory = StartMemory;
+
+	TArray<int32> NextEvent;
+	NextEvent.SetNumZeroed(NumClients);
+
+	const double StartTime = FPlatformTime::Seconds();
+	double LastTime = StartTime;
+	double LastMemorySample = StartTime;
+	double DrainStart = 0.0;
+	while (!IsEngineExitRequested())
+	{
+		const double Now = FPlatformTime::Seconds();
+		const double Elapsed = Now - StartTime;
+
+		bool bAllIssued = true;
+		for (int32 Index = 0; Index < NumClients; ++Index)
+		{
+			FFirebaseLoadClient& Client = *Clients[Index];
+			const double Offset = Spread * Index / NumClients;
+			int32& Next = NextEvent[Index];
+			while (Next < Capture.Events.Num() && Capture.Events[Next].Time * TimeScale + Offset <= Elapsed)
+			{
+				const FFirebaseTrafficEvent& Event = Capture.Events[Next++];
+				const FString& Path = Event.Op == EFirebaseTrafficOp::Auth ? Capture.Paths[Event.PathIndex] : ClientPaths[Index][Event.PathIndex];
+				const FFirebasePayload* Body = Bodies.Find(Event.Bytes);
+				Client.Issue(Event.Op, Path, Body ? *Body : FFirebasePayload());
+			}
+			bAllIssued &= Next == Capture.Events.Num();
+		}
+
+		FFirebaseLoadClient::Pump(float(Now - LastTime));
+		LastTime = Now;
+
+		if (Now - LastMemorySample >= MemorySampleSeconds)
+		{
+			PeakMemory = FMath::Max(PeakMemory, FPlatformMemory::GetStats().UsedPhysical);
+			LastMemorySample = Now;
+		}
+
+		if (bAllIssued)
+		{
+			DrainStart = DrainStart > 0.0 ? DrainStart : Now;
+
+			int32 InFlight = 0;
+			for (const TSharedRef<FFirebaseLoadClient>& Client : Clients)
+			{
+				InFlight += Client->GetInFlight();
+			}
+			if (InFlight == 0)
+			{
+				break;
+			}
+			if (Now - DrainStart > Timeout)
+			{
+				UE_LOG(LogFirebase, Warning, TEXT("Firebase Replay: Gave up on %d calls still in flight after %.0fs"), InFlight, Timeout);
+				break;
+			}
+		}
+
+		FPlatformProcess::Sleep(TimeScale > 0.0f ? 0.001f : 0.0f);
+	}
+
+	const double Seconds = FPlatformTime::Seconds() - StartTime;
+	const uint64 EndMemory = FPlatformMemory::GetStats().UsedPhysical;
+	PeakMemory = FMath::Max(PeakMemory, EndMemory);
+
+	FFirebaseLoadClient::LogSummary(Clients, Seconds);
+	UE_LOG(LogFirebase, Display, TEXT("Firebase Replay: process memory %.1f MB at start, %.1f MB peak, %.1f MB at end; buffer pool holds %.1f MB"),
+		ToMB(StartMemory), ToMB(PeakMemory), ToMB(EndMemory), ToMB(FFirebaseBufferPool::Get().GetStats().PooledBytes));
+	FFirebaseRequestMetrics::Get().Dump(*GLog);
+
+	Clients.Reset();
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	if (bStartedEmulator)
+	{
+		Emulator.Stop();
+	}
+	return 0;
+}
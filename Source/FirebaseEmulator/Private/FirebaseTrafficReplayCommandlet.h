@@ -0,0 +1,33 @@
+// Copyright. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "FirebaseTrafficReplayCommandlet.generated.h"
+
+/**
+ * Replays a traffic recording (see FFirebaseTrafficRecorder) against the
+ * local emulator, to reproduce a production load shape on a build machine.
+ *
+ *   UnrealEditor-Cmd <Project> -run=FirebaseTrafficReplay -File=<recording>
+ *     [-TimeScale=1.0]   Multiplies recorded gaps; 0.5 replays twice as fast, 0 as fast as possible
+ *     [-Clients=1]       Each recorded call is issued once per client
+ *     [-Spread=0]        Seconds over which client start times are staggered
+ *     [-Isolate]         Prefix each client's paths with clients/<n>/ so they do not share data
+ *     [-Port=9400]       Emulator port
+ *     [-Timeout=600]     Seconds to wait for outstanding calls after the last one is issued
+ *
+ * Bodies are synthesized at the recorded sizes. Prints per-op throughput and
+ * latency, process memory and the plugin's own request metrics.
+ */
+UCLASS()
+class UFirebaseTrafficReplayCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UFirebaseTrafficReplayCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
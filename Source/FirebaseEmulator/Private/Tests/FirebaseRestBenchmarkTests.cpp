@@ -0,0 +1,508 @@
+// Copyright. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Dom/JsonObject.h"
+#include "FirebaseEmulatorAuth.h"
+#include "FirebaseEmulatorDatabase.h"
+#include "FirebaseEmulatorModule.h"
+#include "FirebaseInMemoryTransport.h"
+#include "FirebaseJsonDocument.h"
+#include "FirebaseJsonWriter.h"
+#include "FirebaseRestAPI.h"
+#include "HAL/FileManager.h"
+#include "Misc/App.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+
+/**
+ * Throughput and latency of the REST API's hot paths.
+ *
+ * Every case runs one operation (Set, Update, Get, Push, Query or an auth
+ * sign-in) a fixed number of times with a fixed number of requests in
+ * flight, against one of two backends:
+ *  - Mock: FFirebaseInMemoryTransport with canned answers, so the numbers are
+ *    the plugin's own cost (URL building, serialization, dispatch, parsing).
+ *  - Emulator: the FirebaseEmulator server over loopback HTTP. Responses land
+ *    on the game thread, so latencies include tick granularity, as they do
+ *    for real callers.
+ *
+ * Each case appends one row to Saved/Automation/FirebaseBenchmarks/FirebaseBenchmarks.csv
+ * and one object to FirebaseBenchmarks.jsonl next to it, for regression tracking.
+ * Run with: Automation RunTests Firebase.Benchmark
+ */
+namespace FirebaseRestBenchmark
+{
+	enum class EBackend : uint8
+	{
+		Mock,
+		Emulator
+	};
+
+	enum class EOperation : uint8
+	{
+		Set,
+		Update,
+		Get,
+		Push,
+		Query,
+		Auth
+	};
+
+	static const TCHAR* BackendNames[] = { TEXT("Mock"), TEXT("Emulator") };
+	static const TCHAR* OperationNames[] = { TEXT("Set"), TEXT("Update"), TEXT("Get"), TEXT("Push"), TEXT("Query"), TEXT("Auth") };
+	static const int32 PayloadSizes[] = { 64, 1024, 16 * 1024 };
+	static const int32 ConcurrencyLevels[] = { 1, 8, 32 };
+
+	// Operations per case; the mock is cheap enough for many more samples
+	static constexpr int32 MockOperations = 2000;
+	static constexpr int32 EmulatorOperations = 200;
+
+	// Port used when the emulator is not already running
+	static constexpr uint32 EmulatorPort = 9400;
+
+	// A case that has not finished by then fails
+	static constexpr double TimeoutSeconds = 120.0;
+
+	// Distinct paths written by Set/Update, so writes do not all hit one node
+	static constexpr int32 WritePaths = 64;
+
+	static const TCHAR* BenchEmail = TEXT("bench@example.com");
+	static const TCHAR* BenchPassword = TEXT("bench-password");
+
+	struct FCase
+	{
+		EBackend Backend = EBackend::Mock;
+		EOperation Operation = EOperation::Set;
+		int32 PayloadBytes = 0;
+		int32 Concurrency = 1;
+	};
+
+	/** "Mock Set 1024 8" */
+	bool ParseCase(const FString& Parameters, FCase& OutCase)
+	{
+		TArray<FString> Parts;
+		Parameters.ParseIntoArrayWS(Parts);
+		if (Parts.Num() != 4)
+		{
+			return false;
+		}
+
+		bool bFound = false;
+		for (int32 Index = 0; Index < UE_ARRAY_COUNT(BackendNames); ++Index)
+		{
+			if (Parts[0] == BackendNames[Index])
+			{
+				OutCase.Backend = EBackend(Index);
+				bFound = true;
+			}
+		}
+		for (int32 Index = 0; Index < UE_ARRAY_COUNT(OperationNames) && bFound; ++Index)
+		{
+			if (Parts[1] == OperationNames[Index])
+			{
+				OutCase.Operation = EOperation(Index);
+				LexFromString(OutCase.PayloadBytes, *Parts[2]);
+				LexFromString(OutCase.Concurrency, *Parts[3]);
+				return OutCase.Concurrency > 0;
+			}
+		}
+		return false;
+	}
+
+	/** One database record of roughly Bytes bytes */
+	void WriteRecord(FFirebaseJsonWriter& Writer, int32 Index, int32 Bytes)
+	{
+		Writer.BeginObject();
+		Writer.WriteKey(FStringView(TEXT("score")));
+		Writer.WriteInt(Index * 7919 % 100000);
+		Writer.WriteKey(FStringView(TEXT("name")));
+		Writer.WriteString(FString::Printf(TEXT("player_%d"), Index));
+		Writer.WriteKey(FStringView(TEXT("blob")));
+		Writer.WriteString(FString::ChrN(FMath::Max(Bytes - 48, 0), TEXT('x')));
+		Writer.EndObject();
+	}
+
+	FFirebasePayload MakeRecord(int32 Index, int32 Bytes)
+	{
+		FFirebaseJsonWriter Writer(Bytes + 64);
+		WriteRecord(Writer, Index, Bytes);
+		return Writer.TakePayload();
+	}
+
+	/** Collection of 32 children totalling roughly Bytes bytes, for Get and Query */
+	FFirebasePayload MakeCollection(int32 Bytes)
+	{
+		constexpr int32 Children = 32;
+		FFirebaseJsonWriter Writer(Bytes + Children * 64);
+		Writer.BeginObject();
+		for (int32 Index = 0; Index < Children; ++Index)
+		{
+			Writer.WriteKey(FString::Printf(TEXT("child_%02d"), Index));
+			WriteRecord(Writer, Index, Bytes / Children);
+		}
+		Writer.EndObject();
+		return Writer.TakePayload();
+	}
+
+	double Percentile(const TArray<double>& Sorted, double Percent)
+	{
+		if (Sorted.Num() == 0)
+		{
+			return 0.0;
+		}
+		const int32 Index = FMath::Clamp(FMath::CeilToInt(Percent / 100.0 * Sorted.Num()) - 1, 0, Sorted.Num() - 1);
+		return Sorted[Index];
+	}
+
+	/** Append Line to Saved/Automation/FirebaseBenchmarks/<FileName>, writing Header first into a new file */
+	void AppendResult(const TCHAR* FileName, const FString& Header, const FString& Line)
+	{
+		const FString Path = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Automation"), TEXT("FirebaseBenchmarks"), FileName);
+		FString Text;
+		if (!Header.IsEmpty() && !IFileManager::Get().FileExists(*Path))
+		{
+			Text = Header + LINE_TERMINATOR;
+		}
+		Text += Line + LINE_TERMINATOR;
+		FFileHelper::SaveStringToFile(Text, *Path, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM, &IFileManager::Get(), FILEWRITE_Append);
+	}
+
+	/**
+	 * One benchmark case: keeps Concurrency operations in flight until all
+	 * have completed, recording each operation's latency
+	 */
+	class FRun : public TSharedFromThis<FRun>
+	{
+	public:
+		FRun(const FCase& InCase, FAutomationTestBase& InTest)
+			: Case(InCase)
+			, Test(InTest)
+		{
+			Total = Case.Backend == EBackend::Mock ? MockOperations : EmulatorOperations;
+			Latencies.Reserve(Total);
+		}
+
+		~FRun()
+		{
+			if (Api)
+			{
+				Api->SetTransport(nullptr);
+				Api->RemoveFromRoot();
+			}
+			if (bStartedEmulator)
+			{
+				FFirebaseEmulatorModule::Get().Stop();
+			}
+		}
+
+		bool Setup()
+		{
+			Record = MakeRecord(1, Case.PayloadBytes);
+			Collection = MakeCollection(Case.PayloadBytes);
+
+			Api = NewObject<UFirebaseRestAPI>(GetTransientPackage());
+			Api->AddToRoot();
+
+			if (Case.Backend == EBackend::Mock)
+			{
+				SetupMock();
+				Api->Initialize(TEXT("bench-key"), TEXT("bench"), TEXT("https://bench.firebaseio.com"));
+				Api->SetTransport(Mock);
+			}
+			else
+			{
+				FFirebaseEmulatorModule& Emulator = FFirebaseEmulatorModule::Get();
+				if (!Emulator.IsRunning())
+				{
+					if (!Emulator.Start(EmulatorPort, /*bRedirectSettings=*/ false))
+					{
+						Test.AddError(FString::Printf(TEXT("Could not start the emulator on port %u"), EmulatorPort));
+						return false;
+					}
+					bStartedEmulator = true;
+				}
+				SetupEmulator(Emulator);
+				Api->Initialize(TEXT("bench-key"), TEXT("bench"), Emulator.GetDatabaseUrl());
+				Api->SetAuthEmulator(Emulator.GetAuthUrl());
+			}
+
+			StartTime = FPlatformTime::Seconds();
+			return true;
+		}
+
+		/** Start operations up to the concurrency limit; true once every operation has completed */
+		bool Pump()
+		{
+			if (Completed >= Total)
+			{
+				return true;
+			}
+
+			if (FPlatformTime::Seconds() - StartTime > TimeoutSeconds)
+			{
+				Test.AddError(FString::Printf(TEXT("Timed out with %d of %d operations complete"), Completed, Total));
+				return true;
+			}
+
+			do
+			{
+				while (Started < Total && Started - Completed < Case.Concurrency)
+				{
+					StartOne();
+				}
+
+				// Mock responses are held until the whole window has been sent, then delivered together
+				if (Mock.IsValid())
+				{
+					Mock->Flush();
+				}
+			}
+			while (Mock.IsValid() && Completed < Total);
+
+			if (Completed < Total)
+			{
+				return false;
+			}
+
+			Report(FPlatformTime::Seconds() - StartTime);
+			return true;
+		}
+
+	private:
+		void SetupMock()
+		{
+			Mock = MakeShared<FFirebaseInMemoryTransport>();
+			Mock->bRecordRequests = false;
+			if (Case.Concurrency > 1)
+			{
+				Mock->SetDefaultDelay(1e-6);
+			}
+
+			const FString Base = TEXT("https://bench.firebaseio.com/");
+			Mock->AddRoute(Base, [](const FFirebaseHttpRequest& Request)
+			{
+				// Writes echo the value they were sent, as the server does
+				return FFirebaseInMemoryTransport::MakeResponse(200, Request.Body);
+			});
+			Mock->AddRoute(Base + TEXT("bench/get"), FFirebaseInMemoryTransport::Respond(200, Collection));
+			Mock->AddRoute(Base + TEXT("bench/query"), FFirebaseInMemoryTransport::Respond(200, Collection));
+			Mock->AddRoute(Base + TEXT("bench/push"), FFirebaseInMemoryTransport::Respond(200,
+				FFirebasePayload::FromUtf8(UTF8TEXTVIEW("{\"name\":\"-NbenchAAAAAAAAAAAAA\"}"))));
+			Mock->SetHandler(FFirebaseInMemoryTransport::Respond(200, FFirebasePayload::FromUtf8(UTF8TEXTVIEW(
+				"{\"kind\":\"identitytoolkit#VerifyPasswordResponse\",\"localId\":\"bench-user\",\"email\":\"bench@example.com\","
+				"\"idToken\":\"eyJhbGciOiJub25lIn0.eyJzdWIiOiJiZW5jaC11c2VyIn0.\",\"registered\":true,"
+				"\"refreshToken\":\"bench-refresh\",\"expiresIn\":\"3600\"}"))));
+		}
+
+		void SetupEmulator(FFirebaseEmulatorModule& Emulator)
+		{
+			FFirebaseEmulatorDatabase& Database = Emulator.GetDatabase();
+			Database.Set(TEXT("bench"), nullptr);
+
+			const TSharedPtr<FJsonValue> CollectionValue = FFirebaseJsonDocument::Parse(Collection)->GetRoot();
+			Database.Set(TEXT("bench/get"), CollectionValue);
+			Database.Set(TEXT("bench/query"), CollectionValue);
+
+			if (Case.Operation == EOperation::Auth)
+			{
+				TSharedPtr<FJsonObject> Request = MakeShared<FJsonObject>();
+				Request->SetStringField(TEXT("email"), BenchEmail);
+				Request->SetStringField(TEXT("password"), BenchPassword);
+				TSharedPtr<FJsonObject> Response;
+				Emulator.GetAuth().Handle(TEXT("accounts:signUp"), Request, Response);
+			}
+		}
+
+		void StartOne()
+		{
+			const int32 Index = Started++;
+			const double SendTime = FPlatformTime::Seconds();
+
+			TWeakPtr<FRun> WeakThis = AsShared();
+			auto OnDone = [WeakThis, SendTime](bool bSuccess)
+			{
+				if (TSharedPtr<FRun> This = WeakThis.Pin())
+				{
+					This->Latencies.Add(FPlatformTime::Seconds() - SendTime);
+					This->Failures += bSuccess ? 0 : 1;
+					This->Completed++;
+				}
+			};
+			const FFirebaseRestPayloadCallback PayloadDone = FFirebaseRestPayloadCallback::CreateLambda([OnDone](bool bSuccess, const FFirebasePayload&) { OnDone(bSuccess); });
+			const FFirebaseRestCallback StringDone = FFirebaseRestCallback::CreateLambda([OnDone](bool bSuccess, const FString&) { OnDone(bSuccess); });
+
+			const FString WritePath = FString::Printf(TEXT("bench/write/%d"), Index % WritePaths);
+			switch (Case.Operation)
+			{
+			case EOperation::Set:
+				Api->SetValue(WritePath, Record, FString(), PayloadDone);
+				break;
+			case EOperation::Update:
+				Api->UpdateValue(WritePath, Record, FString(), PayloadDone);
+				break;
+			case EOperation::Get:
+				Api->GetValue(TEXT("bench/get"), FString(), PayloadDone);
+				break;
+			case EOperation::Push:
+				Api->PushValue(TEXT("bench/push"), Record, FString(), PayloadDone);
+				break;
+			case EOperation::Query:
+				Api->QueryOrderByChild(TEXT("bench/query"), TEXT("score"), FString(), StringDone);
+				break;
+			case EOperation::Auth:
+				Api->SignInWithEmail(BenchEmail, BenchPassword, StringDone);
+				break;
+			}
+		}
+
+		void Report(double Seconds)
+		{
+			Latencies.Sort();
+			const double OpsPerSecond = Seconds > 0.0 ? Completed / Seconds : 0.0;
+			const double P50 = Percentile(Latencies, 50.0) * 1000.0;
+			const double P90 = Percentile(Latencies, 90.0) * 1000.0;
+			const double P99 = Percentile(Latencies, 99.0) * 1000.0;
+			const double Max = Latencies.Num() > 0 ? Latencies.Last() * 1000.0 : 0.0;
+
+			const TCHAR* Backend = BackendNames[(int32)Case.Backend];
+			const TCHAR* Operation = OperationNames[(int32)Case.Operation];
+			const FString Timestamp = FDateTime::UtcNow().ToIso8601();
+			const FString Build = FApp::GetBuildVersion();
+
+			Test.AddInfo(FString::Printf(TEXT("%s %s %dB x%d: %.0f ops/s, p50 %.3f ms, p90 %.3f ms, p99 %.3f ms, max %.3f ms, %d failed"),
+				Backend, Operation, Case.PayloadBytes, Case.Concurrency, OpsPerSecond, P50, P90, P99, Max, Failures));
+
+			if (Failures > 0)
+			{
+				Test.AddError(FString::Printf(TEXT("%d of %d operations failed"), Failures, Completed));
+			}
+
+			AppendResult(TEXT("FirebaseBenchmarks.csv"),
+				TEXT("timestamp,build,backend,operation,payload_bytes,concurrency,operations,failures,seconds,ops_per_sec,p50_ms,p90_ms,p99_ms,max_ms"),
+				FString::Printf(TEXT("%s,%s,%s,%s,%d,%d,%d,%d,%.6f,%.1f,%.4f,%.4f,%.4f,%.4f"),
+					*Timestamp, *Build, Backend, Operation, Case.PayloadBytes, Case.Concurrency, Completed, Failures, Seconds, OpsPerSecond, P50, P90, P99, Max));
+
+			FFirebaseJsonWriter Json;
+			Json.BeginObject();
+			Json.WriteKey(FStringView(TEXT("timestamp")));
+			Json.WriteString(Timestamp);
+			Json.WriteKey(FStringView(TEXT("build")));
+			Json.WriteString(Build);
+			Json.WriteKey(FStringView(TEXT("backend")));
+			Json.WriteString(FStringView(Backend));
+			Json.WriteKey(FStringView(TEXT("operation")));
+			Json.WriteString(FStringView(Operation));
+			Json.WriteKey(FStringView(TEXT("payload_bytes")));
+			Json.WriteInt(Case.PayloadBytes);
+			Json.WriteKey(FStringView(TEXT("concurrency")));
+			Json.WriteInt(Case.Concurrency);
+			Json.WriteKey(FStringView(TEXT("operations")));
+			Json.WriteInt(Completed);
+			Json.WriteKey(FStringView(TEXT("failures")));
+			Json.WriteInt(Failures);
+			Json.WriteKey(FStringView(TEXT("seconds")));
+			Json.WriteDouble(Seconds);
+			Json.WriteKey(FStringView(TEXT("ops_per_sec")));
+			Json.WriteDouble(OpsPerSecond);
+			Json.WriteKey(FStringView(TEXT("p50_ms")));
+			Json.WriteDouble(P50);
+			Json.WriteKey(FStringView(TEXT("p90_ms")));
+			Json.WriteDouble(P90);
+			Json.WriteKey(FStringView(TEXT("p99_ms")));
+			Json.WriteDouble(P99);
+			Json.WriteKey(FStringView(TEXT("max_ms")));
+			Json.WriteDouble(Max);
+			Json.EndObject();
+			AppendResult(TEXT("FirebaseBenchmarks.jsonl"), FString(), Json.ToString());
+		}
+
+		FCase Case;
+		FAutomationTestBase& Test;
+
+		UFirebaseRestAPI* Api = nullptr;
+		TSharedPtr<FFirebaseInMemoryTransport> Mock;
+		bool bStartedEmulator = false;
+
+		FFirebasePayload Record;
+		FFirebasePayload Collection;
+
+		int32 Total = 0;
+		int32 Started = 0;
+		int32 Completed = 0;
+		int32 Failures = 0;
+		double StartTime = 0.0;
+		TArray<double> Latencies;
+	};
+
+	/** Pumps a run once per frame until it is done */
+	class FRunCommand : public IAutomationLatentCommand
+	{
+	public:
+		explicit FRunCommand(TSharedRef<FRun> InRun)
+			: Run(MoveTemp(InRun))
+		{
+		}
+
+		virtual bool Update() override
+		{
+			return Run->Pump();
+		}
+
+	private:
+		TSharedRef<FRun> Run;
+	};
+}
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FFirebaseRestBenchmarkTest, "Firebase.Benchmark.Rest",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+void FFirebaseRestBenchmarkTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	using namespace FirebaseRestBenchmark;
+
+	for (const TCHAR* Backend : BackendNames)
+	{
+		for (int32 Operation = 0; Operation < UE_ARRAY_COUNT(OperationNames); ++Operation)
+		{
+			// Auth bodies do not depend on the database payload size
+			const int32 NumSizes = Operation == (int32)EOperation::Auth ? 1 : UE_ARRAY_COUNT(PayloadSizes);
+			for (int32 SizeIndex = 0; SizeIndex < NumSizes; ++SizeIndex)
+			{
+				for (const int32 Concurrency : ConcurrencyLevels)
+				{
+					const int32 Bytes = PayloadSizes[SizeIndex];
+					OutBeautifiedNames.Add(FString::Printf(TEXT("%s.%s.%dB.x%d"), Backend, OperationNames[Operation], Bytes, Concurrency));
+					OutTestCommands.Add(FString::Printf(TEXT("%s %s %d %d"), Backend, OperationNames[Operation], Bytes, Concurrency));
+				}
+			}
+		}
+	}
+}
+
+bool FFirebaseRestBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace FirebaseRestBenchmark;
+
+	FCase Case;
+	if (!ParseCase(Parameters, Case))
+	{
+		AddError(FString::Printf(TEXT("Invalid benchmark case '%s'"), *Parameters));
+		return false;
+	}
+
+	TSharedRef<FRun> Run = MakeShared<FRun>(Case, *this);
+	if (!Run->Setup())
+	{
+		return false;
+	}
+
+	ADD_LATENT_AUTOMATION_COMMAND(FRunCommand(Run));
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
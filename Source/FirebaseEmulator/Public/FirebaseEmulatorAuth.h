@@ -0,0 +1,75 @@
+// Copyright. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+
+/**
+ * In-memory stand-in for the identitytoolkit and securetoken endpoints.
+ *
+ * Accounts live only in memory. Tokens are unsigned JWTs ("alg": "none"),
+ * the same form the Firebase Auth emulator issues, so nothing that only
+ * reads their claims can tell the difference. Errors use the live API's
+ * {"error": {"code", "message"}} shape and message codes (EMAIL_EXISTS,
+ * INVALID_PASSWORD, INVALID_ID_TOKEN, ...).
+ */
+class FIREBASEEMULATOR_API FFirebaseEmulatorAuth
+{
+public:
+	/**
+	 * Handle one auth request
+	 * @param Method Last path segment, e.g. "accounts:signUp" or "token"
+	 * @param Request Parsed JSON body (may be null)
+	 * @param OutResponse JSON body to send back
+	 * @return HTTP status code
+	 */
+	int32 Handle(FStringView Method, const TSharedPtr<FJsonObject>& Request, TSharedPtr<FJsonObject>& OutResponse);
+
+	/** Remove every account and token */
+	void Reset();
+
+	/** Number of accounts, including anonymous ones */
+	int32 GetNumAccounts() const { return Accounts.Num(); }
+
+	/** Project ID written into token claims */
+	FString ProjectId = TEXT("demo-project");
+
+	/** Token lifetime reported to clients */
+	int32 ExpiresInSeconds = 3600;
+
+private:
+	struct FAccount
+	{
+		FString LocalId;
+		FString Email;
+		FString Password;
+		FString DisplayName;
+		FString PhotoUrl;
+		bool bEmailVerified = false;
+		int64 CreatedAtMs = 0;
+	};
+
+	int32 SignUp(const TSharedPtr<FJsonObject>& Request, TSharedPtr<FJsonObject>& OutResponse);
+	int32 SignInWithPassword(const TSharedPtr<FJsonObject>& Request, TSharedPtr<FJsonObject>& OutResponse);
+	int32 RefreshToken(const TSharedPtr<FJsonObject>& Request, TSharedPtr<FJsonObject>& OutResponse);
+	int32 SendOobCode(const TSharedPtr<FJsonObject>& Request, TSharedPtr<FJsonObject>& OutResponse);
+	int32 Update(const TSharedPtr<FJsonObject>& Request, TSharedPtr<FJsonObject>& OutResponse);
+	int32 Delete(const TSharedPtr<FJsonObject>& Request, TSharedPtr<FJsonObject>& OutResponse);
+	int32 Lookup(const TSharedPtr<FJsonObject>& Request, TSharedPtr<FJsonObject>& OutResponse);
+
+	/** Account of the request's idToken, or null (OutResponse then holds the error) */
+	FAccount* FindByIdToken(const TSharedPtr<FJsonObject>& Request, TSharedPtr<FJsonObject>& OutResponse);
+
+	/** Fill idToken, refreshToken and expiresIn for a fresh sign-in */
+	void IssueTokens(const FAccount& Account, const TSharedPtr<FJsonObject>& OutResponse);
+	FString MakeIdToken(const FAccount& Account);
+
+	static int32 Error(const TCHAR* Message, TSharedPtr<FJsonObject>& OutResponse);
+
+	TMap<FString, FAccount> Accounts;
+	TMap<FString, FString> LocalIdByEmail;
+	TMap<FString, FString> LocalIdByIdToken;
+	TMap<FString, FString> LocalIdByRefreshToken;
+	int64 TokenCounter = 0;
+};
@@ -0,0 +1,101 @@
+// Copyright. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonValue.h"
+#include "FirebaseJsonTape.h"
+#include "FirebaseKeyFuncs.h"
+
+class FFirebaseJsonWriter;
+
+/**
+ * Query parameters of a database read, as sent in the REST query string
+ */
+struct FIREBASEEMULATOR_API FFirebaseEmulatorQuery
+{
+	/** "$key", "$value", "$priority" or a child path; empty for an unordered read */
+	FString OrderBy;
+
+	/** Range filters, compared against the ordering value (null when not given) */
+	TSharedPtr<FJsonValue> StartAt;
+	TSharedPtr<FJsonValue> EndAt;
+	TSharedPtr<FJsonValue> EqualTo;
+
+	/** 0 when not given */
+	int32 LimitToFirst = 0;
+	int32 LimitToLast = 0;
+
+	/** Return only the first level: objects become true */
+	bool bShallow = false;
+
+	/** Whether anything but a plain read was asked for */
+	bool IsFiltered() const;
+};
+
+/**
+ * One stored value: a leaf (bool, number or string) or an object whose
+ * children are keyed case-sensitively, as in the real database
+ */
+struct FFirebaseEmulatorNode
+{
+	/** Scalar value; null for an object */
+	TSharedPtr<FJsonValue> Leaf;
+
+	TFirebaseCaseSensitiveMap<TSharedPtr<FFirebaseEmulatorNode>> Children;
+
+	bool IsObject() const { return !Leaf.IsValid(); }
+};
+
+/**
+ * In-memory Realtime Database tree.
+ *
+ * Stores values the way the server does: nulls and empty objects are
+ * removed, arrays are kept as objects with index keys and handed back as
+ * arrays when their keys are dense enough, and {".sv": "timestamp"} is
+ * replaced by the write time. Paths are "/"-separated, already decoded.
+ * Keys that differ only in case are different children. The tree is only
+ * turned into JSON when a response is written.
+ *
+ * Not thread-safe; the emulator server uses it from the game thread.
+ */
+class FIREBASEEMULATOR_API FFirebaseEmulatorDatabase
+{
+public:
+	/** Write the value at Path (filtered and ordered when Query asks for it) as JSON */
+	bool Write(FStringView Path, const FFirebaseEmulatorQuery& Query, FFirebaseJsonWriter& Writer, FString& OutError) const;
+
+	/** Value at Path as compact JSON ("null" if missing) */
+	FString GetJson(FStringView Path) const;
+
+	/** Replace the value at Path with a parsed request body; null deletes it */
+	void Set(FStringView Path, const FFirebaseJsonTape::FValue& Value);
+
+	/**
+	 * Replace the value at Path; null deletes it. For seeding from C++: FJsonObject
+	 * keys that differ only in case have already been merged before they get here.
+	 */
+	void Set(FStringView Path, const TSharedPtr<FJsonValue>& Value);
+
+	/** Multi-path update: each key of Values (which may itself be a path) is set below Path. False if Values is not an object. */
+	bool Update(FStringView Path, const FFirebaseJsonTape::FValue& Values);
+
+	/** Store Value under a new push ID below Path and return the ID */
+	FString Push(FStringView Path, const FFirebaseJsonTape::FValue& Value);
+
+	/** ETag of the value at Path; changes whenever the value does */
+	FString GetETag(FStringView Path) const;
+
+	/** Remove everything */
+	void Reset();
+
+	/** Number of writes applied since the last reset */
+	int64 GetWriteCount() const { return WriteCount; }
+
+private:
+	const FFirebaseEmulatorNode* Find(FStringView Path) const;
+	void SetNode(FStringView Path, const TSharedPtr<FFirebaseEmulatorNode>& Node);
+
+	TSharedPtr<FFirebaseEmulatorNode> Root;
+	int64 WriteCount = 0;
+};
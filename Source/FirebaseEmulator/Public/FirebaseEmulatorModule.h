@@ -0,0 +1,65 @@
+// Copyright. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Modules/ModuleManager.h"
+
+class FFirebaseEmulatorDatabase;
+class FFirebaseEmulatorAuth;
+class FFirebaseEmulatorServer;
+
+/**
+ * Firebase Emulator Module
+ *
+ * Serves the Realtime Database and Auth REST APIs from memory on a local
+ * port so the plugin can run without network access, e.g. in automation on
+ * Linux build machines. Start it with -FirebaseEmulator[=Port] on the command
+ * line (the plugin settings are redirected before first use) or with the
+ * Firebase.Emulator.Start console command.
+ */
+class FIREBASEEMULATOR_API FFirebaseEmulatorModule : public IModuleInterface
+{
+public:
+	static constexpr uint32 DefaultPort = 9000;
+
+	/** IModuleInterface implementation */
+	virtual void StartupModule() override;
+	virtual void ShutdownModule() override;
+
+	static FFirebaseEmulatorModule& Get()
+	{
+		return FModuleManager::LoadModuleChecked<FFirebaseEmulatorModule>("FirebaseEmulator");
+	}
+
+	/**
+	 * Start serving on Port
+	 * @param bRedirectSettings Point the plugin settings' DatabaseUrl and AuthEmulatorUrl here.
+	 *        REST clients read the settings when first used, so redirect before the first request.
+	 */
+	bool Start(uint32 Port = DefaultPort, bool bRedirectSettings = true);
+
+	void Stop();
+
+	bool IsRunning() const;
+
+	/** "http://127.0.0.1:<port>?ns=<project>", the value to use as DatabaseUrl */
+	FString GetDatabaseUrl() const;
+
+	/** "http://127.0.0.1:<port>", the value to use as AuthEmulatorUrl */
+	FString GetAuthUrl() const;
+
+	/** Clear all data and accounts */
+	void Reset();
+
+	FFirebaseEmulatorDatabase& GetDatabase() { return *Database; }
+	FFirebaseEmulatorAuth& GetAuth() { return *Auth; }
+
+private:
+	void RedirectSettings() const;
+
+	TUniquePtr<FFirebaseEmulatorDatabase> Database;
+	TUniquePtr<FFirebaseEmulatorAuth> Auth;
+	TUniquePtr<FFirebaseEmulatorServer> Server;
+	TArray<IConsoleObject*> ConsoleCommands;
+};
@@ -95,7 +95,7 @@ public class FirebaseHelper {
      * Sign up with email and password
      */
     public static void signUpWithEmail(final String email, final String password, final String operationId) {
-        if (!checkAuth()) return;
+        if (!checkAuth(operationId)) return;
 
         currentActivity.runOnUiThread(new Runnable() {
             @Override
@@ -118,7 +118,7 @@ public class FirebaseHelper {
                                                 if (tokenTask.isSuccessful() && tokenTask.getResult() != null) {
                                                     token = tokenTask.getResult().getToken();
                                                 }
-                                                nativeOnAuthResult(true, userId, userEmail, displayName, "", token);
+                                                nativeOnAuthResult(operationId, true, userId, userEmail, displayName, "", token);
                                             }
                                         });
                                         
@@ -127,7 +127,7 @@ public class FirebaseHelper {
                                 } else {
                                     String error = task.getException() != null ? task.getException().getMessage() : "Unknown error";
                                     Log.e(TAG, "Sign up failed: " + error);
-                                    nativeOnAuthResult(false, "", "", "", error, "");
+                                    nativeOnAuthResult(operationId, false, "", "", "", error, "");
                                 }
                             }
                         });
@@ -139,7 +139,7 @@ public class FirebaseHelper {
      * Sign in with email and password
      */
     public static void signInWithEmail(final String email, final String password, final String operationId) {
-        if (!checkAuth()) return;
+        if (!checkAuth(operationId)) return;
 
         currentActivity.runOnUiThread(new Runnable() {
             @Override
@@ -162,7 +162,7 @@ public class FirebaseHelper {
                                                 if (tokenTask.isSuccessful() && tokenTask.getResult() != null) {
                                                     token = tokenTask.getResult().getToken();
                                                 }
-                                                nativeOnAuthResult(true, userId, userEmail, displayName, "", token);
+                                                nativeOnAuthResult(operationId, true, userId, userEmail, displayName, "", token);
                                             }
                                         });
                                         
@@ -171,7 +171,7 @@ public class FirebaseHelper {
                                 } else {
                                     String error = task.getException() != null ? task.getException().getMessage() : "Unknown error";
                                     Log.e(TAG, "Sign in failed: " + error);
-                                    nativeOnAuthResult(false, "", "", "", error, "");
+                                    nativeOnAuthResult(operationId, false, "", "", "", error, "");
                                 }
                             }
                         });
@@ -183,7 +183,7 @@ public class FirebaseHelper {
      * Sign in anonymously
      */
     public static void signInAnonymously(final String operationId) {
-        if (!checkAuth()) return;
+        if (!checkAuth(operationId)) return;
 
         currentActivity.runOnUiThread(new Runnable() {
             @Override
@@ -204,7 +204,7 @@ public class FirebaseHelper {
                                                 if (tokenTask.isSuccessful() && tokenTask.getResult() != null) {
                                                     token = tokenTask.getResult().getToken();
                                                 }
-                                                nativeOnAuthResult(true, userId, "", "Anonymous", "", token);
+                                                nativeOnAuthResult(operationId, true, userId, "", "Anonymous", "", token);
                                             }
                                         });
                                         
@@ -213,7 +213,7 @@ public class FirebaseHelper {
                                 } else {
                                     String error = task.getException() != null ? task.getException().getMessage() : "Unknown error";
                                     Log.e(TAG, "Anonymous sign in failed: " + error);
-                                    nativeOnAuthResult(false, "", "", "", error, "");
+                                    nativeOnAuthResult(operationId, false, "", "", "", error, "");
                                 }
                             }
                         });
@@ -227,7 +227,7 @@ public class FirebaseHelper {
     public static void signInWithGoogle(final String operationId) {
         // TODO: Implement Google Sign-In
         Log.w(TAG, "Google Sign-In not yet implemented");
-        nativeOnAuthResult(false, "", "", "", "Google Sign-In not yet implemented", "");
+        nativeOnAuthResult(operationId, false, "", "", "", "Google Sign-In not yet implemented", "");
     }
 
     /**
@@ -292,8 +292,8 @@ public class FirebaseHelper {
      * Send email verification
      */
     public static void sendEmailVerification(final String operationId) {
-        if (!checkAuth() || mAuth.getCurrentUser() == null) {
-            nativeOnAuthResult(false, "", "", "", "No user signed in", "");
+        if (!checkAuth(operationId) || mAuth.getCurrentUser() == null) {
+            nativeOnAuthResult(operationId, false, "", "", "", "No user signed in", "");
             return;
         }
 
@@ -306,10 +306,10 @@ public class FirebaseHelper {
                             public void onComplete(@NonNull Task<Void> task) {
                                 if (task.isSuccessful()) {
                                     Log.i(TAG, "Email verification sent");
-                                    nativeOnAuthResult(true, getCurrentUserId(), getCurrentUserEmail(), "", "Verification email sent", "");
+                                    nativeOnAuthResult(operationId, true, getCurrentUserId(), getCurrentUserEmail(), "", "Verification email sent", "");
                                 } else {
                                     String error = task.getException() != null ? task.getException().getMessage() : "Unknown error";
-                                    nativeOnAuthResult(false, "", "", "", error, "");
+                                    nativeOnAuthResult(operationId, false, "", "", "", error, "");
                                 }
                             }
                         });
@@ -331,7 +331,7 @@ public class FirebaseHelper {
      * Send password reset email
      */
     public static void sendPasswordResetEmail(final String email, final String operationId) {
-        if (!checkAuth()) return;
+        if (!checkAuth(operationId)) return;
 
         currentActivity.runOnUiThread(new Runnable() {
             @Override
@@ -342,10 +342,10 @@ public class FirebaseHelper {
                             public void onComplete(@NonNull Task<Void> task) {
                                 if (task.isSuccessful()) {
                                     Log.i(TAG, "Password reset email sent");
-                                    nativeOnAuthResult(true, "", email, "", "Password reset email sent", "");
+                                    nativeOnAuthResult(operationId, true, "", email, "", "Password reset email sent", "");
                                 } else {
                                     String error = task.getException() != null ? task.getException().getMessage() : "Unknown error";
-                                    nativeOnAuthResult(false, "", "", "", error, "");
+                                    nativeOnAuthResult(operationId, false, "", "", "", error, "");
                                 }
                             }
                         });
@@ -357,8 +357,8 @@ public class FirebaseHelper {
      * Update user password
      */
     public static void updatePassword(final String newPassword, final String operationId) {
-        if (!checkAuth() || mAuth.getCurrentUser() == null) {
-            nativeOnAuthResult(false, "", "", "", "No user signed in", "");
+        if (!checkAuth(operationId) || mAuth.getCurrentUser() == null) {
+            nativeOnAuthResult(operationId, false, "", "", "", "No user signed in", "");
             return;
         }
 
@@ -371,10 +371,10 @@ public class FirebaseHelper {
                             public void onComplete(@NonNull Task<Void> task) {
                                 if (task.isSuccessful()) {
                                     Log.i(TAG, "Password updated");
-                                    nativeOnAuthResult(true, getCurrentUserId(), getCurrentUserEmail(), "", "Password updated", "");
+                                    nativeOnAuthResult(operationId, true, getCurrentUserId(), getCurrentUserEmail(), "", "Password updated", "");
                                 } else {
                                     String error = task.getException() != null ? task.getException().getMessage() : "Unknown error";
-                                    nativeOnAuthResult(false, "", "", "", error, "");
+                                    nativeOnAuthResult(operationId, false, "", "", "", error, "");
                                 }
                             }
                         });
@@ -386,8 +386,8 @@ public class FirebaseHelper {
      * Update user display name
      */
     public static void updateDisplayName(final String displayName, final String operationId) {
-        if (!checkAuth() || mAuth.getCurrentUser() == null) {
-            nativeOnAuthResult(false, "", "", "", "No user signed in", "");
+        if (!checkAuth(operationId) || mAuth.getCurrentUser() == null) {
+            nativeOnAuthResult(operationId, false, "", "", "", "No user signed in", "");
             return;
         }
 
@@ -404,10 +404,10 @@ public class FirebaseHelper {
                             public void onComplete(@NonNull Task<Void> task) {
                                 if (task.isSuccessful()) {
                                     Log.i(TAG, "Display name updated");
-                                    nativeOnAuthResult(true, getCurrentUserId(), getCurrentUserEmail(), displayName, "", "");
+                                    nativeOnAuthResult(operationId, true, getCurrentUserId(), getCurrentUserEmail(), displayName, "", "");
                                 } else {
                                     String error = task.getException() != null ? task.getException().getMessage() : "Unknown error";
-                                    nativeOnAuthResult(false, "", "", "", error, "");
+                                    nativeOnAuthResult(operationId, false, "", "", "", error, "");
                                 }
                             }
                         });
@@ -419,8 +419,8 @@ public class FirebaseHelper {
      * Delete user account
      */
     public static void deleteUserAccount(final String operationId) {
-        if (!checkAuth() || mAuth.getCurrentUser() == null) {
-            nativeOnAuthResult(false, "", "", "", "No user signed in", "");
+        if (!checkAuth(operationId) || mAuth.getCurrentUser() == null) {
+            nativeOnAuthResult(operationId, false, "", "", "", "No user signed in", "");
             return;
         }
 
@@ -433,10 +433,10 @@ public class FirebaseHelper {
                             public void onComplete(@NonNull Task<Void> task) {
                                 if (task.isSuccessful()) {
                                     Log.i(TAG, "User account deleted");
-                                    nativeOnAuthResult(true, "", "", "", "Account deleted", "");
+                                    nativeOnAuthResult(operationId, true, "", "", "", "Account deleted", "");
                                 } else {
                                     String error = task.getException() != null ? task.getException().getMessage() : "Unknown error";
-                                    nativeOnAuthResult(false, "", "", "", error, "");
+                                    nativeOnAuthResult(operationId, false, "", "", "", error, "");
                                 }
                             }
                         });
@@ -450,7 +450,7 @@ public class FirebaseHelper {
      * Set value in database
      */
     public static void setDatabaseValue(final String path, final String jsonData, final String operationId) {
-        if (!checkDatabase()) return;
+        if (!checkDatabase(operationId)) return;
 
         currentActivity.runOnUiThread(new Runnable() {
             @Override
@@ -464,19 +464,19 @@ public class FirebaseHelper {
                                 @Override
                                 public void onSuccess(Void aVoid) {
                                     Log.i(TAG, "Database value set: " + path);
-                                    nativeOnDatabaseResult(true, path, jsonData, "");
+                                    nativeOnDatabaseResult(operationId, true, path, jsonData, "");
                                 }
                             })
                             .addOnFailureListener(new OnFailureListener() {
                                 @Override
                                 public void onFailure(@NonNull Exception e) {
                                     Log.e(TAG, "Failed to set database value: " + e.getMessage());
-                                    nativeOnDatabaseResult(false, path, "", e.getMessage());
+                                    nativeOnDatabaseResult(operationId, false, path, "", e.getMessage());
                                 }
                             });
                 } catch (Exception e) {
                     Log.e(TAG, "Error setting database value: " + e.getMessage());
-                    nativeOnDatabaseResult(false, path, "", e.getMessage());
+                    nativeOnDatabaseResult(operationId, false, path, "", e.getMessage());
                 }
             }
         });
@@ -486,7 +486,7 @@ public class FirebaseHelper {
      * Update value in database
      */
     public static void updateDatabaseValue(final String path, final String jsonData, final String operationId) {
-        if (!checkDatabase()) return;
+        if (!checkDatabase(operationId)) return;
 
         currentActivity.runOnUiThread(new Runnable() {
             @Override
@@ -500,19 +500,19 @@ public class FirebaseHelper {
                                 @Override
                                 public void onSuccess(Void aVoid) {
                                     Log.i(TAG, "Database value updated: " + path);
-                                    nativeOnDatabaseResult(true, path, jsonData, "");
+                                    nativeOnDatabaseResult(operationId, true, path, jsonData, "");
                                 }
                             })
                             .addOnFailureListener(new OnFailureListener() {
                                 @Override
                                 public void onFailure(@NonNull Exception e) {
                                     Log.e(TAG, "Failed to update database value: " + e.getMessage());
-                                    nativeOnDatabaseResult(false, path, "", e.getMessage());
+                                    nativeOnDatabaseResult(operationId, false, path, "", e.getMessage());
                                 }
                             });
                 } catch (Exception e) {
                     Log.e(TAG, "Error updating database value: " + e.getMessage());
-                    nativeOnDatabaseResult(false, path, "", e.getMessage());
+                    nativeOnDatabaseResult(operationId, false, path, "", e.getMessage());
                 }
             }
         });
@@ -522,7 +522,7 @@ public class FirebaseHelper {
      * Push value to database (generates unique key)
      */
     public static void pushDatabaseValue(final String path, final String jsonData, final String operationId) {
-        if (!checkDatabase()) return;
+        if (!checkDatabase(operationId)) return;
 
         currentActivity.runOnUiThread(new Runnable() {
             @Override
@@ -538,19 +538,19 @@ public class FirebaseHelper {
                                 public void onSuccess(Void aVoid) {
                                     String newPath = pushRef.getKey();
                                     Log.i(TAG, "Database value pushed: " + newPath);
-                                    nativeOnDatabaseResult(true, path + "/" + newPath, jsonData, "");
+                                    nativeOnDatabaseResult(operationId, true, path + "/" + newPath, jsonData, "");
                                 }
                             })
                             .addOnFailureListener(new OnFailureListener() {
                                 @Override
                                 public void onFailure(@NonNull Exception e) {
                                     Log.e(TAG, "Failed to push database value: " + e.getMessage());
-                                    nativeOnDatabaseResult(false, path, "", e.getMessage());
+                                    nativeOnDatabaseResult(operationId, false, path, "", e.getMessage());
                                 }
                             });
                 } catch (Exception e) {
                     Log.e(TAG, "Error pushing database value: " + e.getMessage());
-                    nativeOnDatabaseResult(false, path, "", e.getMessage());
+                    nativeOnDatabaseResult(operationId, false, path, "", e.getMessage());
                 }
             }
         });
@@ -560,7 +560,7 @@ public class FirebaseHelper {
      * Delete value from database
      */
     public static void deleteDatabaseValue(final String path, final String operationId) {
-        if (!checkDatabase()) return;
+        if (!checkDatabase(operationId)) return;
 
         currentActivity.runOnUiThread(new Runnable() {
             @Override
@@ -572,14 +572,14 @@ public class FirebaseHelper {
                             @Override
                             public void onSuccess(Void aVoid) {
                                 Log.i(TAG, "Database value deleted: " + path);
-                                nativeOnDatabaseResult(true, path, "", "");
+                                nativeOnDatabaseResult(operationId, true, path, "", "");
                             }
                         })
                         .addOnFailureListener(new OnFailureListener() {
                             @Override
                             public void onFailure(@NonNull Exception e) {
                                 Log.e(TAG, "Failed to delete database value: " + e.getMessage());
-                                nativeOnDatabaseResult(false, path, "", e.getMessage());
+                                nativeOnDatabaseResult(operationId, false, path, "", e.getMessage());
                             }
                         });
             }
@@ -590,7 +590,7 @@ public class FirebaseHelper {
      * Get value from database
      */
     public static void getDatabaseValue(final String path, final String operationId) {
-        if (!checkDatabase()) return;
+        if (!checkDatabase(operationId)) return;
 
         currentActivity.runOnUiThread(new Runnable() {
             @Override
@@ -602,13 +602,13 @@ public class FirebaseHelper {
                     public void onSuccess(DataSnapshot snapshot) {
                         String jsonData = dataSnapshotToJson(snapshot);
                         Log.i(TAG, "Database value retrieved: " + path);
-                        nativeOnDatabaseResult(true, path, jsonData, "");
+                        nativeOnDatabaseResult(operationId, true, path, jsonData, "");
                     }
                 }).addOnFailureListener(new OnFailureListener() {
                     @Override
                     public void onFailure(@NonNull Exception e) {
                         Log.e(TAG, "Failed to get database value: " + e.getMessage());
-                        nativeOnDatabaseResult(false, path, "", e.getMessage());
+                        nativeOnDatabaseResult(operationId, false, path, "", e.getMessage());
                     }
                 });
             }
@@ -671,7 +671,7 @@ public class FirebaseHelper {
      */
     public static void queryDatabaseValues(final String path, final String orderByKey, final int limitToFirst, 
                                           final String startAt, final String endAt, final String operationId) {
-        if (!checkDatabase()) return;
+        if (!checkDatabase(operationId)) return;
 
         currentActivity.runOnUiThread(new Runnable() {
             @Override
@@ -694,13 +694,13 @@ public class FirebaseHelper {
                     public void onSuccess(DataSnapshot snapshot) {
                         String jsonData = dataSnapshotToJson(snapshot);
                         Log.i(TAG, "Database query successful: " + path);
-                        nativeOnDatabaseResult(true, path, jsonData, "");
+                        nativeOnDatabaseResult(operationId, true, path, jsonData, "");
                     }
                 }).addOnFailureListener(new OnFailureListener() {
                     @Override
                     public void onFailure(@NonNull Exception e) {
                         Log.e(TAG, "Database query failed: " + e.getMessage());
-                        nativeOnDatabaseResult(false, path, "", e.getMessage());
+                        nativeOnDatabaseResult(operationId, false, path, "", e.getMessage());
                     }
                 });
             }
@@ -711,7 +711,7 @@ public class FirebaseHelper {
      * Run transaction
      */
     public static void runTransaction(final String path, final String jsonData, final String operationId) {
-        if (!checkDatabase()) return;
+        if (!checkDatabase(operationId)) return;
 
         currentActivity.runOnUiThread(new Runnable() {
             @Override
@@ -736,11 +736,11 @@ public class FirebaseHelper {
                     public void onComplete(DatabaseError error, boolean committed, DataSnapshot snapshot) {
                         if (committed && error == null) {
                             Log.i(TAG, "Transaction successful: " + path);
-                            nativeOnDatabaseResult(true, path, jsonData, "");
+                            nativeOnDatabaseResult(operationId, true, path, jsonData, "");
                         } else {
                             String errorMsg = error != null ? error.getMessage() : "Transaction failed";
                             Log.e(TAG, "Transaction failed: " + errorMsg);
-                            nativeOnDatabaseResult(false, path, "", errorMsg);
+                            nativeOnDatabaseResult(operationId, false, path, "", errorMsg);
                         }
                     }
                 });
@@ -828,10 +828,10 @@ public class FirebaseHelper {
 
     // ====== HELPER METHODS ======
 
-    private static boolean checkAuth() {
+    private static boolean checkAuth(final String operationId) {
         if (!isInitialized || mAuth == null) {
             Log.e(TAG, "Firebase Auth not initialized");
-            nativeOnAuthResult(false, "", "", "", "Firebase not initialized", "");
+            nativeOnAuthResult(operationId, false, "", "", "", "Firebase not initialized", "");
             return false;
         }
         return true;
@@ -845,6 +845,14 @@ public class FirebaseHelper {
         return true;
     }
 
+    private static boolean checkDatabase(final String operationId) {
+        if (!checkDatabase()) {
+            nativeOnDatabaseResult(operationId, false, "", "", "Firebase not initialized");
+            return false;
+        }
+        return true;
+    }
+
     private static Object jsonToObject(String jsonData) throws JSONException {
         if (jsonData == null || jsonData.isEmpty() || jsonData.equals("null")) {
             return null;
@@ -904,9 +912,9 @@ public class FirebaseHelper {
     }
 
     // Native callbacks to Unreal Engine
-    public static native void nativeOnAuthResult(boolean success, String userId, String email, 
+    public static native void nativeOnAuthResult(String operationId, boolean success, String userId, String email, 
                                                  String displayName, String errorMessage, String authToken);
-    public static native void nativeOnDatabaseResult(boolean success, String path, 
+    public static native void nativeOnDatabaseResult(String operationId, boolean success, String path, 
                                                      String data, String errorMessage);
     public static native void nativeOnDatabaseValueChanged(String path, String data);
 }
@@ -1,7 +1,11 @@
 // Copyright. All Rights Reserved.
 
 #include "FirebaseAuth.h"
+#include "FirebaseLog.h"
+#include "FirebaseMemory.h"
 #include "FirebaseSettings.h"
+#include "FirebaseTrace.h"
+#include "FirebaseTrafficRecorder.h"
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
 
@@ -11,21 +15,68 @@
 #endif
 
 // Initialize static members
-TMap<FString, FOnFirebaseAuthComplete> UFirebaseAuth::PendingCallbacks;
-int32 UFirebaseAuth::CurrentOperationId = 0;
+TFirebasePendingOperations<FOnFirebaseAuthComplete> UFirebaseAuth::PendingOperations;
+FTSTicker::FDelegateHandle UFirebaseAuth::PendingOperationsTicker;
 UFirebaseRestAPI* UFirebaseAuth::RestAPIInstance = nullptr;
 
-FString UFirebaseAuth::GenerateOperationId()
+int64 UFirebaseAuth::RegisterCallback(const FOnFirebaseAuthComplete& Callback)
 {
-	return FString::Printf(TEXT("AUTH_%d"), ++CurrentOperationId);
+	if (!Callback.IsBound())
+	{
+		// Nobody waits for the result, so there is nothing to track
+		return PendingOperations.AllocateId();
+	}
+
+	if (const UFirebaseSettings* Settings = GetDefault<UFirebaseSettings>())
+	{
+		PendingOperations.Configure(Settings->MaxPendingOperations, Settings->PendingOperationTimeoutSeconds);
+	}
+
+	const int64 OperationId = PendingOperations.Add(Callback, FPlatformTime::Seconds());
+	if (OperationId == PendingOperations.InvalidId)
+	{
+		UE_LOG(LogFirebase, Error, TEXT("Firebase Auth: Too many pending operations"));
+		FFirebaseAuthResult Result;
+		Result.bSuccess = false;
+		Result.ErrorMessage = TEXT("Too many pending operations");
+		Callback.ExecuteIfBound(Result);
+		return PendingOperations.InvalidId;
+	}
+
+	if (!PendingOperationsTicker.IsValid())
+	{
+		PendingOperationsTicker = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateStatic(&UFirebaseAuth::TickPendingOperations), 0.25f);
+	}
+
+	return OperationId;
 }
 
-void UFirebaseAuth::RegisterCallback(const FString& OperationId, const FOnFirebaseAuthComplete& Callback)
+int32 UFirebaseAuth::GetPendingOperationCount()
 {
-	if (Callback.IsBound())
+	return PendingOperations.Num();
+}
+
+bool UFirebaseAuth::TickPendingOperations(float DeltaTime)
+{
+	TArray<TPair<int64, FOnFirebaseAuthComplete>> Expired;
+	PendingOperations.CollectExpired(FPlatformTime::Seconds(), Expired);
+
+	for (const TPair<int64, FOnFirebaseAuthComplete>& Pair : Expired)
 	{
-		PendingCallbacks.Add(OperationId, Callback);
+		UE_LOG(LogFirebase, Error, TEXT("Firebase Auth: Operation %lld timed out"), Pair.Key);
+		FFirebaseAuthResult Result;
+		Result.bSuccess = false;
+		Result.ErrorMessage = TEXT("Operation timed out");
+		Pair.Value.ExecuteIfBound(Result);
+	}
+
+	if (PendingOperations.Num() == 0)
+	{
+		PendingOperationsTicker.Reset();
+		return false;
 	}
+	return true;
 }
 
 bool UFirebaseAuth::ShouldUseRestAPI()
@@ -56,6 +107,7 @@ UFirebaseRestAPI* UFirebaseAuth::GetRestAPI()
 				Settings->ProjectId,
 				Settings->GetFullDatabaseUrl()
 			);
+			RestAPIInstance->ConfigureFromSettings(Settings);
 		}
 	}
 	
@@ -97,8 +149,10 @@ void UFirebaseAuth::SignUpWithEmail(const FString& Email, const FString& Passwor
 				}
 				
 				// Execute callback on game thread
-				AsyncTask(ENamedThreads::GameThread, [OnComplete, Result]()
+				const uint64 TraceId = FFirebaseTrace::GetCurrentRequestId();
+				AsyncTask(ENamedThreads::GameThread, [OnComplete, Result, TraceId]()
 				{
+					FIREBASE_TRACE_CALLBACK_SCOPE(EFirebaseTraceOrigin::Rest, TraceId);
 					OnComplete.ExecuteIfBound(Result);
 				});
 			}));
@@ -107,14 +161,20 @@ void UFirebaseAuth::SignUpWithEmail(const FString& Email, const FString& Passwor
 	}
 
 #if PLATFORM_ANDROID
-	FString OperationId = GenerateOperationId();
-	RegisterCallback(OperationId, OnComplete);
+	const int64 OperationId = RegisterCallback(OnComplete);
+	if (OperationId == PendingOperations.InvalidId)
+	{
+		return;
+	}
+
+	FFirebaseTrace::Request(EFirebaseTraceOrigin::Jni, OperationId, TEXT("SignUpWithEmail"), FStringView(), 0);
+	FFirebaseTrafficRecorder::Get().Record(EFirebaseTrafficOp::Auth, TEXT("SignUpWithEmail"), 0);
 
 	if (JNIEnv* Env = FAndroidApplication::GetJavaEnv())
 	{
 		jstring jEmail = Env->NewStringUTF(TCHAR_TO_UTF8(*Email));
 		jstring jPassword = Env->NewStringUTF(TCHAR_TO_UTF8(*Password));
-		jstring jOperationId = Env->NewStringUTF(TCHAR_TO_UTF8(*OperationId));
+		jstring jOperationId = Env->NewStringUTF(TCHAR_TO_UTF8(*LexToString(OperationId)));
 
 		jclass FirebaseHelperClass = FAndroidApplication::FindJavaClass("com/epicgames/unreal/FirebaseHelper");
 		if (FirebaseHelperClass)
@@ -124,6 +184,7 @@ void UFirebaseAuth::SignUpWithEmail(const FString& Email, const FString& Passwor
 			if (SignUpMethod)
 			{
 				Env->CallStaticVoidMethod(FirebaseHelperClass, SignUpMethod, jEmail, jPassword, jOperationId);
+				FFirebaseTrace::Stage(EFirebaseTraceOrigin::Jni, OperationId, EFirebaseTraceStage::Sent);
 			}
 			Env->DeleteLocalRef(FirebaseHelperClass);
 		}
@@ -133,7 +194,7 @@ void UFirebaseAuth::SignUpWithEmail(const FString& Email, const FString& Passwor
 		Env->DeleteLocalRef(jOperationId);
 	}
 #else
-	UE_LOG(LogTemp, Warning, TEXT("Firebase Auth: SignUpWithEmail not available"));
+	UE_LOG(LogFirebase, Warning, TEXT("Firebase Auth: SignUpWithEmail not available"));
 	FFirebaseAuthResult Result;
 	Result.bSuccess = false;
 	Result.ErrorMessage = TEXT("Platform not supported");
@@ -145,14 +206,20 @@ void UFirebaseAuth::SignInWithEmail(const FString& Email, const FString& Passwor
 	const FOnFirebaseAuthComplete& OnComplete)
 {
 #if PLATFORM_ANDROID
-	FString OperationId = GenerateOperationId();
-	RegisterCallback(OperationId, OnComplete);
+	const int64 OperationId = RegisterCallback(OnComplete);
+	if (OperationId == PendingOperations.InvalidId)
+	{
+		return;
+	}
+
+	FFirebaseTrace::Request(EFirebaseTraceOrigin::Jni, OperationId, TEXT("SignInWithEmail"), FStringView(), 0);
+	FFirebaseTrafficRecorder::Get().Record(EFirebaseTrafficOp::Auth, TEXT("SignInWithEmail"), 0);
 
 	if (JNIEnv* Env = FAndroidApplication::GetJavaEnv())
 	{
 		jstring jEmail = Env->NewStringUTF(TCHAR_TO_UTF8(*Email));
 		jstring jPassword = Env->NewStringUTF(TCHAR_TO_UTF8(*Password));
-		jstring jOperationId = Env->NewStringUTF(TCHAR_TO_UTF8(*OperationId));
+		jstring jOperationId = Env->NewStringUTF(TCHAR_TO_UTF8(*LexToString(OperationId)));
 
 		jclass FirebaseHelperClass = FAndroidApplication::FindJavaClass("com/epicgames/unreal/FirebaseHelper");
 		if (FirebaseHelperClass)
@@ -162,6 +229,7 @@ void UFirebaseAuth::SignInWithEmail(const FString& Email, const FString& Passwor
 			if (SignInMethod)
 			{
 				Env->CallStaticVoidMethod(FirebaseHelperClass, SignInMethod, jEmail, jPassword, jOperationId);
+				FFirebaseTrace::Stage(EFirebaseTraceOrigin::Jni, OperationId, EFirebaseTraceStage::Sent);
 			}
 			Env->DeleteLocalRef(FirebaseHelperClass);
 		}
@@ -171,7 +239,7 @@ void UFirebaseAuth::SignInWithEmail(const FString& Email, const FString& Passwor
 		Env->DeleteLocalRef(jOperationId);
 	}
 #else
-	UE_LOG(LogTemp, Warning, TEXT("Firebase Auth: SignInWithEmail only available on Android"));
+	UE_LOG(LogFirebase, Warning, TEXT("Firebase Auth: SignInWithEmail only available on Android"));
 	FFirebaseAuthResult Result;
 	Result.bSuccess = false;
 	Result.ErrorMessage = TEXT("Platform not supported");
@@ -189,7 +257,7 @@ void UFirebaseAuth::SignInAnonymously(const FOnFirebaseAuthComplete& OnComplete)
 		UFirebaseRestAPI* RestAPI = GetRestAPI();
 		if (!RestAPI)
 		{
-			UE_LOG(LogTemp, Error, TEXT("Firebase Auth: Failed to initialize REST API"));
+			UE_LOG(LogFirebase, Error, TEXT("Firebase Auth: Failed to initialize REST API"));
 			FFirebaseAuthResult Result;
 			Result.bSuccess = false;
 			Result.ErrorMessage = TEXT("Failed to initialize REST API");
@@ -222,8 +290,10 @@ void UFirebaseAuth::SignInAnonymously(const FOnFirebaseAuthComplete& OnComplete)
 			}
 			
 			// Execute callback on game thread
-			AsyncTask(ENamedThreads::GameThread, [OnComplete, Result]()
+			const uint64 TraceId = FFirebaseTrace::GetCurrentRequestId();
+			AsyncTask(ENamedThreads::GameThread, [OnComplete, Result, TraceId]()
 			{
+				FIREBASE_TRACE_CALLBACK_SCOPE(EFirebaseTraceOrigin::Rest, TraceId);
 				OnComplete.ExecuteIfBound(Result);
 			});
 		}));
@@ -231,12 +301,18 @@ void UFirebaseAuth::SignInAnonymously(const FOnFirebaseAuthComplete& OnComplete)
 	}
 
 #if PLATFORM_ANDROID
-	FString OperationId = GenerateOperationId();
-	RegisterCallback(OperationId, OnComplete);
+	const int64 OperationId = RegisterCallback(OnComplete);
+	if (OperationId == PendingOperations.InvalidId)
+	{
+		return;
+	}
+
+	FFirebaseTrace::Request(EFirebaseTraceOrigin::Jni, OperationId, TEXT("SignInAnonymously"), FStringView(), 0);
+	FFirebaseTrafficRecorder::Get().Record(EFirebaseTrafficOp::Auth, TEXT("SignInAnonymously"), 0);
 
 	if (JNIEnv* Env = FAndroidApplication::GetJavaEnv())
 	{
-		jstring jOperationId = Env->NewStringUTF(TCHAR_TO_UTF8(*OperationId));
+		jstring jOperationId = Env->NewStringUTF(TCHAR_TO_UTF8(*LexToString(OperationId)));
 
 		jclass FirebaseHelperClass = FAndroidApplication::FindJavaClass("com/epicgames/unreal/FirebaseHelper");
 		if (FirebaseHelperClass)
@@ -246,6 +322,7 @@ void UFirebaseAuth::SignInAnonymously(const FOnFirebaseAuthComplete& OnComplete)
 			if (SignInMethod)
 			{
 				Env->CallStaticVoidMethod(FirebaseHelperClass, SignInMethod, jOperationId);
+				FFirebaseTrace::Stage(EFirebaseTraceOrigin::Jni, OperationId, EFirebaseTraceStage::Sent);
 			}
 			Env->DeleteLocalRef(FirebaseHelperClass);
 		}
@@ -253,7 +330,7 @@ void UFirebaseAuth::SignInAnonymously(const FOnFirebaseAuthComplete& OnComplete)
 		Env->DeleteLocalRef(jOperationId);
 	}
 #else
-	UE_LOG(LogTemp, Warning, TEXT("Firebase Auth: SignInAnonymously not available"));
+	UE_LOG(LogFirebase, Warning, TEXT("Firebase Auth: SignInAnonymously not available"));
 	FFirebaseAuthResult Result;
 	Result.bSuccess = false;
 	Result.ErrorMessage = TEXT("Platform not supported");
@@ -266,12 +343,18 @@ void UFirebaseAuth::SignInAnonymously(const FOnFirebaseAuthComplete& OnComplete)
 void UFirebaseAuth::SignInWithGoogle(const FOnFirebaseAuthComplete& OnComplete)
 {
 #if PLATFORM_ANDROID
-	FString OperationId = GenerateOperationId();
-	RegisterCallback(OperationId, OnComplete);
+	const int64 OperationId = RegisterCallback(OnComplete);
+	if (OperationId == PendingOperations.InvalidId)
+	{
+		return;
+	}
+
+	FFirebaseTrace::Request(EFirebaseTraceOrigin::Jni, OperationId, TEXT("SignInWithGoogle"), FStringView(), 0);
+	FFirebaseTrafficRecorder::Get().Record(EFirebaseTrafficOp::Auth, TEXT("SignInWithGoogle"), 0);
 
 	if (JNIEnv* Env = FAndroidApplication::GetJavaEnv())
 	{
-		jstring jOperationId = Env->NewStringUTF(TCHAR_TO_UTF8(*OperationId));
+		jstring jOperationId = Env->NewStringUTF(TCHAR_TO_UTF8(*LexToString(OperationId)));
 
 		jclass FirebaseHelperClass = FAndroidApplication::FindJavaClass("com/epicgames/unreal/FirebaseHelper");
 		if (FirebaseHelperClass)
@@ -281,6 +364,7 @@ void UFirebaseAuth::SignInWithGoogle(const FOnFirebaseAuthComplete& OnComplete)
 			if (SignInMethod)
 			{
 				Env->CallStaticVoidMethod(FirebaseHelperClass, SignInMethod, jOperationId);
+				FFirebaseTrace::Stage(EFirebaseTraceOrigin::Jni, OperationId, EFirebaseTraceStage::Sent);
 			}
 			Env->DeleteLocalRef(FirebaseHelperClass);
 		}
@@ -288,7 +372,7 @@ void UFirebaseAuth::SignInWithGoogle(const FOnFirebaseAuthComplete& OnComplete)
 		Env->DeleteLocalRef(jOperationId);
 	}
 #else
-	UE_LOG(LogTemp, Warning, TEXT("Firebase Auth: SignInWithGoogle only available on Android"));
+	UE_LOG(LogFirebase, Warning, TEXT("Firebase Auth: SignInWithGoogle only available on Android"));
 	FFirebaseAuthResult Result;
 	Result.bSuccess = false;
 	Result.ErrorMessage = TEXT("Platform not supported");
@@ -315,7 +399,7 @@ void UFirebaseAuth::SignOut()
 		}
 	}
 #endif
-	UE_LOG(LogTemp, Log, TEXT("Firebase Auth: User signed out"));
+	UE_LOG(LogFirebase, Log, TEXT("Firebase Auth: User signed out"));
 }
 
 bool UFirebaseAuth::IsUserSignedIn()
@@ -466,12 +550,18 @@ FString UFirebaseAuth::GetAuthToken()
 void UFirebaseAuth::SendEmailVerification(const FOnFirebaseAuthComplete& OnComplete)
 {
 #if PLATFORM_ANDROID
-	FString OperationId = GenerateOperationId();
-	RegisterCallback(OperationId, OnComplete);
+	const int64 OperationId = RegisterCallback(OnComplete);
+	if (OperationId == PendingOperations.InvalidId)
+	{
+		return;
+	}
+
+	FFirebaseTrace::Request(EFirebaseTraceOrigin::Jni, OperationId, TEXT("SendEmailVerification"), FStringView(), 0);
+	FFirebaseTrafficRecorder::Get().Record(EFirebaseTrafficOp::Auth, TEXT("SendEmailVerification"), 0);
 
 	if (JNIEnv* Env = FAndroidApplication::GetJavaEnv())
 	{
-		jstring jOperationId = Env->NewStringUTF(TCHAR_TO_UTF8(*OperationId));
+		jstring jOperationId = Env->NewStringUTF(TCHAR_TO_UTF8(*LexToString(OperationId)));
 
 		jclass FirebaseHelperClass = FAndroidApplication::FindJavaClass("com/epicgames/unreal/FirebaseHelper");
 		if (FirebaseHelperClass)
@@ -481,6 +571,7 @@ void UFirebaseAuth::SendEmailVerification(const FOnFirebaseAuthComplete& OnCompl
 			if (SendVerificationMethod)
 			{
 				Env->CallStaticVoidMethod(FirebaseHelperClass, SendVerificationMethod, jOperationId);
+				FFirebaseTrace::Stage(EFirebaseTraceOrigin::Jni, OperationId, EFirebaseTraceStage::Sent);
 			}
 			Env->DeleteLocalRef(FirebaseHelperClass);
 		}
@@ -522,13 +613,19 @@ bool UFirebaseAuth::IsEmailVerified()
 void UFirebaseAuth::SendPasswordResetEmail(const FString& Email, const FOnFirebaseAuthComplete& OnComplete)
 {
 #if PLATFORM_ANDROID
-	FString OperationId = GenerateOperationId();
-	RegisterCallback(OperationId, OnComplete);
+	const int64 OperationId = RegisterCallback(OnComplete);
+	if (OperationId == PendingOperations.InvalidId)
+	{
+		return;
+	}
+
+	FFirebaseTrace::Request(EFirebaseTraceOrigin::Jni, OperationId, TEXT("SendPasswordResetEmail"), FStringView(), 0);
+	FFirebaseTrafficRecorder::Get().Record(EFirebaseTrafficOp::Auth, TEXT("SendPasswordResetEmail"), 0);
 
 	if (JNIEnv* Env = FAndroidApplication::GetJavaEnv())
 	{
 		jstring jEmail = Env->NewStringUTF(TCHAR_TO_UTF8(*Email));
-		jstring jOperationId = Env->NewStringUTF(TCHAR_TO_UTF8(*OperationId));
+		jstring jOperationId = Env->NewStringUTF(TCHAR_TO_UTF8(*LexToString(OperationId)));
 
 		jclass FirebaseHelperClass = FAndroidApplication::FindJavaClass("com/epicgames/unreal/FirebaseHelper");
 		if (FirebaseHelperClass)
@@ -538,6 +635,7 @@ void UFirebaseAuth::SendPasswordResetEmail(const FString& Email, const FOnFireba
 			if (SendResetMethod)
 			{
 				Env->CallStaticVoidMethod(FirebaseHelperClass, SendResetMethod, jEmail, jOperationId);
+				FFirebaseTrace::Stage(EFirebaseTraceOrigin::Jni, OperationId, EFirebaseTraceStage::Sent);
 			}
 			Env->DeleteLocalRef(FirebaseHelperClass);
 		}
@@ -556,13 +654,19 @@ void UFirebaseAuth::SendPasswordResetEmail(const FString& Email, const FOnFireba
 void UFirebaseAuth::UpdatePassword(const FString& NewPassword, const FOnFirebaseAuthComplete& OnComplete)
 {
 #if PLATFORM_ANDROID
-	FString OperationId = GenerateOperationId();
-	RegisterCallback(OperationId, OnComplete);
+	const int64 OperationId = RegisterCallback(OnComplete);
+	if (OperationId == PendingOperations.InvalidId)
+	{
+		return;
+	}
+
+	FFirebaseTrace::Request(EFirebaseTraceOrigin::Jni, OperationId, TEXT("UpdatePassword"), FStringView(), 0);
+	FFirebaseTrafficRecorder::Get().Record(EFirebaseTrafficOp::Auth, TEXT("UpdatePassword"), 0);
 
 	if (JNIEnv* Env = FAndroidApplication::GetJavaEnv())
 	{
 		jstring jPassword = Env->NewStringUTF(TCHAR_TO_UTF8(*NewPassword));
-		jstring jOperationId = Env->NewStringUTF(TCHAR_TO_UTF8(*OperationId));
+		jstring jOperationId = Env->NewStringUTF(TCHAR_TO_UTF8(*LexToString(OperationId)));
 
 		jclass FirebaseHelperClass = FAndroidApplication::FindJavaClass("com/epicgames/unreal/FirebaseHelper");
 		if (FirebaseHelperClass)
@@ -572,6 +676,7 @@ void UFirebaseAuth::UpdatePassword(const FString& NewPassword, const FOnFirebase
 			if (UpdateMethod)
 			{
 				Env->CallStaticVoidMethod(FirebaseHelperClass, UpdateMethod, jPassword, jOperationId);
+				FFirebaseTrace::Stage(EFirebaseTraceOrigin::Jni, OperationId, EFirebaseTraceStage::Sent);
 			}
 			Env->DeleteLocalRef(FirebaseHelperClass);
 		}
@@ -592,13 +697,19 @@ void UFirebaseAuth::UpdatePassword(const FString& NewPassword, const FOnFirebase
 void UFirebaseAuth::UpdateDisplayName(const FString& DisplayName, const FOnFirebaseAuthComplete& OnComplete)
 {
 #if PLATFORM_ANDROID
-	FString OperationId = GenerateOperationId();
-	RegisterCallback(OperationId, OnComplete);
+	const int64 OperationId = RegisterCallback(OnComplete);
+	if (OperationId == PendingOperations.InvalidId)
+	{
+		return;
+	}
+
+	FFirebaseTrace::Request(EFirebaseTraceOrigin::Jni, OperationId, TEXT("UpdateDisplayName"), FStringView(), 0);
+	FFirebaseTrafficRecorder::Get().Record(EFirebaseTrafficOp::Auth, TEXT("UpdateDisplayName"), 0);
 
 	if (JNIEnv* Env = FAndroidApplication::GetJavaEnv())
 	{
 		jstring jDisplayName = Env->NewStringUTF(TCHAR_TO_UTF8(*DisplayName));
-		jstring jOperationId = Env->NewStringUTF(TCHAR_TO_UTF8(*OperationId));
+		jstring jOperationId = Env->NewStringUTF(TCHAR_TO_UTF8(*LexToString(OperationId)));
 
 		jclass FirebaseHelperClass = FAndroidApplication::FindJavaClass("com/epicgames/unreal/FirebaseHelper");
 		if (FirebaseHelperClass)
@@ -608,6 +719,7 @@ void UFirebaseAuth::UpdateDisplayName(const FString& DisplayName, const FOnFireb
 			if (UpdateMethod)
 			{
 				Env->CallStaticVoidMethod(FirebaseHelperClass, UpdateMethod, jDisplayName, jOperationId);
+				FFirebaseTrace::Stage(EFirebaseTraceOrigin::Jni, OperationId, EFirebaseTraceStage::Sent);
 			}
 			Env->DeleteLocalRef(FirebaseHelperClass);
 		}
@@ -626,12 +738,18 @@ void UFirebaseAuth::UpdateDisplayName(const FString& DisplayName, const FOnFireb
 void UFirebaseAuth::DeleteUserAccount(const FOnFirebaseAuthComplete& OnComplete)
 {
 #if PLATFORM_ANDROID
-	FString OperationId = GenerateOperationId();
-	RegisterCallback(OperationId, OnComplete);
+	const int64 OperationId = RegisterCallback(OnComplete);
+	if (OperationId == PendingOperations.InvalidId)
+	{
+		return;
+	}
+
+	FFirebaseTrace::Request(EFirebaseTraceOrigin::Jni, OperationId, TEXT("DeleteUserAccount"), FStringView(), 0);
+	FFirebaseTrafficRecorder::Get().Record(EFirebaseTrafficOp::Auth, TEXT("DeleteUserAccount"), 0);
 
 	if (JNIEnv* Env = FAndroidApplication::GetJavaEnv())
 	{
-		jstring jOperationId = Env->NewStringUTF(TCHAR_TO_UTF8(*OperationId));
+		jstring jOperationId = Env->NewStringUTF(TCHAR_TO_UTF8(*LexToString(OperationId)));
 
 		jclass FirebaseHelperClass = FAndroidApplication::FindJavaClass("com/epicgames/unreal/FirebaseHelper");
 		if (FirebaseHelperClass)
@@ -641,6 +759,7 @@ void UFirebaseAuth::DeleteUserAccount(const FOnFirebaseAuthComplete& OnComplete)
 			if (DeleteMethod)
 			{
 				Env->CallStaticVoidMethod(FirebaseHelperClass, DeleteMethod, jOperationId);
+				FFirebaseTrace::Stage(EFirebaseTraceOrigin::Jni, OperationId, EFirebaseTraceStage::Sent);
 			}
 			Env->DeleteLocalRef(FirebaseHelperClass);
 		}
@@ -657,12 +776,18 @@ void UFirebaseAuth::DeleteUserAccount(const FOnFirebaseAuthComplete& OnComplete)
 
 // === CALLBACK HANDLER ===
 
-void UFirebaseAuth::OnAuthResultReceived(bool bSuccess, const FString& UserId, 
+void UFirebaseAuth::OnAuthResultReceived(int64 OperationId, bool bSuccess, const FString& UserId, 
 	const FString& Email, const FString& DisplayName, 
 	const FString& ErrorMessage, const FString& AuthToken)
 {
-	// Extract operation ID from the error message or use a different mechanism
-	// For now, we'll call all pending callbacks
+	FOnFirebaseAuthComplete Callback;
+	if (!PendingOperations.Complete(OperationId, Callback))
+	{
+		// Unbound callback, or the result arrived after the operation timed out
+		UE_LOG(LogFirebase, Verbose, TEXT("Firebase Auth: Ignoring result for unknown operation %lld"), OperationId);
+		return;
+	}
+
 	FFirebaseAuthResult Result;
 	Result.bSuccess = bSuccess;
 	Result.UserId = UserId;
@@ -671,20 +796,18 @@ void UFirebaseAuth::OnAuthResultReceived(bool bSuccess, const FString& UserId,
 	Result.ErrorMessage = ErrorMessage;
 	Result.AuthToken = AuthToken;
 
-	// Execute all pending callbacks (we'll need to improve this with proper operation ID tracking)
-	for (auto& Pair : PendingCallbacks)
 	{
-		Pair.Value.ExecuteIfBound(Result);
+		FIREBASE_TRACE_CALLBACK_SCOPE(EFirebaseTraceOrigin::Jni, OperationId);
+		Callback.ExecuteIfBound(Result);
 	}
-	PendingCallbacks.Empty();
 
 	if (bSuccess)
 	{
-		UE_LOG(LogTemp, Log, TEXT("Firebase Auth: Operation successful - User: %s"), *UserId);
+		UE_LOG(LogFirebase, Verbose, TEXT("Firebase Auth: Operation successful - User: %s"), *UserId);
 	}
 	else
 	{
-		UE_LOG(LogTemp, Error, TEXT("Firebase Auth: Operation failed - %s"), *ErrorMessage);
+		UE_LOG(LogFirebase, Error, TEXT("Firebase Auth: Operation failed - %s"), *ErrorMessage);
 	}
 }
 
@@ -692,10 +815,15 @@ void UFirebaseAuth::OnAuthResultReceived(bool bSuccess, const FString& UserId,
 
 #if PLATFORM_ANDROID
 extern "C" JNIEXPORT void JNICALL Java_com_epicgames_unreal_FirebaseHelper_nativeOnAuthResult(
-	JNIEnv* env, jclass clazz, jboolean success, jstring userId, jstring email, 
+	JNIEnv* env, jclass clazz, jstring operationId, jboolean success, jstring userId, jstring email, 
 	jstring displayName, jstring errorMessage, jstring authToken)
 {
+	LLM_SCOPE_BYTAG(Firebase_Transport);
 	bool bSuccess = (bool)success;
+
+	const char* operationIdChars = env->GetStringUTFChars(operationId, nullptr);
+	int64 OperationId = FCStringAnsi::Atoi64(operationIdChars);
+	env->ReleaseStringUTFChars(operationId, operationIdChars);
 	
 	const char* userIdChars = env->GetStringUTFChars(userId, nullptr);
 	FString UserIdStr = FString(UTF8_TO_TCHAR(userIdChars));
@@ -717,10 +845,12 @@ extern "C" JNIEXPORT void JNICALL Java_com_epicgames_unreal_FirebaseHelper_nativ
 	FString TokenStr = FString(UTF8_TO_TCHAR(tokenChars));
 	env->ReleaseStringUTFChars(authToken, tokenChars);
 
+	FFirebaseTrace::Stage(EFirebaseTraceOrigin::Jni, OperationId, EFirebaseTraceStage::Complete, 0, bSuccess ? 200 : 0);
+
 	// Call on game thread
-	AsyncTask(ENamedThreads::GameThread, [bSuccess, UserIdStr, EmailStr, DisplayNameStr, ErrorStr, TokenStr]()
+	AsyncTask(ENamedThreads::GameThread, [OperationId, bSuccess, UserIdStr, EmailStr, DisplayNameStr, ErrorStr, TokenStr]()
 	{
-		UFirebaseAuth::OnAuthResultReceived(bSuccess, UserIdStr, EmailStr, DisplayNameStr, ErrorStr, TokenStr);
+		UFirebaseAuth::OnAuthResultReceived(OperationId, bSuccess, UserIdStr, EmailStr, DisplayNameStr, ErrorStr, TokenStr);
 	});
 }
 #endif
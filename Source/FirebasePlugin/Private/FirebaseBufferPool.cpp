@@ -0,0 +1,131 @@
+// Copyright. All Rights Reserved.
+
+#include "FirebaseBufferPool.h"
+#include "FirebaseMemory.h"
+
+FFirebaseBufferPool& FFirebaseBufferPool::Get()
+{
+	static FFirebaseBufferPool Pool;
+	return Pool;
+}
+
+FFirebaseBufferPool::FFirebaseBufferPool()
+{
+	Stats.MaxPooledBytes = 4 * 1024 * 1024;
+}
+
+int32 FFirebaseBufferPool::GetAcquireClass(int32 Size)
+{
+	if (Size > (1 << MaxClassShift))
+	{
+		return INDEX_NONE;
+	}
+	const int32 Shift = Size <= (1 << MinClassShift) ? MinClassShift : int32(FMath::CeilLogTwo(uint32(Size)));
+	return Shift - MinClassShift;
+}
+
+int32 FFirebaseBufferPool::GetReleaseClass(int32 Capacity)
+{
+	if (Capacity < (1 << MinClassShift))
+	{
+		return INDEX_NONE;
+	}
+	const int32 Shift = FMath::Min(int32(FMath::FloorLog2(uint32(Capacity))), MaxClassShift);
+	return Shift - MinClassShift;
+}
+
+TArray<uint8> FFirebaseBufferPool::Acquire(int32 MinCapacity)
+{
+	MinCapacity = FMath::Max(MinCapacity, 0);
+	const int32 Class = GetAcquireClass(MinCapacity);
+	{
+		FScopeLock ScopeLock(&Lock);
+		++Stats.Acquired;
+		if (Class != INDEX_NONE && FreeBuffers[Class].Num() > 0)
+		{
+			TArray<uint8> Buffer = FreeBuffers[Class].Pop();
+			++Stats.Reused;
+			--Stats.PooledBuffers;
+			Stats.PooledBytes -= Buffer.Max();
+			FFirebaseMemory::Get().Release(EFirebaseMemoryCategory::Buffers, Buffer.Max());
+			return Buffer;
+		}
+		++Stats.Allocated;
+	}
+
+	LLM_SCOPE_BYTAG(Firebase_Buffers);
+
+	// Allocate the full class size so the buffer can be reused for anything in its class
+	TArray<uint8> Buffer;
+	Buffer.Reserve(Class != INDEX_NONE ? 1 << (Class + MinClassShift) : MinCapacity);
+	return Buffer;
+}
+
+void FFirebaseBufferPool::Release(TArray<uint8>&& Buffer)
+{
+	const int32 Class = GetReleaseClass(Buffer.Max());
+
+	FScopeLock ScopeLock(&Lock);
+	if (Class == INDEX_NONE || Stats.PooledBytes + Buffer.Max() > Stats.MaxPooledBytes
+		|| !FFirebaseMemory::Get().TryReserve(EFirebaseMemoryCategory::Buffers, Buffer.Max()))
+	{
+		++Stats.Discarded;
+		Buffer.Empty();
+		return;
+	}
+
+	Buffer.Reset();
+	++Stats.Recycled;
+	++Stats.PooledBuffers;
+	Stats.PooledBytes += Buffer.Max();
+	FreeBuffers[Class].Add(MoveTemp(Buffer));
+}
+
+void FFirebaseBufferPool::SetMaxPooledBytes(int64 InMaxPooledBytes)
+{
+	FScopeLock ScopeLock(&Lock);
+	Stats.MaxPooledBytes = FMath::Max<int64>(InMaxPooledBytes, 0);
+	TrimTo(Stats.MaxPooledBytes);
+}
+
+void FFirebaseBufferPool::Trim()
+{
+	FScopeLock ScopeLock(&Lock);
+	for (TArray<TArray<uint8>>& Buffers : FreeBuffers)
+	{
+		Buffers.Empty();
+	}
+	FFirebaseMemory::Get().Release(EFirebaseMemoryCategory::Buffers, Stats.PooledBytes);
+	Stats.PooledBuffers = 0;
+	Stats.PooledBytes = 0;
+}
+
+int64 FFirebaseBufferPool::Evict(int64 Bytes)
+{
+	FScopeLock ScopeLock(&Lock);
+	const int64 Before = Stats.PooledBytes;
+	TrimTo(Before - FMath::Max<int64>(Bytes, 0));
+	return Before - Stats.PooledBytes;
+}
+
+void FFirebaseBufferPool::TrimTo(int64 MaxBytes)
+{
+	// Large buffers are the rarest to reuse, so they go first
+	for (int32 Class = NumClasses - 1; Class >= 0 && Stats.PooledBytes > MaxBytes; --Class)
+	{
+		TArray<TArray<uint8>>& Buffers = FreeBuffers[Class];
+		while (Buffers.Num() > 0 && Stats.PooledBytes > MaxBytes)
+		{
+			Stats.PooledBytes -= Buffers.Last().Max();
+			FFirebaseMemory::Get().Release(EFirebaseMemoryCategory::Buffers, Buffers.Last().Max());
+			--Stats.PooledBuffers;
+			Buffers.Pop();
+		}
+	}
+}
+
+FFirebaseBufferPoolStats FFirebaseBufferPool::GetStats() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return Stats;
+}
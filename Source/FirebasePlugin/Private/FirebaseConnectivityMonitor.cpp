@@ -0,0 +1,98 @@
+// Copyright. All Rights Reserved.
+
+#include "FirebaseConnectivityMonitor.h"
+#include "FirebaseLog.h"
+
+void FFirebaseConnectivityMonitor::Configure(int32 InFailuresBeforeOffline, float InProbeIntervalSeconds, float InMaxProbeIntervalSeconds)
+{
+	FailuresBeforeOffline = FMath::Max(InFailuresBeforeOffline, 1);
+	ProbeIntervalSeconds = FMath::Max(InProbeIntervalSeconds, 0.1f);
+	MaxProbeIntervalSeconds = FMath::Max(InMaxProbeIntervalSeconds, ProbeIntervalSeconds);
+	CurrentProbeIntervalSeconds = ProbeIntervalSeconds;
+}
+
+void FFirebaseConnectivityMonitor::ReportResponse(double Now)
+{
+	ConsecutiveFailures = 0;
+	SetState(EState::Online, Now);
+}
+
+void FFirebaseConnectivityMonitor::ReportNetworkFailure(double Now)
+{
+	if (++ConsecutiveFailures >= FailuresBeforeOffline)
+	{
+		SetState(EState::Offline, Now);
+	}
+}
+
+void FFirebaseConnectivityMonitor::SetManualOffline(bool bOffline)
+{
+	const bool bWasConnected = IsConnected();
+	bManualOffline = bOffline;
+
+	if (!bOffline && State != EState::Online)
+	{
+		// Coming back from GoOffline: check the connection right away, with or without auto-reconnect
+		NextProbeTime = 0.0;
+		LastProbeTime = 0.0;
+		bProbeRequested = true;
+		CurrentProbeIntervalSeconds = ProbeIntervalSeconds;
+	}
+
+	BroadcastIfChanged(bWasConnected);
+}
+
+bool FFirebaseConnectivityMonitor::ShouldProbe(double Now, bool bPeriodic) const
+{
+	if (bManualOffline || State == EState::Online)
+	{
+		return false;
+	}
+	if (bProbeRequested && Now >= LastProbeTime + ProbeIntervalSeconds)
+	{
+		return true;
+	}
+	return bPeriodic && Now >= NextProbeTime;
+}
+
+void FFirebaseConnectivityMonitor::OnProbeSent(double Now)
+{
+	bProbeRequested = false;
+	LastProbeTime = Now;
+	NextProbeTime = Now + CurrentProbeIntervalSeconds;
+	CurrentProbeIntervalSeconds = FMath::Min(CurrentProbeIntervalSeconds * 2.0f, MaxProbeIntervalSeconds);
+}
+
+void FFirebaseConnectivityMonitor::SetState(EState NewState, double Now)
+{
+	if (State == NewState)
+	{
+		return;
+	}
+
+	const bool bWasConnected = IsConnected();
+	State = NewState;
+
+	if (State == EState::Offline)
+	{
+		// Start probing with the shortest interval
+		CurrentProbeIntervalSeconds = ProbeIntervalSeconds;
+		NextProbeTime = Now + CurrentProbeIntervalSeconds;
+	}
+	else if (State == EState::Online)
+	{
+		bProbeRequested = false;
+	}
+
+	UE_LOG(LogFirebase, Log, TEXT("Firebase: Connection is %s"), State == EState::Online ? TEXT("online") : TEXT("offline"));
+	BroadcastIfChanged(bWasConnected);
+}
+
+void FFirebaseConnectivityMonitor::BroadcastIfChanged(bool bWasConnected)
+{
+	const bool bIsConnected = IsConnected();
+	if (bIsConnected != bWasConnected)
+	{
+		ConnectivityChangedEvent.Broadcast(bIsConnected);
+	}
+}
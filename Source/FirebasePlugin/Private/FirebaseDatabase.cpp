@@ -1,41 +1,146 @@
 // Copyright. All Rights Reserved.
 
 #include "FirebaseDatabase.h"
+#include "FirebaseLog.h"
 #include "FirebaseSettings.h"
 #include "FirebaseAuth.h"
+#include "FirebaseJsonPath.h"
+#include "FirebaseJsonWriter.h"
+#include "FirebaseJsonBuilder.h"
+#include "FirebaseMemory.h"
+#include "FirebaseStructCodec.h"
+#include "FirebaseTrace.h"
+#include "FirebaseTrafficRecorder.h"
 #include "Json.h"
 #include "JsonUtilities.h"
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
+#include "Tasks/Task.h"
+#include "UObject/StructOnScope.h"
 
 #if PLATFORM_ANDROID
 #include "Android/AndroidJNI.h"
 #include "Android/AndroidApplication.h"
+
+namespace
+{
+	/** FString and Java strings are both UTF-16 on Android, so JSON bodies are handed over without transcoding */
+	jstring NewJavaStringFromUtf16(JNIEnv* Env, const FString& Text)
+	{
+		static_assert(sizeof(TCHAR) == sizeof(jchar), "TCHAR must be UTF-16 on Android");
+		return Env->NewString(reinterpret_cast<const jchar*>(*Text), Text.Len());
+	}
+
+	/** Copy a Java string's UTF-16 chars straight into an FString */
+	FString FStringFromJavaUtf16(JNIEnv* Env, jstring Text)
+	{
+		if (!Text)
+		{
+			return FString();
+		}
+
+		const jsize Length = Env->GetStringLength(Text);
+		const jchar* Chars = Env->GetStringChars(Text, nullptr);
+		FString Result(Length, reinterpret_cast<const TCHAR*>(Chars));
+		Env->ReleaseStringChars(Text, Chars);
+		return Result;
+	}
+}
 #endif
 
 // Initialize static members
-TMap<FString, FOnFirebaseDatabaseComplete> UFirebaseDatabase::PendingCallbacks;
+TFirebasePendingOperations<FFirebasePendingDatabaseOperation> UFirebaseDatabase::PendingOperations;
+FTSTicker::FDelegateHandle UFirebaseDatabase::PendingOperationsTicker;
 TMap<FString, FOnFirebaseDatabaseValueChanged> UFirebaseDatabase::ValueListeners;
-int32 UFirebaseDatabase::CurrentOperationId = 0;
 UFirebaseRestAPI* UFirebaseDatabase::RestAPIInstance = nullptr;
+TArray<FOnFirebaseConnectionStateChanged> UFirebaseDatabase::ConnectionStateListeners;
+
+namespace FirebaseListeners
+{
+	/** Estimated bytes a value listener keeps registered */
+	static int64 GetValueListenerBytes(const FString& Path)
+	{
+		return sizeof(TPair<FString, FOnFirebaseDatabaseValueChanged>) + (Path.Len() + 1) * sizeof(TCHAR);
+	}
+
+	static constexpr int64 ConnectionListenerBytes = sizeof(FOnFirebaseConnectionStateChanged);
+}
+
+int64 UFirebaseDatabase::RegisterCallback(const FOnFirebaseDatabaseComplete& Callback, const FString& Path)
+{
+	if (!Callback.IsBound())
+	{
+		// Nobody waits for the result, so there is nothing to track
+		return PendingOperations.AllocateId();
+	}
+
+	if (const UFirebaseSettings* Settings = GetDefault<UFirebaseSettings>())
+	{
+		PendingOperations.Configure(Settings->MaxPendingOperations, Settings->PendingOperationTimeoutSeconds);
+	}
+
+	FFirebasePendingDatabaseOperation Operation;
+	Operation.Callback = Callback;
+	Operation.Path = Path;
+
+	const int64 OperationId = PendingOperations.Add(Operation, FPlatformTime::Seconds());
+	if (OperationId == PendingOperations.InvalidId)
+	{
+		UE_LOG(LogFirebase, Error, TEXT("Firebase Database: Too many pending operations - Path: %s"), *Path);
+		FFirebaseDatabaseResult Result;
+		Result.bSuccess = false;
+		Result.Path = Path;
+		Result.ErrorMessage = TEXT("Too many pending operations");
+		Callback.ExecuteIfBound(Result);
+		return PendingOperations.InvalidId;
+	}
+
+	if (!PendingOperationsTicker.IsValid())
+	{
+		PendingOperationsTicker = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateStatic(&UFirebaseDatabase::TickPendingOperations), 0.25f);
+	}
 
-FString UFirebaseDatabase::GenerateOperationId()
+	return OperationId;
+}
+
+int32 UFirebaseDatabase::GetPendingOperationCount()
 {
-	return FString::Printf(TEXT("DB_%d"), ++CurrentOperationId);
+	return PendingOperations.Num();
 }
 
-void UFirebaseDatabase::RegisterCallback(const FString& OperationId, const FOnFirebaseDatabaseComplete& Callback)
+bool UFirebaseDatabase::TickPendingOperations(float DeltaTime)
 {
-	if (Callback.IsBound())
+	TArray<TPair<int64, FFirebasePendingDatabaseOperation>> Expired;
+	PendingOperations.CollectExpired(FPlatformTime::Seconds(), Expired);
+
+	for (const TPair<int64, FFirebasePendingDatabaseOperation>& Pair : Expired)
+	{
+		UE_LOG(LogFirebase, Error, TEXT("Firebase Database: Operation %lld timed out - Path: %s"), Pair.Key, *Pair.Value.Path);
+		FFirebaseDatabaseResult Result;
+		Result.bSuccess = false;
+		Result.Path = Pair.Value.Path;
+		Result.ErrorMessage = TEXT("Operation timed out");
+		Pair.Value.Callback.ExecuteIfBound(Result);
+	}
+
+	if (PendingOperations.Num() == 0)
 	{
-		PendingCallbacks.Add(OperationId, Callback);
+		PendingOperationsTicker.Reset();
+		return false;
 	}
+	return true;
 }
 
 void UFirebaseDatabase::RegisterListener(const FString& Path, const FOnFirebaseDatabaseValueChanged& Listener)
 {
 	if (Listener.IsBound())
 	{
+		LLM_SCOPE_BYTAG(Firebase_Listeners);
+		if (!ValueListeners.Contains(Path))
+		{
+			FFirebaseMemory::Get().Add(EFirebaseMemoryCategory::Listeners, FirebaseListeners::GetValueListenerBytes(Path));
+		}
 		ValueListeners.Add(Path, Listener);
 	}
 }
@@ -68,12 +173,124 @@ UFirebaseRestAPI* UFirebaseDatabase::GetRestAPI()
 				Settings->ProjectId,
 				Settings->GetFullDatabaseUrl()
 			);
+			RestAPIInstance->ConfigureFromSettings(Settings);
 		}
+
+		// This instance owns the database connection state
+		RestAPIInstance->OnConnectivityChanged().AddStatic(&UFirebaseDatabase::OnRestConnectivityChanged);
+		RestAPIInstance->StartConnectivityMonitoring();
+
+		// Polling listeners pick up the current token on every poll
+		RestAPIInstance->SetAuthTokenProvider(FFirebaseRestTokenProvider::CreateStatic(&UFirebaseDatabase::GetRestAuthToken));
 	}
 	
 	return RestAPIInstance;
 }
 
+FFirebaseRestPayloadCallback UFirebaseDatabase::MakeRestResultCallback(const FOnFirebaseDatabaseComplete& OnComplete, const FString& Path)
+{
+	return FFirebaseRestPayloadCallback::CreateLambda([OnComplete, Path](bool bSuccess, const FFirebasePayload& Response)
+	{
+		// Runs inside the REST completion callback, so its request is the current one
+		const uint64 TraceId = FFirebaseTrace::GetCurrentRequestId();
+
+		FFirebaseDatabaseResult Result;
+		Result.bSuccess = bSuccess;
+		Result.Path = Path;
+		Result.Payload = Response;
+
+		const UFirebaseSettings* Settings = GetDefault<UFirebaseSettings>();
+		if (bSuccess && Settings && Settings->bParseResponsesOffGameThread)
+		{
+			// Parse and transcode on a worker; the game thread only runs the delegate
+			UE::Tasks::Launch(UE_SOURCE_LOCATION, [OnComplete, TraceId, Result = MoveTemp(Result)]() mutable
+			{
+				Result.Document = FFirebaseJsonDocument::Parse(Result.Payload);
+				Result.Document->GetValue(); // Build the typed tree here too, not on the first Blueprint read
+				Result.Data = Result.Payload.ToString();
+				FFirebaseTrace::Stage(EFirebaseTraceOrigin::Rest, TraceId, EFirebaseTraceStage::Parsed, Result.Payload.Num());
+
+				AsyncTask(ENamedThreads::GameThread, [OnComplete, TraceId, Result = MoveTemp(Result)]()
+				{
+					FIREBASE_TRACE_CALLBACK_SCOPE(EFirebaseTraceOrigin::Rest, TraceId);
+					OnComplete.ExecuteIfBound(Result);
+				});
+			});
+			return;
+		}
+
+		// Blueprint delegates need an FString; this is the only conversion of the body
+		Result.Data = Response.ToString();
+		FFirebaseTrace::Stage(EFirebaseTraceOrigin::Rest, TraceId, EFirebaseTraceStage::Parsed, Response.Num());
+
+		if (!bSuccess)
+		{
+			Result.ErrorMessage = Result.Data;
+		}
+
+		// Execute callback on game thread
+		AsyncTask(ENamedThreads::GameThread, [OnComplete, TraceId, Result = MoveTemp(Result)]()
+		{
+			FIREBASE_TRACE_CALLBACK_SCOPE(EFirebaseTraceOrigin::Rest, TraceId);
+			OnComplete.ExecuteIfBound(Result);
+		});
+	});
+}
+
+FFirebaseRestPayloadCallback UFirebaseDatabase::MakeRawResultCallback(const FOnFirebaseDatabaseRawComplete& OnComplete)
+{
+	return FFirebaseRestPayloadCallback::CreateLambda([OnComplete](bool bSuccess, const FFirebasePayload& Response)
+	{
+		const uint64 TraceId = FFirebaseTrace::GetCurrentRequestId();
+		AsyncTask(ENamedThreads::GameThread, [OnComplete, bSuccess, Response, TraceId]()
+		{
+			FIREBASE_TRACE_CALLBACK_SCOPE(EFirebaseTraceOrigin::Rest, TraceId);
+			OnComplete.ExecuteIfBound(bSuccess, Response);
+		});
+	});
+}
+
+UFirebaseRestAPI* UFirebaseDatabase::GetRestAPIForRawRequest(const FOnFirebaseDatabaseRawComplete& OnComplete)
+{
+	UFirebaseRestAPI* RestAPI = ShouldUseRestAPI() ? GetRestAPI() : nullptr;
+	if (!RestAPI)
+	{
+		UE_LOG(LogFirebase, Warning, TEXT("Firebase Database: Raw payload requests require the REST API"));
+		OnComplete.ExecuteIfBound(false, FFirebasePayload::FromString(TEXT("Platform not supported")));
+	}
+	return RestAPI;
+}
+
+FString UFirebaseDatabase::GetRestAuthToken()
+{
+	UFirebaseRestAPI* AuthAPI = UFirebaseAuth::GetRestAPI();
+	return AuthAPI && IsValid(AuthAPI) ? AuthAPI->GetIdToken() : FString();
+}
+
+void UFirebaseDatabase::SetValueRaw(const FString& Path, const FFirebasePayload& JsonData, const FOnFirebaseDatabaseRawComplete& OnComplete)
+{
+	if (UFirebaseRestAPI* RestAPI = GetRestAPIForRawRequest(OnComplete))
+	{
+		RestAPI->SetValue(Path, JsonData, GetRestAuthToken(), MakeRawResultCallback(OnComplete));
+	}
+}
+
+void UFirebaseDatabase::UpdateValueRaw(const FString& Path, const FFirebasePayload& JsonData, const FOnFirebaseDatabaseRawComplete& OnComplete)
+{
+	if (UFirebaseRestAPI* RestAPI = GetRestAPIForRawRequest(OnComplete))
+	{
+		RestAPI->UpdateValue(Path, JsonData, GetRestAuthToken(), MakeRawResultCallback(OnComplete));
+	}
+}
+
+void UFirebaseDatabase::GetValueRaw(const FString& Path, const FOnFirebaseDatabaseRawComplete& OnComplete)
+{
+	if (UFirebaseRestAPI* RestAPI = GetRestAPIForRawRequest(OnComplete))
+	{
+		RestAPI->GetValue(Path, GetRestAuthToken(), MakeRawResultCallback(OnComplete));
+	}
+}
+
 // === WRITE OPERATIONS ===
 
 void UFirebaseDatabase::SetValue(const FString& Path, const FString& JsonData, 
@@ -85,7 +302,7 @@ void UFirebaseDatabase::SetValue(const FString& Path, const FString& JsonData,
 		UFirebaseRestAPI* RestAPI = GetRestAPI();
 		if (!RestAPI)
 		{
-			UE_LOG(LogTemp, Error, TEXT("Firebase Database: Failed to initialize REST API"));
+			UE_LOG(LogFirebase, Error, TEXT("Firebase Database: Failed to initialize REST API"));
 			FFirebaseDatabaseResult Result;
 			Result.bSuccess = false;
 			Result.Path = Path;
@@ -102,37 +319,26 @@ void UFirebaseDatabase::SetValue(const FString& Path, const FString& JsonData,
 			AuthToken = AuthAPI->GetIdToken();
 		}
 		
-		RestAPI->SetValue(Path, JsonData, AuthToken,
-			FFirebaseRestCallback::CreateLambda([OnComplete, Path](bool bSuccess, const FString& Response)
-		{
-			FFirebaseDatabaseResult Result;
-			Result.bSuccess = bSuccess;
-			Result.Path = Path;
-			Result.Data = Response;
-			
-			if (!bSuccess)
-			{
-				Result.ErrorMessage = Response;
-			}
-			
-			// Execute callback on game thread
-			AsyncTask(ENamedThreads::GameThread, [OnComplete, Result]()
-			{
-				OnComplete.ExecuteIfBound(Result);
-			});
-		}));
+		RestAPI->SetValue(Path, FFirebasePayload::FromString(JsonData), AuthToken,
+			MakeRestResultCallback(OnComplete, Path));
 		return;
 	}
 
 #if PLATFORM_ANDROID
-	FString OperationId = GenerateOperationId();
-	RegisterCallback(OperationId, OnComplete);
+	const int64 OperationId = RegisterCallback(OnComplete, Path);
+	if (OperationId == PendingOperations.InvalidId)
+	{
+		return;
+	}
+
+	FFirebaseTrace::Request(EFirebaseTraceOrigin::Jni, OperationId, TEXT("SetValue"), Path, JsonData.Len() * sizeof(UTF16CHAR));
+	FFirebaseTrafficRecorder::Get().Record(EFirebaseTrafficOp::Set, Path, JsonData.Len() * sizeof(UTF16CHAR));
 
 	if (JNIEnv* Env = FAndroidApplication::GetJavaEnv())
 	{
 		jstring jPath = Env->NewStringUTF(TCHAR_TO_UTF8(*Path));
-		jstring jData = Env->NewStringUTF(TCHAR_TO_UTF8(*JsonData));
-		jstring jOperationId = Env->NewStringUTF(TCHAR_TO_UTF8(*OperationId));
+		jstring jData = NewJavaStringFromUtf16(Env, JsonData);
+		jstring jOperationId = Env->NewStringUTF(TCHAR_TO_UTF8(*LexToString(OperationId)));
 
 		jclass FirebaseHelperClass = FAndroidApplication::FindJavaClass("com/epicgames/unreal/FirebaseHelper");
 		if (FirebaseHelperClass)
@@ -142,6 +348,7 @@ void UFirebaseDatabase::SetValue(const FString& Path, const FString& JsonData,
 			if (SetValueMethod)
 			{
 				Env->CallStaticVoidMethod(FirebaseHelperClass, SetValueMethod, jPath, jData, jOperationId);
+				FFirebaseTrace::Stage(EFirebaseTraceOrigin::Jni, OperationId, EFirebaseTraceStage::Sent);
 			}
 			Env->DeleteLocalRef(FirebaseHelperClass);
 		}
@@ -151,7 +358,7 @@ void UFirebaseDatabase::SetValue(const FString& Path, const FString& JsonData,
 		Env->DeleteLocalRef(jOperationId);
 	}
 #else
-	UE_LOG(LogTemp, Warning, TEXT("Firebase Database: SetValue not available"));
+	UE_LOG(LogFirebase, Warning, TEXT("Firebase Database: SetValue not available"));
 	FFirebaseDatabaseResult Result;
 	Result.bSuccess = false;
 	Result.ErrorMessage = TEXT("Platform not supported");
@@ -171,38 +378,27 @@ void UFirebaseDatabase::UpdateValue(const FString& Path, const FString& JsonData
 			// Get auth token from FirebaseAuth
 			FString AuthToken = UFirebaseAuth::GetRestAPI() ? UFirebaseAuth::GetRestAPI()->GetIdToken() : TEXT("");
 			
-			RestAPI->UpdateValue(Path, JsonData, AuthToken,
-				FFirebaseRestCallback::CreateLambda([OnComplete, Path](bool bSuccess, const FString& Response)
-			{
-				FFirebaseDatabaseResult Result;
-				Result.bSuccess = bSuccess;
-				Result.Path = Path;
-				Result.Data = Response;
-				
-				if (!bSuccess)
-				{
-					Result.ErrorMessage = Response;
-				}
-				
-				// Execute callback on game thread
-				AsyncTask(ENamedThreads::GameThread, [OnComplete, Result]()
-				{
-					OnComplete.ExecuteIfBound(Result);
-				});
-			}));
+			RestAPI->UpdateValue(Path, FFirebasePayload::FromString(JsonData), AuthToken,
+				MakeRestResultCallback(OnComplete, Path));
 		}
 		return;
 	}
 
 #if PLATFORM_ANDROID
-	FString OperationId = GenerateOperationId();
-	RegisterCallback(OperationId, OnComplete);
+	const int64 OperationId = RegisterCallback(OnComplete, Path);
+	if (OperationId == PendingOperations.InvalidId)
+	{
+		return;
+	}
+
+	FFirebaseTrace::Request(EFirebaseTraceOrigin::Jni, OperationId, TEXT("UpdateValue"), Path, JsonData.Len() * sizeof(UTF16CHAR));
+	FFirebaseTrafficRecorder::Get().Record(EFirebaseTrafficOp::Update, Path, JsonData.Len() * sizeof(UTF16CHAR));
 
 	if (JNIEnv* Env = FAndroidApplication::GetJavaEnv())
 	{
 		jstring jPath = Env->NewStringUTF(TCHAR_TO_UTF8(*Path));
-		jstring jData = Env->NewStringUTF(TCHAR_TO_UTF8(*JsonData));
-		jstring jOperationId = Env->NewStringUTF(TCHAR_TO_UTF8(*OperationId));
+		jstring jData = NewJavaStringFromUtf16(Env, JsonData);
+		jstring jOperationId = Env->NewStringUTF(TCHAR_TO_UTF8(*LexToString(OperationId)));
 
 		jclass FirebaseHelperClass = FAndroidApplication::FindJavaClass("com/epicgames/unreal/FirebaseHelper");
 		if (FirebaseHelperClass)
@@ -212,6 +408,7 @@ void UFirebaseDatabase::UpdateValue(const FString& Path, const FString& JsonData
 			if (UpdateMethod)
 			{
 				Env->CallStaticVoidMethod(FirebaseHelperClass, UpdateMethod, jPath, jData, jOperationId);
+				FFirebaseTrace::Stage(EFirebaseTraceOrigin::Jni, OperationId, EFirebaseTraceStage::Sent);
 			}
 			Env->DeleteLocalRef(FirebaseHelperClass);
 		}
@@ -228,6 +425,209 @@ void UFirebaseDatabase::UpdateValue(const FString& Path, const FString& JsonData
 #endif
 }
 
+namespace
+{
+	void FailOperation(const FString& Path, const TCHAR* Message, const FOnFirebaseDatabaseComplete& OnComplete)
+	{
+		UE_LOG(LogFirebase, Warning, TEXT("Firebase Database: %s (%s)"), Message, *Path);
+		FFirebaseDatabaseResult Result;
+		Result.bSuccess = false;
+		Result.Path = Path;
+		Result.ErrorMessage = Message;
+		OnComplete.ExecuteIfBound(Result);
+	}
+}
+
+void UFirebaseDatabase::SetValuePayload(const FString& Path, const FFirebasePayload& JsonData, 
+	const FOnFirebaseDatabaseComplete& OnComplete)
+{
+	if (ShouldUseRestAPI())
+	{
+		if (UFirebaseRestAPI* RestAPI = GetRestAPI())
+		{
+			RestAPI->SetValue(Path, JsonData, GetRestAuthToken(), MakeRestResultCallback(OnComplete, Path));
+			return;
+		}
+	}
+
+	SetValue(Path, JsonData.ToString(), OnComplete);
+}
+
+void UFirebaseDatabase::UpdateValuePayload(const FString& Path, const FFirebasePayload& JsonData, 
+	const FOnFirebaseDatabaseComplete& OnComplete)
+{
+	if (ShouldUseRestAPI())
+	{
+		if (UFirebaseRestAPI* RestAPI = GetRestAPI())
+		{
+			RestAPI->UpdateValue(Path, JsonData, GetRestAuthToken(), MakeRestResultCallback(OnComplete, Path));
+			return;
+		}
+	}
+
+	UpdateValue(Path, JsonData.ToString(), OnComplete);
+}
+
+void UFirebaseDatabase::SetValueFromBuilder(const FString& Path, UFirebaseJsonBuilder* Builder, 
+	const FOnFirebaseDatabaseComplete& OnComplete)
+{
+	if (!Builder)
+	{
+		FailOperation(Path, TEXT("JSON builder is null"), OnComplete);
+		return;
+	}
+
+	SetValuePayload(Path, Builder->ToPayload(), OnComplete);
+}
+
+void UFirebaseDatabase::UpdateValueFromBuilder(const FString& Path, UFirebaseJsonBuilder* Builder, 
+	const FOnFirebaseDatabaseComplete& OnComplete)
+{
+	if (!Builder)
+	{
+		FailOperation(Path, TEXT("JSON builder is null"), OnComplete);
+		return;
+	}
+
+	UpdateValuePayload(Path, Builder->ToPayload(), OnComplete);
+}
+
+// === STRUCT OPERATIONS ===
+
+void UFirebaseDatabase::SetStruct(const FString& Path, const UScriptStruct* Struct, const void* Data, 
+	const FOnFirebaseDatabaseComplete& OnComplete)
+{
+	if (!Struct || !Data)
+	{
+		FailOperation(Path, TEXT("Set Struct needs a struct value"), OnComplete);
+		return;
+	}
+
+	SetValuePayload(Path, FFirebaseStructCodec::ToPayload(Struct, Data), OnComplete);
+}
+
+void UFirebaseDatabase::UpdateStruct(const FString& Path, const UScriptStruct* Struct, const void* Data, 
+	const FOnFirebaseDatabaseComplete& OnComplete)
+{
+	if (!Struct || !Data)
+	{
+		FailOperation(Path, TEXT("Update Struct needs a struct value"), OnComplete);
+		return;
+	}
+
+	UpdateValuePayload(Path, FFirebaseStructCodec::ToPayload(Struct, Data), OnComplete);
+}
+
+void UFirebaseDatabase::GetStruct(const FString& Path, const UScriptStruct* Struct, 
+	TFunction<void(bool bSuccess, const void* Data, const FString& Error)> OnComplete)
+{
+	check(Struct);
+
+	// Blueprint structs can be unloaded while the request is in flight
+	TWeakObjectPtr<const UScriptStruct> WeakStruct(Struct);
+	GetValueRaw(Path, FOnFirebaseDatabaseRawComplete::CreateLambda(
+		[WeakStruct, OnComplete = MoveTemp(OnComplete)](bool bSuccess, const FFirebasePayload& Data)
+	{
+		const UScriptStruct* Struct = WeakStruct.Get();
+		if (!bSuccess || !Struct)
+		{
+			OnComplete(false, nullptr, bSuccess ? FString(TEXT("Struct type was unloaded")) : Data.ToString());
+			return;
+		}
+
+		FStructOnScope Value(Struct);
+		FString Error;
+		const bool bRead = FFirebaseStructCodec::FromPayload(Struct, Value.GetStructMemory(), Data, &Error);
+		OnComplete(bRead, Value.GetStructMemory(), Error);
+	}));
+}
+
+bool UFirebaseDatabase::GetResultStruct(const FFirebaseDatabaseResult& Result, const UScriptStruct* Struct, void* Data)
+{
+	if (!Struct || !Data || !Result.bSuccess)
+	{
+		return false;
+	}
+
+	FString Error;
+	bool bRead = false;
+	if (Result.Document.IsValid() && Result.Document->GetTape())
+	{
+		// Already parsed on a worker
+		bRead = FFirebaseStructCodec::Read(Struct, Data, Result.Document->GetTape()->GetRoot(), &Error);
+	}
+	else
+	{
+		const FFirebasePayload Payload = Result.Payload.IsEmpty() ? FFirebasePayload::FromString(Result.Data) : Result.Payload;
+		bRead = FFirebaseStructCodec::FromPayload(Struct, Data, Payload, &Error);
+	}
+
+	if (!bRead)
+	{
+		UE_LOG(LogFirebase, Warning, TEXT("Firebase Database: Could not read %s as %s: %s"), *Result.Path, *Struct->GetName(), *Error);
+	}
+	return bRead;
+}
+
+DEFINE_FUNCTION(UFirebaseDatabase::execK2_SetStruct)
+{
+	P_GET_PROPERTY(FStrProperty, Path);
+
+	Stack.MostRecentProperty = nullptr;
+	Stack.MostRecentPropertyAddress = nullptr;
+	Stack.StepCompiledIn<FStructProperty>(nullptr);
+	const FStructProperty* ValueProperty = CastField<FStructProperty>(Stack.MostRecentProperty);
+	const void* ValueData = Stack.MostRecentPropertyAddress;
+
+	P_GET_PROPERTY(FDelegateProperty, OnComplete);
+	P_FINISH;
+
+	P_NATIVE_BEGIN;
+	SetStruct(Path, ValueProperty ? ValueProperty->Struct : nullptr, ValueData, FOnFirebaseDatabaseComplete(OnComplete));
+	P_NATIVE_END;
+}
+
+DEFINE_FUNCTION(UFirebaseDatabase::execK2_UpdateStruct)
+{
+	P_GET_PROPERTY(FStrProperty, Path);
+
+	Stack.MostRecentProperty = nullptr;
+	Stack.MostRecentPropertyAddress = nullptr;
+	Stack.StepCompiledIn<FStructProperty>(nullptr);
+	const FStructProperty* ValueProperty = CastField<FStructProperty>(Stack.MostRecentProperty);
+	const void* ValueData = Stack.MostRecentPropertyAddress;
+
+	P_GET_PROPERTY(FDelegateProperty, OnComplete);
+	P_FINISH;
+
+	P_NATIVE_BEGIN;
+	UpdateStruct(Path, ValueProperty ? ValueProperty->Struct : nullptr, ValueData, FOnFirebaseDatabaseComplete(OnComplete));
+	P_NATIVE_END;
+}
+
+DEFINE_FUNCTION(UFirebaseDatabase::execK2_GetResultStruct)
+{
+	P_GET_STRUCT_REF(FFirebaseDatabaseResult, Result);
+
+	Stack.MostRecentProperty = nullptr;
+	Stack.MostRecentPropertyAddress = nullptr;
+	Stack.StepCompiledIn<FStructProperty>(nullptr);
+	const FStructProperty* ValueProperty = CastField<FStructProperty>(Stack.MostRecentProperty);
+	void* ValueData = Stack.MostRecentPropertyAddress;
+
+	P_FINISH;
+
+	bool bSuccess = false;
+	P_NATIVE_BEGIN;
+	if (ValueProperty && ValueData)
+	{
+		ValueProperty->Struct->ClearScriptStruct(ValueData);
+		bSuccess = GetResultStruct(Result, ValueProperty->Struct, ValueData);
+	}
+	P_NATIVE_END;
+	*(bool*)RESULT_PARAM = bSuccess;
+}
+
 void UFirebaseDatabase::PushValue(const FString& Path, const FString& JsonData, 
 	const FOnFirebaseDatabaseComplete& OnComplete)
 {
@@ -240,38 +640,27 @@ void UFirebaseDatabase::PushValue(const FString& Path, const FString& JsonData,
 			// Get auth token from FirebaseAuth
 			FString AuthToken = UFirebaseAuth::GetRestAPI() ? UFirebaseAuth::GetRestAPI()->GetIdToken() : TEXT("");
 			
-			RestAPI->PushValue(Path, JsonData, AuthToken,
-				FFirebaseRestCallback::CreateLambda([OnComplete, Path](bool bSuccess, const FString& Response)
-			{
-				FFirebaseDatabaseResult Result;
-				Result.bSuccess = bSuccess;
-				Result.Path = Path;
-				Result.Data = Response;
-				
-				if (!bSuccess)
-				{
-					Result.ErrorMessage = Response;
-				}
-				
-				// Execute callback on game thread
-				AsyncTask(ENamedThreads::GameThread, [OnComplete, Result]()
-				{
-					OnComplete.ExecuteIfBound(Result);
-				});
-			}));
+			RestAPI->PushValue(Path, FFirebasePayload::FromString(JsonData), AuthToken,
+				MakeRestResultCallback(OnComplete, Path));
 		}
 		return;
 	}
 
 #if PLATFORM_ANDROID
-	FString OperationId = GenerateOperationId();
-	RegisterCallback(OperationId, OnComplete);
+	const int64 OperationId = RegisterCallback(OnComplete, Path);
+	if (OperationId == PendingOperations.InvalidId)
+	{
+		return;
+	}
+
+	FFirebaseTrace::Request(EFirebaseTraceOrigin::Jni, OperationId, TEXT("PushValue"), Path, JsonData.Len() * sizeof(UTF16CHAR));
+	FFirebaseTrafficRecorder::Get().Record(EFirebaseTrafficOp::Push, Path, JsonData.Len() * sizeof(UTF16CHAR));
 
 	if (JNIEnv* Env = FAndroidApplication::GetJavaEnv())
 	{
 		jstring jPath = Env->NewStringUTF(TCHAR_TO_UTF8(*Path));
-		jstring jData = Env->NewStringUTF(TCHAR_TO_UTF8(*JsonData));
-		jstring jOperationId = Env->NewStringUTF(TCHAR_TO_UTF8(*OperationId));
+		jstring jData = NewJavaStringFromUtf16(Env, JsonData);
+		jstring jOperationId = Env->NewStringUTF(TCHAR_TO_UTF8(*LexToString(OperationId)));
 
 		jclass FirebaseHelperClass = FAndroidApplication::FindJavaClass("com/epicgames/unreal/FirebaseHelper");
 		if (FirebaseHelperClass)
@@ -281,6 +670,7 @@ void UFirebaseDatabase::PushValue(const FString& Path, const FString& JsonData,
 			if (PushMethod)
 			{
 				Env->CallStaticVoidMethod(FirebaseHelperClass, PushMethod, jPath, jData, jOperationId);
+				FFirebaseTrace::Stage(EFirebaseTraceOrigin::Jni, OperationId, EFirebaseTraceStage::Sent);
 			}
 			Env->DeleteLocalRef(FirebaseHelperClass);
 		}
@@ -309,36 +699,25 @@ void UFirebaseDatabase::DeleteValue(const FString& Path, const FOnFirebaseDataba
 			FString AuthToken = UFirebaseAuth::GetRestAPI() ? UFirebaseAuth::GetRestAPI()->GetIdToken() : TEXT("");
 			
 			RestAPI->DeleteValue(Path, AuthToken,
-				FFirebaseRestCallback::CreateLambda([OnComplete, Path](bool bSuccess, const FString& Response)
-			{
-				FFirebaseDatabaseResult Result;
-				Result.bSuccess = bSuccess;
-				Result.Path = Path;
-				Result.Data = Response;
-				
-				if (!bSuccess)
-				{
-					Result.ErrorMessage = Response;
-				}
-				
-				// Execute callback on game thread
-				AsyncTask(ENamedThreads::GameThread, [OnComplete, Result]()
-				{
-					OnComplete.ExecuteIfBound(Result);
-				});
-			}));
+				MakeRestResultCallback(OnComplete, Path));
 		}
 		return;
 	}
 
 #if PLATFORM_ANDROID
-	FString OperationId = GenerateOperationId();
-	RegisterCallback(OperationId, OnComplete);
+	const int64 OperationId = RegisterCallback(OnComplete, Path);
+	if (OperationId == PendingOperations.InvalidId)
+	{
+		return;
+	}
+
+	FFirebaseTrace::Request(EFirebaseTraceOrigin::Jni, OperationId, TEXT("DeleteValue"), Path, 0);
+	FFirebaseTrafficRecorder::Get().Record(EFirebaseTrafficOp::Delete, Path, 0);
 
 	if (JNIEnv* Env = FAndroidApplication::GetJavaEnv())
 	{
 		jstring jPath = Env->NewStringUTF(TCHAR_TO_UTF8(*Path));
-		jstring jOperationId = Env->NewStringUTF(TCHAR_TO_UTF8(*OperationId));
+		jstring jOperationId = Env->NewStringUTF(TCHAR_TO_UTF8(*LexToString(OperationId)));
 
 		jclass FirebaseHelperClass = FAndroidApplication::FindJavaClass("com/epicgames/unreal/FirebaseHelper");
 		if (FirebaseHelperClass)
@@ -348,6 +727,7 @@ void UFirebaseDatabase::DeleteValue(const FString& Path, const FOnFirebaseDataba
 			if (DeleteMethod)
 			{
 				Env->CallStaticVoidMethod(FirebaseHelperClass, DeleteMethod, jPath, jOperationId);
+				FFirebaseTrace::Stage(EFirebaseTraceOrigin::Jni, OperationId, EFirebaseTraceStage::Sent);
 			}
 			Env->DeleteLocalRef(FirebaseHelperClass);
 		}
@@ -377,36 +757,25 @@ void UFirebaseDatabase::GetValue(const FString& Path, const FOnFirebaseDatabaseC
 			FString AuthToken = UFirebaseAuth::GetRestAPI() ? UFirebaseAuth::GetRestAPI()->GetIdToken() : TEXT("");
 			
 			RestAPI->GetValue(Path, AuthToken,
-				FFirebaseRestCallback::CreateLambda([OnComplete, Path](bool bSuccess, const FString& Response)
-			{
-				FFirebaseDatabaseResult Result;
-				Result.bSuccess = bSuccess;
-				Result.Path = Path;
-				Result.Data = Response;
-				
-				if (!bSuccess)
-				{
-					Result.ErrorMessage = Response;
-				}
-				
-				// Execute callback on game thread
-				AsyncTask(ENamedThreads::GameThread, [OnComplete, Result]()
-				{
-					OnComplete.ExecuteIfBound(Result);
-				});
-			}));
+				MakeRestResultCallback(OnComplete, Path));
 		}
 		return;
 	}
 
 #if PLATFORM_ANDROID
-	FString OperationId = GenerateOperationId();
-	RegisterCallback(OperationId, OnComplete);
+	const int64 OperationId = RegisterCallback(OnComplete, Path);
+	if (OperationId == PendingOperations.InvalidId)
+	{
+		return;
+	}
+
+	FFirebaseTrace::Request(EFirebaseTraceOrigin::Jni, OperationId, TEXT("GetValue"), Path, 0);
+	FFirebaseTrafficRecorder::Get().Record(EFirebaseTrafficOp::Get, Path, 0);
 
 	if (JNIEnv* Env = FAndroidApplication::GetJavaEnv())
 	{
 		jstring jPath = Env->NewStringUTF(TCHAR_TO_UTF8(*Path));
-		jstring jOperationId = Env->NewStringUTF(TCHAR_TO_UTF8(*OperationId));
+		jstring jOperationId = Env->NewStringUTF(TCHAR_TO_UTF8(*LexToString(OperationId)));
 
 		jclass FirebaseHelperClass = FAndroidApplication::FindJavaClass("com/epicgames/unreal/FirebaseHelper");
 		if (FirebaseHelperClass)
@@ -416,6 +785,7 @@ void UFirebaseDatabase::GetValue(const FString& Path, const FOnFirebaseDatabaseC
 			if (GetMethod)
 			{
 				Env->CallStaticVoidMethod(FirebaseHelperClass, GetMethod, jPath, jOperationId);
+				FFirebaseTrace::Stage(EFirebaseTraceOrigin::Jni, OperationId, EFirebaseTraceStage::Sent);
 			}
 			Env->DeleteLocalRef(FirebaseHelperClass);
 		}
@@ -434,6 +804,29 @@ void UFirebaseDatabase::GetValue(const FString& Path, const FOnFirebaseDatabaseC
 void UFirebaseDatabase::ListenForValueChanges(const FString& Path, 
 	const FOnFirebaseDatabaseValueChanged& OnValueChanged)
 {
+	FFirebaseTrafficRecorder::Get().Record(EFirebaseTrafficOp::Listen, Path, 0);
+
+	// REST has no streaming connection here, so listeners poll
+	if (ShouldUseRestAPI())
+	{
+		UFirebaseRestAPI* RestAPI = GetRestAPI();
+		if (!RestAPI || !OnValueChanged.IsBound())
+		{
+			return;
+		}
+
+		RegisterListener(Path, OnValueChanged);
+		RestAPI->StartPolling(Path, OnValueChanged.GetUObject(),
+			FFirebaseRestPayloadCallback::CreateLambda([Path](bool bSuccess, const FFirebasePayload& Data)
+		{
+			if (bSuccess)
+			{
+				OnDatabaseValueChanged(Path, Data.ToString());
+			}
+		}));
+		return;
+	}
+
 #if PLATFORM_ANDROID
 	RegisterListener(Path, OnValueChanged);
 
@@ -456,14 +849,32 @@ void UFirebaseDatabase::ListenForValueChanges(const FString& Path,
 		Env->DeleteLocalRef(jPath);
 	}
 #else
-	UE_LOG(LogTemp, Warning, TEXT("Firebase Database: ListenForValueChanges only available on Android"));
+	UE_LOG(LogFirebase, Warning, TEXT("Firebase Database: ListenForValueChanges not available"));
 #endif
 }
 
 void UFirebaseDatabase::StopListening(const FString& Path)
 {
+	FFirebaseTrafficRecorder::Get().Record(EFirebaseTrafficOp::StopListen, Path, 0);
+
+	if (ShouldUseRestAPI())
+	{
+		if (ValueListeners.Remove(Path) > 0)
+		{
+			FFirebaseMemory::Get().Release(EFirebaseMemoryCategory::Listeners, FirebaseListeners::GetValueListenerBytes(Path));
+		}
+		if (RestAPIInstance && IsValid(RestAPIInstance))
+		{
+			RestAPIInstance->StopPolling(Path);
+		}
+		return;
+	}
+
 #if PLATFORM_ANDROID
-	ValueListeners.Remove(Path);
+	if (ValueListeners.Remove(Path) > 0)
+	{
+		FFirebaseMemory::Get().Release(EFirebaseMemoryCategory::Listeners, FirebaseListeners::GetValueListenerBytes(Path));
+	}
 
 	if (JNIEnv* Env = FAndroidApplication::GetJavaEnv())
 	{
@@ -493,8 +904,14 @@ void UFirebaseDatabase::QueryValues(const FString& Path, const FString& OrderByK
 	const FOnFirebaseDatabaseComplete& OnComplete)
 {
 #if PLATFORM_ANDROID
-	FString OperationId = GenerateOperationId();
-	RegisterCallback(OperationId, OnComplete);
+	const int64 OperationId = RegisterCallback(OnComplete, Path);
+	if (OperationId == PendingOperations.InvalidId)
+	{
+		return;
+	}
+
+	FFirebaseTrace::Request(EFirebaseTraceOrigin::Jni, OperationId, TEXT("QueryValues"), Path, 0);
+	FFirebaseTrafficRecorder::Get().Record(EFirebaseTrafficOp::Query, Path, 0);
 
 	if (JNIEnv* Env = FAndroidApplication::GetJavaEnv())
 	{
@@ -502,7 +919,7 @@ void UFirebaseDatabase::QueryValues(const FString& Path, const FString& OrderByK
 		jstring jOrderBy = Env->NewStringUTF(TCHAR_TO_UTF8(*OrderByKey));
 		jstring jStartAt = Env->NewStringUTF(TCHAR_TO_UTF8(*StartAt));
 		jstring jEndAt = Env->NewStringUTF(TCHAR_TO_UTF8(*EndAt));
-		jstring jOperationId = Env->NewStringUTF(TCHAR_TO_UTF8(*OperationId));
+		jstring jOperationId = Env->NewStringUTF(TCHAR_TO_UTF8(*LexToString(OperationId)));
 
 		jclass FirebaseHelperClass = FAndroidApplication::FindJavaClass("com/epicgames/unreal/FirebaseHelper");
 		if (FirebaseHelperClass)
@@ -513,6 +930,7 @@ void UFirebaseDatabase::QueryValues(const FString& Path, const FString& OrderByK
 			{
 				Env->CallStaticVoidMethod(FirebaseHelperClass, QueryMethod, jPath, jOrderBy, 
 					(jint)LimitToFirst, jStartAt, jEndAt, jOperationId);
+				FFirebaseTrace::Stage(EFirebaseTraceOrigin::Jni, OperationId, EFirebaseTraceStage::Sent);
 			}
 			Env->DeleteLocalRef(FirebaseHelperClass);
 		}
@@ -537,14 +955,20 @@ void UFirebaseDatabase::RunTransaction(const FString& Path, const FString& JsonD
 	const FOnFirebaseDatabaseComplete& OnComplete)
 {
 #if PLATFORM_ANDROID
-	FString OperationId = GenerateOperationId();
-	RegisterCallback(OperationId, OnComplete);
+	const int64 OperationId = RegisterCallback(OnComplete, Path);
+	if (OperationId == PendingOperations.InvalidId)
+	{
+		return;
+	}
+
+	FFirebaseTrace::Request(EFirebaseTraceOrigin::Jni, OperationId, TEXT("RunTransaction"), Path, JsonData.Len() * sizeof(UTF16CHAR));
+	FFirebaseTrafficRecorder::Get().Record(EFirebaseTrafficOp::Transaction, Path, JsonData.Len() * sizeof(UTF16CHAR));
 
 	if (JNIEnv* Env = FAndroidApplication::GetJavaEnv())
 	{
 		jstring jPath = Env->NewStringUTF(TCHAR_TO_UTF8(*Path));
-		jstring jData = Env->NewStringUTF(TCHAR_TO_UTF8(*JsonData));
-		jstring jOperationId = Env->NewStringUTF(TCHAR_TO_UTF8(*OperationId));
+		jstring jData = NewJavaStringFromUtf16(Env, JsonData);
+		jstring jOperationId = Env->NewStringUTF(TCHAR_TO_UTF8(*LexToString(OperationId)));
 
 		jclass FirebaseHelperClass = FAndroidApplication::FindJavaClass("com/epicgames/unreal/FirebaseHelper");
 		if (FirebaseHelperClass)
@@ -554,6 +978,7 @@ void UFirebaseDatabase::RunTransaction(const FString& Path, const FString& JsonD
 			if (TransactionMethod)
 			{
 				Env->CallStaticVoidMethod(FirebaseHelperClass, TransactionMethod, jPath, jData, jOperationId);
+				FFirebaseTrace::Stage(EFirebaseTraceOrigin::Jni, OperationId, EFirebaseTraceStage::Sent);
 			}
 			Env->DeleteLocalRef(FirebaseHelperClass);
 		}
@@ -589,7 +1014,7 @@ void UFirebaseDatabase::EnableOfflinePersistence()
 		}
 	}
 #endif
-	UE_LOG(LogTemp, Log, TEXT("Firebase Database: Offline persistence enabled"));
+	UE_LOG(LogFirebase, Log, TEXT("Firebase Database: Offline persistence enabled"));
 }
 
 void UFirebaseDatabase::DisableOfflinePersistence()
@@ -609,7 +1034,7 @@ void UFirebaseDatabase::DisableOfflinePersistence()
 		}
 	}
 #endif
-	UE_LOG(LogTemp, Log, TEXT("Firebase Database: Offline persistence disabled"));
+	UE_LOG(LogFirebase, Log, TEXT("Firebase Database: Offline persistence disabled"));
 }
 
 void UFirebaseDatabase::KeepSynced(const FString& Path, bool bKeepSynced)
@@ -638,6 +1063,16 @@ void UFirebaseDatabase::KeepSynced(const FString& Path, bool bKeepSynced)
 
 void UFirebaseDatabase::GoOnline()
 {
+	if (ShouldUseRestAPI())
+	{
+		if (UFirebaseRestAPI* RestAPI = GetRestAPI())
+		{
+			RestAPI->GoOnline();
+		}
+		UE_LOG(LogFirebase, Log, TEXT("Firebase Database: Going online"));
+		return;
+	}
+
 #if PLATFORM_ANDROID
 	if (JNIEnv* Env = FAndroidApplication::GetJavaEnv())
 	{
@@ -653,11 +1088,21 @@ void UFirebaseDatabase::GoOnline()
 		}
 	}
 #endif
-	UE_LOG(LogTemp, Log, TEXT("Firebase Database: Going online"));
+	UE_LOG(LogFirebase, Log, TEXT("Firebase Database: Going online"));
 }
 
 void UFirebaseDatabase::GoOffline()
 {
+	if (ShouldUseRestAPI())
+	{
+		if (UFirebaseRestAPI* RestAPI = GetRestAPI())
+		{
+			RestAPI->GoOffline();
+		}
+		UE_LOG(LogFirebase, Log, TEXT("Firebase Database: Going offline"));
+		return;
+	}
+
 #if PLATFORM_ANDROID
 	if (JNIEnv* Env = FAndroidApplication::GetJavaEnv())
 	{
@@ -673,11 +1118,17 @@ void UFirebaseDatabase::GoOffline()
 		}
 	}
 #endif
-	UE_LOG(LogTemp, Log, TEXT("Firebase Database: Going offline"));
+	UE_LOG(LogFirebase, Log, TEXT("Firebase Database: Going offline"));
 }
 
 bool UFirebaseDatabase::IsConnected()
 {
+	if (ShouldUseRestAPI())
+	{
+		UFirebaseRestAPI* RestAPI = GetRestAPI();
+		return RestAPI && RestAPI->IsConnected();
+	}
+
 #if PLATFORM_ANDROID
 	if (JNIEnv* Env = FAndroidApplication::GetJavaEnv())
 	{
@@ -698,6 +1149,51 @@ bool UFirebaseDatabase::IsConnected()
 	return false;
 }
 
+void UFirebaseDatabase::BindConnectionStateChanged(const FOnFirebaseConnectionStateChanged& OnChanged)
+{
+	if (!OnChanged.IsBound())
+	{
+		return;
+	}
+
+	if (!ShouldUseRestAPI())
+	{
+		UE_LOG(LogFirebase, Warning, TEXT("Firebase Database: Connection state events require the REST API"));
+		return;
+	}
+
+	// Make sure the connection is being monitored
+	GetRestAPI();
+
+	LLM_SCOPE_BYTAG(Firebase_Listeners);
+	const int32 Before = ConnectionStateListeners.Num();
+	ConnectionStateListeners.AddUnique(OnChanged);
+	FFirebaseMemory::Get().Add(EFirebaseMemoryCategory::Listeners, (ConnectionStateListeners.Num() - Before) * FirebaseListeners::ConnectionListenerBytes);
+}
+
+void UFirebaseDatabase::UnbindConnectionStateChanged(const FOnFirebaseConnectionStateChanged& OnChanged)
+{
+	const int32 Removed = ConnectionStateListeners.Remove(OnChanged);
+	FFirebaseMemory::Get().Release(EFirebaseMemoryCategory::Listeners, Removed * FirebaseListeners::ConnectionListenerBytes);
+}
+
+void UFirebaseDatabase::OnRestConnectivityChanged(bool bConnected)
+{
+	// Drop listeners whose object has been destroyed
+	const int32 Removed = ConnectionStateListeners.RemoveAll([](const FOnFirebaseConnectionStateChanged& Listener)
+	{
+		return !Listener.IsBound();
+	});
+	FFirebaseMemory::Get().Release(EFirebaseMemoryCategory::Listeners, Removed * FirebaseListeners::ConnectionListenerBytes);
+
+	// Listeners may unbind themselves while being notified
+	const TArray<FOnFirebaseConnectionStateChanged> Listeners = ConnectionStateListeners;
+	for (const FOnFirebaseConnectionStateChanged& Listener : Listeners)
+	{
+		Listener.ExecuteIfBound(bConnected);
+	}
+}
+
 // === UTILITY FUNCTIONS ===
 
 FString UFirebaseDatabase::GeneratePushId()
@@ -731,91 +1227,166 @@ FString UFirebaseDatabase::GeneratePushId()
 }
 
 
+TArray<FFirebaseRateLimiterStats> UFirebaseDatabase::GetRateLimiterStats()
+{
+	UFirebaseRestAPI* RestAPI = GetRestAPI();
+	return RestAPI ? RestAPI->GetRateLimiterStats() : TArray<FFirebaseRateLimiterStats>();
+}
+
+FFirebaseBufferPoolStats UFirebaseDatabase::GetBufferPoolStats()
+{
+	return FFirebaseBufferPool::Get().GetStats();
+}
 
 // === JSON HELPER FUNCTIONS ===
 
+namespace
+{
+	/** One-member object {"Key":Value}; the value is written by the caller's lambda */
+	template <typename WriteValueType>
+	FString MakeSingleMemberJson(const FString& Key, WriteValueType&& WriteValue)
+	{
+		FFirebaseJsonWriter Writer(Key.Len() + 32);
+		Writer.BeginObject();
+		Writer.WriteKey(Key);
+		WriteValue(Writer);
+		Writer.EndObject();
+		return Writer.ToString();
+	}
+}
+
 FString UFirebaseDatabase::MakeJsonString(const FString& Key, const FString& Value)
 {
-	return FString::Printf(TEXT("{\"%s\": \"%s\"}"), *Key, *Value);
+	return MakeSingleMemberJson(Key, [&Value](FFirebaseJsonWriter& Writer) { Writer.WriteString(Value); });
 }
 
 FString UFirebaseDatabase::MakeJsonInt(const FString& Key, int32 Value)
 {
-	return FString::Printf(TEXT("{\"%s\": %d}"), *Key, Value);
+	return MakeSingleMemberJson(Key, [Value](FFirebaseJsonWriter& Writer) { Writer.WriteInt(Value); });
 }
 
 FString UFirebaseDatabase::MakeJsonFloat(const FString& Key, float Value)
 {
-	return FString::Printf(TEXT("{\"%s\": %.6f}"), *Key, Value);
+	return MakeSingleMemberJson(Key, [Value](FFirebaseJsonWriter& Writer) { Writer.WriteFloat(Value); });
 }
 
 FString UFirebaseDatabase::MakeJsonBool(const FString& Key, bool Value)
 {
-	return FString::Printf(TEXT("{\"%s\": %s}"), *Key, Value ? TEXT("true") : TEXT("false"));
+	return MakeSingleMemberJson(Key, [Value](FFirebaseJsonWriter& Writer) { Writer.WriteBool(Value); });
 }
 
 FString UFirebaseDatabase::CombineJson(const TArray<FString>& JsonStrings)
 {
-	if (JsonStrings.Num() == 0)
+	int32 TotalLength = 2;
+	for (const FString& JsonStr : JsonStrings)
 	{
-		return TEXT("{}");
+		TotalLength += JsonStr.Len() + 1;
 	}
 
-	FString Combined = TEXT("{");
-	for (int32 i = 0; i < JsonStrings.Num(); i++)
+	// Splice every object's members into one writer instead of concatenating FStrings
+	FFirebaseJsonWriter Writer(TotalLength);
+	Writer.BeginObject();
+	for (const FString& JsonStr : JsonStrings)
 	{
-		FString JsonStr = JsonStrings[i];
-		// Remove outer braces
-		JsonStr.RemoveFromStart(TEXT("{"));
-		JsonStr.RemoveFromEnd(TEXT("}"));
-		Combined += JsonStr;
-		
-		if (i < JsonStrings.Num() - 1)
+		FStringView Trimmed = FStringView(JsonStr).TrimStartAndEnd();
+		if (Trimmed.Len() < 2 || !Trimmed.StartsWith(TEXT('{')) || !Trimmed.EndsWith(TEXT('}')))
 		{
-			Combined += TEXT(", ");
+			UE_LOG(LogFirebase, Warning, TEXT("Firebase Database: CombineJson skipped a value that is not a JSON object: %s"), *FFirebaseLog::Body(JsonStr));
+			continue;
 		}
+
+		const FStringView Members = Trimmed.Mid(1, Trimmed.Len() - 2);
+		FTCHARToUTF8 Utf8(Members.GetData(), Members.Len());
+		Writer.WriteRawMembers(FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Utf8.Get()), Utf8.Length()));
 	}
-	Combined += TEXT("}");
-	return Combined;
+	Writer.EndObject();
+	return Writer.ToString();
 }
 
 bool UFirebaseDatabase::GetJsonValue(const FString& JsonString, const FString& Key, FString& OutValue)
 {
-	TSharedPtr<FJsonObject> JsonObject;
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
+	const FFirebaseJsonDocumentPtr Document = FFirebaseJsonDocument::Parse(FFirebasePayload::FromString(JsonString));
+	return Document->GetFieldAsString(Key, OutValue);
+}
+
+bool UFirebaseDatabase::GetResultJsonValue(const FFirebaseDatabaseResult& Result, const FString& Key, FString& OutValue)
+{
+	if (Result.Document.IsValid())
+	{
+		return Result.Document->GetFieldAsString(Key, OutValue);
+	}
+	return GetJsonValue(Result.Data, Key, OutValue);
+}
 
-	if (FJsonSerializer::Deserialize(Reader, JsonObject) && JsonObject.IsValid())
+FFirebaseValue UFirebaseDatabase::GetResultValue(const FFirebaseDatabaseResult& Result)
+{
+	if (Result.Document.IsValid())
 	{
-		if (JsonObject->HasField(Key))
+		return Result.Document->GetValue();
+	}
+	if (!Result.Payload.IsEmpty())
+	{
+		return FFirebaseValue::FromPayload(Result.Payload);
+	}
+	return FFirebaseValue::FromJsonString(Result.Data);
+}
+
+namespace
+{
+	bool FindJsonValueAtPath(FUtf8StringView Json, const FString& Path, FString& OutValue)
+	{
+		FUtf8StringView RawValue;
+		if (!FFirebaseJsonPath::FindRaw(Json, Path, RawValue))
 		{
-			TSharedPtr<FJsonValue> Value = JsonObject->TryGetField(Key);
-			if (Value.IsValid())
-			{
-				if (Value->Type == EJson::String)
-				{
-					OutValue = Value->AsString();
-				}
-				else if (Value->Type == EJson::Number)
-				{
-					OutValue = FString::SanitizeFloat(Value->AsNumber());
-				}
-				else if (Value->Type == EJson::Boolean)
-				{
-					OutValue = Value->AsBool() ? TEXT("true") : TEXT("false");
-				}
-				else
-				{
-					// For objects or arrays, serialize back to string
-					FString OutputString;
-					TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
-					FJsonSerializer::Serialize(Value.ToSharedRef(), TEXT(""), Writer);
-					OutValue = OutputString;
-				}
-				return true;
-			}
+			return false;
 		}
+
+		OutValue = FFirebaseJsonPath::FormatValue(RawValue);
+		return true;
+	}
+
+	int32 FindJsonValuesAtPaths(FUtf8StringView Json, const TArray<FString>& Paths, TArray<FString>& OutValues)
+	{
+		TArray<FUtf8StringView> RawValues;
+		const int32 Found = FFirebaseJsonPath::FindRaw(Json, Paths, RawValues);
+
+		OutValues.Reset(RawValues.Num());
+		for (const FUtf8StringView& RawValue : RawValues)
+		{
+			OutValues.Add(FFirebaseJsonPath::FormatValue(RawValue));
+		}
+		return Found;
 	}
-	return false;
+}
+
+bool UFirebaseDatabase::GetJsonValueAtPath(const FString& JsonString, const FString& Path, FString& OutValue)
+{
+	FTCHARToUTF8 Utf8(*JsonString, JsonString.Len());
+	return FindJsonValueAtPath(FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Utf8.Get()), Utf8.Length()), Path, OutValue);
+}
+
+int32 UFirebaseDatabase::GetJsonValuesAtPaths(const FString& JsonString, const TArray<FString>& Paths, TArray<FString>& OutValues)
+{
+	FTCHARToUTF8 Utf8(*JsonString, JsonString.Len());
+	return FindJsonValuesAtPaths(FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Utf8.Get()), Utf8.Length()), Paths, OutValues);
+}
+
+bool UFirebaseDatabase::GetResultJsonValueAtPath(const FFirebaseDatabaseResult& Result, const FString& Path, FString& OutValue)
+{
+	if (!Result.Payload.IsEmpty())
+	{
+		return FindJsonValueAtPath(Result.Payload.GetView(), Path, OutValue);
+	}
+	return GetJsonValueAtPath(Result.Data, Path, OutValue);
+}
+
+int32 UFirebaseDatabase::GetResultJsonValuesAtPaths(const FFirebaseDatabaseResult& Result, const TArray<FString>& Paths, TArray<FString>& OutValues)
+{
+	if (!Result.Payload.IsEmpty())
+	{
+		return FindJsonValuesAtPaths(Result.Payload.GetView(), Paths, OutValues);
+	}
+	return GetJsonValuesAtPaths(Result.Data, Paths, OutValues);
 }
 
 // === SERVER TIMESTAMP HELPERS ===
@@ -886,29 +1457,35 @@ FString UFirebaseDatabase::TimestampToDateString(int64 TimestampMs)
 
 // === CALLBACK HANDLERS ===
 
-void UFirebaseDatabase::OnDatabaseResultReceived(bool bSuccess, const FString& Path, 
+void UFirebaseDatabase::OnDatabaseResultReceived(int64 OperationId, bool bSuccess, const FString& Path, 
 	const FString& Data, const FString& ErrorMessage)
 {
+	FFirebasePendingDatabaseOperation Operation;
+	if (!PendingOperations.Complete(OperationId, Operation))
+	{
+		// Unbound callback, or the result arrived after the operation timed out
+		UE_LOG(LogFirebase, Verbose, TEXT("Firebase Database: Ignoring result for unknown operation %lld - Path: %s"), OperationId, *Path);
+		return;
+	}
+
 	FFirebaseDatabaseResult Result;
 	Result.bSuccess = bSuccess;
 	Result.Path = Path;
 	Result.Data = Data;
 	Result.ErrorMessage = ErrorMessage;
 
-	// Execute all pending callbacks (we'll need to improve this with proper operation ID tracking)
-	for (auto& Pair : PendingCallbacks)
 	{
-		Pair.Value.ExecuteIfBound(Result);
+		FIREBASE_TRACE_CALLBACK_SCOPE(EFirebaseTraceOrigin::Jni, OperationId);
+		Operation.Callback.ExecuteIfBound(Result);
 	}
-	PendingCallbacks.Empty();
 
 	if (bSuccess)
 	{
-		UE_LOG(LogTemp, Log, TEXT("Firebase Database: Operation successful - Path: %s"), *Path);
+		UE_LOG(LogFirebase, Verbose, TEXT("Firebase Database: Operation successful - Path: %s"), *Path);
 	}
 	else
 	{
-		UE_LOG(LogTemp, Error, TEXT("Firebase Database: Operation failed - %s"), *ErrorMessage);
+		UE_LOG(LogFirebase, Error, TEXT("Firebase Database: Operation failed - %s"), *ErrorMessage);
 	}
 }
 
@@ -917,7 +1494,7 @@ void UFirebaseDatabase::OnDatabaseValueChanged(const FString& Path, const FStrin
 	if (ValueListeners.Contains(Path))
 	{
 		ValueListeners[Path].ExecuteIfBound(Path, Data);
-		UE_LOG(LogTemp, Log, TEXT("Firebase Database: Value changed - Path: %s"), *Path);
+		UE_LOG(LogFirebase, Verbose, TEXT("Firebase Database: Value changed - Path: %s"), *Path);
 	}
 }
 
@@ -925,42 +1502,46 @@ void UFirebaseDatabase::OnDatabaseValueChanged(const FString& Path, const FStrin
 
 #if PLATFORM_ANDROID
 extern "C" JNIEXPORT void JNICALL Java_com_epicgames_unreal_FirebaseHelper_nativeOnDatabaseResult(
-	JNIEnv* env, jclass clazz, jboolean success, jstring path, jstring data, jstring errorMessage)
+	JNIEnv* env, jclass clazz, jstring operationId, jboolean success, jstring path, jstring data, jstring errorMessage)
 {
+	LLM_SCOPE_BYTAG(Firebase_Transport);
 	bool bSuccess = (bool)success;
+
+	const char* operationIdChars = env->GetStringUTFChars(operationId, nullptr);
+	int64 OperationId = FCStringAnsi::Atoi64(operationIdChars);
+	env->ReleaseStringUTFChars(operationId, operationIdChars);
 	
 	const char* pathChars = env->GetStringUTFChars(path, nullptr);
 	FString PathStr = FString(UTF8_TO_TCHAR(pathChars));
 	env->ReleaseStringUTFChars(path, pathChars);
 
-	const char* dataChars = env->GetStringUTFChars(data, nullptr);
-	FString DataStr = FString(UTF8_TO_TCHAR(dataChars));
-	env->ReleaseStringUTFChars(data, dataChars);
+	FString DataStr = FStringFromJavaUtf16(env, data);
 
 	const char* errorChars = env->GetStringUTFChars(errorMessage, nullptr);
 	FString ErrorStr = FString(UTF8_TO_TCHAR(errorChars));
 	env->ReleaseStringUTFChars(errorMessage, errorChars);
 
+	FFirebaseTrace::Stage(EFirebaseTraceOrigin::Jni, OperationId, EFirebaseTraceStage::Complete, DataStr.Len() * sizeof(UTF16CHAR), bSuccess ? 200 : 0);
+
 	// Call on game thread
-	AsyncTask(ENamedThreads::GameThread, [bSuccess, PathStr, DataStr, ErrorStr]()
+	AsyncTask(ENamedThreads::GameThread, [OperationId, bSuccess, PathStr, DataStr = MoveTemp(DataStr), ErrorStr]()
 	{
-		UFirebaseDatabase::OnDatabaseResultReceived(bSuccess, PathStr, DataStr, ErrorStr);
+		UFirebaseDatabase::OnDatabaseResultReceived(OperationId, bSuccess, PathStr, DataStr, ErrorStr);
 	});
 }
 
 extern "C" JNIEXPORT void JNICALL Java_com_epicgames_unreal_FirebaseHelper_nativeOnDatabaseValueChanged(
 	JNIEnv* env, jclass clazz, jstring path, jstring data)
 {
+	LLM_SCOPE_BYTAG(Firebase_Transport);
 	const char* pathChars = env->GetStringUTFChars(path, nullptr);
 	FString PathStr = FString(UTF8_TO_TCHAR(pathChars));
 	env->ReleaseStringUTFChars(path, pathChars);
 
-	const char* dataChars = env->GetStringUTFChars(data, nullptr);
-	FString DataStr = FString(UTF8_TO_TCHAR(dataChars));
-	env->ReleaseStringUTFChars(data, dataChars);
+	FString DataStr = FStringFromJavaUtf16(env, data);
 
 	// Call on game thread
-	AsyncTask(ENamedThreads::GameThread, [PathStr, DataStr]()
+	AsyncTask(ENamedThreads::GameThread, [PathStr, DataStr = MoveTemp(DataStr)]()
 	{
 		UFirebaseDatabase::OnDatabaseValueChanged(PathStr, DataStr);
 	});
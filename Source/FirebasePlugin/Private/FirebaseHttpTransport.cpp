@@ -0,0 +1,132 @@
+// Copyright. All Rights Reserved.
+
+#include "FirebaseHttpTransport.h"
+#include "FirebaseMemory.h"
+#include "HttpModule.h"
+#include "Interfaces/IHttpResponse.h"
+#include <atomic>
+
+void FFirebaseHttpRequest::SetHeader(const FString& Name, const FString& Value)
+{
+	for (TPair<FString, FString>& Header : Headers)
+	{
+		if (Header.Key.Equals(Name, ESearchCase::IgnoreCase))
+		{
+			Header.Value = Value;
+			return;
+		}
+	}
+	Headers.Emplace(Name, Value);
+}
+
+const FString* FFirebaseHttpRequest::FindHeader(const TCHAR* Name) const
+{
+	for (const TPair<FString, FString>& Header : Headers)
+	{
+		if (Header.Key.Equals(Name, ESearchCase::IgnoreCase))
+		{
+			return &Header.Value;
+		}
+	}
+	return nullptr;
+}
+
+FString FFirebaseHttpResponse::GetHeader(const TCHAR* Name) const
+{
+	for (const TPair<FString, FString>& Header : Headers)
+	{
+		if (Header.Key.Equals(Name, ESearchCase::IgnoreCase))
+		{
+			return Header.Value;
+		}
+	}
+	return FString();
+}
+
+TSharedRef<FFirebaseHttpModuleTransport> FFirebaseHttpModuleTransport::Get()
+{
+	static TSharedRef<FFirebaseHttpModuleTransport> Instance = MakeShared<FFirebaseHttpModuleTransport>();
+	return Instance;
+}
+
+FFirebaseHttpRequestId FFirebaseHttpModuleTransport::Send(FFirebaseHttpRequest&& Request, FFirebaseHttpCallback&& OnComplete)
+{
+	LLM_SCOPE_BYTAG(Firebase_Transport);
+
+	TSharedRef<IHttpRequest> HttpRequest = FHttpModule::Get().CreateRequest();
+	HttpRequest->SetURL(Request.Url);
+	HttpRequest->SetVerb(Request.Verb);
+	for (const TPair<FString, FString>& Header : Request.Headers)
+	{
+		HttpRequest->SetHeader(Header.Key, Header.Value);
+	}
+	if (!Request.Body.IsEmpty())
+	{
+		// Already UTF-8; the request needs its own copy of the bytes
+		HttpRequest->SetContent(TArray<uint8>(Request.Body.GetData(), Request.Body.Num()));
+	}
+	if (Request.TimeoutSeconds > 0.0f)
+	{
+		HttpRequest->SetTimeout(Request.TimeoutSeconds);
+	}
+
+	const FFirebaseHttpRequestId RequestId = NextRequestId++;
+	InFlight.Add(RequestId, HttpRequest);
+
+	// The first header marks the first byte; headers may be reported off the game thread
+	const double SendTime = FPlatformTime::Seconds();
+	TSharedRef<std::atomic<double>, ESPMode::ThreadSafe> FirstByteTime = MakeShared<std::atomic<double>, ESPMode::ThreadSafe>(0.0);
+	HttpRequest->OnHeaderReceived().BindLambda([FirstByteTime](FHttpRequestPtr, const FString&, const FString&)
+	{
+		double Unset = 0.0;
+		FirstByteTime->compare_exchange_strong(Unset, FPlatformTime::Seconds());
+	});
+
+	TWeakPtr<FFirebaseHttpModuleTransport> WeakThis = AsShared();
+	HttpRequest->OnProcessRequestComplete().BindLambda([WeakThis, RequestId, SendTime, FirstByteTime, OnComplete = MoveTemp(OnComplete)](FHttpRequestPtr, FHttpResponsePtr HttpResponse, bool bWasSuccessful)
+	{
+		if (TSharedPtr<FFirebaseHttpModuleTransport> This = WeakThis.Pin())
+		{
+			This->InFlight.Remove(RequestId);
+		}
+
+		FFirebaseHttpResponse Response;
+		if (bWasSuccessful && HttpResponse.IsValid())
+		{
+			LLM_SCOPE_BYTAG(Firebase_Transport);
+			Response.bSucceeded = true;
+			Response.Code = HttpResponse->GetResponseCode();
+
+			// The payload views the response body; nothing is copied or transcoded here
+			Response.Body = FFirebasePayload::FromResponse(HttpResponse);
+
+			for (const FString& Line : HttpResponse->GetAllHeaders())
+			{
+				FString Name, Value;
+				if (Line.Split(TEXT(":"), &Name, &Value))
+				{
+					Response.Headers.Emplace(MoveTemp(Name), Value.TrimStart());
+				}
+			}
+
+			const double Now = FPlatformTime::Seconds();
+			const double FirstByte = FirstByteTime->load();
+			Response.ElapsedSeconds = float(Now - SendTime);
+			Response.TimeToFirstByteSeconds = float((FirstByte > 0.0 ? FirstByte : Now) - SendTime);
+		}
+		OnComplete(Response);
+	});
+
+	HttpRequest->ProcessRequest();
+	return RequestId;
+}
+
+void FFirebaseHttpModuleTransport::Cancel(FFirebaseHttpRequestId RequestId)
+{
+	FHttpRequestPtr HttpRequest;
+	if (InFlight.RemoveAndCopyValue(RequestId, HttpRequest) && HttpRequest.IsValid())
+	{
+		// The engine completes cancelled requests with bWasSuccessful == false
+		HttpRequest->CancelRequest();
+	}
+}
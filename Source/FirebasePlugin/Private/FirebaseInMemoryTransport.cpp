@@ -0,0 +1,99 @@
+// Copyright. All Rights Reserved.
+
+#include "FirebaseInMemoryTransport.h"
+
+FFirebaseHttpRequestId FFirebaseInMemoryTransport::Send(FFirebaseHttpRequest&& Request, FFirebaseHttpCallback&& OnComplete)
+{
+	const FFirebaseHttpRequestId RequestId = NextRequestId++;
+	NumSent++;
+
+	double Delay = DefaultDelay;
+	if (ScriptedDelays.IsValidIndex(NextScriptedDelay))
+	{
+		Delay = ScriptedDelays[NextScriptedDelay++];
+	}
+
+	const FHandler* RequestHandler = FindHandler(Request.Url);
+	FFirebaseHttpResponse Response = RequestHandler ? (*RequestHandler)(Request) : MakeResponse(404, FFirebasePayload::FromUtf8(UTF8TEXTVIEW("{\"error\":\"Not Found\"}")));
+
+	// A response slower than the request's timeout never arrives
+	if (Request.TimeoutSeconds > 0.0f && Delay > Request.TimeoutSeconds)
+	{
+		Delay = Request.TimeoutSeconds;
+		Response = FFirebaseHttpResponse::Failed();
+	}
+	else if (Response.bSucceeded)
+	{
+		// The whole body arrives at once
+		Response.TimeToFirstByteSeconds = float(Delay);
+		Response.ElapsedSeconds = float(Delay);
+	}
+
+	if (bRecordRequests)
+	{
+		SentRequests.Add(MoveTemp(Request));
+	}
+
+	if (Delay <= 0.0)
+	{
+		OnComplete(Response);
+		return RequestId;
+	}
+
+	Schedule.Add(RequestId, Schedule.GetTime() + Delay, MoveTemp(Response), MoveTemp(OnComplete));
+	return RequestId;
+}
+
+void FFirebaseInMemoryTransport::Cancel(FFirebaseHttpRequestId RequestId)
+{
+	FFirebaseHttpCallback OnComplete;
+	if (Schedule.Remove(RequestId, &OnComplete))
+	{
+		OnComplete(FFirebaseHttpResponse::Failed());
+	}
+}
+
+void FFirebaseInMemoryTransport::AddRoute(const FString& UrlPrefix, FHandler RouteHandler)
+{
+	Routes.Emplace(UrlPrefix, MoveTemp(RouteHandler));
+}
+
+void FFirebaseInMemoryTransport::ScriptDelays(TArrayView<const double> Delays)
+{
+	ScriptedDelays.RemoveAt(0, NextScriptedDelay);
+	NextScriptedDelay = 0;
+	ScriptedDelays.Append(Delays.GetData(), Delays.Num());
+}
+
+const FFirebaseInMemoryTransport::FHandler* FFirebaseInMemoryTransport::FindHandler(const FString& Url) const
+{
+	const FHandler* Best = Handler ? &Handler : nullptr;
+	int32 BestLength = -1;
+	for (const TPair<FString, FHandler>& Route : Routes)
+	{
+		if (Route.Key.Len() > BestLength && Url.StartsWith(Route.Key, ESearchCase::CaseSensitive))
+		{
+			Best = &Route.Value;
+			BestLength = Route.Key.Len();
+		}
+	}
+	return Best;
+}
+
+FFirebaseInMemoryTransport::FHandler FFirebaseInMemoryTransport::Respond(int32 Code, const FFirebasePayload& Body)
+{
+	return [Code, Body](const FFirebaseHttpRequest&)
+	{
+		return MakeResponse(Code, Body);
+	};
+}
+
+FFirebaseHttpResponse FFirebaseInMemoryTransport::MakeResponse(int32 Code, const FFirebasePayload& Body)
+{
+	FFirebaseHttpResponse Response;
+	Response.bSucceeded = true;
+	Response.Code = Code;
+	Response.Headers.Emplace(TEXT("Content-Type"), TEXT("application/json; charset=utf-8"));
+	Response.Body = Body;
+	return Response;
+}
@@ -0,0 +1,101 @@
+// Copyright. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "FirebaseLog.h"
+#include "HAL/IConsoleManager.h"
+#include "FirebaseJsonBenchmarkData.h"
+#include "FirebaseJsonTape.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+#if !UE_BUILD_SHIPPING
+
+namespace FirebaseJsonBenchmark
+{
+	/** Run Parse Iterations times and log the average time and throughput */
+	static void Measure(const TCHAR* PayloadName, const TCHAR* ParserName, int32 Bytes, int32 Iterations, TFunctionRef<bool()> Parse)
+	{
+		// Warm caches and allocators once
+		if (!Parse())
+		{
+			UE_LOG(LogFirebase, Warning, TEXT("Firebase JSON benchmark: %s failed to parse %s"), ParserName, PayloadName);
+			return;
+		}
+
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			Parse();
+		}
+		const double Seconds = (FPlatformTime::Seconds() - StartTime) / Iterations;
+
+		UE_LOG(LogFirebase, Display, TEXT("Firebase JSON benchmark: %-10s %-28s %8.3f ms  %8.1f MB/s"),
+			PayloadName, ParserName, Seconds * 1000.0, Seconds > 0.0 ? (Bytes / (1024.0 * 1024.0)) / Seconds : 0.0);
+	}
+
+	static void Run(const TCHAR* PayloadName, const FFirebasePayload& Payload, int32 Iterations)
+	{
+		Measure(PayloadName, TEXT("FJsonSerializer"), Payload.Num(), Iterations, [&Payload]()
+		{
+			TSharedPtr<FJsonValue> Root;
+			TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Payload.ToString());
+			return FJsonSerializer::Deserialize(Reader, Root);
+		});
+
+		const FString SimdName = FString::Printf(TEXT("Tape (%s)"), FFirebaseJsonTape::GetSimdBackendName());
+		Measure(PayloadName, *SimdName, Payload.Num(), Iterations, [&Payload]()
+		{
+			FFirebaseJsonTape Tape;
+			return Tape.Parse(Payload);
+		});
+
+		Measure(PayloadName, TEXT("Tape (Scalar)"), Payload.Num(), Iterations, [&Payload]()
+		{
+			FFirebaseJsonTape Tape;
+			return Tape.Parse(Payload, false);
+		});
+
+		Measure(PayloadName, TEXT("Tape + FJsonValue tree"), Payload.Num(), Iterations, [&Payload]()
+		{
+			FFirebaseJsonTape Tape;
+			return Tape.Parse(Payload) && Tape.GetRoot().ToJsonValue().IsValid();
+		});
+
+		// Both parsers must agree on the shape of the snapshot
+		TSharedPtr<FJsonValue> Expected;
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Payload.ToString());
+		FFirebaseJsonTape Tape;
+		if (FJsonSerializer::Deserialize(Reader, Expected) && Tape.Parse(Payload))
+		{
+			FString ExpectedText;
+			FString TapeText;
+			FJsonSerializer::Serialize(Expected.ToSharedRef(), TEXT(""), TJsonWriterFactory<>::Create(&ExpectedText));
+			FJsonSerializer::Serialize(Tape.GetRoot().ToJsonValue().ToSharedRef(), TEXT(""), TJsonWriterFactory<>::Create(&TapeText));
+			if (!ExpectedText.Equals(TapeText, ESearchCase::CaseSensitive))
+			{
+				UE_LOG(LogFirebase, Error, TEXT("Firebase JSON benchmark: tape result differs from FJsonSerializer for %s"), PayloadName);
+			}
+		}
+	}
+
+	static void Execute(const TArray<FString>& Args)
+	{
+		const int32 SizeKB = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 2048;
+		const int32 Iterations = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 10;
+
+		const FFirebasePayload Leaderboard = FirebaseJsonBenchmarkData::MakeLeaderboard(SizeKB * 1024);
+		const FFirebasePayload Inventory = FirebaseJsonBenchmarkData::MakeInventory(SizeKB * 1024);
+
+		UE_LOG(LogFirebase, Display, TEXT("Firebase JSON benchmark: %d KB payloads, %d iterations"), SizeKB, Iterations);
+		Run(TEXT("Leaderboard"), Leaderboard, Iterations);
+		Run(TEXT("Inventory"), Inventory, Iterations);
+	}
+
+	static FAutoConsoleCommand BenchmarkCommand(
+		TEXT("Firebase.BenchmarkJson"),
+		TEXT("Compare FJsonSerializer with the tape parser on synthetic database snapshots. Usage: Firebase.BenchmarkJson [SizeKB=2048] [Iterations=10]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&Execute));
+}
+
+#endif // !UE_BUILD_SHIPPING
@@ -0,0 +1,101 @@
+// Copyright. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/RandomStream.h"
+#include "FirebasePayload.h"
+
+/**
+ * Synthetic Realtime Database snapshots for parser benchmarks.
+ * Generation is deterministic for a given seed.
+ */
+namespace FirebaseJsonBenchmarkData
+{
+	/** Random push ID in the format the Realtime Database generates ("-N" + 18 characters) */
+	inline FString MakePushId(FRandomStream& Random)
+	{
+		static const TCHAR Alphabet[] = TEXT("-0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ_abcdefghijklmnopqrstuvwxyz");
+		FString Id = TEXT("-N");
+		for (int32 Index = 0; Index < 18; ++Index)
+		{
+			Id.AppendChar(Alphabet[Random.RandRange(0, 63)]);
+		}
+		return Id;
+	}
+
+	/** Leaderboard: push-ID keyed entries with name, score, timestamp and flags */
+	inline FFirebasePayload MakeLeaderboard(int32 TargetBytes, int32 Seed = 1)
+	{
+		FRandomStream Random(Seed);
+		FString Json;
+		Json.Reserve(TargetBytes + 256);
+		Json += TEXT("{\"scores\":{");
+
+		bool bFirst = true;
+		while (Json.Len() < TargetBytes)
+		{
+			if (!bFirst)
+			{
+				Json += TEXT(",");
+			}
+			bFirst = false;
+
+			Json += FString::Printf(
+				TEXT("\"%s\":{\"name\":\"Player_%d\",\"score\":%d,\"accuracy\":%.4f,\"updatedAt\":%lld,\"verified\":%s,\"region\":\"%s\"}"),
+				*MakePushId(Random),
+				Random.RandRange(0, 999999),
+				Random.RandRange(0, 5000000),
+				Random.FRand(),
+				1700000000000LL + Random.RandRange(0, 100000000),
+				Random.RandRange(0, 1) ? TEXT("true") : TEXT("false"),
+				Random.RandRange(0, 1) ? TEXT("eu-west") : TEXT("us-central"));
+		}
+
+		Json += TEXT("}}");
+		return FFirebasePayload::FromString(Json);
+	}
+
+	/** Inventory: nested per-player item maps with arrays, nulls and escaped text */
+	inline FFirebasePayload MakeInventory(int32 TargetBytes, int32 Seed = 1)
+	{
+		FRandomStream Random(Seed);
+		FString Json;
+		Json.Reserve(TargetBytes + 1024);
+		Json += TEXT("{\n  \"players\": {\n");
+
+		bool bFirstPlayer = true;
+		while (Json.Len() < TargetBytes)
+		{
+			if (!bFirstPlayer)
+			{
+				Json += TEXT(",\n");
+			}
+			bFirstPlayer = false;
+
+			Json += FString::Printf(TEXT("    \"%s\": {\n      \"items\": {"), *MakePushId(Random));
+
+			const int32 ItemCount = Random.RandRange(4, 16);
+			for (int32 Item = 0; Item < ItemCount; ++Item)
+			{
+				Json += FString::Printf(
+					TEXT("%s\n        \"item_%d\": {\"id\": %d, \"count\": %d, \"durability\": %.2f, \"tags\": [\"rare\", \"tradable\", \"lvl%d\"], \"note\": \"Found in \\\"Zone %d\\\"\\n\\u00e9p\\u00e9e\", \"equipped\": %s, \"expires\": null}"),
+					Item == 0 ? TEXT("") : TEXT(","),
+					Item,
+					Random.RandRange(1000, 9999),
+					Random.RandRange(1, 99),
+					Random.FRandRange(0.0f, 100.0f),
+					Random.RandRange(1, 60),
+					Random.RandRange(1, 12),
+					Random.RandRange(0, 1) ? TEXT("true") : TEXT("false"));
+			}
+
+			Json += FString::Printf(TEXT("\n      },\n      \"gold\": %d,\n      \"slots\": [%d, %d, %d, %d]\n    }"),
+				Random.RandRange(0, 1000000),
+				Random.RandRange(0, 40), Random.RandRange(0, 40), Random.RandRange(0, 40), Random.RandRange(0, 40));
+		}
+
+		Json += TEXT("\n  }\n}\n");
+		return FFirebasePayload::FromString(Json);
+	}
+}
@@ -0,0 +1,209 @@
+// Copyright. All Rights Reserved.
+
+#include "FirebaseJsonBuilder.h"
+#include "FirebaseLog.h"
+
+UFirebaseJsonBuilder::UFirebaseJsonBuilder()
+	: Writer(1024)
+{
+	Writer.BeginObject();
+}
+
+UFirebaseJsonBuilder* UFirebaseJsonBuilder::CreateJsonBuilder()
+{
+	return NewObject<UFirebaseJsonBuilder>();
+}
+
+UFirebaseJsonBuilder* UFirebaseJsonBuilder::Reset()
+{
+	Writer.Reset();
+	Writer.BeginObject();
+	return this;
+}
+
+bool UFirebaseJsonBuilder::CheckInObject(const TCHAR* Function) const
+{
+	if (!Writer.IsInObject())
+	{
+		UE_LOG(LogFirebase, Warning, TEXT("Firebase JSON Builder: %s needs an open object; call End to close the array first"), Function);
+		return false;
+	}
+	return true;
+}
+
+bool UFirebaseJsonBuilder::CheckInArray(const TCHAR* Function) const
+{
+	if (!Writer.IsInArray())
+	{
+		UE_LOG(LogFirebase, Warning, TEXT("Firebase JSON Builder: %s needs an open array; call Begin Array first"), Function);
+		return false;
+	}
+	return true;
+}
+
+// === OBJECT MEMBERS ===
+
+UFirebaseJsonBuilder* UFirebaseJsonBuilder::SetString(const FString& Key, const FString& Value)
+{
+	if (CheckInObject(TEXT("SetString")))
+	{
+		Writer.WriteKey(Key);
+		Writer.WriteString(Value);
+	}
+	return this;
+}
+
+UFirebaseJsonBuilder* UFirebaseJsonBuilder::SetInt(const FString& Key, int64 Value)
+{
+	if (CheckInObject(TEXT("SetInt")))
+	{
+		Writer.WriteKey(Key);
+		Writer.WriteInt(Value);
+	}
+	return this;
+}
+
+UFirebaseJsonBuilder* UFirebaseJsonBuilder::SetFloat(const FString& Key, double Value)
+{
+	if (CheckInObject(TEXT("SetFloat")))
+	{
+		Writer.WriteKey(Key);
+		Writer.WriteDouble(Value);
+	}
+	return this;
+}
+
+UFirebaseJsonBuilder* UFirebaseJsonBuilder::SetBool(const FString& Key, bool Value)
+{
+	if (CheckInObject(TEXT("SetBool")))
+	{
+		Writer.WriteKey(Key);
+		Writer.WriteBool(Value);
+	}
+	return this;
+}
+
+UFirebaseJsonBuilder* UFirebaseJsonBuilder::SetNull(const FString& Key)
+{
+	if (CheckInObject(TEXT("SetNull")))
+	{
+		Writer.WriteKey(Key);
+		Writer.WriteNull();
+	}
+	return this;
+}
+
+UFirebaseJsonBuilder* UFirebaseJsonBuilder::SetJson(const FString& Key, const FString& Json)
+{
+	if (CheckInObject(TEXT("SetJson")))
+	{
+		Writer.WriteKey(Key);
+
+		// A key with no value would make the whole body invalid
+		const FStringView Trimmed = FStringView(Json).TrimStartAndEnd();
+		if (Trimmed.IsEmpty())
+		{
+			UE_LOG(LogFirebase, Warning, TEXT("Firebase JSON Builder: SetJson got an empty value for '%s'; writing null"), *Key);
+			Writer.WriteNull();
+			return this;
+		}
+
+		FTCHARToUTF8 Utf8(Trimmed.GetData(), Trimmed.Len());
+		Writer.WriteRawValue(FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Utf8.Get()), Utf8.Length()));
+	}
+	return this;
+}
+
+UFirebaseJsonBuilder* UFirebaseJsonBuilder::BeginObject(const FString& Key)
+{
+	if (CheckInObject(TEXT("BeginObject")))
+	{
+		Writer.WriteKey(Key);
+		Writer.BeginObject();
+	}
+	return this;
+}
+
+UFirebaseJsonBuilder* UFirebaseJsonBuilder::BeginArray(const FString& Key)
+{
+	if (CheckInObject(TEXT("BeginArray")))
+	{
+		Writer.WriteKey(Key);
+		Writer.BeginArray();
+	}
+	return this;
+}
+
+// === ARRAY ELEMENTS ===
+
+UFirebaseJsonBuilder* UFirebaseJsonBuilder::AddString(const FString& Value)
+{
+	if (CheckInArray(TEXT("AddString")))
+	{
+		Writer.WriteString(Value);
+	}
+	return this;
+}
+
+UFirebaseJsonBuilder* UFirebaseJsonBuilder::AddInt(int64 Value)
+{
+	if (CheckInArray(TEXT("AddInt")))
+	{
+		Writer.WriteInt(Value);
+	}
+	return this;
+}
+
+UFirebaseJsonBuilder* UFirebaseJsonBuilder::AddFloat(double Value)
+{
+	if (CheckInArray(TEXT("AddFloat")))
+	{
+		Writer.WriteDouble(Value);
+	}
+	return this;
+}
+
+UFirebaseJsonBuilder* UFirebaseJsonBuilder::AddBool(bool Value)
+{
+	if (CheckInArray(TEXT("AddBool")))
+	{
+		Writer.WriteBool(Value);
+	}
+	return this;
+}
+
+UFirebaseJsonBuilder* UFirebaseJsonBuilder::AddObject()
+{
+	if (CheckInArray(TEXT("AddObject")))
+	{
+		Writer.BeginObject();
+	}
+	return this;
+}
+
+UFirebaseJsonBuilder* UFirebaseJsonBuilder::End()
+{
+	// The root object stays open until output
+	if (Writer.GetDepth() <= 1)
+	{
+		UE_LOG(LogFirebase, Warning, TEXT("Firebase JSON Builder: End called with nothing to close"));
+		return this;
+	}
+
+	if (Writer.IsInArray())
+	{
+		Writer.EndArray();
+	}
+	else
+	{
+		Writer.EndObject();
+	}
+	return this;
+}
+
+// === OUTPUT ===
+
+FString UFirebaseJsonBuilder::ToJsonString() const
+{
+	return Writer.ToString();
+}
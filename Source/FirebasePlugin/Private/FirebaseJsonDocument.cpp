@@ -0,0 +1,185 @@
+// Copyright. All Rights Reserved.
+
+#include "FirebaseJsonDocument.h"
+#include "FirebaseMemory.h"
+#include "FirebaseSettings.h"
+#include "FirebaseStats.h"
+#include "Async/Async.h"
+#include "Tasks/Task.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace
+{
+	FFirebaseJsonTape::FValue FindTapeField(const FFirebaseJsonTape& Tape, const FString& Key)
+	{
+		FTCHARToUTF8 KeyUtf8(*Key, Key.Len());
+		return Tape.GetRoot().FindField(FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(KeyUtf8.Get()), KeyUtf8.Length()));
+	}
+}
+
+FFirebaseJsonDocumentPtr FFirebaseJsonDocument::Parse(const FFirebasePayload& Payload)
+{
+	const UFirebaseSettings* Settings = GetDefault<UFirebaseSettings>();
+	return Parse(Payload, Settings ? Settings->JsonParser : EFirebaseJsonParser::Standard);
+}
+
+FFirebaseJsonDocumentPtr FFirebaseJsonDocument::Parse(const FFirebasePayload& Payload, EFirebaseJsonParser Parser)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FirebaseParseJson);
+	LLM_SCOPE_BYTAG(Firebase_Json);
+
+	TSharedRef<FFirebaseJsonDocument, ESPMode::ThreadSafe> Document = MakeShared<FFirebaseJsonDocument, ESPMode::ThreadSafe>();
+	Document->Payload = Payload;
+
+	if (Payload.IsEmpty())
+	{
+		return Document;
+	}
+
+	if (Parser == EFirebaseJsonParser::Tape)
+	{
+		TSharedRef<FFirebaseJsonTape, ESPMode::ThreadSafe> Tape = MakeShared<FFirebaseJsonTape, ESPMode::ThreadSafe>();
+		if (Tape->Parse(Payload))
+		{
+			Document->Tape = Tape;
+		}
+		return Document;
+	}
+
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Payload.ToString());
+	if (!FJsonSerializer::Deserialize(Reader, Document->Root))
+	{
+		Document->Root.Reset();
+	}
+
+	return Document;
+}
+
+void FFirebaseJsonDocument::ParseAsync(const FFirebasePayload& Payload, TUniqueFunction<void(FFirebaseJsonDocumentPtr)>&& OnParsed)
+{
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [Payload, OnParsed = MoveTemp(OnParsed)]() mutable
+	{
+		FFirebaseJsonDocumentPtr Document = Parse(Payload);
+		AsyncTask(ENamedThreads::GameThread, [Document = MoveTemp(Document), OnParsed = MoveTemp(OnParsed)]() mutable
+		{
+			OnParsed(MoveTemp(Document));
+		});
+	});
+}
+
+bool FFirebaseJsonDocument::IsValid() const
+{
+	return Tape.IsValid() || Root.IsValid();
+}
+
+TSharedPtr<FJsonValue> FFirebaseJsonDocument::GetRoot() const
+{
+	if (!Tape.IsValid())
+	{
+		return Root;
+	}
+
+	FScopeLock Lock(&RootLock);
+	if (!Root.IsValid())
+	{
+		Root = Tape->GetRoot().ToJsonValue();
+	}
+	return Root;
+}
+
+FFirebaseValue FFirebaseJsonDocument::GetValue() const
+{
+	FScopeLock Lock(&ValueLock);
+	if (!bValueBuilt)
+	{
+		Value = Tape.IsValid() ? FFirebaseValue::FromTape(Tape->GetRoot()) : FFirebaseValue::FromJsonValue(Root);
+		bValueBuilt = true;
+	}
+	return Value;
+}
+
+TSharedPtr<FJsonValue> FFirebaseJsonDocument::GetField(const FString& Key) const
+{
+	if (Tape.IsValid())
+	{
+		// Only the requested subtree is converted
+		const FFirebaseJsonTape::FValue Field = FindTapeField(*Tape, Key);
+		return Field.IsValid() ? Field.ToJsonValue() : nullptr;
+	}
+
+	if (!Root.IsValid() || Root->Type != EJson::Object)
+	{
+		return nullptr;
+	}
+	return Root->AsObject()->TryGetField(Key);
+}
+
+bool FFirebaseJsonDocument::GetFieldAsString(const FString& Key, FString& OutValue) const
+{
+	if (Tape.IsValid())
+	{
+		const FFirebaseJsonTape::FValue Field = FindTapeField(*Tape, Key);
+		if (!Field.IsValid())
+		{
+			return false;
+		}
+
+		// Scalars are formatted straight from the tape
+		switch (Field.GetType())
+		{
+		case EFirebaseJsonTapeType::String:
+			OutValue = Field.AsString();
+			return true;
+		case EFirebaseJsonTapeType::Number:
+			OutValue = FString::SanitizeFloat(Field.AsNumber());
+			return true;
+		case EFirebaseJsonTapeType::True:
+		case EFirebaseJsonTapeType::False:
+			OutValue = Field.AsBool() ? TEXT("true") : TEXT("false");
+			return true;
+		default:
+			OutValue = ValueToString(Field.ToJsonValue());
+			return true;
+		}
+	}
+
+	TSharedPtr<FJsonValue> Value = GetField(Key);
+	if (!Value.IsValid())
+	{
+		return false;
+	}
+
+	OutValue = ValueToString(Value);
+	return true;
+}
+
+FString FFirebaseJsonDocument::ValueToString(const TSharedPtr<FJsonValue>& Value)
+{
+	if (!Value.IsValid())
+	{
+		return FString();
+	}
+
+	switch (Value->Type)
+	{
+	case EJson::String:
+		return Value->AsString();
+
+	case EJson::Number:
+		return FString::SanitizeFloat(Value->AsNumber());
+
+	case EJson::Boolean:
+		return Value->AsBool() ? TEXT("true") : TEXT("false");
+
+	default:
+	{
+		// For objects or arrays, serialize back to string
+		FString OutputString;
+		TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
+		FJsonSerializer::Serialize(Value.ToSharedRef(), TEXT(""), Writer);
+		return OutputString;
+	}
+	}
+}
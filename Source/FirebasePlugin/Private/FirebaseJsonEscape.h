@@ -0,0 +1,155 @@
+// Copyright. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * JSON string escape handling shared by the UTF-8 parsers
+ */
+namespace FirebaseJsonEscape
+{
+	inline int32 HexValue(uint8 Character)
+	{
+		if (Character >= '0' && Character <= '9') return Character - '0';
+		if (Character >= 'a' && Character <= 'f') return Character - 'a' + 10;
+		if (Character >= 'A' && Character <= 'F') return Character - 'A' + 10;
+		return -1;
+	}
+
+	inline bool ParseHex4(const uint8* Data, int32 Size, int32 Position, uint32& OutValue)
+	{
+		if (Position + 4 > Size)
+		{
+			return false;
+		}
+
+		OutValue = 0;
+		for (int32 Index = 0; Index < 4; ++Index)
+		{
+			const int32 Digit = HexValue(Data[Position + Index]);
+			if (Digit < 0)
+			{
+				return false;
+			}
+			OutValue = (OutValue << 4) | uint32(Digit);
+		}
+		return true;
+	}
+
+	template<typename AllocatorType>
+	void AppendUtf8(TArray<uint8, AllocatorType>& Out, uint32 CodePoint)
+	{
+		if (CodePoint < 0x80)
+		{
+			Out.Add(uint8(CodePoint));
+		}
+		else if (CodePoint < 0x800)
+		{
+			Out.Add(uint8(0xC0 | (CodePoint >> 6)));
+			Out.Add(uint8(0x80 | (CodePoint & 0x3F)));
+		}
+		else if (CodePoint < 0x10000)
+		{
+			Out.Add(uint8(0xE0 | (CodePoint >> 12)));
+			Out.Add(uint8(0x80 | ((CodePoint >> 6) & 0x3F)));
+			Out.Add(uint8(0x80 | (CodePoint & 0x3F)));
+		}
+		else
+		{
+			Out.Add(uint8(0xF0 | (CodePoint >> 18)));
+			Out.Add(uint8(0x80 | ((CodePoint >> 12) & 0x3F)));
+			Out.Add(uint8(0x80 | ((CodePoint >> 6) & 0x3F)));
+			Out.Add(uint8(0x80 | (CodePoint & 0x3F)));
+		}
+	}
+
+	/**
+	 * Decode a JSON string body starting at Cursor (just past the opening quote)
+	 * and append it to Out as UTF-8. On success Cursor is left on the closing
+	 * quote. Fails on an invalid escape or a missing closing quote.
+	 */
+	template<typename AllocatorType>
+	bool DecodeString(const uint8* Data, int32 Size, int32& Cursor, TArray<uint8, AllocatorType>& Out)
+	{
+		while (Cursor < Size)
+		{
+			const uint8 Character = Data[Cursor];
+			if (Character == '"')
+			{
+				return true;
+			}
+			if (Character != '\\')
+			{
+				Out.Add(Character);
+				++Cursor;
+				continue;
+			}
+
+			if (Cursor + 1 >= Size)
+			{
+				return false;
+			}
+
+			const uint8 Escape = Data[Cursor + 1];
+			Cursor += 2;
+			switch (Escape)
+			{
+			case '"': case '\\': case '/':
+				Out.Add(Escape);
+				break;
+			case 'b': Out.Add('\b'); break;
+			case 'f': Out.Add('\f'); break;
+			case 'n': Out.Add('\n'); break;
+			case 'r': Out.Add('\r'); break;
+			case 't': Out.Add('\t'); break;
+			case 'u':
+			{
+				uint32 CodePoint = 0;
+				if (!ParseHex4(Data, Size, Cursor, CodePoint))
+				{
+					return false;
+				}
+				Cursor += 4;
+
+				// Combine a UTF-16 surrogate pair; a lone surrogate becomes U+FFFD
+				if (CodePoint >= 0xD800 && CodePoint <= 0xDBFF)
+				{
+					uint32 Low = 0;
+					if (Cursor + 1 < Size && Data[Cursor] == '\\' && Data[Cursor + 1] == 'u'
+						&& ParseHex4(Data, Size, Cursor + 2, Low) && Low >= 0xDC00 && Low <= 0xDFFF)
+					{
+						CodePoint = 0x10000 + ((CodePoint - 0xD800) << 10) + (Low - 0xDC00);
+						Cursor += 6;
+					}
+					else
+					{
+						CodePoint = 0xFFFD;
+					}
+				}
+				else if (CodePoint >= 0xDC00 && CodePoint <= 0xDFFF)
+				{
+					CodePoint = 0xFFFD;
+				}
+
+				AppendUtf8(Out, CodePoint);
+				break;
+			}
+			default:
+				return false;
+			}
+		}
+		return false;
+	}
+
+	/** Transcode UTF-8 text to an FString */
+	inline FString Utf8ToString(FUtf8StringView Text)
+	{
+		if (Text.IsEmpty())
+		{
+			return FString();
+		}
+		FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Text.GetData()), Text.Len());
+		return FString(Converter.Length(), Converter.Get());
+	}
+}
@@ -0,0 +1,450 @@
+// Copyright. All Rights Reserved.
+
+#include "FirebaseJsonPath.h"
+#include "FirebaseJsonDocument.h"
+#include "FirebaseJsonEscape.h"
+#include "Algo/Reverse.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace FirebaseJsonPath
+{
+	/**
+	 * Requested paths merged into a prefix tree, so shared prefixes are walked once
+	 */
+	struct FPathTree
+	{
+		struct FNode
+		{
+			int32 SegmentOffset = 0;
+			int32 SegmentLength = 0;
+			int32 FirstChild = INDEX_NONE;
+			int32 NextSibling = INDEX_NONE;
+
+			/** First path ending at this node; further ones chain through NextTarget */
+			int32 FirstTarget = INDEX_NONE;
+		};
+
+		TArray<FNode, TInlineAllocator<16>> Nodes;
+		TArray<uint8, TInlineAllocator<256>> SegmentBytes;
+		TArray<int32, TInlineAllocator<8>> NextTarget;
+
+		explicit FPathTree(int32 NumPaths)
+		{
+			Nodes.AddDefaulted();
+			NextTarget.Init(INDEX_NONE, NumPaths);
+		}
+
+		FUtf8StringView GetSegment(const FNode& Node) const
+		{
+			return FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(SegmentBytes.GetData() + Node.SegmentOffset), Node.SegmentLength);
+		}
+
+		int32 FindChild(int32 Parent, FUtf8StringView Key) const
+		{
+			for (int32 Child = Nodes[Parent].FirstChild; Child != INDEX_NONE; Child = Nodes[Child].NextSibling)
+			{
+				const FUtf8StringView Segment = GetSegment(Nodes[Child]);
+				if (Segment.Len() == Key.Len() && FMemory::Memcmp(Segment.GetData(), Key.GetData(), Key.Len()) == 0)
+				{
+					return Child;
+				}
+			}
+			return INDEX_NONE;
+		}
+
+		void AddPath(FStringView Path, int32 PathIndex)
+		{
+			FTCHARToUTF8 Utf8(Path.GetData(), Path.Len());
+			const uint8* Bytes = reinterpret_cast<const uint8*>(Utf8.Get());
+			const int32 Length = Utf8.Length();
+
+			int32 Node = 0;
+			int32 SegmentStart = 0;
+			for (int32 Index = 0; Index <= Length; ++Index)
+			{
+				if (Index < Length && Bytes[Index] != '/')
+				{
+					continue;
+				}
+
+				// Empty segments ("a//b", leading or trailing slashes) are ignored
+				if (Index > SegmentStart)
+				{
+					const FUtf8StringView Segment(reinterpret_cast<const UTF8CHAR*>(Bytes + SegmentStart), Index - SegmentStart);
+					int32 Child = FindChild(Node, Segment);
+					if (Child == INDEX_NONE)
+					{
+						Child = Nodes.AddDefaulted();
+						Nodes[Child].SegmentOffset = SegmentBytes.Num();
+						Nodes[Child].SegmentLength = Segment.Len();
+						Nodes[Child].NextSibling = Nodes[Node].FirstChild;
+						Nodes[Node].FirstChild = Child;
+						SegmentBytes.Append(Bytes + SegmentStart, Segment.Len());
+					}
+					Node = Child;
+				}
+				SegmentStart = Index + 1;
+			}
+
+			NextTarget[PathIndex] = Nodes[Node].FirstTarget;
+			Nodes[Node].FirstTarget = PathIndex;
+		}
+	};
+
+	enum class EWalkResult : uint8
+	{
+		Continue,
+		/** Every path has been found */
+		Done,
+		Malformed
+	};
+
+	/**
+	 * Single forward pass over the text, guided by the path tree
+	 */
+	struct FScanner
+	{
+		const uint8* Data = nullptr;
+		int32 Size = 0;
+		int32 Cursor = 0;
+		const FPathTree& Tree;
+		FUtf8StringView* OutValues = nullptr;
+		int32 Remaining = 0;
+
+		FScanner(FUtf8StringView Json, const FPathTree& InTree, FUtf8StringView* InOutValues, int32 NumPaths)
+			: Data(reinterpret_cast<const uint8*>(Json.GetData()))
+			, Size(Json.Len())
+			, Tree(InTree)
+			, OutValues(InOutValues)
+			, Remaining(NumPaths)
+		{
+		}
+
+		static bool IsTerminator(uint8 Character)
+		{
+			switch (Character)
+			{
+			case '{': case '}': case '[': case ']': case ':': case ',': case '"':
+			case ' ': case '\t': case '\n': case '\r':
+				return true;
+			default:
+				return false;
+			}
+		}
+
+		void SkipWhitespace()
+		{
+			while (Cursor < Size && (Data[Cursor] == ' ' || Data[Cursor] == '\n' || Data[Cursor] == '\r' || Data[Cursor] == '\t'))
+			{
+				++Cursor;
+			}
+		}
+
+		/** Cursor on an opening quote; leaves it just past the closing quote */
+		bool SkipString()
+		{
+			++Cursor;
+			while (Cursor < Size)
+			{
+				const uint8 Character = Data[Cursor];
+				if (Character == '"')
+				{
+					++Cursor;
+					return true;
+				}
+				Cursor += Character == '\\' ? 2 : 1;
+			}
+			return false;
+		}
+
+		/** Skip one value by matching brackets; strings are the only thing looked into */
+		bool SkipValue()
+		{
+			if (Cursor >= Size)
+			{
+				return false;
+			}
+
+			switch (Data[Cursor])
+			{
+			case '"':
+				return SkipString();
+
+			case '{':
+			case '[':
+			{
+				int32 Depth = 0;
+				while (Cursor < Size)
+				{
+					const uint8 Character = Data[Cursor];
+					if (Character == '"')
+					{
+						if (!SkipString())
+						{
+							return false;
+						}
+						continue;
+					}
+					if (Character == '{' || Character == '[')
+					{
+						++Depth;
+					}
+					else if ((Character == '}' || Character == ']') && --Depth == 0)
+					{
+						++Cursor;
+						return true;
+					}
+					++Cursor;
+				}
+				return false;
+			}
+
+			default:
+			{
+				const int32 Start = Cursor;
+				while (Cursor < Size && !IsTerminator(Data[Cursor]))
+				{
+					++Cursor;
+				}
+				return Cursor > Start;
+			}
+			}
+		}
+
+		/** Child of Parent named by the raw (possibly escaped) key bytes */
+		int32 FindKeyChild(int32 Parent, int32 KeyStart, int32 KeyEnd) const
+		{
+			const FUtf8StringView Key(reinterpret_cast<const UTF8CHAR*>(Data + KeyStart), KeyEnd - KeyStart);
+			int32 EscapeIndex = INDEX_NONE;
+			if (!Key.FindChar(UTF8CHAR('\\'), EscapeIndex))
+			{
+				return Tree.FindChild(Parent, Key);
+			}
+
+			TArray<uint8, TInlineAllocator<128>> Decoded;
+			int32 DecodeCursor = KeyStart;
+			if (!FirebaseJsonEscape::DecodeString(Data, KeyEnd + 1, DecodeCursor, Decoded))
+			{
+				return INDEX_NONE;
+			}
+			return Tree.FindChild(Parent, FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Decoded.GetData()), Decoded.Num()));
+		}
+
+		/** Child of Parent named by an array index */
+		int32 FindIndexChild(int32 Parent, int32 Index) const
+		{
+			UTF8CHAR Digits[16];
+			int32 Length = 0;
+			do
+			{
+				Digits[Length++] = UTF8CHAR('0' + Index % 10);
+				Index /= 10;
+			}
+			while (Index > 0);
+			Algo::Reverse(Digits, Length);
+			return Tree.FindChild(Parent, FUtf8StringView(Digits, Length));
+		}
+
+		/** Consume the value at Cursor for tree node Node (INDEX_NONE = not on any path) */
+		EWalkResult Visit(int32 Node)
+		{
+			if (Node == INDEX_NONE)
+			{
+				return SkipValue() ? EWalkResult::Continue : EWalkResult::Malformed;
+			}
+
+			const int32 Start = Cursor;
+			const EWalkResult Result = Walk(Node);
+			if (Result != EWalkResult::Continue)
+			{
+				return Result;
+			}
+
+			for (int32 Target = Tree.Nodes[Node].FirstTarget; Target != INDEX_NONE; Target = Tree.NextTarget[Target])
+			{
+				// First occurrence wins if a key is duplicated
+				if (OutValues[Target].IsEmpty())
+				{
+					OutValues[Target] = FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Data + Start), Cursor - Start);
+					--Remaining;
+				}
+			}
+			return Remaining == 0 ? EWalkResult::Done : EWalkResult::Continue;
+		}
+
+		/** Consume the value at Cursor, descending only into children of Node */
+		EWalkResult Walk(int32 Node)
+		{
+			if (Tree.Nodes[Node].FirstChild == INDEX_NONE || Cursor >= Size)
+			{
+				return SkipValue() ? EWalkResult::Continue : EWalkResult::Malformed;
+			}
+
+			const uint8 Open = Data[Cursor];
+			if (Open != '{' && Open != '[')
+			{
+				// A scalar where the path expects children: the path does not exist
+				return SkipValue() ? EWalkResult::Continue : EWalkResult::Malformed;
+			}
+
+			const bool bObject = Open == '{';
+			const uint8 Close = bObject ? '}' : ']';
+			++Cursor;
+			SkipWhitespace();
+			if (Cursor < Size && Data[Cursor] == Close)
+			{
+				++Cursor;
+				return EWalkResult::Continue;
+			}
+
+			int32 ElementIndex = 0;
+			while (true)
+			{
+				SkipWhitespace();
+				int32 Child = INDEX_NONE;
+				if (bObject)
+				{
+					if (Cursor >= Size || Data[Cursor] != '"')
+					{
+						return EWalkResult::Malformed;
+					}
+					const int32 KeyStart = Cursor + 1;
+					if (!SkipString())
+					{
+						return EWalkResult::Malformed;
+					}
+					const int32 KeyEnd = Cursor - 1;
+
+					SkipWhitespace();
+					if (Cursor >= Size || Data[Cursor] != ':')
+					{
+						return EWalkResult::Malformed;
+					}
+					++Cursor;
+					SkipWhitespace();
+					Child = FindKeyChild(Node, KeyStart, KeyEnd);
+				}
+				else
+				{
+					Child = FindIndexChild(Node, ElementIndex++);
+				}
+
+				const EWalkResult Result = Visit(Child);
+				if (Result != EWalkResult::Continue)
+				{
+					return Result;
+				}
+
+				SkipWhitespace();
+				if (Cursor >= Size)
+				{
+					return EWalkResult::Malformed;
+				}
+				if (Data[Cursor] == ',')
+				{
+					++Cursor;
+					continue;
+				}
+				if (Data[Cursor] == Close)
+				{
+					++Cursor;
+					return EWalkResult::Continue;
+				}
+				return EWalkResult::Malformed;
+			}
+		}
+	};
+
+	static int32 FindPaths(FUtf8StringView Json, const FPathTree& Tree, FUtf8StringView* OutValues, int32 NumPaths)
+	{
+		FScanner Scanner(Json, Tree, OutValues, NumPaths);
+		Scanner.SkipWhitespace();
+		if (Scanner.Cursor < Scanner.Size)
+		{
+			// Values found before malformed input are still returned
+			Scanner.Visit(0);
+		}
+		return NumPaths - Scanner.Remaining;
+	}
+}
+
+bool FFirebaseJsonPath::FindRaw(FUtf8StringView Json, FStringView Path, FUtf8StringView& OutValue)
+{
+	FirebaseJsonPath::FPathTree Tree(1);
+	Tree.AddPath(Path, 0);
+
+	OutValue = FUtf8StringView();
+	return FirebaseJsonPath::FindPaths(Json, Tree, &OutValue, 1) == 1;
+}
+
+int32 FFirebaseJsonPath::FindRaw(FUtf8StringView Json, TConstArrayView<FString> Paths, TArray<FUtf8StringView>& OutValues)
+{
+	OutValues.Reset(Paths.Num());
+	OutValues.SetNum(Paths.Num());
+	if (Paths.Num() == 0)
+	{
+		return 0;
+	}
+
+	FirebaseJsonPath::FPathTree Tree(Paths.Num());
+	for (int32 Index = 0; Index < Paths.Num(); ++Index)
+	{
+		Tree.AddPath(Paths[Index], Index);
+	}
+
+	return FirebaseJsonPath::FindPaths(Json, Tree, OutValues.GetData(), Paths.Num());
+}
+
+FString FFirebaseJsonPath::FormatValue(FUtf8StringView RawValue)
+{
+	if (RawValue.IsEmpty())
+	{
+		return FString();
+	}
+
+	const uint8* Data = reinterpret_cast<const uint8*>(RawValue.GetData());
+	const int32 Size = RawValue.Len();
+
+	switch (Data[0])
+	{
+	case '"':
+	{
+		TArray<uint8, TInlineAllocator<256>> Decoded;
+		int32 Cursor = 1;
+		if (!FirebaseJsonEscape::DecodeString(Data, Size, Cursor, Decoded))
+		{
+			return FString();
+		}
+		return FirebaseJsonEscape::Utf8ToString(FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Decoded.GetData()), Decoded.Num()));
+	}
+
+	case 't':
+		return TEXT("true");
+
+	case 'f':
+		return TEXT("false");
+
+	case '{':
+	case '[':
+	case 'n':
+	{
+		// Only the extracted value is parsed, to match GetJsonValue formatting
+		TSharedPtr<FJsonValue> Value;
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(FirebaseJsonEscape::Utf8ToString(RawValue));
+		if (FJsonSerializer::Deserialize(Reader, Value))
+		{
+			return FFirebaseJsonDocument::ValueToString(Value);
+		}
+		return FirebaseJsonEscape::Utf8ToString(RawValue);
+	}
+
+	default:
+	{
+		TArray<ANSICHAR, TInlineAllocator<64>> Text;
+		Text.Append(reinterpret_cast<const ANSICHAR*>(Data), Size);
+		Text.Add('\0');
+		return FString::SanitizeFloat(FCStringAnsi::Atod(Text.GetData()));
+	}
+	}
+}
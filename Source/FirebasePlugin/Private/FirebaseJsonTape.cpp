@@ -0,0 +1,876 @@
+// Copyright. All Rights Reserved.
+
+#include "FirebaseJsonTape.h"
+#include "FirebaseMemory.h"
+#include "FirebaseJsonEscape.h"
+#include "Dom/JsonObject.h"
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+	#include <arm_neon.h>
+	#define FIREBASE_JSON_SIMD_NEON 1
+#elif (defined(PLATFORM_ALWAYS_HAS_AVX_2) && PLATFORM_ALWAYS_HAS_AVX_2) || defined(__AVX2__)
+	#include <immintrin.h>
+	#define FIREBASE_JSON_SIMD_AVX2 1
+#elif PLATFORM_ENABLE_VECTORINTRINSICS
+	#include <emmintrin.h>
+	#define FIREBASE_JSON_SIMD_SSE2 1
+#endif
+
+#ifndef FIREBASE_JSON_SIMD_NEON
+	#define FIREBASE_JSON_SIMD_NEON 0
+#endif
+#ifndef FIREBASE_JSON_SIMD_AVX2
+	#define FIREBASE_JSON_SIMD_AVX2 0
+#endif
+#ifndef FIREBASE_JSON_SIMD_SSE2
+	#define FIREBASE_JSON_SIMD_SSE2 0
+#endif
+
+namespace FirebaseJsonTape
+{
+	constexpr int32 BlockSize = 64;
+	constexpr int32 MaxDepth = 1024;
+
+	// Word layout: type in the top byte, payload in the low 56 bits
+	constexpr int32 TypeShift = 56;
+	constexpr uint64 PayloadMask = (uint64(1) << TypeShift) - 1;
+
+	// String payload flag: text lives in the decoded string buffer, not the input
+	constexpr uint64 DecodedStringFlag = uint64(1) << 55;
+	constexpr uint64 StringOffsetMask = DecodedStringFlag - 1;
+
+	FORCEINLINE uint64 MakeWord(EFirebaseJsonTapeType Type, uint64 Payload)
+	{
+		return (uint64(Type) << TypeShift) | (Payload & PayloadMask);
+	}
+
+	FORCEINLINE EFirebaseJsonTapeType GetWordType(uint64 Word)
+	{
+		return static_cast<EFirebaseJsonTapeType>(Word >> TypeShift);
+	}
+
+	FORCEINLINE uint64 GetWordPayload(uint64 Word)
+	{
+		return Word & PayloadMask;
+	}
+
+	/** One bit per byte of a 64-byte block for each character class */
+	struct FBlockMasks
+	{
+		uint64 Backslash = 0;
+		uint64 Quote = 0;
+		uint64 Operator = 0;
+		uint64 Whitespace = 0;
+	};
+
+	static void ClassifyBlockScalar(const uint8* Block, FBlockMasks& Out)
+	{
+		Out = FBlockMasks();
+		for (int32 Index = 0; Index < BlockSize; ++Index)
+		{
+			const uint64 Bit = uint64(1) << Index;
+			switch (Block[Index])
+			{
+			case '\\':
+				Out.Backslash |= Bit;
+				break;
+			case '"':
+				Out.Quote |= Bit;
+				break;
+			case '{': case '}': case '[': case ']': case ':': case ',':
+				Out.Operator |= Bit;
+				break;
+			case ' ': case '\t': case '\n': case '\r':
+				Out.Whitespace |= Bit;
+				break;
+			default:
+				break;
+			}
+		}
+	}
+
+	// '[' and ']' differ from '{' and '}' only in bit 5, so OR-ing 0x20 lets
+	// two compares find all four brackets.
+
+#if FIREBASE_JSON_SIMD_AVX2
+	static FORCEINLINE __m256i Equal(__m256i Bytes, char Character)
+	{
+		return _mm256_cmpeq_epi8(Bytes, _mm256_set1_epi8(Character));
+	}
+
+	static FORCEINLINE uint64 ToMask(__m256i Low, __m256i High)
+	{
+		return uint64(uint32(_mm256_movemask_epi8(Low))) | (uint64(uint32(_mm256_movemask_epi8(High))) << 32);
+	}
+
+	static FORCEINLINE __m256i MatchOperators(__m256i Bytes)
+	{
+		const __m256i Folded = _mm256_or_si256(Bytes, _mm256_set1_epi8(0x20));
+		return _mm256_or_si256(
+			_mm256_or_si256(Equal(Folded, '{'), Equal(Folded, '}')),
+			_mm256_or_si256(Equal(Bytes, ':'), Equal(Bytes, ',')));
+	}
+
+	static FORCEINLINE __m256i MatchWhitespace(__m256i Bytes)
+	{
+		return _mm256_or_si256(
+			_mm256_or_si256(Equal(Bytes, ' '), Equal(Bytes, '\t')),
+			_mm256_or_si256(Equal(Bytes, '\n'), Equal(Bytes, '\r')));
+	}
+
+	static void ClassifyBlockSimd(const uint8* Block, FBlockMasks& Out)
+	{
+		const __m256i Low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Block));
+		const __m256i High = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Block + 32));
+
+		Out.Backslash = ToMask(Equal(Low, '\\'), Equal(High, '\\'));
+		Out.Quote = ToMask(Equal(Low, '"'), Equal(High, '"'));
+		Out.Operator = ToMask(MatchOperators(Low), MatchOperators(High));
+		Out.Whitespace = ToMask(MatchWhitespace(Low), MatchWhitespace(High));
+	}
+#elif FIREBASE_JSON_SIMD_SSE2
+	static FORCEINLINE __m128i Equal(__m128i Bytes, char Character)
+	{
+		return _mm_cmpeq_epi8(Bytes, _mm_set1_epi8(Character));
+	}
+
+	static FORCEINLINE uint64 ToMask(__m128i A, __m128i B, __m128i C, __m128i D)
+	{
+		return uint64(uint32(_mm_movemask_epi8(A)))
+			| (uint64(uint32(_mm_movemask_epi8(B))) << 16)
+			| (uint64(uint32(_mm_movemask_epi8(C))) << 32)
+			| (uint64(uint32(_mm_movemask_epi8(D))) << 48);
+	}
+
+	static FORCEINLINE __m128i MatchOperators(__m128i Bytes)
+	{
+		const __m128i Folded = _mm_or_si128(Bytes, _mm_set1_epi8(0x20));
+		return _mm_or_si128(
+			_mm_or_si128(Equal(Folded, '{'), Equal(Folded, '}')),
+			_mm_or_si128(Equal(Bytes, ':'), Equal(Bytes, ',')));
+	}
+
+	static FORCEINLINE __m128i MatchWhitespace(__m128i Bytes)
+	{
+		return _mm_or_si128(
+			_mm_or_si128(Equal(Bytes, ' '), Equal(Bytes, '\t')),
+			_mm_or_si128(Equal(Bytes, '\n'), Equal(Bytes, '\r')));
+	}
+
+	static void ClassifyBlockSimd(const uint8* Block, FBlockMasks& Out)
+	{
+		const __m128i A = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Block));
+		const __m128i B = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Block + 16));
+		const __m128i C = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Block + 32));
+		const __m128i D = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Block + 48));
+
+		Out.Backslash = ToMask(Equal(A, '\\'), Equal(B, '\\'), Equal(C, '\\'), Equal(D, '\\'));
+		Out.Quote = ToMask(Equal(A, '"'), Equal(B, '"'), Equal(C, '"'), Equal(D, '"'));
+		Out.Operator = ToMask(MatchOperators(A), MatchOperators(B), MatchOperators(C), MatchOperators(D));
+		Out.Whitespace = ToMask(MatchWhitespace(A), MatchWhitespace(B), MatchWhitespace(C), MatchWhitespace(D));
+	}
+#elif FIREBASE_JSON_SIMD_NEON
+	static FORCEINLINE uint8x16_t Equal(uint8x16_t Bytes, uint8 Character)
+	{
+		return vceqq_u8(Bytes, vdupq_n_u8(Character));
+	}
+
+	/** Collapse four compare results (0x00/0xFF per byte) into one bit per byte */
+	static FORCEINLINE uint64 ToMask(uint8x16_t A, uint8x16_t B, uint8x16_t C, uint8x16_t D)
+	{
+		static const uint8 BitValues[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+		const uint8x16_t Bits = vld1q_u8(BitValues);
+		uint8x16_t Sum0 = vpaddq_u8(vandq_u8(A, Bits), vandq_u8(B, Bits));
+		const uint8x16_t Sum1 = vpaddq_u8(vandq_u8(C, Bits), vandq_u8(D, Bits));
+		Sum0 = vpaddq_u8(Sum0, Sum1);
+		Sum0 = vpaddq_u8(Sum0, Sum0);
+		return vgetq_lane_u64(vreinterpretq_u64_u8(Sum0), 0);
+	}
+
+	static FORCEINLINE uint8x16_t MatchOperators(uint8x16_t Bytes)
+	{
+		const uint8x16_t Folded = vorrq_u8(Bytes, vdupq_n_u8(0x20));
+		return vorrq_u8(
+			vorrq_u8(Equal(Folded, '{'), Equal(Folded, '}')),
+			vorrq_u8(Equal(Bytes, ':'), Equal(Bytes, ',')));
+	}
+
+	static FORCEINLINE uint8x16_t MatchWhitespace(uint8x16_t Bytes)
+	{
+		return vorrq_u8(
+			vorrq_u8(Equal(Bytes, ' '), Equal(Bytes, '\t')),
+			vorrq_u8(Equal(Bytes, '\n'), Equal(Bytes, '\r')));
+	}
+
+	static void ClassifyBlockSimd(const uint8* Block, FBlockMasks& Out)
+	{
+		const uint8x16_t A = vld1q_u8(Block);
+		const uint8x16_t B = vld1q_u8(Block + 16);
+		const uint8x16_t C = vld1q_u8(Block + 32);
+		const uint8x16_t D = vld1q_u8(Block + 48);
+
+		Out.Backslash = ToMask(Equal(A, '\\'), Equal(B, '\\'), Equal(C, '\\'), Equal(D, '\\'));
+		Out.Quote = ToMask(Equal(A, '"'), Equal(B, '"'), Equal(C, '"'), Equal(D, '"'));
+		Out.Operator = ToMask(MatchOperators(A), MatchOperators(B), MatchOperators(C), MatchOperators(D));
+		Out.Whitespace = ToMask(MatchWhitespace(A), MatchWhitespace(B), MatchWhitespace(C), MatchWhitespace(D));
+	}
+#endif
+
+	/**
+	 * Bits of characters preceded by an odd run of backslashes.
+	 * PrevEscaped carries a run that crosses into the next block.
+	 */
+	static FORCEINLINE uint64 FindEscaped(uint64 Backslash, uint64& PrevEscaped)
+	{
+		constexpr uint64 EvenBits = 0x5555555555555555ull;
+
+		Backslash &= ~PrevEscaped;
+		const uint64 FollowsEscape = (Backslash << 1) | PrevEscaped;
+
+		// Adding the run starts at odd positions carries through each run;
+		// runs that started on an even bit come out inverted
+		const uint64 OddSequenceStarts = Backslash & ~EvenBits & ~FollowsEscape;
+		const uint64 SequencesStartingOnEvenBits = OddSequenceStarts + Backslash;
+		PrevEscaped = SequencesStartingOnEvenBits < OddSequenceStarts ? 1 : 0;
+
+		const uint64 InvertMask = SequencesStartingOnEvenBits << 1;
+		return (EvenBits ^ InvertMask) & FollowsEscape;
+	}
+
+	/** Bit i = XOR of bits 0..i; turns quote positions into an inside-string mask */
+	static FORCEINLINE uint64 PrefixXor(uint64 Bits)
+	{
+		Bits ^= Bits << 1;
+		Bits ^= Bits << 2;
+		Bits ^= Bits << 4;
+		Bits ^= Bits << 8;
+		Bits ^= Bits << 16;
+		Bits ^= Bits << 32;
+		return Bits;
+	}
+
+	/**
+	 * Stage 1: offsets of every operator outside strings, every opening quote
+	 * and the first byte of every scalar. Returns false on an unterminated string.
+	 */
+	static bool FindStructuralIndices(const uint8* Data, int32 Size, bool bAllowSimd, TArray<uint32>& OutIndices)
+	{
+		OutIndices.Reset(Size / 4 + BlockSize);
+
+		uint64 PrevEscaped = 0;
+		uint64 PrevInString = 0;
+		uint64 PrevScalar = 0;
+		uint8 TailBlock[BlockSize];
+
+		for (int32 Offset = 0; Offset < Size; Offset += BlockSize)
+		{
+			const uint8* Block = Data + Offset;
+			const int32 Remaining = Size - Offset;
+			if (Remaining < BlockSize)
+			{
+				// Pad the last block with whitespace, which never produces an index
+				FMemory::Memset(TailBlock, ' ', BlockSize);
+				FMemory::Memcpy(TailBlock, Block, Remaining);
+				Block = TailBlock;
+			}
+
+			FBlockMasks Masks;
+#if FIREBASE_JSON_SIMD_AVX2 || FIREBASE_JSON_SIMD_SSE2 || FIREBASE_JSON_SIMD_NEON
+			if (bAllowSimd)
+			{
+				ClassifyBlockSimd(Block, Masks);
+			}
+			else
+#endif
+			{
+				ClassifyBlockScalar(Block, Masks);
+			}
+
+			const uint64 Escaped = FindEscaped(Masks.Backslash, PrevEscaped);
+			const uint64 Quotes = Masks.Quote & ~Escaped;
+
+			// Set from an opening quote up to (not including) its closing quote
+			const uint64 InString = PrefixXor(Quotes) ^ PrevInString;
+			PrevInString = uint64(int64(InString) >> 63);
+
+			const uint64 Scalar = ~(Masks.Operator | Masks.Whitespace | Quotes) & ~InString;
+			const uint64 ScalarStarts = Scalar & ~((Scalar << 1) | PrevScalar);
+			PrevScalar = Scalar >> 63;
+
+			uint64 Structurals = (Masks.Operator & ~InString) | (Quotes & InString) | ScalarStarts;
+			if (Structurals == 0)
+			{
+				continue;
+			}
+
+			const int32 Count = FMath::CountBits(Structurals);
+			uint32* Out = OutIndices.GetData() + OutIndices.AddUninitialized(Count);
+			while (Structurals != 0)
+			{
+				*Out++ = uint32(Offset) + uint32(FMath::CountTrailingZeros64(Structurals));
+				Structurals &= Structurals - 1;
+			}
+		}
+
+		return PrevInString == 0;
+	}
+
+	FORCEINLINE bool IsDigit(uint8 Character)
+	{
+		return Character >= '0' && Character <= '9';
+	}
+
+	/** Whether a character may end a literal or number */
+	FORCEINLINE bool IsTerminator(uint8 Character)
+	{
+		switch (Character)
+		{
+		case '{': case '}': case '[': case ']': case ':': case ',': case '"':
+		case ' ': case '\t': case '\n': case '\r':
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	static bool KeyEquals(FUtf8StringView A, FUtf8StringView B)
+	{
+		return A.Len() == B.Len() && FMemory::Memcmp(A.GetData(), B.GetData(), A.Len()) == 0;
+	}
+}
+
+// === PARSING ===
+
+bool FFirebaseJsonTape::Parse(const FFirebasePayload& InPayload, bool bAllowSimd)
+{
+	LLM_SCOPE_BYTAG(Firebase_Json);
+	Payload = InPayload;
+	Words.Reset();
+	Strings.Reset();
+	Error.Reset();
+	bValid = false;
+
+	TArray<uint32> Indices;
+	if (!FirebaseJsonTape::FindStructuralIndices(Payload.GetData(), Payload.Num(), bAllowSimd, Indices))
+	{
+		return Fail(TEXT("Unterminated string"), uint32(Payload.Num()));
+	}
+
+	bValid = BuildTape(Indices);
+	return bValid;
+}
+
+bool FFirebaseJsonTape::BuildTape(const TArray<uint32>& Indices)
+{
+	enum class EExpect : uint8
+	{
+		Value,
+		ObjectKeyOrEnd,
+		ObjectKey,
+		Colon,
+		ObjectCommaOrEnd,
+		ArrayValueOrEnd,
+		ArrayCommaOrEnd,
+		Done
+	};
+
+	const uint8* Data = Payload.GetData();
+	TArray<int32, TInlineAllocator<64>> Stack;
+	EExpect Expect = EExpect::Value;
+
+	// Every index yields at most two words; most yield one or none
+	Words.Reserve(Indices.Num() + 2);
+
+	auto FinishValue = [&]()
+	{
+		if (Stack.Num() == 0)
+		{
+			Expect = EExpect::Done;
+		}
+		else
+		{
+			Expect = FirebaseJsonTape::GetWordType(Words[Stack.Last()]) == EFirebaseJsonTapeType::Object
+				? EExpect::ObjectCommaOrEnd
+				: EExpect::ArrayCommaOrEnd;
+		}
+	};
+
+	for (const uint32 Position : Indices)
+	{
+		const uint8 Character = Data[Position];
+		switch (Character)
+		{
+		case '{':
+		case '[':
+		{
+			if (Expect != EExpect::Value && Expect != EExpect::ArrayValueOrEnd)
+			{
+				return Fail(TEXT("Unexpected container"), Position);
+			}
+			if (Stack.Num() >= FirebaseJsonTape::MaxDepth)
+			{
+				return Fail(TEXT("Nesting too deep"), Position);
+			}
+
+			const bool bObject = Character == '{';
+			Stack.Push(Words.Num());
+			// Patched with the index of the matching end once it is known
+			Words.Add(FirebaseJsonTape::MakeWord(bObject ? EFirebaseJsonTapeType::Object : EFirebaseJsonTapeType::Array, 0));
+			Expect = bObject ? EExpect::ObjectKeyOrEnd : EExpect::ArrayValueOrEnd;
+			break;
+		}
+
+		case '}':
+		case ']':
+		{
+			const bool bObject = Character == '}';
+			const bool bCanClose = bObject
+				? (Expect == EExpect::ObjectKeyOrEnd || Expect == EExpect::ObjectCommaOrEnd)
+				: (Expect == EExpect::ArrayValueOrEnd || Expect == EExpect::ArrayCommaOrEnd);
+			if (!bCanClose || Stack.Num() == 0)
+			{
+				return Fail(TEXT("Unexpected end of container"), Position);
+			}
+
+			const int32 Open = Stack.Pop();
+			const int32 Close = Words.Num();
+			Words.Add(FirebaseJsonTape::MakeWord(bObject ? EFirebaseJsonTapeType::ObjectEnd : EFirebaseJsonTapeType::ArrayEnd, uint64(Open)));
+			Words[Open] = FirebaseJsonTape::MakeWord(bObject ? EFirebaseJsonTapeType::Object : EFirebaseJsonTapeType::Array, uint64(Close));
+			FinishValue();
+			break;
+		}
+
+		case ':':
+			if (Expect != EExpect::Colon)
+			{
+				return Fail(TEXT("Unexpected ':'"), Position);
+			}
+			Expect = EExpect::Value;
+			break;
+
+		case ',':
+			if (Expect == EExpect::ObjectCommaOrEnd)
+			{
+				Expect = EExpect::ObjectKey;
+			}
+			else if (Expect == EExpect::ArrayCommaOrEnd)
+			{
+				Expect = EExpect::Value;
+			}
+			else
+			{
+				return Fail(TEXT("Unexpected ','"), Position);
+			}
+			break;
+
+		case '"':
+			if (Expect == EExpect::ObjectKeyOrEnd || Expect == EExpect::ObjectKey)
+			{
+				if (!ParseString(Position))
+				{
+					return false;
+				}
+				Expect = EExpect::Colon;
+			}
+			else if (Expect == EExpect::Value || Expect == EExpect::ArrayValueOrEnd)
+			{
+				if (!ParseString(Position))
+				{
+					return false;
+				}
+				FinishValue();
+			}
+			else
+			{
+				return Fail(TEXT("Unexpected string"), Position);
+			}
+			break;
+
+		default:
+			if (Expect != EExpect::Value && Expect != EExpect::ArrayValueOrEnd)
+			{
+				return Fail(TEXT("Unexpected value"), Position);
+			}
+			if (!ParseScalar(Position))
+			{
+				return false;
+			}
+			FinishValue();
+			break;
+		}
+	}
+
+	if (Expect != EExpect::Done)
+	{
+		return Fail(TEXT("Unexpected end of input"), uint32(Payload.Num()));
+	}
+	return true;
+}
+
+bool FFirebaseJsonTape::ParseString(uint32 Position)
+{
+	const uint8* Data = Payload.GetData();
+	const int32 Size = Payload.Num();
+	const int32 Start = int32(Position) + 1;
+
+	int32 Cursor = Start;
+	while (Cursor < Size && Data[Cursor] != '"' && Data[Cursor] != '\\')
+	{
+		++Cursor;
+	}
+	if (Cursor >= Size)
+	{
+		return Fail(TEXT("Unterminated string"), Position);
+	}
+
+	if (Data[Cursor] == '"')
+	{
+		// No escapes: reference the input directly
+		Words.Add(FirebaseJsonTape::MakeWord(EFirebaseJsonTapeType::String, uint64(Start)));
+		Words.Add(uint64(Cursor - Start));
+		return true;
+	}
+
+	const int32 DecodedOffset = Strings.Num();
+	Strings.Append(Data + Start, Cursor - Start);
+	if (!FirebaseJsonEscape::DecodeString(Data, Size, Cursor, Strings))
+	{
+		return Fail(TEXT("Invalid string"), Position);
+	}
+
+	Words.Add(FirebaseJsonTape::MakeWord(EFirebaseJsonTapeType::String, FirebaseJsonTape::DecodedStringFlag | uint64(DecodedOffset)));
+	Words.Add(uint64(Strings.Num() - DecodedOffset));
+	return true;
+}
+
+bool FFirebaseJsonTape::ParseScalar(uint32 Position)
+{
+	const uint8* Data = Payload.GetData();
+	const int32 Size = Payload.Num();
+
+	auto MatchLiteral = [&](const char* Literal, int32 Length)
+	{
+		return int32(Position) + Length <= Size
+			&& FMemory::Memcmp(Data + Position, Literal, Length) == 0
+			&& (int32(Position) + Length == Size || FirebaseJsonTape::IsTerminator(Data[Position + Length]));
+	};
+
+	switch (Data[Position])
+	{
+	case 't':
+		if (!MatchLiteral("true", 4))
+		{
+			return Fail(TEXT("Invalid literal"), Position);
+		}
+		Words.Add(FirebaseJsonTape::MakeWord(EFirebaseJsonTapeType::True, 0));
+		return true;
+
+	case 'f':
+		if (!MatchLiteral("false", 5))
+		{
+			return Fail(TEXT("Invalid literal"), Position);
+		}
+		Words.Add(FirebaseJsonTape::MakeWord(EFirebaseJsonTapeType::False, 0));
+		return true;
+
+	case 'n':
+		if (!MatchLiteral("null", 4))
+		{
+			return Fail(TEXT("Invalid literal"), Position);
+		}
+		Words.Add(FirebaseJsonTape::MakeWord(EFirebaseJsonTapeType::Null, 0));
+		return true;
+
+	default:
+		break;
+	}
+
+	// Number: -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+	int32 Cursor = int32(Position);
+	const bool bNegative = Data[Cursor] == '-';
+	if (bNegative)
+	{
+		++Cursor;
+	}
+	if (Cursor >= Size || !FirebaseJsonTape::IsDigit(Data[Cursor]))
+	{
+		return Fail(TEXT("Invalid value"), Position);
+	}
+	if (Data[Cursor] == '0' && Cursor + 1 < Size && FirebaseJsonTape::IsDigit(Data[Cursor + 1]))
+	{
+		return Fail(TEXT("Leading zero in number"), Position);
+	}
+
+	uint64 Mantissa = 0;
+	int32 Digits = 0;
+	while (Cursor < Size && FirebaseJsonTape::IsDigit(Data[Cursor]))
+	{
+		Mantissa = Mantissa * 10 + uint64(Data[Cursor] - '0');
+		++Digits;
+		++Cursor;
+	}
+
+	bool bInteger = true;
+	if (Cursor < Size && Data[Cursor] == '.')
+	{
+		bInteger = false;
+		++Cursor;
+		if (Cursor >= Size || !FirebaseJsonTape::IsDigit(Data[Cursor]))
+		{
+			return Fail(TEXT("Invalid number"), Position);
+		}
+		while (Cursor < Size && FirebaseJsonTape::IsDigit(Data[Cursor]))
+		{
+			++Cursor;
+		}
+	}
+	if (Cursor < Size && (Data[Cursor] == 'e' || Data[Cursor] == 'E'))
+	{
+		bInteger = false;
+		++Cursor;
+		if (Cursor < Size && (Data[Cursor] == '+' || Data[Cursor] == '-'))
+		{
+			++Cursor;
+		}
+		if (Cursor >= Size || !FirebaseJsonTape::IsDigit(Data[Cursor]))
+		{
+			return Fail(TEXT("Invalid number"), Position);
+		}
+		while (Cursor < Size && FirebaseJsonTape::IsDigit(Data[Cursor]))
+		{
+			++Cursor;
+		}
+	}
+	if (Cursor < Size && !FirebaseJsonTape::IsTerminator(Data[Cursor]))
+	{
+		return Fail(TEXT("Invalid number"), Position);
+	}
+
+	double Value = 0.0;
+	if (bInteger && Digits <= 19)
+	{
+		// Integer to double conversion is correctly rounded, so this matches strtod
+		Value = double(Mantissa);
+		if (bNegative)
+		{
+			Value = -Value;
+		}
+	}
+	else
+	{
+		const int32 Length = Cursor - int32(Position);
+		TArray<ANSICHAR, TInlineAllocator<64>> Text;
+		Text.Append(reinterpret_cast<const ANSICHAR*>(Data + Position), Length);
+		Text.Add('\0');
+		Value = FCStringAnsi::Atod(Text.GetData());
+	}
+
+	uint64 Bits = 0;
+	FMemory::Memcpy(&Bits, &Value, sizeof(Bits));
+	Words.Add(FirebaseJsonTape::MakeWord(EFirebaseJsonTapeType::Number, 0));
+	Words.Add(Bits);
+	return true;
+}
+
+bool FFirebaseJsonTape::Fail(const TCHAR* Reason, uint32 Position)
+{
+	Error = FString::Printf(TEXT("%s at offset %u"), Reason, Position);
+	Words.Reset();
+	Strings.Reset();
+	bValid = false;
+	return false;
+}
+
+// === ACCESS ===
+
+FFirebaseJsonTape::FValue FFirebaseJsonTape::GetRoot() const
+{
+	return bValid && Words.Num() > 0 ? FValue(this, 0) : FValue();
+}
+
+SIZE_T FFirebaseJsonTape::GetAllocatedSize() const
+{
+	return Words.GetAllocatedSize() + Strings.GetAllocatedSize();
+}
+
+const TCHAR* FFirebaseJsonTape::GetSimdBackendName()
+{
+#if FIREBASE_JSON_SIMD_AVX2
+	return TEXT("AVX2");
+#elif FIREBASE_JSON_SIMD_SSE2
+	return TEXT("SSE2");
+#elif FIREBASE_JSON_SIMD_NEON
+	return TEXT("NEON");
+#else
+	return TEXT("Scalar");
+#endif
+}
+
+EFirebaseJsonTapeType FFirebaseJsonTape::FValue::GetType() const
+{
+	return Tape ? FirebaseJsonTape::GetWordType(Tape->Words[Index]) : EFirebaseJsonTapeType::Null;
+}
+
+double FFirebaseJsonTape::FValue::AsNumber() const
+{
+	if (!IsNumber())
+	{
+		return 0.0;
+	}
+
+	const uint64 Bits = Tape->Words[Index + 1];
+	double Value = 0.0;
+	FMemory::Memcpy(&Value, &Bits, sizeof(Value));
+	return Value;
+}
+
+FUtf8StringView FFirebaseJsonTape::FValue::AsUtf8() const
+{
+	if (!IsString())
+	{
+		return FUtf8StringView();
+	}
+
+	const uint64 WordPayload = FirebaseJsonTape::GetWordPayload(Tape->Words[Index]);
+	const uint8* Base = (WordPayload & FirebaseJsonTape::DecodedStringFlag) ? Tape->Strings.GetData() : Tape->Payload.GetData();
+	const uint8* Text = Base + (WordPayload & FirebaseJsonTape::StringOffsetMask);
+	return FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Text), int32(Tape->Words[Index + 1]));
+}
+
+FString FFirebaseJsonTape::FValue::AsString() const
+{
+	return FirebaseJsonEscape::Utf8ToString(AsUtf8());
+}
+
+int32 FFirebaseJsonTape::FValue::GetNextIndex() const
+{
+	const uint64 Word = Tape->Words[Index];
+	switch (FirebaseJsonTape::GetWordType(Word))
+	{
+	case EFirebaseJsonTapeType::Object:
+	case EFirebaseJsonTapeType::Array:
+		return int32(FirebaseJsonTape::GetWordPayload(Word)) + 1;
+	case EFirebaseJsonTapeType::String:
+	case EFirebaseJsonTapeType::Number:
+		return Index + 2;
+	default:
+		return Index + 1;
+	}
+}
+
+FFirebaseJsonTape::FValue FFirebaseJsonTape::FValue::FindField(FUtf8StringView Key) const
+{
+	FValue Result;
+	ForEachField([&Result, Key](FUtf8StringView FieldKey, const FValue& Value)
+	{
+		if (FirebaseJsonTape::KeyEquals(FieldKey, Key))
+		{
+			Result = Value;
+			return false;
+		}
+		return true;
+	});
+	return Result;
+}
+
+void FFirebaseJsonTape::FValue::ForEachField(TFunctionRef<bool(FUtf8StringView Key, const FValue& Value)> Visitor) const
+{
+	if (!IsObject())
+	{
+		return;
+	}
+
+	const int32 End = int32(FirebaseJsonTape::GetWordPayload(Tape->Words[Index]));
+	int32 Cursor = Index + 1;
+	while (Cursor < End)
+	{
+		// Keys are strings (two words) followed by their value
+		const FValue Key(Tape, Cursor);
+		const FValue Value(Tape, Cursor + 2);
+		if (!Visitor(Key.AsUtf8(), Value))
+		{
+			return;
+		}
+		Cursor = Value.GetNextIndex();
+	}
+}
+
+void FFirebaseJsonTape::FValue::ForEachElement(TFunctionRef<bool(const FValue& Element)> Visitor) const
+{
+	if (!IsArray())
+	{
+		return;
+	}
+
+	const int32 End = int32(FirebaseJsonTape::GetWordPayload(Tape->Words[Index]));
+	int32 Cursor = Index + 1;
+	while (Cursor < End)
+	{
+		const FValue Element(Tape, Cursor);
+		if (!Visitor(Element))
+		{
+			return;
+		}
+		Cursor = Element.GetNextIndex();
+	}
+}
+
+int32 FFirebaseJsonTape::FValue::Num() const
+{
+	int32 Count = 0;
+	if (IsObject())
+	{
+		ForEachField([&Count](FUtf8StringView, const FValue&) { ++Count; return true; });
+	}
+	else if (IsArray())
+	{
+		ForEachElement([&Count](const FValue&) { ++Count; return true; });
+	}
+	return Count;
+}
+
+TSharedPtr<FJsonValue> FFirebaseJsonTape::FValue::ToJsonValue() const
+{
+	if (!IsValid())
+	{
+		return nullptr;
+	}
+
+	switch (GetType())
+	{
+	case EFirebaseJsonTapeType::True:
+	case EFirebaseJsonTapeType::False:
+		return MakeShared<FJsonValueBoolean>(AsBool());
+
+	case EFirebaseJsonTapeType::Number:
+		return MakeShared<FJsonValueNumber>(AsNumber());
+
+	case EFirebaseJsonTapeType::String:
+		return MakeShared<FJsonValueString>(AsString());
+
+	case EFirebaseJsonTapeType::Object:
+	{
+		TSharedPtr<FJsonObject> Object = MakeShared<FJsonObject>();
+		ForEachField([&Object](FUtf8StringView Key, const FValue& Value)
+		{
+			Object->Values.Add(FirebaseJsonEscape::Utf8ToString(Key), Value.ToJsonValue());
+			return true;
+		});
+		return MakeShared<FJsonValueObject>(Object);
+	}
+
+	case EFirebaseJsonTapeType::Array:
+	{
+		TArray<TSharedPtr<FJsonValue>> Elements;
+		ForEachElement([&Elements](const FValue& Element)
+		{
+			Elements.Add(Element.ToJsonValue());
+			return true;
+		});
+		return MakeShared<FJsonValueArray>(Elements);
+	}
+
+	default:
+		return MakeShared<FJsonValueNull>();
+	}
+}
@@ -0,0 +1,398 @@
+// Copyright. All Rights Reserved.
+
+#include "FirebaseJsonWriter.h"
+#include "FirebaseJsonEscape.h"
+#include "FirebaseBufferPool.h"
+
+FFirebaseJsonWriter::FFirebaseJsonWriter(int32 InInitialCapacity)
+	: Buffer(FFirebaseBufferPool::Get().Acquire(InInitialCapacity))
+	, InitialCapacity(InInitialCapacity)
+{
+}
+
+FFirebaseJsonWriter::~FFirebaseJsonWriter()
+{
+	FFirebaseBufferPool::Get().Release(MoveTemp(Buffer));
+}
+
+void FFirebaseJsonWriter::Reset()
+{
+	Buffer.Reset(InitialCapacity);
+	Scopes.Reset();
+	bAfterKey = false;
+}
+
+// === STRUCTURE ===
+
+void FFirebaseJsonWriter::BeforeValue()
+{
+	if (bAfterKey)
+	{
+		bAfterKey = false;
+		return;
+	}
+
+	if (Scopes.Num() > 0)
+	{
+		uint8& Scope = Scopes.Last();
+		if (Scope & ScopeHasMembers)
+		{
+			Buffer.Add(',');
+		}
+		Scope |= ScopeHasMembers;
+	}
+}
+
+void FFirebaseJsonWriter::BeginObject()
+{
+	BeforeValue();
+	Buffer.Add('{');
+	Scopes.Add(0);
+}
+
+void FFirebaseJsonWriter::EndObject()
+{
+	if (!ensureMsgf(IsInObject() && !bAfterKey, TEXT("Firebase JSON writer: EndObject without a matching BeginObject")))
+	{
+		return;
+	}
+	Scopes.Pop();
+	Buffer.Add('}');
+}
+
+void FFirebaseJsonWriter::BeginArray()
+{
+	BeforeValue();
+	Buffer.Add('[');
+	Scopes.Add(ScopeArray);
+}
+
+void FFirebaseJsonWriter::EndArray()
+{
+	if (!ensureMsgf(IsInArray(), TEXT("Firebase JSON writer: EndArray without a matching BeginArray")))
+	{
+		return;
+	}
+	Scopes.Pop();
+	Buffer.Add(']');
+}
+
+void FFirebaseJsonWriter::WriteKey(FStringView Key)
+{
+	if (!ensureMsgf(IsInObject() && !bAfterKey, TEXT("Firebase JSON writer: key written outside an object")))
+	{
+		return;
+	}
+
+	BeforeValue();
+	Buffer.Add('"');
+	AppendEscaped(Key);
+	Buffer.Add('"');
+	Buffer.Add(':');
+	bAfterKey = true;
+}
+
+void FFirebaseJsonWriter::WriteKey(FUtf8StringView Key)
+{
+	if (!ensureMsgf(IsInObject() && !bAfterKey, TEXT("Firebase JSON writer: key written outside an object")))
+	{
+		return;
+	}
+
+	BeforeValue();
+	Buffer.Add('"');
+	AppendEscaped(Key);
+	Buffer.Add('"');
+	Buffer.Add(':');
+	bAfterKey = true;
+}
+
+bool FFirebaseJsonWriter::IsInObject() const
+{
+	return Scopes.Num() > 0 && !(Scopes.Last() & ScopeArray);
+}
+
+bool FFirebaseJsonWriter::IsInArray() const
+{
+	return Scopes.Num() > 0 && (Scopes.Last() & ScopeArray);
+}
+
+// === VALUES ===
+
+void FFirebaseJsonWriter::WriteString(FStringView Value)
+{
+	BeforeValue();
+	Buffer.Add('"');
+	AppendEscaped(Value);
+	Buffer.Add('"');
+}
+
+void FFirebaseJsonWriter::WriteString(FUtf8StringView Value)
+{
+	BeforeValue();
+	Buffer.Add('"');
+	AppendEscaped(Value);
+	Buffer.Add('"');
+}
+
+void FFirebaseJsonWriter::WriteInt(int64 Value)
+{
+	BeforeValue();
+
+	ANSICHAR Digits[24];
+	int32 Length = 0;
+	uint64 Magnitude = Value < 0 ? uint64(0) - uint64(Value) : uint64(Value);
+	do
+	{
+		Digits[Length++] = ANSICHAR('0' + Magnitude % 10);
+		Magnitude /= 10;
+	}
+	while (Magnitude > 0);
+
+	if (Value < 0)
+	{
+		Buffer.Add('-');
+	}
+	while (Length > 0)
+	{
+		Buffer.Add(uint8(Digits[--Length]));
+	}
+}
+
+void FFirebaseJsonWriter::WriteDouble(double Value)
+{
+	BeforeValue();
+	ANSICHAR Text[32];
+	AppendAscii(Text, FormatDouble(Value, Text));
+}
+
+void FFirebaseJsonWriter::WriteFloat(float Value)
+{
+	BeforeValue();
+	ANSICHAR Text[32];
+	AppendAscii(Text, FormatFloat(Value, Text));
+}
+
+void FFirebaseJsonWriter::WriteBool(bool Value)
+{
+	BeforeValue();
+	if (Value)
+	{
+		AppendAscii("true", 4);
+	}
+	else
+	{
+		AppendAscii("false", 5);
+	}
+}
+
+void FFirebaseJsonWriter::WriteNull()
+{
+	BeforeValue();
+	AppendAscii("null", 4);
+}
+
+void FFirebaseJsonWriter::WriteRawValue(FUtf8StringView Json)
+{
+	BeforeValue();
+	Buffer.Append(reinterpret_cast<const uint8*>(Json.GetData()), Json.Len());
+}
+
+void FFirebaseJsonWriter::WriteRawMembers(FUtf8StringView Members)
+{
+	if (!ensureMsgf(IsInObject() && !bAfterKey, TEXT("Firebase JSON writer: members written outside an object")))
+	{
+		return;
+	}
+
+	Members.TrimStartAndEndInline();
+	if (Members.IsEmpty())
+	{
+		return;
+	}
+
+	BeforeValue();
+	Buffer.Append(reinterpret_cast<const uint8*>(Members.GetData()), Members.Len());
+}
+
+// === OUTPUT ===
+
+FUtf8StringView FFirebaseJsonWriter::GetView() const
+{
+	return FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Buffer.GetData()), Buffer.Num());
+}
+
+void FFirebaseJsonWriter::AppendClosers(TArray<uint8>& Out) const
+{
+	for (int32 Index = Scopes.Num() - 1; Index >= 0; --Index)
+	{
+		Out.Add((Scopes[Index] & ScopeArray) ? ']' : '}');
+	}
+}
+
+FFirebasePayload FFirebaseJsonWriter::ToPayload() const
+{
+	TArray<uint8> Bytes = FFirebaseBufferPool::Get().Acquire(Buffer.Num() + Scopes.Num());
+	Bytes.Append(Buffer);
+	AppendClosers(Bytes);
+	return FFirebasePayload::FromUtf8(MoveTemp(Bytes));
+}
+
+FFirebasePayload FFirebaseJsonWriter::TakePayload()
+{
+	AppendClosers(Buffer);
+	FFirebasePayload Payload = FFirebasePayload::FromUtf8(MoveTemp(Buffer));
+
+	Buffer = FFirebaseBufferPool::Get().Acquire(InitialCapacity);
+	Reset();
+	return Payload;
+}
+
+FString FFirebaseJsonWriter::ToString() const
+{
+	FString Result = FirebaseJsonEscape::Utf8ToString(GetView());
+	for (int32 Index = Scopes.Num() - 1; Index >= 0; --Index)
+	{
+		Result.AppendChar((Scopes[Index] & ScopeArray) ? TEXT(']') : TEXT('}'));
+	}
+	return Result;
+}
+
+// === FORMATTING ===
+
+int32 FFirebaseJsonWriter::FormatDouble(double Value, ANSICHAR (&Out)[32])
+{
+	if (!FMath::IsFinite(Value))
+	{
+		FMemory::Memcpy(Out, "null", 5);
+		return 4;
+	}
+
+	// Any decimal with up to 15 significant digits survives a round trip through
+	// a double, so %.15g is exact whenever a short form exists; otherwise 16 or
+	// 17 digits are needed, and 17 always suffice.
+	int32 Length = 0;
+	for (int32 Precision = 15; Precision <= 17; ++Precision)
+	{
+		Length = FCStringAnsi::Snprintf(Out, UE_ARRAY_COUNT(Out), "%.*g", Precision, Value);
+		if (FCStringAnsi::Atod(Out) == Value)
+		{
+			break;
+		}
+	}
+	return Length;
+}
+
+int32 FFirebaseJsonWriter::FormatFloat(float Value, ANSICHAR (&Out)[32])
+{
+	if (!FMath::IsFinite(Value))
+	{
+		FMemory::Memcpy(Out, "null", 5);
+		return 4;
+	}
+
+	// Same idea for floats: 6 digits are always exact, 9 always suffice
+	int32 Length = 0;
+	for (int32 Precision = 6; Precision <= 9; ++Precision)
+	{
+		Length = FCStringAnsi::Snprintf(Out, UE_ARRAY_COUNT(Out), "%.*g", Precision, double(Value));
+		if (float(FCStringAnsi::Atod(Out)) == Value)
+		{
+			break;
+		}
+	}
+	return Length;
+}
+
+// === ESCAPING ===
+
+void FFirebaseJsonWriter::AppendAscii(const ANSICHAR* Text, int32 Length)
+{
+	Buffer.Append(reinterpret_cast<const uint8*>(Text), Length);
+}
+
+void FFirebaseJsonWriter::AppendEscapedAscii(uint8 Character)
+{
+	static const ANSICHAR HexDigits[] = "0123456789abcdef";
+
+	switch (Character)
+	{
+	case '"': AppendAscii("\\\"", 2); break;
+	case '\\': AppendAscii("\\\\", 2); break;
+	case '\b': AppendAscii("\\b", 2); break;
+	case '\f': AppendAscii("\\f", 2); break;
+	case '\n': AppendAscii("\\n", 2); break;
+	case '\r': AppendAscii("\\r", 2); break;
+	case '\t': AppendAscii("\\t", 2); break;
+	default:
+		if (Character < 0x20)
+		{
+			const ANSICHAR Escape[6] = { '\\', 'u', '0', '0', HexDigits[Character >> 4], HexDigits[Character & 0xF] };
+			AppendAscii(Escape, 6);
+		}
+		else
+		{
+			Buffer.Add(Character);
+		}
+		break;
+	}
+}
+
+void FFirebaseJsonWriter::AppendEscaped(FUtf8StringView Text)
+{
+	const uint8* Data = reinterpret_cast<const uint8*>(Text.GetData());
+	const int32 Length = Text.Len();
+
+	int32 RunStart = 0;
+	for (int32 Index = 0; Index < Length; ++Index)
+	{
+		const uint8 Character = Data[Index];
+		if (Character >= 0x20 && Character != '"' && Character != '\\')
+		{
+			continue;
+		}
+
+		// Copy the clean run in one go, then the escape
+		Buffer.Append(Data + RunStart, Index - RunStart);
+		AppendEscapedAscii(Character);
+		RunStart = Index + 1;
+	}
+	Buffer.Append(Data + RunStart, Length - RunStart);
+}
+
+void FFirebaseJsonWriter::AppendEscaped(FStringView Text)
+{
+	const TCHAR* Data = Text.GetData();
+	const int32 Length = Text.Len();
+
+	for (int32 Index = 0; Index < Length; ++Index)
+	{
+		uint32 CodePoint = uint32(Data[Index]);
+		if (CodePoint < 0x80)
+		{
+			AppendEscapedAscii(uint8(CodePoint));
+			continue;
+		}
+
+		// Transcode UTF-16 directly; a lone surrogate becomes U+FFFD
+		if (CodePoint >= 0xD800 && CodePoint <= 0xDBFF)
+		{
+			const uint32 Low = Index + 1 < Length ? uint32(Data[Index + 1]) : 0;
+			if (Low >= 0xDC00 && Low <= 0xDFFF)
+			{
+				CodePoint = 0x10000 + ((CodePoint - 0xD800) << 10) + (Low - 0xDC00);
+				++Index;
+			}
+			else
+			{
+				CodePoint = 0xFFFD;
+			}
+		}
+		else if (CodePoint >= 0xDC00 && CodePoint <= 0xDFFF)
+		{
+			CodePoint = 0xFFFD;
+		}
+
+		FirebaseJsonEscape::AppendUtf8(Buffer, CodePoint);
+	}
+}
@@ -0,0 +1,117 @@
+// Copyright. All Rights Reserved.
+
+#include "FirebaseLatencyHistogram.h"
+
+FFirebaseLatencyHistogram::FFirebaseLatencyHistogram()
+{
+	Reset();
+}
+
+int32 FFirebaseLatencyHistogram::GetBucketIndex(uint64 Micros)
+{
+	if (Micros < SubBucketCount)
+	{
+		return int32(Micros);
+	}
+
+	// Top SubBucketBits + 1 bits of the value pick the bucket
+	const int32 Shift = int32(FMath::FloorLog2_64(Micros)) - SubBucketBits;
+	const int32 SubBucket = int32(Micros >> Shift) - SubBucketCount;
+	return (Shift + 1) * SubBucketCount + SubBucket;
+}
+
+uint64 FFirebaseLatencyHistogram::GetBucketUpperBound(int32 Index)
+{
+	if (Index < SubBucketCount)
+	{
+		return uint64(Index);
+	}
+
+	const int32 Shift = Index / SubBucketCount - 1;
+	const uint64 Lower = uint64(SubBucketCount + Index % SubBucketCount) << Shift;
+	return Lower + (uint64(1) << Shift) - 1;
+}
+
+void FFirebaseLatencyHistogram::Record(double Seconds)
+{
+	const uint64 Micros = uint64(FMath::Max(Seconds, 0.0) * 1e6);
+	const int32 Index = FMath::Min(GetBucketIndex(Micros), NumBuckets - 1);
+
+	Counts[Index]++;
+	Count++;
+	SumMicros += Micros;
+	MaxMicros = FMath::Max(MaxMicros, Micros);
+}
+
+void FFirebaseLatencyHistogram::Merge(const FFirebaseLatencyHistogram& Other)
+{
+	if (Other.Count == 0)
+	{
+		return;
+	}
+
+	for (int32 Index = 0; Index < NumBuckets; ++Index)
+	{
+		Counts[Index] += Other.Counts[Index];
+	}
+	Count += Other.Count;
+	SumMicros += Other.SumMicros;
+	MaxMicros = FMath::Max(MaxMicros, Other.MaxMicros);
+}
+
+void FFirebaseLatencyHistogram::Reset()
+{
+	FMemory::Memzero(Counts);
+	Count = 0;
+	SumMicros = 0;
+	MaxMicros = 0;
+}
+
+double FFirebaseLatencyHistogram::GetPercentile(double Percent) const
+{
+	if (Count == 0)
+	{
+		return 0.0;
+	}
+
+	const uint64 Rank = FMath::Clamp<uint64>(uint64(FMath::CeilToDouble(Percent / 100.0 * double(Count))), 1, Count);
+	uint64 Seen = 0;
+	for (int32 Index = 0; Index < NumBuckets; ++Index)
+	{
+		Seen += Counts[Index];
+		if (Seen >= Rank)
+		{
+			return double(FMath::Min(GetBucketUpperBound(Index), MaxMicros)) * 1e-6;
+		}
+	}
+	return GetMax();
+}
+
+FFirebaseLatencySummary FFirebaseLatencyHistogram::Summarize() const
+{
+	FFirebaseLatencySummary Summary;
+	Summary.Count = Count;
+	Summary.Max = GetMax();
+	Summary.Mean = GetMean();
+	if (Count == 0)
+	{
+		return Summary;
+	}
+
+	const double Percents[] = { 50.0, 90.0, 99.0 };
+	double* const Outputs[] = { &Summary.P50, &Summary.P90, &Summary.P99 };
+	constexpr int32 NumPercents = UE_ARRAY_COUNT(Percents);
+
+	int32 Next = 0;
+	uint64 Seen = 0;
+	for (int32 Index = 0; Index < NumBuckets && Next < NumPercents; ++Index)
+	{
+		Seen += Counts[Index];
+		while (Next < NumPercents
+			&& Seen >= FMath::Max<uint64>(uint64(FMath::CeilToDouble(Percents[Next] / 100.0 * double(Count))), 1))
+		{
+			*Outputs[Next++] = double(FMath::Min(GetBucketUpperBound(Index), MaxMicros)) * 1e-6;
+		}
+	}
+	return Summary;
+}
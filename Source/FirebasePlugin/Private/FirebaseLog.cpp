@@ -0,0 +1,299 @@
+// Copyright. All Rights Reserved.
+
+#include "FirebaseLog.h"
+#include "FirebaseHttpTransport.h"
+#include "FirebaseSettings.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/OutputDevice.h"
+
+DEFINE_LOG_CATEGORY(LogFirebase);
+
+namespace FirebaseLog
+{
+	static TAutoConsoleVariable<int32> CVarMaxBodyChars(
+		TEXT("Firebase.Log.MaxBodyChars"),
+#if UE_BUILD_SHIPPING
+		0,
+#else
+		256,
+#endif
+		TEXT("Longest server body written to LogFirebase, after redaction; 0 logs only its length, -1 logs all of it"));
+
+	// JSON fields whose string values never reach the log
+	static const TCHAR* SecretFields[] =
+	{
+		TEXT("idToken"), TEXT("refreshToken"), TEXT("id_token"), TEXT("refresh_token"),
+		TEXT("access_token"), TEXT("password"), TEXT("oobCode"), TEXT("apiKey")
+	};
+
+	// URL query parameters likewise
+	static const TCHAR* SecretParams[] = { TEXT("auth"), TEXT("key"), TEXT("access_token") };
+
+	static const TCHAR* Redacted = TEXT("<redacted>");
+
+	static bool IsSecret(FStringView Name, TArrayView<const TCHAR* const> Secrets)
+	{
+		for (const TCHAR* Secret : Secrets)
+		{
+			if (Name.Equals(Secret, ESearchCase::IgnoreCase))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// Index just past the string whose opening quote is at Start (or the end of a cut-off string)
+	static int32 SkipString(FStringView Text, int32 Start)
+	{
+		int32 Index = Start + 1;
+		while (Index < Text.Len() && Text[Index] != TEXT('"'))
+		{
+			Index += Text[Index] == TEXT('\\') ? 2 : 1;
+		}
+		return FMath::Min(Index + 1, Text.Len());
+	}
+
+	static int32 SkipSpace(FStringView Text, int32 Index)
+	{
+		while (Index < Text.Len() && FChar::IsWhitespace(Text[Index]))
+		{
+			++Index;
+		}
+		return Index;
+	}
+
+	static bool IsParamChar(TCHAR Char)
+	{
+		return FChar::IsAlnum(Char) || Char == TEXT('_');
+	}
+
+	static bool IsParamValueEnd(TCHAR Char)
+	{
+		return Char == TEXT('&') || Char == TEXT('#') || Char == TEXT('"') || FChar::IsWhitespace(Char);
+	}
+
+	template <int32 N>
+	static void CopyTruncated(TCHAR (&Dest)[N], FStringView Source)
+	{
+		const int32 Len = FMath::Min(Source.Len(), N - 1);
+		FMemory::Memcpy(Dest, Source.GetData(), Len * sizeof(TCHAR));
+		Dest[Len] = TEXT('\0');
+	}
+
+	static FAutoConsoleCommandWithOutputDevice DumpCommand(
+		TEXT("Firebase.Log.Dump"),
+		TEXT("Print the most recent REST requests (operation, path prefix, status, latency, bytes, trace id)"),
+		FConsoleCommandWithOutputDeviceDelegate::CreateLambda([](FOutputDevice& Ar)
+		{
+			FFirebaseRequestLog::Get().Dump(Ar);
+		}));
+}
+
+// === LOG HELPERS ===
+
+FString FFirebaseLog::Body(FStringView Text)
+{
+	const int32 MaxChars = FirebaseLog::CVarMaxBodyChars.GetValueOnAnyThread();
+	if (MaxChars == 0)
+	{
+		return FString::Printf(TEXT("<%d chars>"), Text.Len());
+	}
+	if (MaxChars < 0 || Text.Len() <= MaxChars)
+	{
+		return Redact(Text);
+	}
+
+	// Cut before redacting: a secret cut in half still reads as an unterminated secret and is dropped
+	return FString::Printf(TEXT("%s... <%d more chars>"), *Redact(Text.Left(MaxChars)), Text.Len() - MaxChars);
+}
+
+FString FFirebaseLog::Body(FUtf8StringView Text)
+{
+	const int32 MaxChars = FirebaseLog::CVarMaxBodyChars.GetValueOnAnyThread();
+	if (MaxChars == 0)
+	{
+		return FString::Printf(TEXT("<%d bytes>"), Text.Len());
+	}
+
+	// Never split a multi-byte character
+	int32 Cut = Text.Len();
+	if (MaxChars > 0 && Text.Len() > MaxChars)
+	{
+		Cut = MaxChars;
+		while (Cut > 0 && (uint8(Text[Cut]) & 0xC0) == 0x80)
+		{
+			--Cut;
+		}
+	}
+
+	FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Text.GetData()), Cut);
+	const FString Logged = Redact(FStringView(Converted.Get(), Converted.Length()));
+	return Cut < Text.Len() ? FString::Printf(TEXT("%s... <%d more bytes>"), *Logged, Text.Len() - Cut) : Logged;
+}
+
+FString FFirebaseLog::Redact(FStringView Text)
+{
+	using namespace FirebaseLog;
+
+	FString Out;
+	Out.Reserve(Text.Len());
+
+	int32 Index = 0;
+	while (Index < Text.Len())
+	{
+		const TCHAR Char = Text[Index];
+
+		if (Char == TEXT('"'))
+		{
+			const int32 End = SkipString(Text, Index);
+			const FStringView Name = Text.Mid(Index + 1, FMath::Max(End - Index - 2, 0));
+			Out.Append(Text.Mid(Index, End - Index));
+			Index = End;
+
+			// "secretField" : "value"
+			const int32 Colon = SkipSpace(Text, End);
+			if (Colon < Text.Len() && Text[Colon] == TEXT(':') && IsSecret(Name, SecretFields))
+			{
+				const int32 Value = SkipSpace(Text, Colon + 1);
+				if (Value < Text.Len() && Text[Value] == TEXT('"'))
+				{
+					Out.Append(Text.Mid(End, Value - End));
+					Out += TEXT('"');
+					Out += Redacted;
+					Out += TEXT('"');
+					Index = SkipString(Text, Value);
+				}
+			}
+			continue;
+		}
+
+		// ?secretParam=value or &secretParam=value
+		if (Char == TEXT('?') || Char == TEXT('&'))
+		{
+			int32 Equals = Index + 1;
+			while (Equals < Text.Len() && IsParamChar(Text[Equals]))
+			{
+				++Equals;
+			}
+			if (Equals < Text.Len() && Text[Equals] == TEXT('=') && IsSecret(Text.Mid(Index + 1, Equals - Index - 1), SecretParams))
+			{
+				Out.Append(Text.Mid(Index, Equals + 1 - Index));
+				Out += Redacted;
+				Index = Equals + 1;
+				while (Index < Text.Len() && !IsParamValueEnd(Text[Index]))
+				{
+					++Index;
+				}
+				continue;
+			}
+		}
+
+		Out += Char;
+		++Index;
+	}
+	return Out;
+}
+
+void FFirebaseLog::ApplySettings()
+{
+	// Only ever raise to Verbose or drop back from it, so -LogCmds overrides survive
+	const bool bVerbose = GetDefault<UFirebaseSettings>()->bEnableVerboseLogging;
+	const ELogVerbosity::Type Current = LogFirebase.GetVerbosity();
+	if (bVerbose && Current < ELogVerbosity::Verbose)
+	{
+		LogFirebase.SetVerbosity(ELogVerbosity::Verbose);
+	}
+	else if (!bVerbose && Current == ELogVerbosity::Verbose)
+	{
+		LogFirebase.SetVerbosity(ELogVerbosity::Log);
+	}
+}
+
+// === REQUEST LOG ===
+
+FFirebaseRequestLog& FFirebaseRequestLog::Get()
+{
+	static FFirebaseRequestLog Instance;
+	return Instance;
+}
+
+void FFirebaseRequestLog::Record(FStringView Operation, FStringView Path, uint64 TraceId, const FFirebaseHttpResponse& Response)
+{
+	const uint64 Index = NextIndex.fetch_add(1, std::memory_order_relaxed);
+	FSlot& Slot = Slots[Index % Capacity];
+
+	// Odd while writing, so a reader that races this write throws its copy away
+	Slot.Sequence.store(2 * Index + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	FFirebaseRequestLogEntry& Entry = Slot.Entry;
+	Entry.Time = FPlatformTime::Seconds();
+	Entry.TraceId = TraceId;
+	Entry.ElapsedMs = Response.ElapsedSeconds >= 0.0f ? Response.ElapsedSeconds * 1000.0f : -1.0f;
+	Entry.Status = Response.Code;
+	Entry.Bytes = Response.Body.Num();
+	Entry.bSucceeded = Response.bSucceeded;
+	FirebaseLog::CopyTruncated(Entry.Operation, Operation);
+	FirebaseLog::CopyTruncated(Entry.Path, Path);
+
+	Slot.Sequence.store(2 * Index + 2, std::memory_order_release);
+}
+
+void FFirebaseRequestLog::ForEachEntry(TFunctionRef<void(const FFirebaseRequestLogEntry&)> Visitor) const
+{
+	const uint64 End = NextIndex.load(std::memory_order_acquire);
+	const uint64 Begin = End > Capacity ? End - Capacity : 0;
+
+	for (uint64 Index = Begin; Index < End; ++Index)
+	{
+		const FSlot& Slot = Slots[Index % Capacity];
+		const uint64 Expected = 2 * Index + 2;
+		if (Slot.Sequence.load(std::memory_order_acquire) != Expected)
+		{
+			// Still being written, or already overwritten by a newer request
+			continue;
+		}
+
+		const FFirebaseRequestLogEntry Copy = Slot.Entry;
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (Slot.Sequence.load(std::memory_order_relaxed) == Expected)
+		{
+			Visitor(Copy);
+		}
+	}
+}
+
+void FFirebaseRequestLog::Snapshot(TArray<FFirebaseRequestLogEntry>& OutEntries) const
+{
+	OutEntries.Reset(Capacity);
+	ForEachEntry([&OutEntries](const FFirebaseRequestLogEntry& Entry)
+	{
+		OutEntries.Add(Entry);
+	});
+}
+
+void FFirebaseRequestLog::Dump(FOutputDevice& Ar) const
+{
+	const double Now = FPlatformTime::Seconds();
+
+	Ar.Logf(TEXT("Firebase: recent REST requests, oldest first (age, operation, path, status, latency, bytes, trace id)"));
+	int32 NumEntries = 0;
+	ForEachEntry([&Ar, &NumEntries, Now](const FFirebaseRequestLogEntry& Entry)
+	{
+		const FString Status = Entry.bSucceeded ? FString::Printf(TEXT("%d"), Entry.Status) : FString(TEXT("failed"));
+		Ar.Logf(TEXT("  %9.3fs ago  %-6s %-24s %-6s %8.1f ms %9d B  #%llu"),
+			Now - Entry.Time, Entry.Operation, Entry.Path, *Status, Entry.ElapsedMs, Entry.Bytes, Entry.TraceId);
+		++NumEntries;
+	});
+	Ar.Logf(TEXT("Firebase: %d requests listed"), NumEntries);
+}
+
+void FFirebaseRequestLog::Reset()
+{
+	for (FSlot& Slot : Slots)
+	{
+		Slot.Sequence.store(0, std::memory_order_relaxed);
+	}
+	NextIndex.store(0, std::memory_order_release);
+}
@@ -0,0 +1,141 @@
+// Copyright. All Rights Reserved.
+
+#include "FirebaseMemory.h"
+#include "FirebaseLog.h"
+#include "FirebaseBufferPool.h"
+#include "FirebaseSettings.h"
+#include "HAL/IConsoleManager.h"
+
+LLM_DEFINE_TAG(Firebase);
+LLM_DEFINE_TAG(Firebase_Transport, TEXT("Transport"), TEXT("Firebase"));
+LLM_DEFINE_TAG(Firebase_Buffers, TEXT("Buffers"), TEXT("Firebase"));
+LLM_DEFINE_TAG(Firebase_Json, TEXT("Json"), TEXT("Firebase"));
+LLM_DEFINE_TAG(Firebase_Listeners, TEXT("Listeners"), TEXT("Firebase"));
+LLM_DEFINE_TAG(Firebase_PendingOps, TEXT("PendingOps"), TEXT("Firebase"));
+LLM_DEFINE_TAG(Firebase_Queues, TEXT("Queues"), TEXT("Firebase"));
+LLM_DEFINE_TAG(Firebase_Diagnostics, TEXT("Diagnostics"), TEXT("Firebase"));
+
+namespace FirebaseMemory
+{
+	static const TCHAR* CategoryNames[] =
+	{
+		TEXT("Buffers"), TEXT("Queues"), TEXT("PendingOps"), TEXT("Listeners"), TEXT("Diagnostics")
+	};
+	static_assert(UE_ARRAY_COUNT(CategoryNames) == (int32)EFirebaseMemoryCategory::Num, "Name every memory category");
+
+	static FAutoConsoleCommandWithOutputDevice DumpCommand(
+		TEXT("Firebase.Memory.Dump"),
+		TEXT("Print the memory the plugin accounts for per category, against its budget"),
+		FConsoleCommandWithOutputDeviceDelegate::CreateLambda([](FOutputDevice& Ar)
+		{
+			FFirebaseMemory::Get().Dump(Ar);
+		}));
+}
+
+const TCHAR* LexToString(EFirebaseMemoryCategory Category)
+{
+	return Category < EFirebaseMemoryCategory::Num ? FirebaseMemory::CategoryNames[(int32)Category] : TEXT("Unknown");
+}
+
+FFirebaseMemory& FFirebaseMemory::Get()
+{
+	static FFirebaseMemory Instance;
+	return Instance;
+}
+
+void FFirebaseMemory::ApplySettings()
+{
+	SetBudget(int64(GetDefault<UFirebaseSettings>()->MemoryBudgetKB) * 1024);
+}
+
+void FFirebaseMemory::SetBudget(int64 InBudgetBytes)
+{
+	const int64 Budget = FMath::Max<int64>(InBudgetBytes, 0);
+	BudgetBytes.store(Budget, std::memory_order_relaxed);
+
+	const int64 Excess = GetTotal() - Budget;
+	if (Budget > 0 && Excess > 0)
+	{
+		FFirebaseBufferPool::Get().Evict(Excess);
+	}
+}
+
+bool FFirebaseMemory::TryReserve(EFirebaseMemoryCategory Category, int64 Bytes)
+{
+	const int64 Budget = GetBudget();
+	if (Budget <= 0 || Bytes <= 0)
+	{
+		Add(Category, Bytes);
+		return true;
+	}
+
+	int64 Total = TotalBytes.load(std::memory_order_relaxed);
+	do
+	{
+		if (Total + Bytes > Budget)
+		{
+			return false;
+		}
+	}
+	while (!TotalBytes.compare_exchange_weak(Total, Total + Bytes, std::memory_order_relaxed));
+
+	Usage[(int32)Category].fetch_add(Bytes, std::memory_order_relaxed);
+	return true;
+}
+
+bool FFirebaseMemory::Reserve(EFirebaseMemoryCategory Category, int64 Bytes)
+{
+	if (TryReserve(Category, Bytes))
+	{
+		return true;
+	}
+
+	// Pooled buffers are the only memory that can go without losing work
+	FFirebaseBufferPool::Get().Evict(GetTotal() + Bytes - GetBudget());
+	if (TryReserve(Category, Bytes))
+	{
+		return true;
+	}
+
+	if (Refusals.fetch_add(1, std::memory_order_relaxed) == 0)
+	{
+		UE_LOG(LogFirebase, Warning, TEXT("Firebase Memory: Budget of %lld KB reached; refusing %lld bytes of %s (further refusals are only counted)"),
+			GetBudget() / 1024, Bytes, LexToString(Category));
+	}
+	return false;
+}
+
+void FFirebaseMemory::Add(EFirebaseMemoryCategory Category, int64 Bytes)
+{
+	Usage[(int32)Category].fetch_add(Bytes, std::memory_order_relaxed);
+	TotalBytes.fetch_add(Bytes, std::memory_order_relaxed);
+}
+
+void FFirebaseMemory::Release(EFirebaseMemoryCategory Category, int64 Bytes)
+{
+	Add(Category, -Bytes);
+}
+
+int64 FFirebaseMemory::GetUsage(EFirebaseMemoryCategory Category) const
+{
+	return Category < EFirebaseMemoryCategory::Num ? Usage[(int32)Category].load(std::memory_order_relaxed) : 0;
+}
+
+void FFirebaseMemory::Dump(FOutputDevice& Ar) const
+{
+	const int64 Budget = GetBudget();
+	if (Budget > 0)
+	{
+		Ar.Logf(TEXT("Firebase Memory: %.1f KB of %.1f KB budget, %lld refusals"), GetTotal() / 1024.0, Budget / 1024.0, GetRefusals());
+	}
+	else
+	{
+		Ar.Logf(TEXT("Firebase Memory: %.1f KB, no budget"), GetTotal() / 1024.0);
+	}
+
+	for (int32 Index = 0; Index < (int32)EFirebaseMemoryCategory::Num; ++Index)
+	{
+		const EFirebaseMemoryCategory Category = EFirebaseMemoryCategory(Index);
+		Ar.Logf(TEXT("  %-12s %10.1f KB"), LexToString(Category), GetUsage(Category) / 1024.0);
+	}
+}
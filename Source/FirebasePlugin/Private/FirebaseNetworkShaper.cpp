@@ -0,0 +1,274 @@
+// Copyright. All Rights Reserved.
+
+#include "FirebaseNetworkShaper.h"
+
+FFirebaseNetworkProfile FFirebaseNetworkProfile::Mobile3G()
+{
+	FFirebaseNetworkProfile Profile;
+	Profile.LatencyDistribution = EFirebaseLatencyDistribution::LogNormal;
+	Profile.LatencySeconds = 0.3f;
+	Profile.LatencyShape = 0.5f;
+	Profile.JitterSeconds = 0.05f;
+	Profile.UplinkBytesPerSecond = 750000 / 8;
+	Profile.DownlinkBytesPerSecond = 1600000 / 8;
+	Profile.RequestLossProbability = 0.01f;
+	Profile.ResponseLossProbability = 0.01f;
+	Profile.ReorderProbability = 0.02f;
+	Profile.ReorderDelaySeconds = 0.2f;
+	Profile.TruncationProbability = 0.005f;
+	return Profile;
+}
+
+FFirebaseNetworkProfile FFirebaseNetworkProfile::Mobile4G()
+{
+	FFirebaseNetworkProfile Profile;
+	Profile.LatencyDistribution = EFirebaseLatencyDistribution::LogNormal;
+	Profile.LatencySeconds = 0.07f;
+	Profile.LatencyShape = 0.35f;
+	Profile.JitterSeconds = 0.015f;
+	Profile.UplinkBytesPerSecond = 3000000 / 8;
+	Profile.DownlinkBytesPerSecond = 9000000 / 8;
+	Profile.RequestLossProbability = 0.002f;
+	Profile.ResponseLossProbability = 0.002f;
+	return Profile;
+}
+
+FFirebaseNetworkProfile FFirebaseNetworkProfile::CongestedWiFi()
+{
+	FFirebaseNetworkProfile Profile;
+	Profile.LatencyDistribution = EFirebaseLatencyDistribution::Pareto;
+	Profile.LatencySeconds = 0.02f;
+	Profile.LatencyShape = 1.5f;
+	Profile.JitterSeconds = 0.08f;
+	Profile.MaxLatencySeconds = 5.0f;
+	Profile.UplinkBytesPerSecond = 1000000 / 8;
+	Profile.DownlinkBytesPerSecond = 2000000 / 8;
+	Profile.RequestLossProbability = 0.03f;
+	Profile.ResponseLossProbability = 0.03f;
+	Profile.ReorderProbability = 0.05f;
+	Profile.ReorderDelaySeconds = 0.1f;
+	Profile.TruncationProbability = 0.01f;
+	return Profile;
+}
+
+FFirebaseNetworkProfile FFirebaseNetworkProfile::Offline()
+{
+	FFirebaseNetworkProfile Profile;
+	Profile.RequestLossProbability = 1.0f;
+	return Profile;
+}
+
+bool FFirebaseNetworkProfile::FindByName(const FString& Name, FFirebaseNetworkProfile& OutProfile)
+{
+	static const TPair<const TCHAR*, FFirebaseNetworkProfile(*)()> Profiles[] = {
+		{ TEXT("Ideal"), &FFirebaseNetworkProfile::Ideal },
+		{ TEXT("Mobile3G"), &FFirebaseNetworkProfile::Mobile3G },
+		{ TEXT("Mobile4G"), &FFirebaseNetworkProfile::Mobile4G },
+		{ TEXT("CongestedWiFi"), &FFirebaseNetworkProfile::CongestedWiFi },
+		{ TEXT("Offline"), &FFirebaseNetworkProfile::Offline },
+	};
+
+	for (const TPair<const TCHAR*, FFirebaseNetworkProfile(*)()>& Entry : Profiles)
+	{
+		if (Name.Equals(Entry.Key, ESearchCase::IgnoreCase))
+		{
+			OutProfile = Entry.Value();
+			return true;
+		}
+	}
+	return false;
+}
+
+FFirebaseNetworkShaper::FFirebaseNetworkShaper(TSharedRef<IFirebaseHttpTransport> InInner, const FFirebaseNetworkProfile& InProfile, int32 Seed)
+	: Inner(MoveTemp(InInner))
+	, Profile(InProfile)
+	, Random(Seed)
+{
+}
+
+double FFirebaseNetworkShaper::SampleLatency()
+{
+	const double Base = Profile.LatencySeconds;
+	double Latency = Base;
+
+	switch (Profile.LatencyDistribution)
+	{
+	case EFirebaseLatencyDistribution::Uniform:
+		Latency = Base + (Random.FRand() * 2.0 - 1.0) * Profile.LatencySpreadSeconds;
+		break;
+
+	case EFirebaseLatencyDistribution::Normal:
+	case EFirebaseLatencyDistribution::LogNormal:
+	{
+		// Box-Muller
+		const double U1 = FMath::Max((double)Random.FRand(), 1e-12);
+		const double U2 = Random.FRand();
+		const double Z = FMath::Sqrt(-2.0 * FMath::Loge(U1)) * FMath::Cos(2.0 * UE_DOUBLE_PI * U2);
+		Latency = Profile.LatencyDistribution == EFirebaseLatencyDistribution::Normal
+			? Base + Z * Profile.LatencySpreadSeconds
+			: Base * FMath::Exp(Z * Profile.LatencyShape);
+		break;
+	}
+
+	case EFirebaseLatencyDistribution::Pareto:
+	{
+		const double U = FMath::Max(1.0 - Random.FRand(), 1e-12);
+		Latency = Base / FMath::Pow(U, 1.0 / FMath::Max((double)Profile.LatencyShape, 0.01));
+		break;
+	}
+
+	default:
+		break;
+	}
+
+	Latency += Random.FRand() * Profile.JitterSeconds;
+	return FMath::Clamp(Latency, 0.0, (double)Profile.MaxLatencySeconds);
+}
+
+FFirebaseHttpRequestId FFirebaseNetworkShaper::Send(FFirebaseHttpRequest&& Request, FFirebaseHttpCallback&& OnComplete)
+{
+	const FFirebaseHttpRequestId RequestId = NextRequestId++;
+	const double Now = Schedule.GetTime();
+	Stats.Requests++;
+
+	const double Timeout = Request.TimeoutSeconds > 0.0f ? Request.TimeoutSeconds : Profile.LossTimeoutSeconds;
+	const double Deadline = Now + Timeout;
+
+	if (Random.FRand() < Profile.RequestLossProbability)
+	{
+		// Never reaches the server; the client notices only when it gives up
+		Stats.RequestsLost++;
+		Schedule.Add(RequestId, Deadline, FFirebaseHttpResponse::Failed(), MoveTemp(OnComplete));
+		return RequestId;
+	}
+
+	// The body queues behind earlier uploads on the shared link
+	double UploadDone = Now;
+	const int32 UploadBytes = Request.Body.Num();
+	Stats.BytesUp += UploadBytes;
+	if (Profile.UplinkBytesPerSecond > 0)
+	{
+		UploadDone = FMath::Max(Now, UplinkFreeTime) + double(UploadBytes) / Profile.UplinkBytesPerSecond;
+		UplinkFreeTime = UploadDone;
+	}
+
+	FInFlightRequest& Entry = InFlight.Add(RequestId);
+	Entry.OnComplete = MoveTemp(OnComplete);
+	Entry.SendTime = Now;
+	Entry.UploadDoneTime = UploadDone;
+	Entry.Deadline = Deadline;
+	Entry.LatencySeconds = SampleLatency();
+
+	TWeakPtr<FFirebaseNetworkShaper> WeakThis = AsShared();
+	const FFirebaseHttpRequestId InnerId = Inner->Send(MoveTemp(Request), [WeakThis, RequestId](const FFirebaseHttpResponse& Response)
+	{
+		if (TSharedPtr<FFirebaseNetworkShaper> This = WeakThis.Pin())
+		{
+			This->OnInnerResponse(RequestId, Response);
+		}
+	});
+
+	// The inner transport may already have answered
+	if (FInFlightRequest* Pending = InFlight.Find(RequestId))
+	{
+		Pending->InnerId = InnerId;
+	}
+	return RequestId;
+}
+
+void FFirebaseNetworkShaper::OnInnerResponse(FFirebaseHttpRequestId RequestId, const FFirebaseHttpResponse& InnerResponse)
+{
+	FInFlightRequest Entry;
+	if (!InFlight.RemoveAndCopyValue(RequestId, Entry))
+	{
+		// Cancelled
+		return;
+	}
+
+	const double Now = Schedule.GetTime();
+
+	if (!InnerResponse.bSucceeded || Random.FRand() < Profile.ResponseLossProbability)
+	{
+		if (InnerResponse.bSucceeded)
+		{
+			// The server saw the request (a write was applied) but the client never hears back
+			Stats.ResponsesLost++;
+			Deliver(RequestId, Entry.Deadline, FFirebaseHttpResponse::Failed(), MoveTemp(Entry.OnComplete));
+		}
+		else
+		{
+			Deliver(RequestId, FMath::Max(Now, Entry.UploadDoneTime) + Entry.LatencySeconds, FFirebaseHttpResponse::Failed(), MoveTemp(Entry.OnComplete));
+		}
+		return;
+	}
+
+	FFirebaseHttpResponse Response = InnerResponse;
+
+	// First byte after the round trip; the body then queues behind earlier downloads
+	const double FirstByteTime = FMath::Max(Now, Entry.UploadDoneTime) + Entry.LatencySeconds;
+	double DoneTime = FirstByteTime;
+	const int32 DownloadBytes = Response.Body.Num();
+	Stats.BytesDown += DownloadBytes;
+	if (Profile.DownlinkBytesPerSecond > 0)
+	{
+		DoneTime = FMath::Max(DoneTime, DownlinkFreeTime) + double(DownloadBytes) / Profile.DownlinkBytesPerSecond;
+		DownlinkFreeTime = DoneTime;
+	}
+
+	if (Random.FRand() < Profile.ReorderProbability)
+	{
+		Stats.Reordered++;
+		DoneTime += Random.FRand() * Profile.ReorderDelaySeconds;
+	}
+
+	if (DownloadBytes > 0 && Random.FRand() < Profile.TruncationProbability)
+	{
+		Stats.Truncated++;
+		const int32 Kept = Random.RandHelper(DownloadBytes);
+		Response.Body = FFirebasePayload::FromUtf8(FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Response.Body.GetData()), Kept));
+	}
+
+	if (DoneTime > Entry.Deadline)
+	{
+		Stats.TimedOut++;
+		Deliver(RequestId, Entry.Deadline, FFirebaseHttpResponse::Failed(), MoveTemp(Entry.OnComplete));
+		return;
+	}
+
+	// Timings on the shaper's clock replace whatever the inner transport measured
+	Response.TimeToFirstByteSeconds = float(FirstByteTime - Entry.SendTime);
+	Response.ElapsedSeconds = float(DoneTime - Entry.SendTime);
+
+	Deliver(RequestId, DoneTime, MoveTemp(Response), MoveTemp(Entry.OnComplete));
+}
+
+void FFirebaseNetworkShaper::Deliver(FFirebaseHttpRequestId RequestId, double DueTime, FFirebaseHttpResponse&& Response, FFirebaseHttpCallback&& OnComplete)
+{
+	if (DueTime <= Schedule.GetTime())
+	{
+		OnComplete(Response);
+		return;
+	}
+	Schedule.Add(RequestId, DueTime, MoveTemp(Response), MoveTemp(OnComplete));
+}
+
+void FFirebaseNetworkShaper::Cancel(FFirebaseHttpRequestId RequestId)
+{
+	FInFlightRequest Entry;
+	if (InFlight.RemoveAndCopyValue(RequestId, Entry))
+	{
+		// The inner response is ignored once the entry is gone
+		if (Entry.InnerId != 0)
+		{
+			Inner->Cancel(Entry.InnerId);
+		}
+		Entry.OnComplete(FFirebaseHttpResponse::Failed());
+		return;
+	}
+
+	FFirebaseHttpCallback OnComplete;
+	if (Schedule.Remove(RequestId, &OnComplete))
+	{
+		OnComplete(FFirebaseHttpResponse::Failed());
+	}
+}
@@ -0,0 +1,89 @@
+// Copyright. All Rights Reserved.
+
+#include "FirebasePayload.h"
+#include "FirebaseMemory.h"
+#include "FirebaseBufferPool.h"
+
+FFirebasePayload FFirebasePayload::FromResponse(const FHttpResponsePtr& Response)
+{
+	FFirebasePayload Payload;
+	if (Response.IsValid())
+	{
+		const TArray<uint8>& Content = Response->GetContent();
+		Payload.Response = Response;
+		Payload.Data = Content.GetData();
+		Payload.Size = Content.Num();
+	}
+	return Payload;
+}
+
+FFirebasePayload FFirebasePayload::FromUtf8(TArray<uint8>&& Bytes)
+{
+	LLM_SCOPE_BYTAG(Firebase_Buffers);
+	FFirebasePayload Payload;
+	if (Bytes.Num() > 0)
+	{
+		// The bytes go back to the pool when the last copy of the payload is released
+		TSharedPtr<const TArray<uint8>, ESPMode::ThreadSafe> Buffer(new TArray<uint8>(MoveTemp(Bytes)), [](const TArray<uint8>* Owned)
+		{
+			FFirebaseBufferPool::Get().Release(MoveTemp(*const_cast<TArray<uint8>*>(Owned)));
+			delete Owned;
+		});
+		Payload.Data = Buffer->GetData();
+		Payload.Size = Buffer->Num();
+		Payload.Buffer = MoveTemp(Buffer);
+	}
+	else
+	{
+		FFirebaseBufferPool::Get().Release(MoveTemp(Bytes));
+	}
+	return Payload;
+}
+
+FFirebasePayload FFirebasePayload::FromUtf8(FUtf8StringView Text)
+{
+	if (Text.IsEmpty())
+	{
+		return FFirebasePayload();
+	}
+
+	TArray<uint8> Bytes = FFirebaseBufferPool::Get().Acquire(Text.Len());
+	Bytes.Append(reinterpret_cast<const uint8*>(Text.GetData()), Text.Len());
+	return FromUtf8(MoveTemp(Bytes));
+}
+
+FFirebasePayload FFirebasePayload::FromString(const FString& Text)
+{
+	if (Text.IsEmpty())
+	{
+		return FFirebasePayload();
+	}
+
+	// Transcode straight into a pooled buffer
+	const int32 Length = FPlatformString::ConvertedLength<UTF8CHAR>(*Text, Text.Len());
+	TArray<uint8> Bytes = FFirebaseBufferPool::Get().Acquire(Length);
+	Bytes.AddUninitialized(Length);
+	FPlatformString::Convert(reinterpret_cast<UTF8CHAR*>(Bytes.GetData()), Length, *Text, Text.Len());
+	return FromUtf8(MoveTemp(Bytes));
+}
+
+FString FFirebasePayload::ToString() const
+{
+	if (Size == 0)
+	{
+		return FString();
+	}
+
+	FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Data), Size);
+	return FString(Converter.Length(), Converter.Get());
+}
+
+uint32 FFirebasePayload::GetHash() const
+{
+	return FCrc::MemCrc32(Data, Size);
+}
+
+bool FFirebasePayload::Equals(const FFirebasePayload& Other) const
+{
+	return Size == Other.Size && (Size == 0 || Data == Other.Data || FMemory::Memcmp(Data, Other.Data, Size) == 0);
+}
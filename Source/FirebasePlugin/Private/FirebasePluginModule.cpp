@@ -1,7 +1,13 @@
 // Copyright. All Rights Reserved.
 
 #include "FirebasePluginModule.h"
+#include "FirebaseLog.h"
 #include "FirebaseSettings.h"
+#include "FirebaseBufferPool.h"
+#include "FirebaseMemory.h"
+#include "FirebaseStats.h"
+#include "FirebaseTrafficRecorder.h"
+#include "Misc/CoreDelegates.h"
 
 #if WITH_EDITOR
 #include "ISettingsModule.h"
@@ -12,18 +18,48 @@
 
 void FFirebasePluginModule::StartupModule()
 {
-	UE_LOG(LogTemp, Log, TEXT("FirebasePlugin: Module starting up"));
+	UE_LOG(LogFirebase, Log, TEXT("FirebasePlugin: Module starting up"));
 	
 	// Register settings
 	RegisterSettings();
+	FFirebaseLog::ApplySettings();
+	FFirebaseMemory::Get().ApplySettings();
+
+	// Give pooled buffers back when the platform runs low on memory
+	MemoryTrimHandle = FCoreDelegates::GetMemoryTrimDelegate().AddLambda([]()
+	{
+		FFirebaseBufferPool::Get().Trim();
+	});
+
+	// Roll the latency windows and refresh `stat Firebase` a few times a second
+	StatsTickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([](float DeltaTime)
+	{
+		FFirebaseRequestMetrics::Get().Tick(FPlatformTime::Seconds());
+		return true;
+	}), 0.25f);
+
+	// Leave the last requests in the log when the engine reports a crash
+	SystemErrorHandle = FCoreDelegates::OnHandleSystemError.AddLambda([]()
+	{
+		FFirebaseRequestLog::Get().Dump(*GLog);
+	});
+
+	FFirebaseTrafficRecorder::Get().StartFromCommandLine();
 }
 
 void FFirebasePluginModule::ShutdownModule()
 {
-	UE_LOG(LogTemp, Log, TEXT("FirebasePlugin: Module shutting down"));
+	UE_LOG(LogFirebase, Log, TEXT("FirebasePlugin: Module shutting down"));
+
+	FFirebaseTrafficRecorder::Get().StopFromCommandLine();
 	
 	// Unregister settings
 	UnregisterSettings();
+
+	FCoreDelegates::GetMemoryTrimDelegate().Remove(MemoryTrimHandle);
+	FTSTicker::GetCoreTicker().RemoveTicker(StatsTickHandle);
+	FCoreDelegates::OnHandleSystemError.Remove(SystemErrorHandle);
+	FFirebaseBufferPool::Get().Trim();
 }
 
 bool FFirebasePluginModule::RegisterSettings()
@@ -0,0 +1,340 @@
+// Copyright. All Rights Reserved.
+
+#include "FirebaseRateLimiter.h"
+#include "FirebaseMemory.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace
+{
+	FString NormalizePrefix(const FString& Path)
+	{
+		FString Clean = Path;
+		Clean.RemoveFromStart(TEXT("/"));
+		Clean.RemoveFromEnd(TEXT("/"));
+		return Clean;
+	}
+
+	bool PathMatchesPrefix(const FString& Path, const FString& Prefix)
+	{
+		if (Prefix.IsEmpty())
+		{
+			return true;
+		}
+
+		// "users/1" must not match "users/10"; keys are case-sensitive, so neither may "Users/1"
+		if (!Path.StartsWith(Prefix, ESearchCase::CaseSensitive))
+		{
+			return false;
+		}
+		return Path.Len() == Prefix.Len() || Path[Prefix.Len()] == TEXT('/');
+	}
+}
+
+EFirebaseRateLimitOperation FFirebaseRateLimiter::GetOperationType(const FString& Method)
+{
+	if (Method == TEXT("GET"))
+	{
+		return EFirebaseRateLimitOperation::Read;
+	}
+	if (Method == TEXT("DELETE"))
+	{
+		return EFirebaseRateLimitOperation::Delete;
+	}
+	return EFirebaseRateLimitOperation::Write;
+}
+
+// === QUEUED REQUEST ===
+
+SIZE_T FFirebaseQueuedRequest::GetAllocatedSize() const
+{
+	return sizeof(FFirebaseQueuedRequest) + Path.GetAllocatedSize() + Method.GetAllocatedSize() + Url.GetAllocatedSize()
+		+ Body.Num() + CoalescedCallbacks.GetAllocatedSize();
+}
+
+bool FFirebaseQueuedRequest::ReserveMemory()
+{
+	const int64 Bytes = GetAllocatedSize();
+	if (!FFirebaseMemory::Get().Reserve(EFirebaseMemoryCategory::Queues, Bytes))
+	{
+		return false;
+	}
+	ReservedBytes += Bytes;
+	return true;
+}
+
+void FFirebaseQueuedRequest::ReleaseMemory()
+{
+	FFirebaseMemory::Get().Release(EFirebaseMemoryCategory::Queues, ReservedBytes);
+	ReservedBytes = 0;
+}
+
+// === RATE LIMITER ===
+
+FFirebaseRateLimiter::~FFirebaseRateLimiter()
+{
+	for (FBucket& Bucket : Buckets)
+	{
+		for (FFirebaseQueuedRequest& Request : Bucket.Queue)
+		{
+			Request.ReleaseMemory();
+		}
+	}
+}
+
+void FFirebaseRateLimiter::SetRules(const TArray<FFirebaseRateLimitRule>& InRules, TArray<FFirebaseQueuedRequest>& OutReleased)
+{
+	// Anything still waiting is released so no callback is lost
+	for (FBucket& Bucket : Buckets)
+	{
+		for (FFirebaseQueuedRequest& Request : Bucket.Queue)
+		{
+			Request.ReleaseMemory();
+		}
+		OutReleased.Append(MoveTemp(Bucket.Queue));
+	}
+	Buckets.Reset();
+
+	const double Now = FPlatformTime::Seconds();
+	for (const FFirebaseRateLimitRule& Rule : InRules)
+	{
+		FBucket& Bucket = Buckets.AddDefaulted_GetRef();
+		Bucket.Rule = Rule;
+		Bucket.Rule.PathPrefix = NormalizePrefix(Rule.PathPrefix);
+		Bucket.Rule.RequestsPerSecond = FMath::Max(Rule.RequestsPerSecond, 0.01f);
+		Bucket.Rule.BurstSize = FMath::Max(Rule.BurstSize, 1);
+		Bucket.Rule.MaxQueuedRequests = FMath::Max(Rule.MaxQueuedRequests, 1);
+		Bucket.Tokens = Bucket.Rule.BurstSize;
+		Bucket.LastRefillTime = Now;
+		Bucket.Stats.PathPrefix = Bucket.Rule.PathPrefix;
+		Bucket.Stats.Operation = Bucket.Rule.Operation;
+	}
+}
+
+int32 FFirebaseRateLimiter::FindBucket(const FString& Path, EFirebaseRateLimitOperation Operation) const
+{
+	// Most specific rule wins: longest prefix, then exact operation over "Any"
+	int32 BestIndex = INDEX_NONE;
+	int32 BestScore = -1;
+
+	for (int32 Index = 0; Index < Buckets.Num(); Index++)
+	{
+		const FFirebaseRateLimitRule& Rule = Buckets[Index].Rule;
+		if (Rule.Operation != EFirebaseRateLimitOperation::Any && Rule.Operation != Operation)
+		{
+			continue;
+		}
+		if (!PathMatchesPrefix(Path, Rule.PathPrefix))
+		{
+			continue;
+		}
+
+		const int32 Score = Rule.PathPrefix.Len() * 2 + (Rule.Operation == Operation ? 1 : 0);
+		if (Score > BestScore)
+		{
+			BestScore = Score;
+			BestIndex = Index;
+		}
+	}
+
+	return BestIndex;
+}
+
+void FFirebaseRateLimiter::Refill(FBucket& Bucket, double Now)
+{
+	const double Elapsed = FMath::Max(Now - Bucket.LastRefillTime, 0.0);
+	Bucket.Tokens = FMath::Min(Bucket.Tokens + Elapsed * Bucket.Rule.RequestsPerSecond, (double)Bucket.Rule.BurstSize);
+	Bucket.LastRefillTime = Now;
+}
+
+FFirebaseRateLimiter::EAdmitResult FFirebaseRateLimiter::Admit(FFirebaseQueuedRequest& Request, double Now)
+{
+	const int32 BucketIndex = FindBucket(NormalizePrefix(Request.Path), GetOperationType(Request.Method));
+	if (BucketIndex == INDEX_NONE)
+	{
+		return EAdmitResult::Send;
+	}
+
+	FBucket& Bucket = Buckets[BucketIndex];
+	Refill(Bucket, Now);
+
+	// Queued requests go first so ordering is preserved
+	if (Bucket.Queue.Num() == 0 && Bucket.Tokens >= 1.0)
+	{
+		Bucket.Tokens -= 1.0;
+		Bucket.Stats.SentRequests++;
+		return EAdmitResult::Send;
+	}
+
+	if (Bucket.Rule.Overflow == EFirebaseRateLimitOverflow::Coalesce && TryCoalesce(Bucket, Request))
+	{
+		Bucket.Stats.CoalescedRequests++;
+		return EAdmitResult::Deferred;
+	}
+
+	if (Bucket.Rule.Overflow == EFirebaseRateLimitOverflow::Reject
+		|| Bucket.Queue.Num() >= Bucket.Rule.MaxQueuedRequests
+		|| !Request.ReserveMemory())
+	{
+		Bucket.Stats.RejectedRequests++;
+		return EAdmitResult::Rejected;
+	}
+
+	LLM_SCOPE_BYTAG(Firebase_Queues);
+	Bucket.Queue.Add(MoveTemp(Request));
+	Bucket.Stats.ThrottledRequests++;
+	return EAdmitResult::Deferred;
+}
+
+bool FFirebaseRateLimiter::TryCoalesce(FBucket& Bucket, FFirebaseQueuedRequest& Request)
+{
+	// Pushes always create a new child, so they can never be merged
+	if (Request.Method == TEXT("POST"))
+	{
+		return false;
+	}
+
+	if (Request.Method == TEXT("GET"))
+	{
+		// Identical reads share one response, as long as no write queued after the earlier
+		// read (to any path) would have been visible to this one
+		for (int32 Index = Bucket.Queue.Num() - 1; Index >= 0; Index--)
+		{
+			FFirebaseQueuedRequest& Queued = Bucket.Queue[Index];
+			if (Queued.Method != TEXT("GET"))
+			{
+				return false;
+			}
+			if (Queued.Path.Equals(Request.Path, ESearchCase::CaseSensitive) && Queued.Url.Equals(Request.Url, ESearchCase::CaseSensitive))
+			{
+				Queued.CoalescedCallbacks.Add(Request.Callback);
+				Queued.CoalescedCallbacks.Append(MoveTemp(Request.CoalescedCallbacks));
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// Writes only merge into the newest queued request, so a merged write is never sent
+	// ahead of a request that was queued before it
+	if (Bucket.Queue.Num() == 0)
+	{
+		return false;
+	}
+
+	FFirebaseQueuedRequest& Queued = Bucket.Queue.Last();
+	if (!Queued.Path.Equals(Request.Path, ESearchCase::CaseSensitive) || Queued.Method == TEXT("GET"))
+	{
+		return false;
+	}
+
+	if (Request.Method == TEXT("PATCH") && Queued.Method == TEXT("PATCH"))
+	{
+		// Merge partial updates, newer fields win
+		Queued.Body = MergePatchBodies(Queued.Body, Request.Body);
+	}
+	else if (Request.Method == TEXT("PUT") || Request.Method == TEXT("DELETE"))
+	{
+		// Overwrite (or delete) supersedes whatever was queued for this path
+		Queued.Method = Request.Method;
+		Queued.Body = Request.Body;
+	}
+	else
+	{
+		return false;
+	}
+
+	// Latest write wins; older callers complete with its result
+	Queued.Url = Request.Url;
+	Queued.CoalescedCallbacks.Add(Queued.Callback);
+	Queued.CoalescedCallbacks.Append(MoveTemp(Request.CoalescedCallbacks));
+	Queued.Callback = Request.Callback;
+	return true;
+}
+
+FFirebasePayload FFirebaseRateLimiter::MergePatchBodies(const FFirebasePayload& OlderBody, const FFirebasePayload& NewerBody)
+{
+	TSharedPtr<FJsonObject> OlderObject;
+	TSharedPtr<FJsonObject> NewerObject;
+	TSharedRef<TJsonReader<>> OlderReader = TJsonReaderFactory<>::Create(OlderBody.ToString());
+	TSharedRef<TJsonReader<>> NewerReader = TJsonReaderFactory<>::Create(NewerBody.ToString());
+
+	if (!FJsonSerializer::Deserialize(OlderReader, OlderObject) || !OlderObject.IsValid()
+		|| !FJsonSerializer::Deserialize(NewerReader, NewerObject) || !NewerObject.IsValid())
+	{
+		// Not mergeable; the newest update is the best we can do
+		return NewerBody;
+	}
+
+	for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : NewerObject->Values)
+	{
+		OlderObject->SetField(Field.Key, Field.Value);
+	}
+
+	FString Merged;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer =
+		TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Merged);
+	FJsonSerializer::Serialize(OlderObject.ToSharedRef(), Writer);
+	return FFirebasePayload::FromString(Merged);
+}
+
+void FFirebaseRateLimiter::Tick(double Now, TArray<FFirebaseQueuedRequest>& OutReady)
+{
+	for (FBucket& Bucket : Buckets)
+	{
+		if (Bucket.Queue.Num() == 0)
+		{
+			continue;
+		}
+
+		Refill(Bucket, Now);
+
+		int32 ReadyCount = 0;
+		while (ReadyCount < Bucket.Queue.Num() && Bucket.Tokens >= 1.0)
+		{
+			Bucket.Tokens -= 1.0;
+			Bucket.Stats.SentRequests++;
+			ReadyCount++;
+		}
+
+		if (ReadyCount > 0)
+		{
+			for (int32 Index = 0; Index < ReadyCount; Index++)
+			{
+				Bucket.Queue[Index].ReleaseMemory();
+				OutReady.Add(MoveTemp(Bucket.Queue[Index]));
+			}
+			Bucket.Queue.RemoveAt(0, ReadyCount);
+		}
+	}
+}
+
+bool FFirebaseRateLimiter::HasQueuedRequests() const
+{
+	for (const FBucket& Bucket : Buckets)
+	{
+		if (Bucket.Queue.Num() > 0)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+TArray<FFirebaseRateLimiterStats> FFirebaseRateLimiter::GetStats(double Now) const
+{
+	TArray<FFirebaseRateLimiterStats> Result;
+	Result.Reserve(Buckets.Num());
+
+	for (const FBucket& Bucket : Buckets)
+	{
+		FFirebaseRateLimiterStats& Stats = Result.Add_GetRef(Bucket.Stats);
+		const double Elapsed = FMath::Max(Now - Bucket.LastRefillTime, 0.0);
+		Stats.AvailableTokens = (float)FMath::Min(Bucket.Tokens + Elapsed * Bucket.Rule.RequestsPerSecond, (double)Bucket.Rule.BurstSize);
+		Stats.QueuedRequests = Bucket.Queue.Num();
+	}
+
+	return Result;
+}
@@ -0,0 +1,109 @@
+// Copyright. All Rights Reserved.
+
+#include "FirebaseResponseSchedule.h"
+
+FFirebaseResponseSchedule::~FFirebaseResponseSchedule()
+{
+	SetRealTime(false);
+}
+
+void FFirebaseResponseSchedule::Add(FFirebaseHttpRequestId RequestId, double DueTime, FFirebaseHttpResponse&& Response, FFirebaseHttpCallback&& OnComplete)
+{
+	FEntry& Entry = Pending.AddDefaulted_GetRef();
+	Entry.RequestId = RequestId;
+	Entry.DueTime = DueTime;
+	Entry.Sequence = NextSequence++;
+	Entry.Response = MoveTemp(Response);
+	Entry.OnComplete = MoveTemp(OnComplete);
+}
+
+bool FFirebaseResponseSchedule::Remove(FFirebaseHttpRequestId RequestId, FFirebaseHttpCallback* OutOnComplete)
+{
+	const int32 Index = Pending.IndexOfByPredicate([RequestId](const FEntry& Entry) { return Entry.RequestId == RequestId; });
+	if (Index == INDEX_NONE)
+	{
+		return false;
+	}
+
+	if (OutOnComplete)
+	{
+		*OutOnComplete = MoveTemp(Pending[Index].OnComplete);
+	}
+	Pending.RemoveAt(Index);
+	return true;
+}
+
+bool FFirebaseResponseSchedule::PopDue(double Until, FEntry& OutEntry)
+{
+	int32 BestIndex = INDEX_NONE;
+	for (int32 Index = 0; Index < Pending.Num(); ++Index)
+	{
+		const FEntry& Entry = Pending[Index];
+		if (Entry.DueTime > Until)
+		{
+			continue;
+		}
+		if (BestIndex == INDEX_NONE || Entry.DueTime < Pending[BestIndex].DueTime
+			|| (Entry.DueTime == Pending[BestIndex].DueTime && Entry.Sequence < Pending[BestIndex].Sequence))
+		{
+			BestIndex = Index;
+		}
+	}
+
+	if (BestIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	OutEntry = MoveTemp(Pending[BestIndex]);
+	Pending.RemoveAt(BestIndex);
+	return true;
+}
+
+int32 FFirebaseResponseSchedule::Advance(double Seconds)
+{
+	const double Until = Now + FMath::Max(Seconds, 0.0);
+	int32 Delivered = 0;
+
+	// Callbacks may schedule more responses; any that fall due before Until are delivered in this call too
+	FEntry Entry;
+	while (PopDue(Until, Entry))
+	{
+		Now = FMath::Max(Now, Entry.DueTime);
+		Entry.OnComplete(Entry.Response);
+		Delivered++;
+	}
+
+	Now = Until;
+	return Delivered;
+}
+
+int32 FFirebaseResponseSchedule::Flush()
+{
+	int32 Delivered = 0;
+	FEntry Entry;
+	while (PopDue(TNumericLimits<double>::Max(), Entry))
+	{
+		Now = FMath::Max(Now, Entry.DueTime);
+		Entry.OnComplete(Entry.Response);
+		Delivered++;
+	}
+	return Delivered;
+}
+
+void FFirebaseResponseSchedule::SetRealTime(bool bEnabled)
+{
+	if (bEnabled && !TickHandle.IsValid())
+	{
+		TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([this](float DeltaTime)
+		{
+			Advance(DeltaTime);
+			return true;
+		}));
+	}
+	else if (!bEnabled && TickHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+		TickHandle.Reset();
+	}
+}
@@ -1,8 +1,16 @@
 // Copyright. All Rights Reserved.
 
 #include "FirebaseRestAPI.h"
-#include "HttpModule.h"
-#include "Interfaces/IHttpResponse.h"
+#include "FirebaseLog.h"
+#include "FirebaseSettings.h"
+#include "FirebaseBufferPool.h"
+#include "FirebaseMemory.h"
+#include "FirebaseStats.h"
+#include "FirebaseTrace.h"
+#include "FirebaseTrafficRecorder.h"
+#include "Containers/Ticker.h"
+#include "GameFramework/Actor.h"
+#include "Components/ActorComponent.h"
 #include "Serialization/JsonSerializer.h"
 #include "Serialization/JsonWriter.h"
 
@@ -16,15 +24,186 @@ const FString UFirebaseRestAPI::AUTH_DELETE_ENDPOINT = TEXT("https://identitytoo
 const FString UFirebaseRestAPI::AUTH_GET_USER_ENDPOINT = TEXT("https://identitytoolkit.googleapis.com/v1/accounts:lookup");
 const FString UFirebaseRestAPI::AUTH_SEND_VERIFICATION_ENDPOINT = TEXT("https://identitytoolkit.googleapis.com/v1/accounts:sendOobCode");
 
+namespace FirebaseHedging
+{
+	// Number of recent read latencies used for the percentile estimate
+	static constexpr int32 MaxLatencySamples = 256;
+
+	// Samples required before the percentile replaces the initial delay
+	static constexpr int32 MinLatencySamples = 20;
+
+	// Recompute the percentile after this many new samples
+	static constexpr int32 DelayUpdateInterval = 16;
+
+	// Cap on saved-up hedges so a quiet period cannot turn into a burst
+	static constexpr float MaxHedgeTokens = 10.0f;
+
+	/** Shared state of one hedged read (primary + optional duplicate) */
+	struct FHedgedReadState
+	{
+		bool bCompleted = false;
+		int32 InFlight = 0;
+		TArray<FFirebaseHttpRequestId> Attempts;
+
+		/** When each attempt was sent; 0 once it has failed */
+		TArray<double> AttemptStartTimes;
+		TSharedPtr<IFirebaseHttpTransport> Transport;
+		FTSTicker::FDelegateHandle HedgeTimer;
+	};
+}
+
+namespace FirebaseConnectivity
+{
+	// Tiny server-generated value; any HTTP answer (even 401) proves the database is reachable
+	static const TCHAR* ProbePath = TEXT(".info/serverTimeOffset");
+
+	// Probes give up quickly so a dead network is noticed early
+	static constexpr float ProbeTimeoutSeconds = 5.0f;
+}
+
+namespace FirebasePolling
+{
+	// Interval multipliers: speed up on change, back off while nothing happens
+	static constexpr float ChangedIntervalScale = 0.5f;
+	static constexpr float UnchangedIntervalScale = 1.25f;
+
+	// An owner that has been rendered counts as relevant for this long afterwards
+	static constexpr float RenderRelevanceSeconds = 1.0f;
+}
+
+/** One polled path */
+struct FFirebasePollingListener
+{
+	FString Path;
+	FFirebaseRestPayloadCallback OnChanged;
+
+	// Owner gates polling; listeners without an owner always poll
+	TWeakObjectPtr<const UObject> Owner;
+	bool bHasOwner = false;
+
+	// Last seen version of the value (server ETag, or a hash of the body)
+	FString ETag;
+	bool bHasValue = false;
+
+	double NextPollTime = 0.0;
+	float IntervalSeconds = 5.0f;
+	bool bInFlight = false;
+	bool bStopped = false;
+
+	// Counted against FFirebaseMemory while registered
+	int64 AccountedBytes = 0;
+};
+
 UFirebaseRestAPI::UFirebaseRestAPI()
 {
 }
 
 void UFirebaseRestAPI::Initialize(const FString& InApiKey, const FString& InProjectId, const FString& InDatabaseUrl)
 {
+	LLM_SCOPE_BYTAG(Firebase);
+
 	ApiKey = InApiKey;
 	ProjectId = InProjectId;
 	DatabaseUrl = InDatabaseUrl;
+	UrlBuilder.Configure(DatabaseUrl, ApiKey);
+
+	if (!TickHandle.IsValid())
+	{
+		TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UFirebaseRestAPI::Tick));
+	}
+}
+
+void UFirebaseRestAPI::BeginDestroy()
+{
+	if (TickHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+		TickHandle.Reset();
+	}
+
+	// In-flight polls must not report into a dead object
+	for (TPair<FString, TSharedRef<FFirebasePollingListener>>& Pair : PollingListeners)
+	{
+		Pair.Value->bStopped = true;
+		FFirebaseMemory::Get().Release(EFirebaseMemoryCategory::Listeners, Pair.Value->AccountedBytes);
+	}
+	PollingListeners.Empty();
+
+	// Held requests die with the object
+	for (FFirebaseQueuedRequest& Request : OfflineQueue)
+	{
+		Request.ReleaseMemory();
+	}
+
+	Super::BeginDestroy();
+}
+
+bool UFirebaseRestAPI::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FirebaseRestTick);
+	LLM_SCOPE_BYTAG(Firebase);
+
+	const double Now = FPlatformTime::Seconds();
+
+	// Check whether a lost connection is back; without auto-reconnect only GoOnline and held work ask
+	if (bMonitorConnectivity && !bProbeInFlight && Connectivity.ShouldProbe(Now, bAutoReconnect))
+	{
+		SendConnectivityProbe();
+	}
+
+	// Expire held requests, or send them once the connection is back
+	UpdateOfflineQueue(Now);
+
+	// Poll listeners that are due
+	TickPolling(Now);
+
+	// Release requests whose rate limit bucket has refilled
+	if (RateLimiter.HasQueuedRequests())
+	{
+		TArray<FFirebaseQueuedRequest> Ready;
+		RateLimiter.Tick(Now, Ready);
+		for (const FFirebaseQueuedRequest& Request : Ready)
+		{
+			DispatchDatabaseRequest(Request);
+		}
+	}
+
+	return true;
+}
+
+void UFirebaseRestAPI::ConfigureFromSettings(const UFirebaseSettings* Settings)
+{
+	if (!Settings)
+	{
+		return;
+	}
+
+	FFirebaseHedgingConfig Config;
+	Config.bEnabled = Settings->bEnableHedgedReads;
+	Config.DelayPercentile = Settings->HedgeDelayPercentile;
+	Config.InitialDelaySeconds = Settings->HedgeInitialDelaySeconds;
+	Config.MinDelaySeconds = Settings->HedgeMinDelaySeconds;
+	Config.BudgetPercent = Settings->HedgeBudgetPercent;
+	SetHedgingConfig(Config);
+
+	SetRateLimitRules(Settings->bEnableRateLimiting ? Settings->RateLimitRules : TArray<FFirebaseRateLimitRule>());
+
+	FFirebasePollingConfig Polling;
+	Polling.InitialIntervalSeconds = Settings->RestApiPollingInterval;
+	Polling.MinIntervalSeconds = Settings->RestApiMinPollingInterval;
+	Polling.MaxIntervalSeconds = Settings->RestApiMaxPollingInterval;
+	Polling.bPauseWhenOwnerNotRendered = Settings->bPausePollingWhenOwnerNotRendered;
+	SetPollingConfig(Polling);
+
+	Connectivity.Configure(Settings->ConnectivityFailureThreshold, Settings->ConnectivityProbeIntervalSeconds, Settings->ConnectivityMaxProbeIntervalSeconds);
+	bAutoReconnect = Settings->bAutoReconnect;
+	bPauseRequestsWhileOffline = Settings->bPauseRequestsWhileOffline;
+	OfflineQueueTimeoutSeconds = Settings->OfflineQueueTimeoutSeconds;
+	MaxOfflineQueuedRequests = FMath::Max(Settings->MaxOfflineQueuedRequests, 1);
+
+	UrlBuilder.SetAuthEmulator(Settings->AuthEmulatorUrl);
+
+	FFirebaseBufferPool::Get().SetMaxPooledBytes(int64(Settings->BufferPoolBudgetKB) * 1024);
 }
 
 void UFirebaseRestAPI::ClearTokens()
@@ -40,30 +219,27 @@ void UFirebaseRestAPI::GetTrustedServerTime(FFirebaseRestCallback Callback)
 	// Multiple time API options with fast timeout
 	// We'll try worldtimeapi.org which is simpler and faster
 	
-	TSharedRef<IHttpRequest> HttpRequest = FHttpModule::Get().CreateRequest();
+	FFirebaseHttpRequest HttpRequest;
 	
 	// Use worldtimeapi.org - simple, fast, reliable
-	HttpRequest->SetURL(TEXT("http://worldtimeapi.org/api/timezone/Etc/UTC"));
-	HttpRequest->SetVerb(TEXT("GET"));
-	HttpRequest->SetHeader(TEXT("Accept"), TEXT("application/json"));
-	HttpRequest->SetTimeout(5.0f); // 5 second timeout instead of 30
+	HttpRequest.Url = TEXT("http://worldtimeapi.org/api/timezone/Etc/UTC");
+	HttpRequest.Verb = TEXT("GET");
+	HttpRequest.SetHeader(TEXT("Accept"), TEXT("application/json"));
+	HttpRequest.TimeoutSeconds = 5.0f; // 5 second timeout instead of 30
 	
-	UE_LOG(LogTemp, Log, TEXT("Fetching server time from worldtimeapi.org (5s timeout)..."));
+	UE_LOG(LogFirebase, Verbose, TEXT("Firebase: Fetching server time from worldtimeapi.org (5s timeout)"));
 	
 	// Keep a strong reference to this object to prevent garbage collection
 	UFirebaseRestAPI* StrongThis = this;
 	
-	HttpRequest->OnProcessRequestComplete().BindLambda([Callback, StrongThis](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+	GetTransport()->Send(MoveTemp(HttpRequest), [Callback, StrongThis](const FFirebaseHttpResponse& Response)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("==== Time API Lambda Callback Fired! Success: %s ===="), bWasSuccessful ? TEXT("true") : TEXT("false"));
-		
-		if (bWasSuccessful && Response.IsValid())
+		if (Response.bSucceeded)
 		{
-			FString ResponseString = Response->GetContentAsString();
-			int32 ResponseCode = Response->GetResponseCode();
+			FString ResponseString = Response.Body.ToString();
+			int32 ResponseCode = Response.Code;
 			
-			UE_LOG(LogTemp, Log, TEXT("Time API Response Code: %d"), ResponseCode);
-			UE_LOG(LogTemp, Log, TEXT("Time API Response: %s"), *ResponseString);
+			UE_LOG(LogFirebase, Verbose, TEXT("Firebase: Time API response %d - %s"), ResponseCode, *FFirebaseLog::Body(ResponseString));
 			
 			if (ResponseCode >= 200 && ResponseCode < 300)
 			{
@@ -85,7 +261,7 @@ void UFirebaseRestAPI::GetTrustedServerTime(FFirebaseRestCallback Callback)
 						{
 							int64 TimestampMs = ParsedDateTime.ToUnixTimestamp() * 1000LL;
 							FString TimestampString = FString::Printf(TEXT("%lld"), TimestampMs);
-							UE_LOG(LogTemp, Log, TEXT("Successfully parsed time: %s"), *TimestampString);
+							UE_LOG(LogFirebase, Verbose, TEXT("Firebase: Server time is %s"), *TimestampString);
 							Callback.ExecuteIfBound(true, TimestampString);
 							return;
 						}
@@ -97,7 +273,7 @@ void UFirebaseRestAPI::GetTrustedServerTime(FFirebaseRestCallback Callback)
 						int64 UnixTimeSeconds = (int64)JsonObject->GetNumberField(TEXT("unixtime"));
 						int64 TimestampMs = UnixTimeSeconds * 1000LL;
 						FString TimestampString = FString::Printf(TEXT("%lld"), TimestampMs);
-						UE_LOG(LogTemp, Log, TEXT("Successfully parsed time: %s"), *TimestampString);
+						UE_LOG(LogFirebase, Verbose, TEXT("Firebase: Server time is %s"), *TimestampString);
 						Callback.ExecuteIfBound(true, TimestampString);
 						return;
 					}
@@ -108,17 +284,17 @@ void UFirebaseRestAPI::GetTrustedServerTime(FFirebaseRestCallback Callback)
 						int64 TimestampSec = (int64)JsonObject->GetNumberField(TEXT("timestamp"));
 						int64 TimestampMs = TimestampSec * 1000LL;
 						FString TimestampString = FString::Printf(TEXT("%lld"), TimestampMs);
-						UE_LOG(LogTemp, Log, TEXT("Successfully parsed time: %s"), *TimestampString);
+						UE_LOG(LogFirebase, Verbose, TEXT("Firebase: Server time is %s"), *TimestampString);
 						Callback.ExecuteIfBound(true, TimestampString);
 						return;
 					}
 				}
 			}
 			
-			UE_LOG(LogTemp, Error, TEXT("Failed to parse time API response. Response Code: %d, Body: %s"), ResponseCode, *ResponseString);
+			UE_LOG(LogFirebase, Error, TEXT("Firebase: Failed to parse time API response %d - %s"), ResponseCode, *FFirebaseLog::Body(ResponseString));
 			
 			// FALLBACK: Use device time with warning
-			UE_LOG(LogTemp, Warning, TEXT("Using device time as fallback (can be spoofed!)"));
+			UE_LOG(LogFirebase, Warning, TEXT("Firebase: Using device time as fallback (can be spoofed!)"));
 			FDateTime Now = FDateTime::UtcNow();
 			int64 TimestampMs = Now.ToUnixTimestamp() * 1000LL + Now.GetMillisecond();
 			FString TimestampString = FString::Printf(TEXT("%lld"), TimestampMs);
@@ -126,26 +302,18 @@ void UFirebaseRestAPI::GetTrustedServerTime(FFirebaseRestCallback Callback)
 		}
 		else
 		{
-			FString ErrorMsg = TEXT("Network error");
-			if (Request.IsValid())
-			{
-				ErrorMsg = FString::Printf(TEXT("Request failed. Status: %s"), 
-					Response.IsValid() ? *FString::FromInt(Response->GetResponseCode()) : TEXT("No Response"));
-			}
+			FString ErrorMsg = TEXT("Request failed. Status: No Response");
 			
-			UE_LOG(LogTemp, Error, TEXT("Time API request failed: %s"), *ErrorMsg);
+			UE_LOG(LogFirebase, Error, TEXT("Firebase: Time API request failed: %s"), *ErrorMsg);
 			
 			// FALLBACK: Use device time with warning
-			UE_LOG(LogTemp, Warning, TEXT("Using device time as fallback (can be spoofed!)"));
+			UE_LOG(LogFirebase, Warning, TEXT("Firebase: Using device time as fallback (can be spoofed!)"));
 			FDateTime Now = FDateTime::UtcNow();
 			int64 TimestampMs = Now.ToUnixTimestamp() * 1000LL + Now.GetMillisecond();
 			FString TimestampString = FString::Printf(TEXT("%lld"), TimestampMs);
 			Callback.ExecuteIfBound(true, TimestampString);
 		}
 	});
-	
-	bool bRequestStarted = HttpRequest->ProcessRequest();
-	UE_LOG(LogTemp, Warning, TEXT("Time API HTTP Request Started: %s"), bRequestStarted ? TEXT("true") : TEXT("false"));
 }
 
 TSharedPtr<FJsonObject> UFirebaseRestAPI::ParseJsonResponse(const FString& Response) const
@@ -158,6 +326,8 @@ TSharedPtr<FJsonObject> UFirebaseRestAPI::ParseJsonResponse(const FString& Respo
 
 void UFirebaseRestAPI::CacheAuthResponse(const FString& Response)
 {
+	LLM_SCOPE_BYTAG(Firebase);
+
 	TSharedPtr<FJsonObject> JsonResponse = ParseJsonResponse(Response);
 	if (JsonResponse.IsValid())
 	{
@@ -180,24 +350,6 @@ void UFirebaseRestAPI::CacheAuthResponse(const FString& Response)
 	}
 }
 
-FString UFirebaseRestAPI::BuildDatabaseUrl(const FString& Path, const FString& QueryParams) const
-{
-	FString CleanPath = Path;
-	if (!CleanPath.StartsWith(TEXT("/")))
-	{
-		CleanPath = TEXT("/") + CleanPath;
-	}
-	
-	FString Url = DatabaseUrl + CleanPath + TEXT(".json");
-	
-	if (!QueryParams.IsEmpty())
-	{
-		Url += TEXT("?") + QueryParams;
-	}
-	
-	return Url;
-}
-
 // === AUTHENTICATION ===
 
 void UFirebaseRestAPI::SignUpWithEmail(const FString& Email, const FString& Password, FFirebaseRestCallback Callback)
@@ -312,28 +464,48 @@ void UFirebaseRestAPI::UpdateProfile(const FString& IdToken, const FString& Disp
 
 void UFirebaseRestAPI::SendAuthRequest(const FString& Endpoint, const TSharedPtr<FJsonObject>& JsonPayload, FFirebaseRestCallback Callback, bool bCacheTokens)
 {
+	SCOPE_CYCLE_COUNTER(STAT_FirebaseSendAuthRequest);
+
 	// Create HTTP request
-	TSharedRef<IHttpRequest> HttpRequest = FHttpModule::Get().CreateRequest();
+	FFirebaseHttpRequest HttpRequest;
 	
 	// Add API key to URL
-	FString Url = Endpoint + TEXT("?key=") + ApiKey;
-	HttpRequest->SetURL(Url);
-	HttpRequest->SetVerb(TEXT("POST"));
-	HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+	HttpRequest.Url = UrlBuilder.Auth(Endpoint);
+	HttpRequest.Verb = TEXT("POST");
+	HttpRequest.SetHeader(TEXT("Content-Type"), TEXT("application/json"));
 
 	// Serialize JSON payload
 	FString JsonString;
 	TSharedRef<TJsonWriter<>> JsonWriter = TJsonWriterFactory<>::Create(&JsonString);
 	FJsonSerializer::Serialize(JsonPayload.ToSharedRef(), JsonWriter);
-	HttpRequest->SetContentAsString(JsonString);
+	HttpRequest.Body = FFirebasePayload::FromString(JsonString);
+
+	// Counted under the endpoint's method name ("accounts:signUp")
+	int32 LastSlash = INDEX_NONE;
+	Endpoint.FindLastChar(TEXT('/'), LastSlash);
+	const FFirebaseRequestKey StatsKey(TEXT("AUTH"), FStringView(Endpoint).RightChop(LastSlash + 1));
+	const double SentTime = FFirebaseRequestMetrics::Get().RecordSent(StatsKey, HttpRequest.Body.Num());
 
-	// Set callback
-	HttpRequest->OnProcessRequestComplete().BindLambda([this, Callback, bCacheTokens](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+	const uint64 TraceId = FFirebaseTrace::NewRequestId();
+	FFirebaseTrace::Request(EFirebaseTraceOrigin::Rest, TraceId, TEXT("AUTH"), StatsKey.Prefix, HttpRequest.Body.Num());
+	FFirebaseTrafficRecorder::Get().Record(EFirebaseTrafficOp::Auth, StatsKey.Prefix, HttpRequest.Body.Num());
+	FFirebaseTrace::Stage(EFirebaseTraceOrigin::Rest, TraceId, EFirebaseTraceStage::Sent, HttpRequest.Body.Num());
+
+	// Send request
+	GetTransport()->Send(MoveTemp(HttpRequest), [this, Callback, bCacheTokens, StatsKey, SentTime, TraceId](const FFirebaseHttpResponse& Response)
 	{
-		if (bWasSuccessful && Response.IsValid())
+		FFirebaseRequestMetrics::Get().RecordResponse(StatsKey, SentTime, Response);
+		FFirebaseTrace::Response(TraceId, Response, TEXT("AUTH"), StatsKey.Prefix);
+		FFirebaseRequestLog::Get().Record(TEXT("AUTH"), StatsKey.Prefix, TraceId, Response);
+		FIREBASE_TRACE_CALLBACK_SCOPE(EFirebaseTraceOrigin::Rest, TraceId);
+		const double CallbackStartTime = FPlatformTime::Seconds();
+
+		ReportTransportOutcome(Response.bSucceeded);
+
+		if (Response.bSucceeded)
 		{
-			FString ResponseString = Response->GetContentAsString();
-			int32 ResponseCode = Response->GetResponseCode();
+			FString ResponseString = Response.Body.ToString();
+			int32 ResponseCode = Response.Code;
 
 			if (ResponseCode >= 200 && ResponseCode < 300)
 			{
@@ -347,157 +519,824 @@ void UFirebaseRestAPI::SendAuthRequest(const FString& Endpoint, const TSharedPtr
 			}
 			else
 			{
-				UE_LOG(LogTemp, Error, TEXT("Firebase Auth Error: %d - %s"), ResponseCode, *ResponseString);
+				UE_LOG(LogFirebase, Error, TEXT("Firebase Auth Error: %d - %s"), ResponseCode, *FFirebaseLog::Body(ResponseString));
 				Callback.ExecuteIfBound(false, ResponseString);
 			}
 		}
 		else
 		{
 			FString ErrorMessage = TEXT("Network error");
-			UE_LOG(LogTemp, Error, TEXT("Firebase Auth Network Error"));
+			UE_LOG(LogFirebase, Error, TEXT("Firebase Auth Network Error"));
 			Callback.ExecuteIfBound(false, ErrorMessage);
 		}
-	});
 
-	// Send request
-	HttpRequest->ProcessRequest();
+		FFirebaseRequestMetrics::Get().RecordCallback(StatsKey, FPlatformTime::Seconds() - CallbackStartTime);
+	});
 }
 
 // === DATABASE ===
 
+namespace
+{
+	/** Adapt an FString callback; the body is transcoded once, right before the caller sees it */
+	FFirebaseRestPayloadCallback ToPayloadCallback(const FFirebaseRestCallback& Callback)
+	{
+		return FFirebaseRestPayloadCallback::CreateLambda([Callback](bool bSuccess, const FFirebasePayload& Response)
+		{
+			Callback.ExecuteIfBound(bSuccess, Response.ToString());
+		});
+	}
+
+	/** Fail a request with a local error message */
+	void FailRequest(const FFirebaseRestPayloadCallback& Callback, const TCHAR* Message)
+	{
+		Callback.ExecuteIfBound(false, FFirebasePayload::FromString(Message));
+	}
+}
+
 void UFirebaseRestAPI::SetValue(const FString& Path, const FString& JsonValue, const FString& AuthToken, FFirebaseRestCallback Callback)
 {
-	FString QueryParams = AuthToken.IsEmpty() ? TEXT("") : FString::Printf(TEXT("auth=%s"), *AuthToken);
-	SendDatabaseRequest(Path, TEXT("PUT"), JsonValue, AuthToken, QueryParams, Callback);
+	SetValue(Path, FFirebasePayload::FromString(JsonValue), AuthToken, ToPayloadCallback(Callback));
 }
 
 void UFirebaseRestAPI::GetValue(const FString& Path, const FString& AuthToken, FFirebaseRestCallback Callback)
 {
-	FString QueryParams = AuthToken.IsEmpty() ? TEXT("") : FString::Printf(TEXT("auth=%s"), *AuthToken);
-	SendDatabaseRequest(Path, TEXT("GET"), TEXT(""), AuthToken, QueryParams, Callback);
+	GetValue(Path, AuthToken, ToPayloadCallback(Callback));
 }
 
 void UFirebaseRestAPI::UpdateValue(const FString& Path, const FString& JsonValue, const FString& AuthToken, FFirebaseRestCallback Callback)
 {
-	FString QueryParams = AuthToken.IsEmpty() ? TEXT("") : FString::Printf(TEXT("auth=%s"), *AuthToken);
-	SendDatabaseRequest(Path, TEXT("PATCH"), JsonValue, AuthToken, QueryParams, Callback);
+	UpdateValue(Path, FFirebasePayload::FromString(JsonValue), AuthToken, ToPayloadCallback(Callback));
 }
 
 void UFirebaseRestAPI::DeleteValue(const FString& Path, const FString& AuthToken, FFirebaseRestCallback Callback)
 {
-	FString QueryParams = AuthToken.IsEmpty() ? TEXT("") : FString::Printf(TEXT("auth=%s"), *AuthToken);
-	SendDatabaseRequest(Path, TEXT("DELETE"), TEXT(""), AuthToken, QueryParams, Callback);
+	DeleteValue(Path, AuthToken, ToPayloadCallback(Callback));
 }
 
 void UFirebaseRestAPI::PushValue(const FString& Path, const FString& JsonValue, const FString& AuthToken, FFirebaseRestCallback Callback)
 {
-	FString QueryParams = AuthToken.IsEmpty() ? TEXT("") : FString::Printf(TEXT("auth=%s"), *AuthToken);
-	SendDatabaseRequest(Path, TEXT("POST"), JsonValue, AuthToken, QueryParams, Callback);
+	PushValue(Path, FFirebasePayload::FromString(JsonValue), AuthToken, ToPayloadCallback(Callback));
+}
+
+void UFirebaseRestAPI::SetValue(const FString& Path, const FFirebasePayload& JsonValue, const FString& AuthToken, FFirebaseRestPayloadCallback Callback)
+{
+	SendDatabaseRequest(Path, TEXT("PUT"), JsonValue, AuthToken, {}, Callback);
+}
+
+void UFirebaseRestAPI::GetValue(const FString& Path, const FString& AuthToken, FFirebaseRestPayloadCallback Callback)
+{
+	SendDatabaseRequest(Path, TEXT("GET"), FFirebasePayload(), AuthToken, {}, Callback);
+}
+
+void UFirebaseRestAPI::UpdateValue(const FString& Path, const FFirebasePayload& JsonValue, const FString& AuthToken, FFirebaseRestPayloadCallback Callback)
+{
+	SendDatabaseRequest(Path, TEXT("PATCH"), JsonValue, AuthToken, {}, Callback);
+}
+
+void UFirebaseRestAPI::DeleteValue(const FString& Path, const FString& AuthToken, FFirebaseRestPayloadCallback Callback)
+{
+	SendDatabaseRequest(Path, TEXT("DELETE"), FFirebasePayload(), AuthToken, {}, Callback);
+}
+
+void UFirebaseRestAPI::PushValue(const FString& Path, const FFirebasePayload& JsonValue, const FString& AuthToken, FFirebaseRestPayloadCallback Callback)
+{
+	SendDatabaseRequest(Path, TEXT("POST"), JsonValue, AuthToken, {}, Callback);
 }
 
 void UFirebaseRestAPI::QueryOrderByChild(const FString& Path, const FString& ChildKey, const FString& AuthToken, FFirebaseRestCallback Callback)
 {
-	FString QueryParams = FString::Printf(TEXT("orderBy=\"%s\""), *ChildKey);
-	if (!AuthToken.IsEmpty())
+	const FFirebaseUrlParam Params[] = { { TEXT("orderBy"), ChildKey, true } };
+	SendDatabaseRequest(Path, TEXT("GET"), FFirebasePayload(), AuthToken, Params, ToPayloadCallback(Callback));
+}
+
+void UFirebaseRestAPI::QueryLimitToFirst(const FString& Path, int32 Limit, const FString& AuthToken, FFirebaseRestCallback Callback)
+{
+	const FString LimitText = LexToString(Limit);
+	const FFirebaseUrlParam Params[] = { { TEXT("limitToFirst"), LimitText } };
+	SendDatabaseRequest(Path, TEXT("GET"), FFirebasePayload(), AuthToken, Params, ToPayloadCallback(Callback));
+}
+
+void UFirebaseRestAPI::QueryLimitToLast(const FString& Path, int32 Limit, const FString& AuthToken, FFirebaseRestCallback Callback)
+{
+	const FString LimitText = LexToString(Limit);
+	const FFirebaseUrlParam Params[] = { { TEXT("limitToLast"), LimitText } };
+	SendDatabaseRequest(Path, TEXT("GET"), FFirebasePayload(), AuthToken, Params, ToPayloadCallback(Callback));
+}
+
+void UFirebaseRestAPI::QueryStartAt(const FString& Path, const FString& Value, const FString& AuthToken, FFirebaseRestCallback Callback)
+{
+	const FFirebaseUrlParam Params[] = { { TEXT("startAt"), Value, true } };
+	SendDatabaseRequest(Path, TEXT("GET"), FFirebasePayload(), AuthToken, Params, ToPayloadCallback(Callback));
+}
+
+void UFirebaseRestAPI::QueryEndAt(const FString& Path, const FString& Value, const FString& AuthToken, FFirebaseRestCallback Callback)
+{
+	const FFirebaseUrlParam Params[] = { { TEXT("endAt"), Value, true } };
+	SendDatabaseRequest(Path, TEXT("GET"), FFirebasePayload(), AuthToken, Params, ToPayloadCallback(Callback));
+}
+
+void UFirebaseRestAPI::QueryEqualTo(const FString& Path, const FString& Value, const FString& AuthToken, FFirebaseRestCallback Callback)
+{
+	const FFirebaseUrlParam Params[] = { { TEXT("equalTo"), Value, true } };
+	SendDatabaseRequest(Path, TEXT("GET"), FFirebasePayload(), AuthToken, Params, ToPayloadCallback(Callback));
+}
+
+void UFirebaseRestAPI::SendDatabaseRequest(const FString& Path, const FString& Method, const FFirebasePayload& JsonBody, const FString& AuthToken, TArrayView<const FFirebaseUrlParam> QueryParams, FFirebaseRestPayloadCallback Callback)
+{
+	FFirebaseQueuedRequest Request;
+	Request.Path = Path;
+	Request.Method = Method;
+	Request.Url = UrlBuilder.Database(Path, QueryParams, AuthToken);
+	Request.Body = JsonBody;
+	Request.Callback = Callback;
+	Request.EnqueueTime = FPlatformTime::Seconds();
+	Request.TraceId = FFirebaseTrace::NewRequestId();
+	FFirebaseTrace::Request(EFirebaseTraceOrigin::Rest, Request.TraceId, *Method, Path, JsonBody.Num());
+	FFirebaseTrafficRecorder::Get().RecordMethod(Method, Path, JsonBody.Num(), QueryParams.Num() > 0);
+
+	// Hold the request while offline; anything already held goes first so order is kept
+	if (ShouldHoldRequests() || OfflineQueue.Num() > 0)
 	{
-		QueryParams += FString::Printf(TEXT("&auth=%s"), *AuthToken);
+		// Past the memory budget the queue is as full as at its request cap
+		if (OfflineQueue.Num() >= MaxOfflineQueuedRequests || !Request.ReserveMemory())
+		{
+			UE_LOG(LogFirebase, Warning, TEXT("Firebase Database: Offline queue full - %s %s"), *Method, *Path);
+			FailRequest(Callback, TEXT("Offline queue full"));
+			return;
+		}
+
+		LLM_SCOPE_BYTAG(Firebase_Queues);
+		OfflineQueue.Add(MoveTemp(Request));
+		return;
 	}
-	SendDatabaseRequest(Path, TEXT("GET"), TEXT(""), AuthToken, QueryParams, Callback);
+
+	SubmitDatabaseRequest(Request);
 }
 
-void UFirebaseRestAPI::QueryLimitToFirst(const FString& Path, int32 Limit, const FString& AuthToken, FFirebaseRestCallback Callback)
+void UFirebaseRestAPI::SubmitDatabaseRequest(FFirebaseQueuedRequest& Request)
 {
-	FString QueryParams = FString::Printf(TEXT("limitToFirst=%d"), Limit);
-	if (!AuthToken.IsEmpty())
+	// Client-side rate limiting
+	if (RateLimiter.HasRules())
 	{
-		QueryParams += FString::Printf(TEXT("&auth=%s"), *AuthToken);
+		switch (RateLimiter.Admit(Request, FPlatformTime::Seconds()))
+		{
+		case FFirebaseRateLimiter::EAdmitResult::Deferred:
+			return;
+
+		case FFirebaseRateLimiter::EAdmitResult::Rejected:
+			UE_LOG(LogFirebase, Warning, TEXT("Firebase Database: Rate limit exceeded - %s %s"), *Request.Method, *Request.Path);
+			FailRequest(Request.Callback, TEXT("Rate limit exceeded"));
+			return;
+
+		default:
+			break;
+		}
 	}
-	SendDatabaseRequest(Path, TEXT("GET"), TEXT(""), AuthToken, QueryParams, Callback);
+
+	DispatchDatabaseRequest(Request);
 }
 
-void UFirebaseRestAPI::QueryLimitToLast(const FString& Path, int32 Limit, const FString& AuthToken, FFirebaseRestCallback Callback)
+void UFirebaseRestAPI::DispatchDatabaseRequest(const FFirebaseQueuedRequest& Request)
 {
-	FString QueryParams = FString::Printf(TEXT("limitToLast=%d"), Limit);
-	if (!AuthToken.IsEmpty())
+	SCOPE_CYCLE_COUNTER(STAT_FirebaseDispatchRequest);
+
+	const FFirebaseRequestKey StatsKey(Request.Method, Request.Path);
+	FFirebaseRequestMetrics::Get().RecordQueued(StatsKey, FPlatformTime::Seconds() - Request.EnqueueTime);
+	FFirebaseTrace::Stage(EFirebaseTraceOrigin::Rest, Request.TraceId, EFirebaseTraceStage::Scheduled);
+
+	FFirebaseRestPayloadCallback Callback = Request.Callback;
+	if (Request.CoalescedCallbacks.Num() > 0)
 	{
-		QueryParams += FString::Printf(TEXT("&auth=%s"), *AuthToken);
+		// Requests merged by the rate limiter all complete with the same (shared) response
+		TArray<FFirebaseRestPayloadCallback> Callbacks = Request.CoalescedCallbacks;
+		Callbacks.Add(Request.Callback);
+		Callback = FFirebaseRestPayloadCallback::CreateLambda([Callbacks](bool bSuccess, const FFirebasePayload& Response)
+		{
+			for (const FFirebaseRestPayloadCallback& Each : Callbacks)
+			{
+				Each.ExecuteIfBound(bSuccess, Response);
+			}
+		});
 	}
-	SendDatabaseRequest(Path, TEXT("GET"), TEXT(""), AuthToken, QueryParams, Callback);
+
+	// Reads are idempotent, so they may be hedged
+	if (HedgingConfig.bEnabled && Request.Method == TEXT("GET"))
+	{
+		SendHedgedDatabaseRequest(Request.Url, StatsKey, Request.TraceId, Callback);
+		return;
+	}
+
+	// Send request
+	const double SentTime = FFirebaseRequestMetrics::Get().RecordSent(StatsKey, Request.Body.Num());
+	const uint64 TraceId = Request.TraceId;
+	FFirebaseTrace::Stage(EFirebaseTraceOrigin::Rest, TraceId, EFirebaseTraceStage::Sent, Request.Body.Num());
+
+	TWeakObjectPtr<UFirebaseRestAPI> WeakThis(this);
+	GetTransport()->Send(MakeDatabaseRequest(Request.Url, Request.Method, Request.Body), [WeakThis, Callback, StatsKey, SentTime, TraceId](const FFirebaseHttpResponse& Response)
+	{
+		FFirebaseRequestMetrics::Get().RecordResponse(StatsKey, SentTime, Response);
+		FFirebaseTrace::Response(TraceId, Response, *StatsKey.Operation, StatsKey.Prefix);
+		FFirebaseRequestLog::Get().Record(StatsKey.Operation, StatsKey.Prefix, TraceId, Response);
+		if (UFirebaseRestAPI* This = WeakThis.Get())
+		{
+			This->ReportTransportOutcome(Response.bSucceeded);
+		}
+		CompleteDatabaseRequest(Response, Callback, StatsKey, TraceId);
+	});
 }
 
-void UFirebaseRestAPI::QueryStartAt(const FString& Path, const FString& Value, const FString& AuthToken, FFirebaseRestCallback Callback)
+TSharedRef<IFirebaseHttpTransport> UFirebaseRestAPI::GetTransport() const
 {
-	FString QueryParams = FString::Printf(TEXT("startAt=\"%s\""), *Value);
-	if (!AuthToken.IsEmpty())
+	if (Transport.IsValid())
 	{
-		QueryParams += FString::Printf(TEXT("&auth=%s"), *AuthToken);
+		return Transport.ToSharedRef();
 	}
-	SendDatabaseRequest(Path, TEXT("GET"), TEXT(""), AuthToken, QueryParams, Callback);
+	return FFirebaseHttpModuleTransport::Get();
 }
 
-void UFirebaseRestAPI::QueryEndAt(const FString& Path, const FString& Value, const FString& AuthToken, FFirebaseRestCallback Callback)
+FFirebaseHttpRequest UFirebaseRestAPI::MakeDatabaseRequest(const FString& Url, const FString& Method, const FFirebasePayload& JsonBody)
 {
-	FString QueryParams = FString::Printf(TEXT("endAt=\"%s\""), *Value);
-	if (!AuthToken.IsEmpty())
+	FFirebaseHttpRequest HttpRequest;
+	HttpRequest.Url = Url;
+	HttpRequest.Verb = Method;
+	HttpRequest.SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+	HttpRequest.Body = JsonBody;
+	return HttpRequest;
+}
+
+void UFirebaseRestAPI::CompleteDatabaseRequest(const FFirebaseHttpResponse& Response, const FFirebaseRestPayloadCallback& Callback, const FFirebaseRequestKey& StatsKey, uint64 TraceId)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FirebaseCompleteRequest);
+	FIREBASE_TRACE_CALLBACK_SCOPE(EFirebaseTraceOrigin::Rest, TraceId);
+	const double StartTime = FPlatformTime::Seconds();
+
+	if (Response.bSucceeded)
+	{
+		const FFirebasePayload& Payload = Response.Body;
+		int32 ResponseCode = Response.Code;
+
+		if (ResponseCode >= 200 && ResponseCode < 300)
+		{
+			Callback.ExecuteIfBound(true, Payload);
+		}
+		else
+		{
+			UE_LOG(LogFirebase, Error, TEXT("Firebase Database Error: %d - %s"), ResponseCode, *FFirebaseLog::Body(Payload.GetView()));
+			Callback.ExecuteIfBound(false, Payload);
+		}
+	}
+	else
 	{
-		QueryParams += FString::Printf(TEXT("&auth=%s"), *AuthToken);
+		UE_LOG(LogFirebase, Error, TEXT("Firebase Database Network Error"));
+		FailRequest(Callback, TEXT("Network error"));
 	}
-	SendDatabaseRequest(Path, TEXT("GET"), TEXT(""), AuthToken, QueryParams, Callback);
+
+	FFirebaseRequestMetrics::Get().RecordCallback(StatsKey, FPlatformTime::Seconds() - StartTime);
 }
 
-void UFirebaseRestAPI::QueryEqualTo(const FString& Path, const FString& Value, const FString& AuthToken, FFirebaseRestCallback Callback)
+// === RATE LIMITING ===
+
+void UFirebaseRestAPI::SetRateLimitRules(const TArray<FFirebaseRateLimitRule>& Rules)
 {
-	FString QueryParams = FString::Printf(TEXT("equalTo=\"%s\""), *Value);
-	if (!AuthToken.IsEmpty())
+	// Requests held by the old rules are sent rather than dropped
+	TArray<FFirebaseQueuedRequest> Released;
+	RateLimiter.SetRules(Rules, Released);
+	for (const FFirebaseQueuedRequest& Request : Released)
 	{
-		QueryParams += FString::Printf(TEXT("&auth=%s"), *AuthToken);
+		DispatchDatabaseRequest(Request);
 	}
-	SendDatabaseRequest(Path, TEXT("GET"), TEXT(""), AuthToken, QueryParams, Callback);
 }
 
-void UFirebaseRestAPI::SendDatabaseRequest(const FString& Path, const FString& Method, const FString& JsonBody, const FString& AuthToken, const FString& QueryParams, FFirebaseRestCallback Callback)
+TArray<FFirebaseRateLimiterStats> UFirebaseRestAPI::GetRateLimiterStats() const
 {
-	// Create HTTP request
-	TSharedRef<IHttpRequest> HttpRequest = FHttpModule::Get().CreateRequest();
-	
-	// Build URL
-	FString Url = BuildDatabaseUrl(Path, QueryParams);
-	HttpRequest->SetURL(Url);
-	HttpRequest->SetVerb(Method);
-	HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+	return RateLimiter.GetStats(FPlatformTime::Seconds());
+}
+
+// === CONNECTIVITY ===
+
+void UFirebaseRestAPI::StartConnectivityMonitoring()
+{
+	bMonitorConnectivity = true;
+}
+
+void UFirebaseRestAPI::GoOnline()
+{
+	Connectivity.SetManualOffline(false);
+}
+
+void UFirebaseRestAPI::GoOffline()
+{
+	Connectivity.SetManualOffline(true);
+}
+
+bool UFirebaseRestAPI::ShouldHoldRequests() const
+{
+	// GoOffline always holds; a lost connection only if the project wants that
+	return Connectivity.IsManualOffline() || (bPauseRequestsWhileOffline && Connectivity.ShouldPauseRequests());
+}
+
+void UFirebaseRestAPI::ReportTransportOutcome(bool bGotResponse)
+{
+	const double Now = FPlatformTime::Seconds();
+	if (bGotResponse)
+	{
+		Connectivity.ReportResponse(Now);
+	}
+	else
+	{
+		Connectivity.ReportNetworkFailure(Now);
+	}
+}
+
+void UFirebaseRestAPI::SendConnectivityProbe()
+{
+	if (DatabaseUrl.IsEmpty())
+	{
+		return;
+	}
+
+	Connectivity.OnProbeSent(FPlatformTime::Seconds());
+	bProbeInFlight = true;
+
+	FFirebaseHttpRequest HttpRequest = MakeDatabaseRequest(UrlBuilder.Database(FirebaseConnectivity::ProbePath), TEXT("GET"), FFirebasePayload());
+	HttpRequest.TimeoutSeconds = FirebaseConnectivity::ProbeTimeoutSeconds;
+
+	const FFirebaseRequestKey StatsKey(TEXT("PROBE"), FirebaseConnectivity::ProbePath);
+	const double SentTime = FFirebaseRequestMetrics::Get().RecordSent(StatsKey, 0);
+
+	const uint64 TraceId = FFirebaseTrace::NewRequestId();
+	FFirebaseTrace::Request(EFirebaseTraceOrigin::Rest, TraceId, TEXT("PROBE"), FirebaseConnectivity::ProbePath, 0);
+	FFirebaseTrace::Stage(EFirebaseTraceOrigin::Rest, TraceId, EFirebaseTraceStage::Sent);
+
+	TWeakObjectPtr<UFirebaseRestAPI> WeakThis(this);
+	GetTransport()->Send(MoveTemp(HttpRequest), [WeakThis, StatsKey, SentTime, TraceId](const FFirebaseHttpResponse& Response)
+	{
+		FFirebaseRequestMetrics::Get().RecordResponse(StatsKey, SentTime, Response);
+		FFirebaseTrace::Response(TraceId, Response, TEXT("PROBE"), FirebaseConnectivity::ProbePath);
+		FFirebaseRequestLog::Get().Record(TEXT("PROBE"), FirebaseConnectivity::ProbePath, TraceId, Response);
+		if (UFirebaseRestAPI* This = WeakThis.Get())
+		{
+			This->bProbeInFlight = false;
+			This->ReportTransportOutcome(Response.bSucceeded);
+		}
+	});
+}
 
-	// Set body if provided
-	if (!JsonBody.IsEmpty())
+void UFirebaseRestAPI::UpdateOfflineQueue(double Now)
+{
+	if (OfflineQueue.Num() == 0)
 	{
-		HttpRequest->SetContentAsString(JsonBody);
+		return;
 	}
 
-	// Set callback
-	HttpRequest->OnProcessRequestComplete().BindLambda([Callback](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+	if (!ShouldHoldRequests())
 	{
-		if (bWasSuccessful && Response.IsValid())
+		// Back online: send everything in the order it was issued
+		UE_LOG(LogFirebase, Log, TEXT("Firebase Database: Sending %d requests held while offline"), OfflineQueue.Num());
+		TArray<FFirebaseQueuedRequest> Held = MoveTemp(OfflineQueue);
+		OfflineQueue.Reset();
+		for (FFirebaseQueuedRequest& Request : Held)
 		{
-			FString ResponseString = Response->GetContentAsString();
-			int32 ResponseCode = Response->GetResponseCode();
+			Request.ReleaseMemory();
+			SubmitDatabaseRequest(Request);
+		}
+		return;
+	}
 
-			if (ResponseCode >= 200 && ResponseCode < 300)
+	// Held work needs a probe to ever be sent; with auto-reconnect the schedule already covers it
+	if (!bAutoReconnect)
+	{
+		Connectivity.RequestProbe();
+	}
+
+	if (OfflineQueueTimeoutSeconds <= 0.0f)
+	{
+		return;
+	}
+
+	// The queue is in arrival order, so expired requests are at the front
+	int32 ExpiredCount = 0;
+	while (ExpiredCount < OfflineQueue.Num() && Now - OfflineQueue[ExpiredCount].EnqueueTime > OfflineQueueTimeoutSeconds)
+	{
+		ExpiredCount++;
+	}
+
+	if (ExpiredCount > 0)
+	{
+		TArray<FFirebaseQueuedRequest> Expired(OfflineQueue.GetData(), ExpiredCount);
+		OfflineQueue.RemoveAt(0, ExpiredCount);
+
+		for (FFirebaseQueuedRequest& Request : Expired)
+		{
+			Request.ReleaseMemory();
+			UE_LOG(LogFirebase, Error, TEXT("Firebase Database: Request timed out while offline - %s %s"), *Request.Method, *Request.Path);
+			FailRequest(Request.Callback, TEXT("Offline"));
+		}
+	}
+}
+
+// === POLLING LISTENERS ===
+
+void UFirebaseRestAPI::SetPollingConfig(const FFirebasePollingConfig& InConfig)
+{
+	PollingConfig = InConfig;
+	PollingConfig.MinIntervalSeconds = FMath::Max(PollingConfig.MinIntervalSeconds, 0.1f);
+	PollingConfig.MaxIntervalSeconds = FMath::Max(PollingConfig.MaxIntervalSeconds, PollingConfig.MinIntervalSeconds);
+	PollingConfig.InitialIntervalSeconds = FMath::Clamp(PollingConfig.InitialIntervalSeconds, PollingConfig.MinIntervalSeconds, PollingConfig.MaxIntervalSeconds);
+}
+
+void UFirebaseRestAPI::StartPolling(const FString& Path, const UObject* Owner, FFirebaseRestPayloadCallback OnChanged)
+{
+	StopPolling(Path);
+
+	LLM_SCOPE_BYTAG(Firebase_Listeners);
+	TSharedRef<FFirebasePollingListener> Listener = MakeShared<FFirebasePollingListener>();
+	Listener->Path = Path;
+	Listener->OnChanged = OnChanged;
+	Listener->Owner = Owner;
+	Listener->bHasOwner = Owner != nullptr;
+	Listener->IntervalSeconds = PollingConfig.InitialIntervalSeconds;
+
+	// First poll on the next tick delivers the initial value
+	Listener->NextPollTime = 0.0;
+
+	PollingListeners.Add(Path, Listener);
+	Listener->AccountedBytes = sizeof(FFirebasePollingListener) + 2 * Path.GetAllocatedSize();
+	FFirebaseMemory::Get().Add(EFirebaseMemoryCategory::Listeners, Listener->AccountedBytes);
+	UE_LOG(LogFirebase, Log, TEXT("Firebase Database: Polling %s every %.1fs"), *Path, Listener->IntervalSeconds);
+}
+
+void UFirebaseRestAPI::StopPolling(const FString& Path)
+{
+	if (TSharedRef<FFirebasePollingListener>* Listener = PollingListeners.Find(Path))
+	{
+		(*Listener)->bStopped = true;
+		FFirebaseMemory::Get().Release(EFirebaseMemoryCategory::Listeners, (*Listener)->AccountedBytes);
+		PollingListeners.Remove(Path);
+	}
+}
+
+bool UFirebaseRestAPI::IsPollingOwnerRelevant(const FFirebasePollingListener& Listener) const
+{
+	if (!PollingConfig.bPauseWhenOwnerNotRendered)
+	{
+		return true;
+	}
+
+	const UObject* Owner = Listener.Owner.Get();
+	const AActor* Actor = Cast<AActor>(Owner);
+	if (!Actor)
+	{
+		if (const UActorComponent* Component = Cast<UActorComponent>(Owner))
+		{
+			Actor = Component->GetOwner();
+		}
+	}
+
+	if (!Actor)
+	{
+		// Not tied to anything on screen
+		return true;
+	}
+
+	if (Actor->IsHidden())
+	{
+		return false;
+	}
+
+	// Actors that never render (controllers, managers, dedicated servers) always count as relevant
+	return Actor->GetLastRenderTime() <= 0.0f || Actor->WasRecentlyRendered(FirebasePolling::RenderRelevanceSeconds);
+}
+
+void UFirebaseRestAPI::TickPolling(double Now)
+{
+	if (PollingListeners.Num() == 0 || ShouldHoldRequests())
+	{
+		// Polls are not queued while offline; they simply resume later
+		return;
+	}
+
+	TArray<FString> Abandoned;
+	for (TPair<FString, TSharedRef<FFirebasePollingListener>>& Pair : PollingListeners)
+	{
+		FFirebasePollingListener& Listener = Pair.Value.Get();
+
+		if (Listener.bHasOwner && !Listener.Owner.IsValid())
+		{
+			Abandoned.Add(Pair.Key);
+			continue;
+		}
+
+		if (Listener.bInFlight || Now < Listener.NextPollTime)
+		{
+			continue;
+		}
+
+		if (!IsPollingOwnerRelevant(Listener))
+		{
+			// Check again later without spending a request
+			Listener.NextPollTime = Now + Listener.IntervalSeconds;
+			continue;
+		}
+
+		SendPoll(Pair.Value);
+	}
+
+	for (const FString& Path : Abandoned)
+	{
+		UE_LOG(LogFirebase, Log, TEXT("Firebase Database: Stopped polling %s (owner destroyed)"), *Path);
+		StopPolling(Path);
+	}
+}
+
+void UFirebaseRestAPI::SendPoll(const TSharedRef<FFirebasePollingListener>& Listener)
+{
+	Listener->bInFlight = true;
+
+	const FString AuthToken = AuthTokenProvider.IsBound() ? AuthTokenProvider.Execute() : FString();
+
+	FFirebaseHttpRequest HttpRequest = MakeDatabaseRequest(UrlBuilder.Database(Listener->Path, {}, AuthToken), TEXT("GET"), FFirebasePayload());
+
+	// Ask for the value's ETag and let the server skip the body if it has not changed
+	HttpRequest.SetHeader(TEXT("X-Firebase-ETag"), TEXT("true"));
+	if (Listener->bHasValue && !Listener->ETag.IsEmpty())
+	{
+		HttpRequest.SetHeader(TEXT("If-None-Match"), Listener->ETag);
+	}
+
+	const FFirebaseRequestKey StatsKey(TEXT("POLL"), Listener->Path);
+	const double SentTime = FFirebaseRequestMetrics::Get().RecordSent(StatsKey, 0);
+
+	const uint64 TraceId = FFirebaseTrace::NewRequestId();
+	FFirebaseTrace::Request(EFirebaseTraceOrigin::Rest, TraceId, TEXT("POLL"), Listener->Path, 0);
+	FFirebaseTrace::Stage(EFirebaseTraceOrigin::Rest, TraceId, EFirebaseTraceStage::Sent);
+
+	TWeakObjectPtr<UFirebaseRestAPI> WeakThis(this);
+	GetTransport()->Send(MoveTemp(HttpRequest), [WeakThis, Listener, StatsKey, SentTime, TraceId](const FFirebaseHttpResponse& Response)
+	{
+		FFirebaseRequestMetrics::Get().RecordResponse(StatsKey, SentTime, Response);
+		FFirebaseTrace::Response(TraceId, Response, TEXT("POLL"), StatsKey.Prefix);
+		FFirebaseRequestLog::Get().Record(TEXT("POLL"), StatsKey.Prefix, TraceId, Response);
+		FIREBASE_TRACE_CALLBACK_SCOPE(EFirebaseTraceOrigin::Rest, TraceId);
+		Listener->bInFlight = false;
+
+		UFirebaseRestAPI* This = WeakThis.Get();
+		if (!This || Listener->bStopped)
+		{
+			return;
+		}
+
+		const bool bGotResponse = Response.bSucceeded;
+		This->ReportTransportOutcome(bGotResponse);
+
+		const FFirebasePollingConfig& Config = This->PollingConfig;
+		const double Now = FPlatformTime::Seconds();
+
+		if (!bGotResponse)
+		{
+			Listener->NextPollTime = Now + Listener->IntervalSeconds;
+			return;
+		}
+
+		const int32 ResponseCode = Response.Code;
+		const bool bFirstValue = !Listener->bHasValue;
+		bool bChanged = false;
+
+		if (ResponseCode >= 200 && ResponseCode < 300)
+		{
+			const FFirebasePayload& Body = Response.Body;
+
+			// Fall back to a body hash if the server did not send an ETag
+			FString ETag = Response.GetHeader(TEXT("ETag"));
+			if (ETag.IsEmpty())
 			{
-				Callback.ExecuteIfBound(true, ResponseString);
+				ETag = FString::Printf(TEXT("crc:%08x"), Body.GetHash());
 			}
-			else
+
+			if (!Listener->bHasValue || ETag != Listener->ETag)
 			{
-				UE_LOG(LogTemp, Error, TEXT("Firebase Database Error: %d - %s"), ResponseCode, *ResponseString);
-				Callback.ExecuteIfBound(false, ResponseString);
+				Listener->ETag = ETag;
+				Listener->bHasValue = true;
+				bChanged = true;
+				Listener->OnChanged.ExecuteIfBound(true, Body);
 			}
 		}
-		else
+		else if (ResponseCode != 304)
 		{
-			FString ErrorMessage = TEXT("Network error");
-			UE_LOG(LogTemp, Error, TEXT("Firebase Database Network Error"));
-			Callback.ExecuteIfBound(false, ErrorMessage);
+			UE_LOG(LogFirebase, Warning, TEXT("Firebase Database: Poll of %s failed: %d"), *Listener->Path, ResponseCode);
 		}
+
+		// Follow the observed change rate between the floor and the ceiling
+		if (bFirstValue && bChanged)
+		{
+			// The initial value says nothing about how often it changes
+			Listener->NextPollTime = Now + Listener->IntervalSeconds;
+			return;
+		}
+
+		const float Scale = bChanged ? FirebasePolling::ChangedIntervalScale : FirebasePolling::UnchangedIntervalScale;
+		Listener->IntervalSeconds = FMath::Clamp(Listener->IntervalSeconds * Scale, Config.MinIntervalSeconds, Config.MaxIntervalSeconds);
+		Listener->NextPollTime = Now + Listener->IntervalSeconds;
 	});
+}
 
-	// Send request
-	HttpRequest->ProcessRequest();
+// === HEDGED READS ===
+
+void UFirebaseRestAPI::SetHedgingConfig(const FFirebaseHedgingConfig& InConfig)
+{
+	HedgingConfig = InConfig;
+	HedgingConfig.DelayPercentile = FMath::Clamp(HedgingConfig.DelayPercentile, 0.0f, 100.0f);
+	HedgingConfig.MinDelaySeconds = FMath::Max(HedgingConfig.MinDelaySeconds, 0.0f);
+	HedgingConfig.BudgetPercent = FMath::Clamp(HedgingConfig.BudgetPercent, 0.0f, 100.0f);
+
+	// Start with one hedge available so the first slow read can be rescued
+	HedgeTokens = HedgingConfig.BudgetPercent > 0.0f ? 1.0f : 0.0f;
+	SamplesSinceDelayUpdate = FirebaseHedging::DelayUpdateInterval;
+}
+
+FFirebaseHedgingStats UFirebaseRestAPI::GetHedgingStats() const
+{
+	FFirebaseHedgingStats Stats = HedgingStats;
+	Stats.CurrentDelaySeconds = GetHedgeDelay();
+	return Stats;
+}
+
+float UFirebaseRestAPI::GetHedgeDelay() const
+{
+	if (ReadLatencySamples.Num() < FirebaseHedging::MinLatencySamples)
+	{
+		return FMath::Max(HedgingConfig.InitialDelaySeconds, HedgingConfig.MinDelaySeconds);
+	}
+	return FMath::Max(CachedHedgeDelay, HedgingConfig.MinDelaySeconds);
+}
+
+bool UFirebaseRestAPI::TryConsumeHedgeBudget()
+{
+	if (HedgeTokens >= 1.0f)
+	{
+		HedgeTokens -= 1.0f;
+		return true;
+	}
+	return false;
+}
+
+void UFirebaseRestAPI::RecordReadLatency(double Seconds)
+{
+	// Fixed-size ring of recent latencies
+	if (ReadLatencySamples.Num() < FirebaseHedging::MaxLatencySamples)
+	{
+		ReadLatencySamples.Add((float)Seconds);
+	}
+	else
+	{
+		ReadLatencySamples[NextLatencySample] = (float)Seconds;
+		NextLatencySample = (NextLatencySample + 1) % FirebaseHedging::MaxLatencySamples;
+	}
+
+	// Re-estimate the percentile periodically rather than on every read
+	if (++SamplesSinceDelayUpdate >= FirebaseHedging::DelayUpdateInterval
+		&& ReadLatencySamples.Num() >= FirebaseHedging::MinLatencySamples)
+	{
+		SamplesSinceDelayUpdate = 0;
+
+		TArray<float> Sorted = ReadLatencySamples;
+		Sorted.Sort();
+		const int32 Index = FMath::Clamp(
+			FMath::CeilToInt(HedgingConfig.DelayPercentile / 100.0f * Sorted.Num()) - 1, 0, Sorted.Num() - 1);
+		CachedHedgeDelay = Sorted[Index];
+	}
+}
+
+void UFirebaseRestAPI::SendHedgedDatabaseRequest(const FString& Url, const FFirebaseRequestKey& StatsKey, uint64 TraceId, FFirebaseRestPayloadCallback Callback)
+{
+	using namespace FirebaseHedging;
+
+	HedgingStats.Reads++;
+
+	// Every read earns a fraction of a hedge, which bounds the extra load
+	HedgeTokens = FMath::Min(HedgeTokens + HedgingConfig.BudgetPercent / 100.0f, MaxHedgeTokens);
+
+	TSharedRef<FHedgedReadState> State = MakeShared<FHedgedReadState>();
+	State->Transport = GetTransport();
+
+	TWeakObjectPtr<UFirebaseRestAPI> WeakThis(this);
+
+	// Issues one attempt; the first attempt to answer completes the read
+	auto SendAttempt = [WeakThis, State, Url, StatsKey, TraceId, Callback](bool bIsHedge)
+	{
+		UFirebaseRestAPI* This = WeakThis.Get();
+		if (!This)
+		{
+			return;
+		}
+
+		FFirebaseHttpRequest HttpRequest = MakeDatabaseRequest(Url, TEXT("GET"), FFirebasePayload());
+
+		// Attempts are numbered in send order; a response can arrive before Send returns its ID
+		const int32 AttemptIndex = State->Attempts.Num();
+		State->Attempts.Add(0);
+		State->AttemptStartTimes.Add(FPlatformTime::Seconds());
+		State->InFlight++;
+
+		// Every attempt counts as traffic; only the winner's callback is timed
+		const double SentTime = FFirebaseRequestMetrics::Get().RecordSent(StatsKey, 0);
+		FFirebaseTrace::Stage(EFirebaseTraceOrigin::Rest, TraceId, EFirebaseTraceStage::Sent);
+		const FFirebaseHttpRequestId RequestId = State->Transport->Send(MoveTemp(HttpRequest), [WeakThis, State, StatsKey, SentTime, TraceId, Callback, bIsHedge, AttemptIndex](const FFirebaseHttpResponse& Response)
+		{
+			FFirebaseRequestMetrics::Get().RecordResponse(StatsKey, SentTime, Response);
+			State->InFlight--;
+			if (State->bCompleted)
+			{
+				// Loser of the race (or cancelled)
+				return;
+			}
+
+			// A failed attempt only completes the read if nothing else is still running
+			const bool bGotResponse = Response.bSucceeded;
+			if (!bGotResponse && State->InFlight > 0)
+			{
+				State->AttemptStartTimes[AttemptIndex] = 0.0;
+				return;
+			}
+
+			State->bCompleted = true;
+			if (State->HedgeTimer.IsValid())
+			{
+				FTSTicker::GetCoreTicker().RemoveTicker(State->HedgeTimer);
+				State->HedgeTimer.Reset();
+			}
+
+			// Cancel the other attempt
+			const TArray<FFirebaseHttpRequestId> Attempts = MoveTemp(State->Attempts);
+			State->Attempts.Empty();
+			for (int32 Index = 0; Index < Attempts.Num(); ++Index)
+			{
+				if (Index != AttemptIndex && Attempts[Index] != 0)
+				{
+					State->Transport->Cancel(Attempts[Index]);
+				}
+			}
+
+			if (UFirebaseRestAPI* This = WeakThis.Get())
+			{
+				This->ReportTransportOutcome(bGotResponse);
+
+				// Each attempt is timed from its own send. One cancelled while still running took at
+				// least this long, so it counts too; leaving it out would pull the delay towards the winners.
+				const double Now = FPlatformTime::Seconds();
+				for (int32 Index = 0; Index < State->AttemptStartTimes.Num(); ++Index)
+				{
+					const double AttemptStart = State->AttemptStartTimes[Index];
+					if (AttemptStart > 0.0 && (Index != AttemptIndex || bGotResponse))
+					{
+						This->RecordReadLatency(Now - AttemptStart);
+					}
+				}
+				if (bIsHedge)
+				{
+					This->HedgingStats.HedgeWins++;
+				}
+			}
+
+			FFirebaseTrace::Response(TraceId, Response, *StatsKey.Operation, StatsKey.Prefix);
+			FFirebaseRequestLog::Get().Record(StatsKey.Operation, StatsKey.Prefix, TraceId, Response);
+			CompleteDatabaseRequest(Response, Callback, StatsKey, TraceId);
+		});
+
+		if (State->Attempts.IsValidIndex(AttemptIndex))
+		{
+			State->Attempts[AttemptIndex] = RequestId;
+		}
+	};
+
+	SendAttempt(false);
+
+	// Primary may have completed synchronously (e.g. immediate connection failure)
+	if (State->bCompleted)
+	{
+		return;
+	}
+
+	// Schedule the hedge; it only goes out if the primary is still pending
+	State->HedgeTimer = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([WeakThis, State, SendAttempt](float DeltaTime)
+	{
+		State->HedgeTimer.Reset();
+
+		UFirebaseRestAPI* This = WeakThis.Get();
+		if (!This || State->bCompleted)
+		{
+			return false;
+		}
+
+		if (!This->TryConsumeHedgeBudget())
+		{
+			This->HedgingStats.HedgesDeniedByBudget++;
+			return false;
+		}
+
+		This->HedgingStats.HedgesSent++;
+		SendAttempt(true);
+		return false;
+	}), GetHedgeDelay());
 }
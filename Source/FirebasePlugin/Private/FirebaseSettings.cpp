@@ -1,6 +1,8 @@
 // Copyright. All Rights Reserved.
 
 #include "FirebaseSettings.h"
+#include "FirebaseLog.h"
+#include "FirebaseMemory.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
 #include "HAL/PlatformFileManager.h"
@@ -243,19 +245,19 @@ void UFirebaseSettings::PostEditChangeProperty(FPropertyChangedEvent& PropertyCh
 				FString ErrorMessage;
 				if (ImportFromGoogleServicesJson(GoogleServicesJsonPath.FilePath, ErrorMessage))
 				{
-					UE_LOG(LogTemp, Log, TEXT("Firebase: %s"), *ErrorMessage);
+					UE_LOG(LogFirebase, Log, TEXT("Firebase: %s"), *ErrorMessage);
 					
 					// Auto-copy if enabled
 					if (bAutoCopyToBuildFolder)
 					{
 						FString CopyMessage;
 						CopyGoogleServicesJsonToBuildFolder(CopyMessage);
-						UE_LOG(LogTemp, Log, TEXT("Firebase: %s"), *CopyMessage);
+						UE_LOG(LogFirebase, Log, TEXT("Firebase: %s"), *CopyMessage);
 					}
 				}
 				else
 				{
-					UE_LOG(LogTemp, Error, TEXT("Firebase: %s"), *ErrorMessage);
+					UE_LOG(LogFirebase, Error, TEXT("Firebase: %s"), *ErrorMessage);
 				}
 			}
 		}
@@ -267,9 +269,19 @@ void UFirebaseSettings::PostEditChangeProperty(FPropertyChangedEvent& PropertyCh
 			{
 				FString CopyMessage;
 				CopyGoogleServicesJsonToBuildFolder(CopyMessage);
-				UE_LOG(LogTemp, Log, TEXT("Firebase: %s"), *CopyMessage);
+				UE_LOG(LogFirebase, Log, TEXT("Firebase: %s"), *CopyMessage);
 			}
 		}
+
+		else if (PropertyName == GET_MEMBER_NAME_CHECKED(UFirebaseSettings, bEnableVerboseLogging))
+		{
+			FFirebaseLog::ApplySettings();
+		}
+
+		else if (PropertyName == GET_MEMBER_NAME_CHECKED(UFirebaseSettings, MemoryBudgetKB))
+		{
+			FFirebaseMemory::Get().ApplySettings();
+		}
 	}
 }
 #endif
@@ -0,0 +1,380 @@
+// Copyright. All Rights Reserved.
+
+#include "FirebaseStats.h"
+#include "FirebaseMemory.h"
+#include "FirebaseHttpTransport.h"
+#include "FirebaseBufferPool.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/OutputDevice.h"
+
+DEFINE_STAT(STAT_FirebaseRestTick);
+DEFINE_STAT(STAT_FirebaseDispatchRequest);
+DEFINE_STAT(STAT_FirebaseSendAuthRequest);
+DEFINE_STAT(STAT_FirebaseCompleteRequest);
+DEFINE_STAT(STAT_FirebaseBuildUrl);
+DEFINE_STAT(STAT_FirebaseParseJson);
+
+DEFINE_STAT(STAT_FirebaseRequestsInFlight);
+DEFINE_STAT(STAT_FirebaseRequestsSent);
+DEFINE_STAT(STAT_FirebaseResponsesReceived);
+DEFINE_STAT(STAT_FirebaseRequestsFailed);
+DEFINE_STAT(STAT_FirebaseRequestBytes);
+DEFINE_STAT(STAT_FirebaseResponseBytes);
+
+DEFINE_STAT(STAT_FirebaseBufferPoolMemory);
+DEFINE_STAT(STAT_FirebaseHistogramMemory);
+DEFINE_STAT(STAT_FirebaseQueueMemory);
+DEFINE_STAT(STAT_FirebasePendingOpsMemory);
+DEFINE_STAT(STAT_FirebaseListenerMemory);
+DEFINE_STAT(STAT_FirebaseDiagnosticsMemory);
+DEFINE_STAT(STAT_FirebaseBudgetedMemory);
+
+DEFINE_STAT(STAT_FirebaseQueueP50);
+DEFINE_STAT(STAT_FirebaseQueueP90);
+DEFINE_STAT(STAT_FirebaseQueueP99);
+DEFINE_STAT(STAT_FirebaseQueueMax);
+DEFINE_STAT(STAT_FirebaseFirstByteP50);
+DEFINE_STAT(STAT_FirebaseFirstByteP90);
+DEFINE_STAT(STAT_FirebaseFirstByteP99);
+DEFINE_STAT(STAT_FirebaseFirstByteMax);
+DEFINE_STAT(STAT_FirebaseTransferP50);
+DEFINE_STAT(STAT_FirebaseTransferP90);
+DEFINE_STAT(STAT_FirebaseTransferP99);
+DEFINE_STAT(STAT_FirebaseTransferMax);
+DEFINE_STAT(STAT_FirebaseCallbackP50);
+DEFINE_STAT(STAT_FirebaseCallbackP90);
+DEFINE_STAT(STAT_FirebaseCallbackP99);
+DEFINE_STAT(STAT_FirebaseCallbackMax);
+
+DEFINE_STAT(STAT_FirebaseGetP99);
+DEFINE_STAT(STAT_FirebasePutP99);
+DEFINE_STAT(STAT_FirebasePatchP99);
+DEFINE_STAT(STAT_FirebasePostP99);
+DEFINE_STAT(STAT_FirebaseDeleteP99);
+DEFINE_STAT(STAT_FirebaseAuthP99);
+DEFINE_STAT(STAT_FirebasePollP99);
+
+namespace FirebaseStats
+{
+	// Prefix bucket once MaxPrefixes distinct prefixes have been seen
+	static const TCHAR* OtherPrefix = TEXT("(other)");
+
+	static const TCHAR* PhaseNames[] = { TEXT("Queue"), TEXT("First Byte"), TEXT("Transfer"), TEXT("Round Trip"), TEXT("Callback") };
+	static_assert(UE_ARRAY_COUNT(PhaseNames) == (int32)EFirebaseRequestPhase::Num, "Name every request phase");
+
+	static FAutoConsoleCommandWithOutputDevice DumpCommand(
+		TEXT("Firebase.Stats.Dump"),
+		TEXT("Print REST request totals and latency percentiles per phase, operation type and path prefix"),
+		FConsoleCommandWithOutputDeviceDelegate::CreateLambda([](FOutputDevice& Ar)
+		{
+			FFirebaseRequestMetrics::Get().Dump(Ar);
+		}));
+
+	static FAutoConsoleCommand ResetCommand(
+		TEXT("Firebase.Stats.Reset"),
+		TEXT("Forget all REST latency samples and byte totals"),
+		FConsoleCommandDelegate::CreateLambda([]()
+		{
+			FFirebaseRequestMetrics::Get().Reset();
+		}));
+}
+
+FFirebaseRequestKey::FFirebaseRequestKey(const FString& InOperation, FStringView Path)
+	: Operation(InOperation)
+{
+	while (Path.StartsWith(TEXT('/')))
+	{
+		Path.RightChopInline(1);
+	}
+
+	int32 End = 0;
+	while (End < Path.Len() && Path[End] != TEXT('/') && Path[End] != TEXT('?'))
+	{
+		End++;
+	}
+	Prefix = End > 0 ? FString(Path.Left(End)) : FString(TEXT("/"));
+}
+
+FFirebaseRequestMetrics& FFirebaseRequestMetrics::Get()
+{
+	static FFirebaseRequestMetrics Instance;
+	return Instance;
+}
+
+void FFirebaseRequestMetrics::FWindow::Reset()
+{
+	// Entries stay allocated; the same keys come back in the next window
+	for (FFirebaseLatencyHistogram& Histogram : All.Phases)
+	{
+		Histogram.Reset();
+	}
+	for (TFirebaseCaseSensitiveMap<TUniquePtr<FHistograms>>* Map : { &ByOperation, &ByPrefix })
+	{
+		for (TPair<FString, TUniquePtr<FHistograms>>& Pair : *Map)
+		{
+			for (FFirebaseLatencyHistogram& Histogram : Pair.Value->Phases)
+			{
+				Histogram.Reset();
+			}
+		}
+	}
+}
+
+void FFirebaseRequestMetrics::Record(const FFirebaseRequestKey& Key, EFirebaseRequestPhase Phase, double Seconds)
+{
+	LLM_SCOPE_BYTAG(Firebase_Diagnostics);
+
+	FWindow& Window = Windows[CurrentWindow];
+	const int32 PhaseIndex = (int32)Phase;
+
+	Window.All.Phases[PhaseIndex].Record(Seconds);
+
+	TUniquePtr<FHistograms>& Operation = Window.ByOperation.FindOrAdd(Key.Operation);
+	if (!Operation.IsValid())
+	{
+		Operation = MakeUnique<FHistograms>();
+	}
+	Operation->Phases[PhaseIndex].Record(Seconds);
+
+	// Keys of user data (one prefix per player, say) must not grow the table without bound
+	const FString PrefixKey = Window.ByPrefix.Num() < MaxPrefixes || Window.ByPrefix.Contains(Key.Prefix)
+		? Key.Prefix
+		: FirebaseStats::OtherPrefix;
+	TUniquePtr<FHistograms>& Prefix = Window.ByPrefix.FindOrAdd(PrefixKey);
+	if (!Prefix.IsValid())
+	{
+		Prefix = MakeUnique<FHistograms>();
+	}
+	Prefix->Phases[PhaseIndex].Record(Seconds);
+}
+
+void FFirebaseRequestMetrics::RecordQueued(const FFirebaseRequestKey& Key, double Seconds)
+{
+	Record(Key, EFirebaseRequestPhase::Queue, Seconds);
+}
+
+double FFirebaseRequestMetrics::RecordSent(const FFirebaseRequestKey& Key, int64 Bytes)
+{
+	Totals.Sent++;
+	Totals.RequestBytes += Bytes;
+	Totals.InFlight++;
+
+	INC_DWORD_STAT(STAT_FirebaseRequestsSent);
+	INC_DWORD_STAT_BY(STAT_FirebaseRequestBytes, Bytes);
+	INC_DWORD_STAT(STAT_FirebaseRequestsInFlight);
+
+	return FPlatformTime::Seconds();
+}
+
+void FFirebaseRequestMetrics::RecordResponse(const FFirebaseRequestKey& Key, double SentTime, const FFirebaseHttpResponse& Response)
+{
+	Totals.InFlight = FMath::Max(Totals.InFlight - 1, 0);
+	DEC_DWORD_STAT(STAT_FirebaseRequestsInFlight);
+
+	if (!Response.bSucceeded)
+	{
+		// Failures and cancelled hedges carry no timing worth keeping
+		Totals.Failed++;
+		INC_DWORD_STAT(STAT_FirebaseRequestsFailed);
+		return;
+	}
+
+	const int64 Bytes = Response.Body.Num();
+	Totals.Received++;
+	Totals.ResponseBytes += Bytes;
+	INC_DWORD_STAT(STAT_FirebaseResponsesReceived);
+	INC_DWORD_STAT_BY(STAT_FirebaseResponseBytes, Bytes);
+
+	// Prefer the transport's own clock (virtual for test transports); fall back to wall time
+	const double Elapsed = Response.ElapsedSeconds >= 0.0f ? Response.ElapsedSeconds : FPlatformTime::Seconds() - SentTime;
+	const double FirstByte = Response.TimeToFirstByteSeconds >= 0.0f ? FMath::Min((double)Response.TimeToFirstByteSeconds, Elapsed) : Elapsed;
+
+	Record(Key, EFirebaseRequestPhase::FirstByte, FirstByte);
+	Record(Key, EFirebaseRequestPhase::Transfer, Elapsed - FirstByte);
+	Record(Key, EFirebaseRequestPhase::RoundTrip, Elapsed);
+}
+
+void FFirebaseRequestMetrics::RecordCallback(const FFirebaseRequestKey& Key, double Seconds)
+{
+	Record(Key, EFirebaseRequestPhase::Callback, Seconds);
+}
+
+FFirebaseLatencySummary FFirebaseRequestMetrics::Summarize(TFunctionRef<const FHistograms*(const FWindow&)> Select, EFirebaseRequestPhase Phase) const
+{
+	FFirebaseLatencyHistogram Merged;
+	for (const FWindow& Window : Windows)
+	{
+		if (const FHistograms* Histograms = Select(Window))
+		{
+			Merged.Merge(Histograms->Phases[(int32)Phase]);
+		}
+	}
+	return Merged.Summarize();
+}
+
+FFirebaseLatencySummary FFirebaseRequestMetrics::GetSummary(EFirebaseRequestPhase Phase) const
+{
+	return Summarize([](const FWindow& Window) { return &Window.All; }, Phase);
+}
+
+FFirebaseLatencySummary FFirebaseRequestMetrics::GetOperationSummary(const FString& Operation, EFirebaseRequestPhase Phase) const
+{
+	return Summarize([&Operation](const FWindow& Window) -> const FHistograms*
+	{
+		const TUniquePtr<FHistograms>* Found = Window.ByOperation.Find(Operation);
+		return Found ? Found->Get() : nullptr;
+	}, Phase);
+}
+
+FFirebaseLatencySummary FFirebaseRequestMetrics::GetPrefixSummary(const FString& Prefix, EFirebaseRequestPhase Phase) const
+{
+	return Summarize([&Prefix](const FWindow& Window) -> const FHistograms*
+	{
+		const TUniquePtr<FHistograms>* Found = Window.ByPrefix.Find(Prefix);
+		return Found ? Found->Get() : nullptr;
+	}, Phase);
+}
+
+void FFirebaseRequestMetrics::Tick(double Now)
+{
+	if (WindowStartTime == 0.0)
+	{
+		WindowStartTime = Now;
+	}
+	else if (Now - WindowStartTime >= WindowSeconds)
+	{
+		// The oldest window becomes the current one
+		CurrentWindow ^= 1;
+		Windows[CurrentWindow].Reset();
+		WindowStartTime = Now;
+	}
+
+#if STATS
+	const FFirebaseLatencySummary Queue = GetSummary(EFirebaseRequestPhase::Queue);
+	SET_FLOAT_STAT(STAT_FirebaseQueueP50, Queue.P50 * 1000.0);
+	SET_FLOAT_STAT(STAT_FirebaseQueueP90, Queue.P90 * 1000.0);
+	SET_FLOAT_STAT(STAT_FirebaseQueueP99, Queue.P99 * 1000.0);
+	SET_FLOAT_STAT(STAT_FirebaseQueueMax, Queue.Max * 1000.0);
+
+	const FFirebaseLatencySummary FirstByte = GetSummary(EFirebaseRequestPhase::FirstByte);
+	SET_FLOAT_STAT(STAT_FirebaseFirstByteP50, FirstByte.P50 * 1000.0);
+	SET_FLOAT_STAT(STAT_FirebaseFirstByteP90, FirstByte.P90 * 1000.0);
+	SET_FLOAT_STAT(STAT_FirebaseFirstByteP99, FirstByte.P99 * 1000.0);
+	SET_FLOAT_STAT(STAT_FirebaseFirstByteMax, FirstByte.Max * 1000.0);
+
+	const FFirebaseLatencySummary Transfer = GetSummary(EFirebaseRequestPhase::Transfer);
+	SET_FLOAT_STAT(STAT_FirebaseTransferP50, Transfer.P50 * 1000.0);
+	SET_FLOAT_STAT(STAT_FirebaseTransferP90, Transfer.P90 * 1000.0);
+	SET_FLOAT_STAT(STAT_FirebaseTransferP99, Transfer.P99 * 1000.0);
+	SET_FLOAT_STAT(STAT_FirebaseTransferMax, Transfer.Max * 1000.0);
+
+	const FFirebaseLatencySummary Callback = GetSummary(EFirebaseRequestPhase::Callback);
+	SET_FLOAT_STAT(STAT_FirebaseCallbackP50, Callback.P50 * 1000.0);
+	SET_FLOAT_STAT(STAT_FirebaseCallbackP90, Callback.P90 * 1000.0);
+	SET_FLOAT_STAT(STAT_FirebaseCallbackP99, Callback.P99 * 1000.0);
+	SET_FLOAT_STAT(STAT_FirebaseCallbackMax, Callback.Max * 1000.0);
+
+	SET_FLOAT_STAT(STAT_FirebaseGetP99, GetOperationSummary(TEXT("GET"), EFirebaseRequestPhase::RoundTrip).P99 * 1000.0);
+	SET_FLOAT_STAT(STAT_FirebasePutP99, GetOperationSummary(TEXT("PUT"), EFirebaseRequestPhase::RoundTrip).P99 * 1000.0);
+	SET_FLOAT_STAT(STAT_FirebasePatchP99, GetOperationSummary(TEXT("PATCH"), EFirebaseRequestPhase::RoundTrip).P99 * 1000.0);
+	SET_FLOAT_STAT(STAT_FirebasePostP99, GetOperationSummary(TEXT("POST"), EFirebaseRequestPhase::RoundTrip).P99 * 1000.0);
+	SET_FLOAT_STAT(STAT_FirebaseDeleteP99, GetOperationSummary(TEXT("DELETE"), EFirebaseRequestPhase::RoundTrip).P99 * 1000.0);
+	SET_FLOAT_STAT(STAT_FirebaseAuthP99, GetOperationSummary(TEXT("AUTH"), EFirebaseRequestPhase::RoundTrip).P99 * 1000.0);
+	SET_FLOAT_STAT(STAT_FirebasePollP99, GetOperationSummary(TEXT("POLL"), EFirebaseRequestPhase::RoundTrip).P99 * 1000.0);
+
+	SET_MEMORY_STAT(STAT_FirebaseBufferPoolMemory, FFirebaseBufferPool::Get().GetStats().PooledBytes);
+	SET_MEMORY_STAT(STAT_FirebaseHistogramMemory, GetAllocatedSize());
+
+	const FFirebaseMemory& Memory = FFirebaseMemory::Get();
+	SET_MEMORY_STAT(STAT_FirebaseQueueMemory, Memory.GetUsage(EFirebaseMemoryCategory::Queues));
+	SET_MEMORY_STAT(STAT_FirebasePendingOpsMemory, Memory.GetUsage(EFirebaseMemoryCategory::PendingOps));
+	SET_MEMORY_STAT(STAT_FirebaseListenerMemory, Memory.GetUsage(EFirebaseMemoryCategory::Listeners));
+	SET_MEMORY_STAT(STAT_FirebaseDiagnosticsMemory, Memory.GetUsage(EFirebaseMemoryCategory::Diagnostics));
+	SET_MEMORY_STAT(STAT_FirebaseBudgetedMemory, Memory.GetTotal());
+#endif
+}
+
+void FFirebaseRequestMetrics::DumpSection(FOutputDevice& Ar, const FString& Title, TFunctionRef<FFirebaseLatencySummary(EFirebaseRequestPhase)> GetPhase) const
+{
+	Ar.Logf(TEXT("  %s"), *Title);
+	for (int32 PhaseIndex = 0; PhaseIndex < (int32)EFirebaseRequestPhase::Num; ++PhaseIndex)
+	{
+		const FFirebaseLatencySummary Summary = GetPhase((EFirebaseRequestPhase)PhaseIndex);
+		if (Summary.Count == 0)
+		{
+			continue;
+		}
+		Ar.Logf(TEXT("    %-10s %8llu %10.2f %10.2f %10.2f %10.2f"), FirebaseStats::PhaseNames[PhaseIndex], Summary.Count,
+			Summary.P50 * 1000.0, Summary.P90 * 1000.0, Summary.P99 * 1000.0, Summary.Max * 1000.0);
+	}
+}
+
+void FFirebaseRequestMetrics::Dump(FOutputDevice& Ar) const
+{
+	Ar.Logf(TEXT("Firebase REST: %lld sent, %lld received, %lld failed, %d in flight, %lld bytes up, %lld bytes down"),
+		Totals.Sent, Totals.Received, Totals.Failed, Totals.InFlight, Totals.RequestBytes, Totals.ResponseBytes);
+	Ar.Logf(TEXT("Latency over the last %.0f-%.0f s (ms):"), WindowSeconds, WindowSeconds * 2.0);
+	Ar.Logf(TEXT("    %-10s %8s %10s %10s %10s %10s"), TEXT("Phase"), TEXT("Count"), TEXT("p50"), TEXT("p90"), TEXT("p99"), TEXT("max"));
+
+	DumpSection(Ar, TEXT("All requests"), [this](EFirebaseRequestPhase Phase) { return GetSummary(Phase); });
+
+	// Keys seen in either window, sorted so repeated dumps line up
+	TSet<FString> OperationSet;
+	TSet<FString> PrefixSet;
+	for (const FWindow& Window : Windows)
+	{
+		for (const TPair<FString, TUniquePtr<FHistograms>>& Pair : Window.ByOperation)
+		{
+			OperationSet.Add(Pair.Key);
+		}
+		for (const TPair<FString, TUniquePtr<FHistograms>>& Pair : Window.ByPrefix)
+		{
+			PrefixSet.Add(Pair.Key);
+		}
+	}
+	TArray<FString> Operations = OperationSet.Array();
+	TArray<FString> Prefixes = PrefixSet.Array();
+	Operations.Sort();
+	Prefixes.Sort();
+
+	for (const FString& Operation : Operations)
+	{
+		DumpSection(Ar, FString::Printf(TEXT("Operation %s"), *Operation), [this, &Operation](EFirebaseRequestPhase Phase)
+		{
+			return GetOperationSummary(Operation, Phase);
+		});
+	}
+
+	for (const FString& Prefix : Prefixes)
+	{
+		DumpSection(Ar, FString::Printf(TEXT("Prefix %s"), *Prefix), [this, &Prefix](EFirebaseRequestPhase Phase)
+		{
+			return GetPrefixSummary(Prefix, Phase);
+		});
+	}
+}
+
+void FFirebaseRequestMetrics::Reset()
+{
+	for (FWindow& Window : Windows)
+	{
+		Window.All = FHistograms();
+		Window.ByOperation.Empty();
+		Window.ByPrefix.Empty();
+	}
+
+	const int32 InFlight = Totals.InFlight;
+	Totals = FFirebaseRequestTotals();
+	Totals.InFlight = InFlight;
+}
+
+SIZE_T FFirebaseRequestMetrics::GetAllocatedSize() const
+{
+	SIZE_T Size = 0;
+	for (const FWindow& Window : Windows)
+	{
+		Size += Window.ByOperation.GetAllocatedSize() + Window.ByPrefix.GetAllocatedSize();
+		Size += (Window.ByOperation.Num() + Window.ByPrefix.Num()) * sizeof(FHistograms);
+	}
+	return Size;
+}
@@ -0,0 +1,1069 @@
+// Copyright. All Rights Reserved.
+
+#include "FirebaseStructCodec.h"
+#include "FirebaseMemory.h"
+#include "FirebaseJsonWriter.h"
+#include "FirebaseJsonEscape.h"
+#include "JsonObjectConverter.h"
+#include "Misc/ScopeRWLock.h"
+#include "UObject/EnumProperty.h"
+#include "UObject/TextProperty.h"
+#include "UObject/UnrealType.h"
+
+namespace FirebaseStructCodec
+{
+	enum class EKind : uint8
+	{
+		Bool,
+		SignedInt,
+		UnsignedInt,
+		Float,
+		Double,
+		Enum,
+		String,
+		Name,
+		Text,
+		Struct,
+		Array,
+		Set,
+		Map,
+		ExportText
+	};
+
+	struct FStructPlan;
+
+	/** How one value (member, container element, map key or map value) is encoded */
+	struct FValuePlan
+	{
+		EKind Kind = EKind::ExportText;
+		const FProperty* Property = nullptr;
+
+		// Integer storage of numbers and enums
+		const FNumericProperty* Numeric = nullptr;
+
+		// Enum names and values, in declaration order
+		const UEnum* Enum = nullptr;
+		TArray<FString> EnumNames;
+		TArray<int64> EnumValues;
+
+		// Nested struct; StructPlan is null when the plan has to be looked up per call
+		const UScriptStruct* Struct = nullptr;
+		const FStructPlan* StructPlan = nullptr;
+
+		// Array/set element or map value, and map key
+		TUniquePtr<FValuePlan> Inner;
+		TUniquePtr<FValuePlan> Key;
+	};
+
+	struct FMemberPlan
+	{
+		const FProperty* Property = nullptr;
+		int32 ArrayDim = 1;
+		TArray<UTF8CHAR> Key;
+		FValuePlan Value;
+
+		FUtf8StringView GetKey() const { return FUtf8StringView(Key.GetData(), Key.Num()); }
+	};
+
+	struct FStructPlan
+	{
+		TWeakObjectPtr<const UScriptStruct> Struct;
+		uint32 LayoutHash = 0;
+		TArray<FMemberPlan> Members;
+
+		// Member indices sorted by key, ignoring ASCII case
+		TArray<int32> MembersByKey;
+
+		const FMemberPlan* FindMember(FUtf8StringView Key) const;
+	};
+
+	uint8 ToLowerAscii(UTF8CHAR Character)
+	{
+		const uint8 Byte = uint8(Character);
+		return Byte >= 'A' && Byte <= 'Z' ? Byte + ('a' - 'A') : Byte;
+	}
+
+	int32 CompareKeys(FUtf8StringView A, FUtf8StringView B)
+	{
+		const int32 Common = FMath::Min(A.Len(), B.Len());
+		for (int32 Index = 0; Index < Common; ++Index)
+		{
+			const uint8 CharA = ToLowerAscii(A[Index]);
+			const uint8 CharB = ToLowerAscii(B[Index]);
+			if (CharA != CharB)
+			{
+				return CharA < CharB ? -1 : 1;
+			}
+		}
+		return A.Len() - B.Len();
+	}
+
+	const FMemberPlan* FStructPlan::FindMember(FUtf8StringView Key) const
+	{
+		int32 Low = 0;
+		int32 High = MembersByKey.Num() - 1;
+		while (Low <= High)
+		{
+			const int32 Middle = (Low + High) / 2;
+			const FMemberPlan& Member = Members[MembersByKey[Middle]];
+			const int32 Order = CompareKeys(Key, Member.GetKey());
+			if (Order == 0)
+			{
+				return &Member;
+			}
+			if (Order < 0)
+			{
+				High = Middle - 1;
+			}
+			else
+			{
+				Low = Middle + 1;
+			}
+		}
+		return nullptr;
+	}
+
+	bool IsNativeStruct(const UScriptStruct* Struct)
+	{
+		return (Struct->StructFlags & STRUCT_Native) != 0;
+	}
+
+	/** Changes whenever a Blueprint struct is edited and recompiled in place */
+	uint32 ComputeLayoutHash(const UScriptStruct* Struct)
+	{
+		uint32 Hash = GetTypeHash(Struct->GetStructureSize());
+		for (TFieldIterator<FProperty> It(Struct); It; ++It)
+		{
+			Hash = HashCombine(Hash, GetTypeHash(It->GetFName()));
+			Hash = HashCombine(Hash, GetTypeHash(It->GetOffset_ForInternal()));
+			Hash = HashCombine(Hash, GetTypeHash(It->GetClass()->GetFName()));
+		}
+		return Hash;
+	}
+
+	/**
+	 * Process-wide plan cache. Plans are never freed: a plan that goes stale
+	 * (Blueprint struct recompiled, struct unloaded) is replaced in the map but
+	 * kept in storage, so pointers held by other plans or running calls stay valid.
+	 */
+	class FPlanCache
+	{
+	public:
+		static FPlanCache& Get()
+		{
+			static FPlanCache Instance;
+			return Instance;
+		}
+
+		const FStructPlan* FindOrCompile(const UScriptStruct* Struct)
+		{
+			{
+				FReadScopeLock ReadLock(Lock);
+				if (const FStructPlan* Plan = FindLocked(Struct))
+				{
+					return Plan;
+				}
+			}
+
+			FWriteScopeLock WriteLock(Lock);
+
+			// Plans only become visible once every nested plan is complete
+			TMap<const UScriptStruct*, FStructPlan*> Pending;
+			const FStructPlan* Plan = CompileLocked(Struct, Pending);
+			for (const TPair<const UScriptStruct*, FStructPlan*>& Pair : Pending)
+			{
+				Plans.Add(Pair.Key, Pair.Value);
+			}
+			return Plan;
+		}
+
+	private:
+		const FStructPlan* FindLocked(const UScriptStruct* Struct) const
+		{
+			FStructPlan* const* Plan = Plans.Find(Struct);
+			if (!Plan || (*Plan)->Struct.Get() != Struct)
+			{
+				return nullptr;
+			}
+			if (!IsNativeStruct(Struct) && (*Plan)->LayoutHash != ComputeLayoutHash(Struct))
+			{
+				return nullptr;
+			}
+			return *Plan;
+		}
+
+		const FStructPlan* CompileLocked(const UScriptStruct* Struct, TMap<const UScriptStruct*, FStructPlan*>& Pending)
+		{
+			if (const FStructPlan* Existing = FindLocked(Struct))
+			{
+				return Existing;
+			}
+			if (FStructPlan* const* InProgress = Pending.Find(Struct))
+			{
+				// Recursive struct (through a container); the plan is filled in further up the stack
+				return *InProgress;
+			}
+
+			FStructPlan* Plan = Storage.Add_GetRef(MakeUnique<FStructPlan>()).Get();
+			Plan->Struct = Struct;
+			Plan->LayoutHash = ComputeLayoutHash(Struct);
+			Pending.Add(Struct, Plan);
+
+			for (TFieldIterator<FProperty> It(Struct); It; ++It)
+			{
+				const FProperty* Property = *It;
+				if (Property->HasAnyPropertyFlags(CPF_Transient | CPF_Deprecated)
+					|| Property->IsA<FDelegateProperty>() || Property->IsA<FMulticastDelegateProperty>())
+				{
+					continue;
+				}
+
+				FMemberPlan& Member = Plan->Members.AddDefaulted_GetRef();
+				Member.Property = Property;
+				Member.ArrayDim = Property->ArrayDim;
+
+				const FTCHARToUTF8 Key(*FFirebaseStructCodec::GetJsonKey(Property));
+				Member.Key.Append(reinterpret_cast<const UTF8CHAR*>(Key.Get()), Key.Length());
+
+				CompileValue(Property, Member.Value, Pending);
+			}
+
+			Plan->MembersByKey.Reserve(Plan->Members.Num());
+			for (int32 Index = 0; Index < Plan->Members.Num(); ++Index)
+			{
+				Plan->MembersByKey.Add(Index);
+			}
+			Plan->MembersByKey.Sort([Plan](int32 A, int32 B)
+			{
+				return CompareKeys(Plan->Members[A].GetKey(), Plan->Members[B].GetKey()) < 0;
+			});
+
+			return Plan;
+		}
+
+		void CompileValue(const FProperty* Property, FValuePlan& Out, TMap<const UScriptStruct*, FStructPlan*>& Pending)
+		{
+			Out.Property = Property;
+
+			if (Property->IsA<FBoolProperty>())
+			{
+				Out.Kind = EKind::Bool;
+			}
+			else if (const FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property))
+			{
+				CompileEnum(EnumProperty->GetEnum(), EnumProperty->GetUnderlyingProperty(), Out);
+			}
+			else if (const FNumericProperty* Numeric = CastField<FNumericProperty>(Property))
+			{
+				Out.Numeric = Numeric;
+				if (const UEnum* Enum = Numeric->GetIntPropertyEnum())
+				{
+					CompileEnum(Enum, Numeric, Out);
+				}
+				else if (Property->IsA<FFloatProperty>())
+				{
+					Out.Kind = EKind::Float;
+				}
+				else if (Property->IsA<FDoubleProperty>())
+				{
+					Out.Kind = EKind::Double;
+				}
+				else
+				{
+					Out.Kind = Property->IsA<FUInt64Property>() ? EKind::UnsignedInt : EKind::SignedInt;
+				}
+			}
+			else if (Property->IsA<FStrProperty>())
+			{
+				Out.Kind = EKind::String;
+			}
+			else if (Property->IsA<FNameProperty>())
+			{
+				Out.Kind = EKind::Name;
+			}
+			else if (Property->IsA<FTextProperty>())
+			{
+				Out.Kind = EKind::Text;
+			}
+			else if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+			{
+				// Same rule as FJsonObjectConverter: structs with a text form are written as strings
+				UScriptStruct::ICppStructOps* StructOps = StructProperty->Struct->GetCppStructOps();
+				if (StructOps && StructOps->HasExportTextItem())
+				{
+					Out.Kind = EKind::ExportText;
+				}
+				else
+				{
+					Out.Kind = EKind::Struct;
+					Out.Struct = StructProperty->Struct;
+
+					// Blueprint structs can change layout, so they are looked up on every call
+					if (IsNativeStruct(StructProperty->Struct))
+					{
+						Out.StructPlan = CompileLocked(StructProperty->Struct, Pending);
+					}
+				}
+			}
+			else if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+			{
+				Out.Kind = EKind::Array;
+				Out.Inner = MakeUnique<FValuePlan>();
+				CompileValue(ArrayProperty->Inner, *Out.Inner, Pending);
+			}
+			else if (const FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+			{
+				Out.Kind = EKind::Set;
+				Out.Inner = MakeUnique<FValuePlan>();
+				CompileValue(SetProperty->ElementProp, *Out.Inner, Pending);
+			}
+			else if (const FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+			{
+				Out.Kind = EKind::Map;
+				Out.Key = MakeUnique<FValuePlan>();
+				CompileValue(MapProperty->KeyProp, *Out.Key, Pending);
+				Out.Inner = MakeUnique<FValuePlan>();
+				CompileValue(MapProperty->ValueProp, *Out.Inner, Pending);
+			}
+			else
+			{
+				Out.Kind = EKind::ExportText;
+			}
+		}
+
+		static void CompileEnum(const UEnum* Enum, const FNumericProperty* Underlying, FValuePlan& Out)
+		{
+			Out.Kind = EKind::Enum;
+			Out.Enum = Enum;
+			Out.Numeric = Underlying;
+
+			// The last entry is the generated _MAX
+			const int32 NumNames = FMath::Max(Enum->NumEnums() - 1, 0);
+			Out.EnumNames.Reserve(NumNames);
+			Out.EnumValues.Reserve(NumNames);
+			for (int32 Index = 0; Index < NumNames; ++Index)
+			{
+				Out.EnumNames.Add(Enum->GetNameStringByIndex(Index));
+				Out.EnumValues.Add(Enum->GetValueByIndex(Index));
+			}
+		}
+
+		FRWLock Lock;
+		TMap<const UScriptStruct*, FStructPlan*> Plans;
+		TArray<TUniquePtr<FStructPlan>> Storage;
+	};
+
+	const FStructPlan* ResolveStruct(const FValuePlan& Plan)
+	{
+		return Plan.StructPlan ? Plan.StructPlan : FPlanCache::Get().FindOrCompile(Plan.Struct);
+	}
+
+	// === WRITING ===
+
+	void WriteValue(const FValuePlan& Plan, const void* Value, FFirebaseJsonWriter& Writer);
+
+	/** Value of a member; C-style array members become JSON arrays */
+	void WriteMember(const FMemberPlan& Member, const void* Data, FFirebaseJsonWriter& Writer)
+	{
+		if (Member.ArrayDim == 1)
+		{
+			WriteValue(Member.Value, Member.Property->ContainerPtrToValuePtr<void>(Data), Writer);
+			return;
+		}
+
+		Writer.BeginArray();
+		for (int32 Index = 0; Index < Member.ArrayDim; ++Index)
+		{
+			WriteValue(Member.Value, Member.Property->ContainerPtrToValuePtr<void>(Data, Index), Writer);
+		}
+		Writer.EndArray();
+	}
+
+	void WriteStruct(const FStructPlan& Plan, const void* Data, FFirebaseJsonWriter& Writer)
+	{
+		Writer.BeginObject();
+		for (const FMemberPlan& Member : Plan.Members)
+		{
+			Writer.WriteKey(Member.GetKey());
+			WriteMember(Member, Data, Writer);
+		}
+		Writer.EndObject();
+	}
+
+	bool IsMemberIdentical(const FMemberPlan& Member, const void* OldData, const void* NewData)
+	{
+		for (int32 Index = 0; Index < Member.ArrayDim; ++Index)
+		{
+			if (!Member.Property->Identical(
+				Member.Property->ContainerPtrToValuePtr<void>(OldData, Index),
+				Member.Property->ContainerPtrToValuePtr<void>(NewData, Index), PPF_None))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	typedef TArray<UTF8CHAR, TInlineAllocator<256>> FPathBuffer;
+
+	/**
+	 * Write "path/to/member": value for every member that differs. Nested
+	 * structs are descended into so only their changed leaves are sent;
+	 * containers and everything else are replaced as a whole.
+	 */
+	int32 WriteChangedMembers(const FStructPlan& Plan, const void* OldData, const void* NewData, FPathBuffer& Path,
+		FFirebaseJsonWriter& Writer, TArray<FString>* OutPaths)
+	{
+		int32 NumChanged = 0;
+		for (const FMemberPlan& Member : Plan.Members)
+		{
+			const int32 PathLength = Path.Num();
+			if (PathLength > 0)
+			{
+				Path.Add(UTF8CHAR('/'));
+			}
+			Path.Append(Member.Key.GetData(), Member.Key.Num());
+
+			const FStructPlan* NestedPlan = Member.ArrayDim == 1 && Member.Value.Kind == EKind::Struct ? ResolveStruct(Member.Value) : nullptr;
+			if (NestedPlan)
+			{
+				NumChanged += WriteChangedMembers(*NestedPlan,
+					Member.Property->ContainerPtrToValuePtr<void>(OldData),
+					Member.Property->ContainerPtrToValuePtr<void>(NewData), Path, Writer, OutPaths);
+			}
+			else if (!IsMemberIdentical(Member, OldData, NewData))
+			{
+				const FUtf8StringView PathView(Path.GetData(), Path.Num());
+				Writer.WriteKey(PathView);
+				WriteMember(Member, NewData, Writer);
+				if (OutPaths)
+				{
+					OutPaths->Add(FirebaseJsonEscape::Utf8ToString(PathView));
+				}
+				++NumChanged;
+			}
+
+			Path.SetNum(PathLength);
+		}
+		return NumChanged;
+	}
+
+	const FString* FindEnumName(const FValuePlan& Plan, int64 Value)
+	{
+		const int32 Index = Plan.EnumValues.IndexOfByKey(Value);
+		return Index != INDEX_NONE ? &Plan.EnumNames[Index] : nullptr;
+	}
+
+	/** Map keys are always JSON strings */
+	FString KeyToString(const FValuePlan& Plan, const void* Value)
+	{
+		switch (Plan.Kind)
+		{
+		case EKind::String:
+			return *static_cast<const FString*>(Value);
+		case EKind::Name:
+			return static_cast<const FName*>(Value)->ToString();
+		case EKind::Text:
+			return static_cast<const FText*>(Value)->ToString();
+		case EKind::Bool:
+			return static_cast<const FBoolProperty*>(Plan.Property)->GetPropertyValue(Value) ? TEXT("true") : TEXT("false");
+		case EKind::SignedInt:
+			return LexToString(Plan.Numeric->GetSignedIntPropertyValue(Value));
+		case EKind::UnsignedInt:
+			return LexToString(Plan.Numeric->GetUnsignedIntPropertyValue(Value));
+		case EKind::Enum:
+			{
+				const int64 EnumValue = Plan.Numeric->GetSignedIntPropertyValue(Value);
+				const FString* Name = FindEnumName(Plan, EnumValue);
+				return Name ? *Name : LexToString(EnumValue);
+			}
+		default:
+			{
+				FString Text;
+				Plan.Property->ExportTextItem_Direct(Text, Value, nullptr, nullptr, PPF_None);
+				return Text;
+			}
+		}
+	}
+
+	void WriteValue(const FValuePlan& Plan, const void* Value, FFirebaseJsonWriter& Writer)
+	{
+		switch (Plan.Kind)
+		{
+		case EKind::Bool:
+			Writer.WriteBool(static_cast<const FBoolProperty*>(Plan.Property)->GetPropertyValue(Value));
+			break;
+
+		case EKind::SignedInt:
+			Writer.WriteInt(Plan.Numeric->GetSignedIntPropertyValue(Value));
+			break;
+
+		case EKind::UnsignedInt:
+			{
+				const uint64 Unsigned = Plan.Numeric->GetUnsignedIntPropertyValue(Value);
+				if (Unsigned <= uint64(MAX_int64))
+				{
+					Writer.WriteInt(int64(Unsigned));
+				}
+				else
+				{
+					Writer.WriteDouble(double(Unsigned));
+				}
+			}
+			break;
+
+		case EKind::Float:
+			Writer.WriteFloat(*static_cast<const float*>(Value));
+			break;
+
+		case EKind::Double:
+			Writer.WriteDouble(*static_cast<const double*>(Value));
+			break;
+
+		case EKind::Enum:
+			{
+				const int64 EnumValue = Plan.Numeric->GetSignedIntPropertyValue(Value);
+				if (const FString* Name = FindEnumName(Plan, EnumValue))
+				{
+					Writer.WriteString(FStringView(*Name));
+				}
+				else
+				{
+					Writer.WriteInt(EnumValue);
+				}
+			}
+			break;
+
+		case EKind::String:
+			Writer.WriteString(FStringView(*static_cast<const FString*>(Value)));
+			break;
+
+		case EKind::Name:
+			{
+				TStringBuilder<128> Name;
+				static_cast<const FName*>(Value)->AppendString(Name);
+				Writer.WriteString(Name.ToView());
+			}
+			break;
+
+		case EKind::Text:
+			Writer.WriteString(FStringView(static_cast<const FText*>(Value)->ToString()));
+			break;
+
+		case EKind::Struct:
+			if (const FStructPlan* StructPlan = ResolveStruct(Plan))
+			{
+				WriteStruct(*StructPlan, Value, Writer);
+			}
+			else
+			{
+				Writer.WriteNull();
+			}
+			break;
+
+		case EKind::Array:
+			{
+				FScriptArrayHelper Helper(static_cast<const FArrayProperty*>(Plan.Property), Value);
+				Writer.BeginArray();
+				for (int32 Index = 0; Index < Helper.Num(); ++Index)
+				{
+					WriteValue(*Plan.Inner, Helper.GetRawPtr(Index), Writer);
+				}
+				Writer.EndArray();
+			}
+			break;
+
+		case EKind::Set:
+			{
+				FScriptSetHelper Helper(static_cast<const FSetProperty*>(Plan.Property), Value);
+				Writer.BeginArray();
+				for (int32 Index = 0; Index < Helper.GetMaxIndex(); ++Index)
+				{
+					if (Helper.IsValidIndex(Index))
+					{
+						WriteValue(*Plan.Inner, Helper.GetElementPtr(Index), Writer);
+					}
+				}
+				Writer.EndArray();
+			}
+			break;
+
+		case EKind::Map:
+			{
+				FScriptMapHelper Helper(static_cast<const FMapProperty*>(Plan.Property), Value);
+				Writer.BeginObject();
+				for (int32 Index = 0; Index < Helper.GetMaxIndex(); ++Index)
+				{
+					if (Helper.IsValidIndex(Index))
+					{
+						Writer.WriteKey(FStringView(KeyToString(*Plan.Key, Helper.GetKeyPtr(Index))));
+						WriteValue(*Plan.Inner, Helper.GetValuePtr(Index), Writer);
+					}
+				}
+				Writer.EndObject();
+			}
+			break;
+
+		case EKind::ExportText:
+			{
+				FString Text;
+				Plan.Property->ExportTextItem_Direct(Text, Value, nullptr, nullptr, PPF_None);
+				Writer.WriteString(FStringView(Text));
+			}
+			break;
+		}
+	}
+
+	// === READING ===
+
+	struct FReadContext
+	{
+		FString Error;
+
+		void Mismatch(const FMemberPlan& Member)
+		{
+			if (Error.IsEmpty())
+			{
+				Error = FString::Printf(TEXT("'%s' has an unexpected JSON type"), *Member.Property->GetAuthoredName());
+			}
+		}
+	};
+
+	int64 NumberToInt64(double Number)
+	{
+		// Out-of-range casts are undefined; the database stores doubles anyway
+		return int64(FMath::Clamp(FMath::RoundToDouble(Number), -9223372036854775808.0, 9223372036854774784.0));
+	}
+
+	bool FindEnumValue(const FValuePlan& Plan, const FString& Name, int64& OutValue)
+	{
+		for (int32 Index = 0; Index < Plan.EnumNames.Num(); ++Index)
+		{
+			if (Plan.EnumNames[Index].Equals(Name, ESearchCase::IgnoreCase))
+			{
+				OutValue = Plan.EnumValues[Index];
+				return true;
+			}
+		}
+
+		// Fully qualified names ("EMyEnum::Value")
+		OutValue = Plan.Enum->GetValueByNameString(Name);
+		return OutValue != INDEX_NONE;
+	}
+
+	bool KeyFromString(const FValuePlan& Plan, void* Value, const FString& Key)
+	{
+		switch (Plan.Kind)
+		{
+		case EKind::String:
+			*static_cast<FString*>(Value) = Key;
+			return true;
+		case EKind::Name:
+			*static_cast<FName*>(Value) = FName(*Key);
+			return true;
+		case EKind::Text:
+			*static_cast<FText*>(Value) = FText::FromString(Key);
+			return true;
+		case EKind::Bool:
+			static_cast<const FBoolProperty*>(Plan.Property)->SetPropertyValue(Value, Key.ToBool());
+			return true;
+		case EKind::SignedInt:
+			{
+				int64 Number = 0;
+				if (!LexTryParseString(Number, *Key))
+				{
+					return false;
+				}
+				Plan.Numeric->SetIntPropertyValue(Value, Number);
+				return true;
+			}
+		case EKind::UnsignedInt:
+			{
+				uint64 Number = 0;
+				if (!LexTryParseString(Number, *Key))
+				{
+					return false;
+				}
+				Plan.Numeric->SetIntPropertyValue(Value, Number);
+				return true;
+			}
+		case EKind::Enum:
+			{
+				int64 EnumValue = 0;
+				if (!FindEnumValue(Plan, Key, EnumValue) && !LexTryParseString(EnumValue, *Key))
+				{
+					return false;
+				}
+				Plan.Numeric->SetIntPropertyValue(Value, EnumValue);
+				return true;
+			}
+		default:
+			return Plan.Property->ImportText_Direct(*Key, Value, nullptr, PPF_None) != nullptr;
+		}
+	}
+
+	bool ReadValue(const FValuePlan& Plan, void* Value, const FFirebaseJsonTape::FValue& Json, FReadContext& Context);
+
+	void ReadStruct(const FStructPlan& Plan, void* Data, const FFirebaseJsonTape::FValue& Json, FReadContext& Context)
+	{
+		Json.ForEachField([&Plan, Data, &Context](FUtf8StringView Key, const FFirebaseJsonTape::FValue& Field)
+		{
+			const FMemberPlan* Member = Plan.FindMember(Key);
+			if (!Member)
+			{
+				return true;
+			}
+
+			if (Member->ArrayDim == 1)
+			{
+				if (!ReadValue(Member->Value, Member->Property->ContainerPtrToValuePtr<void>(Data), Field, Context))
+				{
+					Context.Mismatch(*Member);
+				}
+				return true;
+			}
+
+			if (!Field.IsArray())
+			{
+				if (!Field.IsNull())
+				{
+					Context.Mismatch(*Member);
+				}
+				return true;
+			}
+
+			int32 Index = 0;
+			Field.ForEachElement([Member, Data, &Index, &Context](const FFirebaseJsonTape::FValue& Element)
+			{
+				if (!ReadValue(Member->Value, Member->Property->ContainerPtrToValuePtr<void>(Data, Index), Element, Context))
+				{
+					Context.Mismatch(*Member);
+				}
+				return ++Index < Member->ArrayDim;
+			});
+			return true;
+		});
+	}
+
+	/** Array from a JSON array, or from the index-keyed object the database returns for sparse arrays */
+	bool ReadArray(const FValuePlan& Plan, void* Value, const FFirebaseJsonTape::FValue& Json, FReadContext& Context)
+	{
+		FScriptArrayHelper Helper(static_cast<const FArrayProperty*>(Plan.Property), Value);
+		bool bMatched = true;
+
+		if (Json.IsArray())
+		{
+			Helper.EmptyAndAddValues(Json.Num());
+			int32 Index = 0;
+			Json.ForEachElement([&Plan, &Helper, &Index, &Context, &bMatched](const FFirebaseJsonTape::FValue& Element)
+			{
+				bMatched &= ReadValue(*Plan.Inner, Helper.GetRawPtr(Index++), Element, Context);
+				return true;
+			});
+			return bMatched;
+		}
+
+		if (!Json.IsObject())
+		{
+			return false;
+		}
+
+		int32 MaxIndex = -1;
+		int32 NumFields = 0;
+		Json.ForEachField([&MaxIndex, &NumFields, &bMatched](FUtf8StringView Key, const FFirebaseJsonTape::FValue&)
+		{
+			int32 Index = 0;
+			if (!LexTryParseString(Index, *FirebaseJsonEscape::Utf8ToString(Key)) || Index < 0)
+			{
+				bMatched = false;
+				return false;
+			}
+			MaxIndex = FMath::Max(MaxIndex, Index);
+			++NumFields;
+			return true;
+		});
+
+		// The database only returns an array as an object while more than half of its slots are
+		// filled; anything sparser is a map with numeric keys, and sizing by its largest key would
+		// let one key allocate without bound
+		if (!bMatched || (NumFields > 0 && int64(MaxIndex) + 1 >= int64(NumFields) * 2))
+		{
+			return false;
+		}
+
+		Helper.EmptyAndAddValues(MaxIndex + 1);
+		Json.ForEachField([&Plan, &Helper, &Context, &bMatched](FUtf8StringView Key, const FFirebaseJsonTape::FValue& Element)
+		{
+			int32 Index = 0;
+			LexTryParseString(Index, *FirebaseJsonEscape::Utf8ToString(Key));
+			bMatched &= ReadValue(*Plan.Inner, Helper.GetRawPtr(Index), Element, Context);
+			return true;
+		});
+		return bMatched;
+	}
+
+	bool ReadValue(const FValuePlan& Plan, void* Value, const FFirebaseJsonTape::FValue& Json, FReadContext& Context)
+	{
+		// The database has no nulls, only missing values; keep whatever is there
+		if (Json.IsNull())
+		{
+			return true;
+		}
+
+		switch (Plan.Kind)
+		{
+		case EKind::Bool:
+			if (!Json.IsBool() && !Json.IsNumber())
+			{
+				return false;
+			}
+			static_cast<const FBoolProperty*>(Plan.Property)->SetPropertyValue(Value, Json.IsBool() ? Json.AsBool() : Json.AsNumber() != 0.0);
+			return true;
+
+		case EKind::SignedInt:
+		case EKind::UnsignedInt:
+			if (Json.IsNumber())
+			{
+				if (Plan.Kind == EKind::UnsignedInt)
+				{
+					Plan.Numeric->SetIntPropertyValue(Value, uint64(FMath::Clamp(FMath::RoundToDouble(Json.AsNumber()), 0.0, 18446744073709549568.0)));
+				}
+				else
+				{
+					Plan.Numeric->SetIntPropertyValue(Value, NumberToInt64(Json.AsNumber()));
+				}
+				return true;
+			}
+			// 64-bit ids are sometimes stored as strings to keep every digit
+			return Json.IsString() && KeyFromString(Plan, Value, Json.AsString());
+
+		case EKind::Float:
+			if (!Json.IsNumber())
+			{
+				return false;
+			}
+			*static_cast<float*>(Value) = float(Json.AsNumber());
+			return true;
+
+		case EKind::Double:
+			if (!Json.IsNumber())
+			{
+				return false;
+			}
+			*static_cast<double*>(Value) = Json.AsNumber();
+			return true;
+
+		case EKind::Enum:
+			if (Json.IsNumber())
+			{
+				Plan.Numeric->SetIntPropertyValue(Value, NumberToInt64(Json.AsNumber()));
+				return true;
+			}
+			return Json.IsString() && KeyFromString(Plan, Value, Json.AsString());
+
+		case EKind::String:
+			if (Json.IsString())
+			{
+				*static_cast<FString*>(Value) = Json.AsString();
+			}
+			else if (Json.IsNumber())
+			{
+				*static_cast<FString*>(Value) = FString::SanitizeFloat(Json.AsNumber(), 0);
+			}
+			else if (Json.IsBool())
+			{
+				*static_cast<FString*>(Value) = Json.AsBool() ? TEXT("true") : TEXT("false");
+			}
+			else
+			{
+				return false;
+			}
+			return true;
+
+		case EKind::Name:
+		case EKind::Text:
+			return Json.IsString() && KeyFromString(Plan, Value, Json.AsString());
+
+		case EKind::Struct:
+			if (!Json.IsObject())
+			{
+				return false;
+			}
+			if (const FStructPlan* StructPlan = ResolveStruct(Plan))
+			{
+				ReadStruct(*StructPlan, Value, Json, Context);
+			}
+			return true;
+
+		case EKind::Array:
+			return ReadArray(Plan, Value, Json, Context);
+
+		case EKind::Set:
+			{
+				if (!Json.IsArray())
+				{
+					return false;
+				}
+
+				FScriptSetHelper Helper(static_cast<const FSetProperty*>(Plan.Property), Value);
+				Helper.EmptyElements(Json.Num());
+				bool bMatched = true;
+				Json.ForEachElement([&Plan, &Helper, &Context, &bMatched](const FFirebaseJsonTape::FValue& Element)
+				{
+					const int32 Index = Helper.AddDefaultValue_Invalid_NeedsRehash();
+					bMatched &= ReadValue(*Plan.Inner, Helper.GetElementPtr(Index), Element, Context);
+					return true;
+				});
+				Helper.Rehash();
+				return bMatched;
+			}
+
+		case EKind::Map:
+			{
+				if (!Json.IsObject() && !Json.IsArray())
+				{
+					return false;
+				}
+
+				FScriptMapHelper Helper(static_cast<const FMapProperty*>(Plan.Property), Value);
+				Helper.EmptyValues(Json.Num());
+				bool bMatched = true;
+
+				auto AddPair = [&Plan, &Helper, &Context, &bMatched](const FString& Key, const FFirebaseJsonTape::FValue& Element)
+				{
+					const int32 Index = Helper.AddDefaultValue_Invalid_NeedsRehash();
+					bMatched &= KeyFromString(*Plan.Key, Helper.GetKeyPtr(Index), Key);
+					bMatched &= ReadValue(*Plan.Inner, Helper.GetValuePtr(Index), Element, Context);
+				};
+
+				if (Json.IsObject())
+				{
+					Json.ForEachField([&AddPair](FUtf8StringView Key, const FFirebaseJsonTape::FValue& Element)
+					{
+						AddPair(FirebaseJsonEscape::Utf8ToString(Key), Element);
+						return true;
+					});
+				}
+				else
+				{
+					// The database turns objects with keys 0..N into arrays, with nulls for the gaps
+					int32 Index = 0;
+					Json.ForEachElement([&AddPair, &Index](const FFirebaseJsonTape::FValue& Element)
+					{
+						if (!Element.IsNull())
+						{
+							AddPair(LexToString(Index), Element);
+						}
+						++Index;
+						return true;
+					});
+				}
+
+				Helper.Rehash();
+				return bMatched;
+			}
+
+		case EKind::ExportText:
+			return Json.IsString() && Plan.Property->ImportText_Direct(*Json.AsString(), Value, nullptr, PPF_None) != nullptr;
+		}
+
+		return false;
+	}
+}
+
+FString FFirebaseStructCodec::GetJsonKey(const FProperty* Property)
+{
+	return FJsonObjectConverter::StandardizeCase(Property->GetAuthoredName());
+}
+
+void FFirebaseStructCodec::Write(const UScriptStruct* Struct, const void* Data, FFirebaseJsonWriter& Writer)
+{
+	const FirebaseStructCodec::FStructPlan* Plan = Struct ? FirebaseStructCodec::FPlanCache::Get().FindOrCompile(Struct) : nullptr;
+	if (!Plan || !Data)
+	{
+		Writer.WriteNull();
+		return;
+	}
+
+	FirebaseStructCodec::WriteStruct(*Plan, Data, Writer);
+}
+
+int32 FFirebaseStructCodec::WriteChanges(const UScriptStruct* Struct, const void* OldData, const void* NewData,
+	FFirebaseJsonWriter& Writer, TArray<FString>* OutPaths)
+{
+	const FirebaseStructCodec::FStructPlan* Plan = Struct ? FirebaseStructCodec::FPlanCache::Get().FindOrCompile(Struct) : nullptr;
+	if (!Plan || !OldData || !NewData)
+	{
+		return 0;
+	}
+
+	FirebaseStructCodec::FPathBuffer Path;
+	return FirebaseStructCodec::WriteChangedMembers(*Plan, OldData, NewData, Path, Writer, OutPaths);
+}
+
+FFirebasePayload FFirebaseStructCodec::ToPayload(const UScriptStruct* Struct, const void* Data)
+{
+	LLM_SCOPE_BYTAG(Firebase_Json);
+	FFirebaseJsonWriter Writer(Struct ? Struct->GetStructureSize() * 2 + 64 : 16);
+	Write(Struct, Data, Writer);
+	return Writer.TakePayload();
+}
+
+bool FFirebaseStructCodec::Read(const UScriptStruct* Struct, void* Data, const FFirebaseJsonTape::FValue& Value, FString* OutError)
+{
+	if (!Struct || !Data)
+	{
+		if (OutError)
+		{
+			*OutError = TEXT("No struct to read into");
+		}
+		return false;
+	}
+
+	if (!Value.IsValid() || Value.IsNull())
+	{
+		// Nothing stored at the path
+		return true;
+	}
+
+	if (!Value.IsObject())
+	{
+		if (OutError)
+		{
+			*OutError = FString::Printf(TEXT("Expected a JSON object for %s"), *Struct->GetName());
+		}
+		return false;
+	}
+
+	FirebaseStructCodec::FReadContext Context;
+	if (const FirebaseStructCodec::FStructPlan* Plan = FirebaseStructCodec::FPlanCache::Get().FindOrCompile(Struct))
+	{
+		FirebaseStructCodec::ReadStruct(*Plan, Data, Value, Context);
+	}
+
+	if (!Context.Error.IsEmpty())
+	{
+		if (OutError)
+		{
+			*OutError = MoveTemp(Context.Error);
+		}
+		return false;
+	}
+	return true;
+}
+
+bool FFirebaseStructCodec::FromPayload(const UScriptStruct* Struct, void* Data, const FFirebasePayload& Payload, FString* OutError)
+{
+	LLM_SCOPE_BYTAG(Firebase_Json);
+	FFirebaseJsonTape Tape;
+	if (!Tape.Parse(Payload))
+	{
+		if (OutError)
+		{
+			*OutError = Tape.GetError();
+		}
+		return false;
+	}
+
+	return Read(Struct, Data, Tape.GetRoot(), OutError);
+}
@@ -0,0 +1,267 @@
+// Copyright. All Rights Reserved.
+
+#include "FirebaseSyncedStruct.h"
+#include "FirebaseLog.h"
+#include "FirebaseJsonWriter.h"
+#include "FirebaseStructCodec.h"
+
+namespace
+{
+	TSharedPtr<FStructOnScope> CopyStruct(const UScriptStruct* Struct, const void* Data)
+	{
+		TSharedPtr<FStructOnScope> Copy = MakeShared<FStructOnScope>(Struct);
+		Struct->CopyScriptStruct(Copy->GetStructMemory(), Data);
+		return Copy;
+	}
+
+	void CompleteAll(TArray<FOnFirebaseDatabaseComplete>& Callbacks, const FFirebaseDatabaseResult& Result)
+	{
+		TArray<FOnFirebaseDatabaseComplete> ToComplete = MoveTemp(Callbacks);
+		Callbacks.Reset();
+		for (const FOnFirebaseDatabaseComplete& Callback : ToComplete)
+		{
+			Callback.ExecuteIfBound(Result);
+		}
+	}
+}
+
+UFirebaseSyncedStruct* UFirebaseSyncedStruct::Create(const FString& Path, const UScriptStruct* Struct, const void* Data)
+{
+	if (!Struct || !Data)
+	{
+		UE_LOG(LogFirebase, Warning, TEXT("Firebase Synced Struct: No struct given for %s"), *Path);
+		return nullptr;
+	}
+
+	UFirebaseSyncedStruct* Handle = NewObject<UFirebaseSyncedStruct>();
+	Handle->Path = Path;
+	Handle->ValueStruct = Struct;
+	Handle->Current = CopyStruct(Struct, Data);
+	Handle->Shadow = CopyStruct(Struct, Data);
+	return Handle;
+}
+
+const UScriptStruct* UFirebaseSyncedStruct::GetStruct() const
+{
+	return ValueStruct;
+}
+
+void UFirebaseSyncedStruct::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
+{
+	Super::AddReferencedObjects(InThis, Collector);
+
+	// Objects held by the working value, the shadow and the value in flight
+	UFirebaseSyncedStruct* This = CastChecked<UFirebaseSyncedStruct>(InThis);
+	if (This->ValueStruct)
+	{
+		for (const TSharedPtr<FStructOnScope>* Value : { &This->Current, &This->Shadow, &This->InFlight })
+		{
+			if (Value->IsValid() && (*Value)->GetStructMemory())
+			{
+				Collector.AddPropertyReferences(This->ValueStruct, (*Value)->GetStructMemory(), This);
+			}
+		}
+	}
+}
+
+bool UFirebaseSyncedStruct::SetValue(const UScriptStruct* Struct, const void* Data)
+{
+	if (!IsValidHandle() || !Data || Struct != GetStruct())
+	{
+		UE_LOG(LogFirebase, Warning, TEXT("Firebase Synced Struct: %s holds %s, not %s"), *Path,
+			GetStruct() ? *GetStruct()->GetName() : TEXT("nothing"), Struct ? *Struct->GetName() : TEXT("nothing"));
+		return false;
+	}
+
+	Struct->CopyScriptStruct(Current->GetStructMemory(), Data);
+	return true;
+}
+
+bool UFirebaseSyncedStruct::HasChanges() const
+{
+	if (!IsValidHandle())
+	{
+		return false;
+	}
+	return !GetStruct()->CompareScriptStruct(Shadow->GetStructMemory(), Current->GetStructMemory(), PPF_None);
+}
+
+TArray<FString> UFirebaseSyncedStruct::GetChangedPaths() const
+{
+	TArray<FString> Paths;
+	if (IsValidHandle())
+	{
+		FFirebaseJsonWriter Writer;
+		Writer.BeginObject();
+		FFirebaseStructCodec::WriteChanges(GetStruct(), Shadow->GetStructMemory(), Current->GetStructMemory(), Writer, &Paths);
+	}
+	return Paths;
+}
+
+// === COMMIT ===
+
+void UFirebaseSyncedStruct::Commit(const FOnFirebaseDatabaseComplete& OnComplete)
+{
+	if (!IsValidHandle())
+	{
+		FFirebaseDatabaseResult Result;
+		Result.bSuccess = false;
+		Result.Path = Path;
+		Result.ErrorMessage = TEXT("Synced struct has no value");
+		OnComplete.ExecuteIfBound(Result);
+		return;
+	}
+
+	QueuedCallbacks.Add(OnComplete);
+
+	// Changes made while a write is in flight go out together once it completes
+	if (!bCommitInFlight)
+	{
+		SendCommit();
+	}
+}
+
+void UFirebaseSyncedStruct::SendCommit()
+{
+	InFlightCallbacks = MoveTemp(QueuedCallbacks);
+	QueuedCallbacks.Reset();
+
+	FFirebaseJsonWriter Writer(1024);
+	Writer.BeginObject();
+	const int32 NumChanged = FFirebaseStructCodec::WriteChanges(GetStruct(), Shadow->GetStructMemory(), Current->GetStructMemory(), Writer);
+	Writer.EndObject();
+
+	if (NumChanged == 0)
+	{
+		FFirebaseDatabaseResult Result;
+		Result.bSuccess = true;
+		Result.Path = Path;
+		CompleteAll(InFlightCallbacks, Result);
+		return;
+	}
+
+	UE_LOG(LogFirebase, Verbose, TEXT("Firebase Synced Struct: Committing %d changed paths under %s"), NumChanged, *Path);
+
+	InFlight = CopyStruct(GetStruct(), Current->GetStructMemory());
+	bCommitInFlight = true;
+
+	FOnFirebaseDatabaseComplete OnWritten;
+	OnWritten.BindUFunction(this, GET_FUNCTION_NAME_CHECKED(UFirebaseSyncedStruct, HandleCommitComplete));
+	UFirebaseDatabase::UpdateValuePayload(Path, Writer.TakePayload(), OnWritten);
+}
+
+void UFirebaseSyncedStruct::HandleCommitComplete(const FFirebaseDatabaseResult& Result)
+{
+	bCommitInFlight = false;
+
+	// Only a successful write moves the shadow; otherwise the next commit resends the same changes
+	if (Result.bSuccess && InFlight.IsValid() && InFlight->GetStruct() == Shadow->GetStruct())
+	{
+		GetStruct()->CopyScriptStruct(Shadow->GetStructMemory(), InFlight->GetStructMemory());
+	}
+	InFlight.Reset();
+
+	CompleteAll(InFlightCallbacks, Result);
+
+	if (QueuedCallbacks.Num() > 0 && !bCommitInFlight)
+	{
+		SendCommit();
+	}
+}
+
+// === REFRESH ===
+
+void UFirebaseSyncedStruct::Refresh(const FOnFirebaseDatabaseComplete& OnComplete)
+{
+	RefreshCallbacks.Add(OnComplete);
+	if (RefreshCallbacks.Num() > 1)
+	{
+		// A read is already on its way
+		return;
+	}
+
+	FOnFirebaseDatabaseComplete OnRead;
+	OnRead.BindUFunction(this, GET_FUNCTION_NAME_CHECKED(UFirebaseSyncedStruct, HandleRefreshComplete));
+	UFirebaseDatabase::GetValue(Path, OnRead);
+}
+
+void UFirebaseSyncedStruct::HandleRefreshComplete(const FFirebaseDatabaseResult& Result)
+{
+	FFirebaseDatabaseResult Outcome = Result;
+	if (Result.bSuccess && IsValidHandle())
+	{
+		// Start from defaults so members missing from the database are not left over
+		const UScriptStruct* Struct = GetStruct();
+		TSharedPtr<FStructOnScope> Loaded = MakeShared<FStructOnScope>(Struct);
+		Outcome.bSuccess = UFirebaseDatabase::GetResultStruct(Result, Struct, Loaded->GetStructMemory());
+		if (Outcome.bSuccess)
+		{
+			Struct->CopyScriptStruct(Current->GetStructMemory(), Loaded->GetStructMemory());
+			Shadow = Loaded;
+		}
+		else
+		{
+			Outcome.ErrorMessage = TEXT("Stored value does not match the struct");
+		}
+	}
+
+	CompleteAll(RefreshCallbacks, Outcome);
+}
+
+// === BLUEPRINT THUNKS ===
+
+DEFINE_FUNCTION(UFirebaseSyncedStruct::execK2_CreateSyncedStruct)
+{
+	P_GET_PROPERTY(FStrProperty, Path);
+
+	Stack.MostRecentProperty = nullptr;
+	Stack.MostRecentPropertyAddress = nullptr;
+	Stack.StepCompiledIn<FStructProperty>(nullptr);
+	const FStructProperty* ValueProperty = CastField<FStructProperty>(Stack.MostRecentProperty);
+	const void* ValueData = Stack.MostRecentPropertyAddress;
+
+	P_FINISH;
+
+	UFirebaseSyncedStruct* Handle = nullptr;
+	P_NATIVE_BEGIN;
+	Handle = Create(Path, ValueProperty ? ValueProperty->Struct : nullptr, ValueData);
+	P_NATIVE_END;
+	*(UFirebaseSyncedStruct**)RESULT_PARAM = Handle;
+}
+
+DEFINE_FUNCTION(UFirebaseSyncedStruct::execK2_SetValue)
+{
+	Stack.MostRecentProperty = nullptr;
+	Stack.MostRecentPropertyAddress = nullptr;
+	Stack.StepCompiledIn<FStructProperty>(nullptr);
+	const FStructProperty* ValueProperty = CastField<FStructProperty>(Stack.MostRecentProperty);
+	const void* ValueData = Stack.MostRecentPropertyAddress;
+
+	P_FINISH;
+
+	P_NATIVE_BEGIN;
+	P_THIS->SetValue(ValueProperty ? ValueProperty->Struct : nullptr, ValueData);
+	P_NATIVE_END;
+}
+
+DEFINE_FUNCTION(UFirebaseSyncedStruct::execK2_GetValue)
+{
+	Stack.MostRecentProperty = nullptr;
+	Stack.MostRecentPropertyAddress = nullptr;
+	Stack.StepCompiledIn<FStructProperty>(nullptr);
+	const FStructProperty* ValueProperty = CastField<FStructProperty>(Stack.MostRecentProperty);
+	void* ValueData = Stack.MostRecentPropertyAddress;
+
+	P_FINISH;
+
+	bool bSuccess = false;
+	P_NATIVE_BEGIN;
+	const UScriptStruct* Struct = P_THIS->GetStruct();
+	if (ValueProperty && ValueData && Struct && ValueProperty->Struct == Struct)
+	{
+		Struct->CopyScriptStruct(ValueData, P_THIS->Current->GetStructMemory());
+		bSuccess = true;
+	}
+	P_NATIVE_END;
+	*(bool*)RESULT_PARAM = bSuccess;
+}
@@ -0,0 +1,125 @@
+// Copyright. All Rights Reserved.
+
+#include "FirebaseTrace.h"
+
+#if FIREBASE_TRACE_ENABLED
+
+#include "FirebaseHttpTransport.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTLS.h"
+#include "ProfilingDebugging/MiscTrace.h"
+#include <atomic>
+
+UE_TRACE_CHANNEL_DEFINE(FirebaseChannel)
+
+UE_TRACE_EVENT_BEGIN(Firebase, RequestBegin)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint64, RequestId)
+	UE_TRACE_EVENT_FIELD(uint8, Origin)
+	UE_TRACE_EVENT_FIELD(int64, Bytes)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, Operation)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, Path)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(Firebase, RequestStage)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint64, RequestId)
+	UE_TRACE_EVENT_FIELD(uint8, Origin)
+	UE_TRACE_EVENT_FIELD(uint8, Stage)
+	UE_TRACE_EVENT_FIELD(int64, Bytes)
+	UE_TRACE_EVENT_FIELD(int32, Status)
+	UE_TRACE_EVENT_FIELD(uint32, ThreadId)
+UE_TRACE_EVENT_END()
+
+namespace FirebaseTrace
+{
+	static TAutoConsoleVariable<float> CVarSlowRequestMs(
+		TEXT("Firebase.Trace.SlowRequestMs"),
+		500.0f,
+		TEXT("REST responses slower than this (send to complete, in ms) add an Insights bookmark; 0 disables"));
+
+	static std::atomic<uint64> NextRequestId{ 1 };
+
+	static thread_local uint64 CurrentRequestId = 0;
+}
+
+uint64 FFirebaseTrace::NewRequestId()
+{
+	return FirebaseTrace::NextRequestId.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool FFirebaseTrace::IsEnabled()
+{
+	return UE_TRACE_CHANNELEXPR_IS_ENABLED(FirebaseChannel);
+}
+
+void FFirebaseTrace::Request(EFirebaseTraceOrigin Origin, uint64 RequestId, const TCHAR* Operation, FStringView Path, int64 Bytes)
+{
+	UE_TRACE_LOG(Firebase, RequestBegin, FirebaseChannel)
+		<< RequestBegin.Cycle(FPlatformTime::Cycles64())
+		<< RequestBegin.RequestId(RequestId)
+		<< RequestBegin.Origin((uint8)Origin)
+		<< RequestBegin.Bytes(Bytes)
+		<< RequestBegin.Operation(Operation, FCString::Strlen(Operation))
+		<< RequestBegin.Path(Path.GetData(), Path.Len());
+
+	Stage(Origin, RequestId, EFirebaseTraceStage::Enqueue, Bytes);
+}
+
+void FFirebaseTrace::Stage(EFirebaseTraceOrigin Origin, uint64 RequestId, EFirebaseTraceStage InStage, int64 Bytes, int32 Status, uint64 Cycle)
+{
+	UE_TRACE_LOG(Firebase, RequestStage, FirebaseChannel)
+		<< RequestStage.Cycle(Cycle != 0 ? Cycle : FPlatformTime::Cycles64())
+		<< RequestStage.RequestId(RequestId)
+		<< RequestStage.Origin((uint8)Origin)
+		<< RequestStage.Stage((uint8)InStage)
+		<< RequestStage.Bytes(Bytes)
+		<< RequestStage.Status(Status)
+		<< RequestStage.ThreadId(FPlatformTLS::GetCurrentThreadId());
+}
+
+void FFirebaseTrace::Response(uint64 RequestId, const FFirebaseHttpResponse& HttpResponse, const TCHAR* Operation, FStringView Path)
+{
+	if (!IsEnabled())
+	{
+		return;
+	}
+
+	const uint64 Now = FPlatformTime::Cycles64();
+	if (HttpResponse.bSucceeded && HttpResponse.TimeToFirstByteSeconds >= 0.0f && HttpResponse.ElapsedSeconds >= 0.0f)
+	{
+		// The transport only reports timings at the end; place the first byte where it happened
+		const double TransferSeconds = FMath::Max(double(HttpResponse.ElapsedSeconds - HttpResponse.TimeToFirstByteSeconds), 0.0);
+		const uint64 FirstByteCycle = Now - FMath::Min(uint64(TransferSeconds / FPlatformTime::GetSecondsPerCycle64()), Now);
+		Stage(EFirebaseTraceOrigin::Rest, RequestId, EFirebaseTraceStage::FirstByte, 0, HttpResponse.Code, FirstByteCycle);
+	}
+	Stage(EFirebaseTraceOrigin::Rest, RequestId, EFirebaseTraceStage::Complete, HttpResponse.Body.Num(), HttpResponse.Code, Now);
+
+	const float SlowMs = FirebaseTrace::CVarSlowRequestMs.GetValueOnAnyThread();
+	if (SlowMs > 0.0f && HttpResponse.ElapsedSeconds * 1000.0f > SlowMs)
+	{
+		TRACE_BOOKMARK(TEXT("Firebase slow %s %s (%.0f ms)"), Operation, *FString(Path), HttpResponse.ElapsedSeconds * 1000.0f);
+	}
+}
+
+uint64 FFirebaseTrace::GetCurrentRequestId()
+{
+	return FirebaseTrace::CurrentRequestId;
+}
+
+FFirebaseTraceCallbackScope::FFirebaseTraceCallbackScope(EFirebaseTraceOrigin InOrigin, uint64 InRequestId)
+	: Origin(InOrigin)
+	, RequestId(InRequestId)
+	, PreviousRequestId(FirebaseTrace::CurrentRequestId)
+{
+	FirebaseTrace::CurrentRequestId = RequestId;
+	FFirebaseTrace::Stage(Origin, RequestId, EFirebaseTraceStage::CallbackBegin);
+}
+
+FFirebaseTraceCallbackScope::~FFirebaseTraceCallbackScope()
+{
+	FFirebaseTrace::Stage(Origin, RequestId, EFirebaseTraceStage::CallbackEnd);
+	FirebaseTrace::CurrentRequestId = PreviousRequestId;
+}
+
+#endif // FIREBASE_TRACE_ENABLED
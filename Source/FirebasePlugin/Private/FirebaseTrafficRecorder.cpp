@@ -0,0 +1,280 @@
+// Copyright. All Rights Reserved.
+
+#include "FirebaseTrafficRecorder.h"
+#include "FirebaseLog.h"
+#include "FirebaseMemory.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace FirebaseTraffic
+{
+	static const TCHAR* OpNames[] =
+	{
+		TEXT("Get"), TEXT("Set"), TEXT("Update"), TEXT("Push"), TEXT("Delete"),
+		TEXT("Query"), TEXT("Transaction"), TEXT("Listen"), TEXT("StopListen"), TEXT("Auth")
+	};
+	static_assert(UE_ARRAY_COUNT(OpNames) == (int32)EFirebaseTrafficOp::Num, "Name every traffic op");
+
+	static FAutoConsoleCommand RecordCommand(
+		TEXT("Firebase.Traffic.Record"),
+		TEXT("Start recording database and auth calls for replay with the FirebaseTrafficReplay commandlet"),
+		FConsoleCommandDelegate::CreateLambda([]()
+		{
+			FFirebaseTrafficRecorder::Get().Start();
+		}));
+
+	static FAutoConsoleCommand StopCommand(
+		TEXT("Firebase.Traffic.Stop"),
+		TEXT("Stop recording and save it. Usage: Firebase.Traffic.Stop [File]"),
+		FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			FFirebaseTrafficRecorder::Get().Stop(Args.Num() > 0 ? Args[0] : FString());
+		}));
+}
+
+const TCHAR* LexToString(EFirebaseTrafficOp Op)
+{
+	return Op < EFirebaseTrafficOp::Num ? FirebaseTraffic::OpNames[(int32)Op] : TEXT("Unknown");
+}
+
+// === CAPTURE ===
+
+void FFirebaseTrafficCapture::Serialize(FArchive& Ar)
+{
+	uint32 Magic = FileMagic;
+	uint32 Version = FileVersion;
+	Ar << Magic << Version;
+	if (Ar.IsLoading() && (Magic != FileMagic || Version != FileVersion))
+	{
+		Ar.SetError();
+		return;
+	}
+
+	Ar << Paths;
+
+	int32 NumEvents = Events.Num();
+	Ar << NumEvents;
+	if (Ar.IsLoading())
+	{
+		// Every event takes at least four bytes, which bounds a corrupt count
+		if (NumEvents < 0 || NumEvents > Ar.TotalSize() / 4)
+		{
+			Ar.SetError();
+			return;
+		}
+		Events.SetNum(NumEvents);
+	}
+
+	uint64 PreviousMicros = 0;
+	for (FFirebaseTrafficEvent& Event : Events)
+	{
+		uint64 DeltaMicros = 0;
+		if (Ar.IsSaving())
+		{
+			DeltaMicros = FMath::Max(uint64(Event.Time * 1e6), PreviousMicros) - PreviousMicros;
+		}
+		Ar.SerializeIntPacked64(DeltaMicros);
+
+		uint8 Op = (uint8)Event.Op;
+		uint32 PathIndex = (uint32)Event.PathIndex;
+		Ar << Op;
+		Ar.SerializeIntPacked(PathIndex);
+		Ar.SerializeIntPacked(Event.Bytes);
+
+		PreviousMicros += DeltaMicros;
+		if (Ar.IsLoading())
+		{
+			if (Op >= (uint8)EFirebaseTrafficOp::Num || PathIndex >= (uint32)Paths.Num() || Ar.IsError())
+			{
+				Ar.SetError();
+				Events.Reset();
+				return;
+			}
+			Event.Time = double(PreviousMicros) * 1e-6;
+			Event.Op = EFirebaseTrafficOp(Op);
+			Event.PathIndex = int32(PathIndex);
+		}
+	}
+}
+
+bool FFirebaseTrafficCapture::SaveToFile(const FString& Filename) const
+{
+	TArray<uint8> Data;
+	FMemoryWriter Writer(Data);
+	const_cast<FFirebaseTrafficCapture*>(this)->Serialize(Writer);
+	return FFileHelper::SaveArrayToFile(Data, *Filename);
+}
+
+bool FFirebaseTrafficCapture::LoadFromFile(const FString& Filename)
+{
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *Filename))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(Data);
+	Serialize(Reader);
+	if (Reader.IsError())
+	{
+		Reset();
+		return false;
+	}
+	return true;
+}
+
+void FFirebaseTrafficCapture::Reset()
+{
+	Paths.Reset();
+	Events.Reset();
+}
+
+// === RECORDER ===
+
+FFirebaseTrafficRecorder& FFirebaseTrafficRecorder::Get()
+{
+	static FFirebaseTrafficRecorder Instance;
+	return Instance;
+}
+
+void FFirebaseTrafficRecorder::Start()
+{
+	FScopeLock ScopeLock(&Lock);
+	Capture.Reset();
+	PathIndices.Reset();
+	FFirebaseMemory::Get().Release(EFirebaseMemoryCategory::Diagnostics, AccountedBytes);
+	AccountedBytes = 0;
+	DroppedEvents = 0;
+	StartTime = FPlatformTime::Seconds();
+	bRecording.store(true, std::memory_order_relaxed);
+
+	UE_LOG(LogFirebase, Log, TEXT("Firebase Traffic: Recording"));
+}
+
+bool FFirebaseTrafficRecorder::Stop(const FString& Filename)
+{
+	FScopeLock ScopeLock(&Lock);
+	if (!bRecording.exchange(false, std::memory_order_relaxed))
+	{
+		return false;
+	}
+
+	const FString SavePath = Filename.IsEmpty() ? MakeDefaultFilename() : Filename;
+	if (!Capture.SaveToFile(SavePath))
+	{
+		UE_LOG(LogFirebase, Error, TEXT("Firebase Traffic: Could not save the recording to %s"), *SavePath);
+		return false;
+	}
+
+	UE_LOG(LogFirebase, Log, TEXT("Firebase Traffic: Saved %d calls over %.1fs to %s"),
+		Capture.Events.Num(), Capture.GetDuration(), *SavePath);
+	if (DroppedEvents > 0)
+	{
+		UE_LOG(LogFirebase, Warning, TEXT("Firebase Traffic: %d calls were not recorded because the memory budget was reached"), DroppedEvents);
+	}
+	return true;
+}
+
+void FFirebaseTrafficRecorder::Record(EFirebaseTrafficOp Op, FStringView Path, int64 Bytes)
+{
+	if (!IsRecording())
+	{
+		return;
+	}
+
+	FScopeLock ScopeLock(&Lock);
+	if (!IsRecording())
+	{
+		return;
+	}
+
+	LLM_SCOPE_BYTAG(Firebase_Diagnostics);
+
+	// A new path is kept twice, in Paths and as the PathIndices key
+	FString PathString(Path);
+	int32* PathIndex = PathIndices.Find(PathString);
+	const int64 EventBytes = sizeof(FFirebaseTrafficEvent)
+		+ (PathIndex ? 0 : 2 * (sizeof(FString) + PathString.GetAllocatedSize()) + sizeof(int32));
+	if (!FFirebaseMemory::Get().Reserve(EFirebaseMemoryCategory::Diagnostics, EventBytes))
+	{
+		++DroppedEvents;
+		return;
+	}
+	AccountedBytes += EventBytes;
+
+	if (!PathIndex)
+	{
+		PathIndex = &PathIndices.Add(PathString, Capture.Paths.Add(PathString));
+	}
+
+	FFirebaseTrafficEvent& Event = Capture.Events.AddDefaulted_GetRef();
+	Event.Time = FPlatformTime::Seconds() - StartTime;
+	Event.Op = Op;
+	Event.PathIndex = *PathIndex;
+	Event.Bytes = (uint32)FMath::Clamp<int64>(Bytes, 0, MAX_uint32);
+}
+
+void FFirebaseTrafficRecorder::RecordMethod(FStringView Method, FStringView Path, int64 Bytes, bool bHasQuery)
+{
+	if (!IsRecording())
+	{
+		return;
+	}
+
+	EFirebaseTrafficOp Op = bHasQuery ? EFirebaseTrafficOp::Query : EFirebaseTrafficOp::Get;
+	if (Method == TEXT("PUT"))
+	{
+		Op = EFirebaseTrafficOp::Set;
+	}
+	else if (Method == TEXT("PATCH"))
+	{
+		Op = EFirebaseTrafficOp::Update;
+	}
+	else if (Method == TEXT("POST"))
+	{
+		Op = EFirebaseTrafficOp::Push;
+	}
+	else if (Method == TEXT("DELETE"))
+	{
+		Op = EFirebaseTrafficOp::Delete;
+	}
+	Record(Op, Path, Bytes);
+}
+
+FFirebaseTrafficCapture FFirebaseTrafficRecorder::GetCapture() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return Capture;
+}
+
+FString FFirebaseTrafficRecorder::MakeDefaultFilename()
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Firebase"), TEXT("Traffic"),
+		FString::Printf(TEXT("Traffic-%s.fbtraffic"), *FDateTime::Now().ToString()));
+}
+
+void FFirebaseTrafficRecorder::StartFromCommandLine()
+{
+	// -FirebaseRecordTraffic or -FirebaseRecordTraffic=<file>
+	const TCHAR* CommandLine = FCommandLine::Get();
+	if (FParse::Value(CommandLine, TEXT("-FirebaseRecordTraffic="), CommandLineFilename) || FParse::Param(CommandLine, TEXT("FirebaseRecordTraffic")))
+	{
+		bStartedFromCommandLine = true;
+		Start();
+	}
+}
+
+void FFirebaseTrafficRecorder::StopFromCommandLine()
+{
+	if (bStartedFromCommandLine)
+	{
+		bStartedFromCommandLine = false;
+		Stop(CommandLineFilename);
+	}
+}
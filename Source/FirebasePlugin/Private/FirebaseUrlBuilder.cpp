@@ -0,0 +1,298 @@
+// Copyright. All Rights Reserved.
+
+#include "FirebaseUrlBuilder.h"
+#include "FirebaseStats.h"
+
+namespace FirebaseUrl
+{
+	static const TCHAR* HexDigits = TEXT("0123456789ABCDEF");
+
+	inline bool IsUnreserved(uint32 Character)
+	{
+		return (Character >= 'A' && Character <= 'Z') || (Character >= 'a' && Character <= 'z')
+			|| (Character >= '0' && Character <= '9')
+			|| Character == '-' || Character == '.' || Character == '_' || Character == '~';
+	}
+
+	/** Next code point of Text, combining UTF-16 surrogate pairs; lone surrogates become U+FFFD */
+	inline uint32 NextCodePoint(FStringView Text, int32& Index)
+	{
+		uint32 CodePoint = uint32(Text[Index++]);
+		if (CodePoint >= 0xD800 && CodePoint <= 0xDBFF && Index < Text.Len())
+		{
+			const uint32 Low = uint32(Text[Index]);
+			if (Low >= 0xDC00 && Low <= 0xDFFF)
+			{
+				++Index;
+				return 0x10000 + ((CodePoint - 0xD800) << 10) + (Low - 0xDC00);
+			}
+		}
+		return (CodePoint >= 0xD800 && CodePoint <= 0xDFFF) ? 0xFFFD : CodePoint;
+	}
+
+	inline int32 Utf8Length(uint32 CodePoint)
+	{
+		return CodePoint < 0x80 ? 1 : CodePoint < 0x800 ? 2 : CodePoint < 0x10000 ? 3 : 4;
+	}
+
+	inline void AppendByte(FString& Out, uint8 Byte)
+	{
+		Out.AppendChar(TEXT('%'));
+		Out.AppendChar(HexDigits[Byte >> 4]);
+		Out.AppendChar(HexDigits[Byte & 0xF]);
+	}
+
+	void AppendCodePoint(FString& Out, uint32 CodePoint)
+	{
+		if (IsUnreserved(CodePoint))
+		{
+			Out.AppendChar(TCHAR(CodePoint));
+		}
+		else if (CodePoint < 0x80)
+		{
+			AppendByte(Out, uint8(CodePoint));
+		}
+		else if (CodePoint < 0x800)
+		{
+			AppendByte(Out, uint8(0xC0 | (CodePoint >> 6)));
+			AppendByte(Out, uint8(0x80 | (CodePoint & 0x3F)));
+		}
+		else if (CodePoint < 0x10000)
+		{
+			AppendByte(Out, uint8(0xE0 | (CodePoint >> 12)));
+			AppendByte(Out, uint8(0x80 | ((CodePoint >> 6) & 0x3F)));
+			AppendByte(Out, uint8(0x80 | (CodePoint & 0x3F)));
+		}
+		else
+		{
+			AppendByte(Out, uint8(0xF0 | (CodePoint >> 18)));
+			AppendByte(Out, uint8(0x80 | ((CodePoint >> 12) & 0x3F)));
+			AppendByte(Out, uint8(0x80 | ((CodePoint >> 6) & 0x3F)));
+			AppendByte(Out, uint8(0x80 | (CodePoint & 0x3F)));
+		}
+	}
+
+	int32 CodePointLength(uint32 CodePoint)
+	{
+		return IsUnreserved(CodePoint) ? 1 : 3 * Utf8Length(CodePoint);
+	}
+
+	/** Characters that must be escaped inside a JSON string */
+	inline bool NeedsJsonEscape(uint32 CodePoint)
+	{
+		return CodePoint == '"' || CodePoint == '\\' || CodePoint < 0x20;
+	}
+
+	/** Encoded JSON string body: \" and \\ become %5C%22 and %5C%5C, control characters %5Cu00XX */
+	int32 JsonStringLength(FStringView Text)
+	{
+		int32 Length = 0;
+		for (int32 Index = 0; Index < Text.Len();)
+		{
+			const uint32 CodePoint = NextCodePoint(Text, Index);
+			if (!NeedsJsonEscape(CodePoint))
+			{
+				Length += CodePointLength(CodePoint);
+			}
+			else
+			{
+				Length += CodePoint < 0x20 ? 3 + 5 : 3 + 3;
+			}
+		}
+		return Length;
+	}
+
+	void AppendJsonString(FString& Out, FStringView Text)
+	{
+		for (int32 Index = 0; Index < Text.Len();)
+		{
+			const uint32 CodePoint = NextCodePoint(Text, Index);
+			if (!NeedsJsonEscape(CodePoint))
+			{
+				AppendCodePoint(Out, CodePoint);
+				continue;
+			}
+
+			AppendByte(Out, '\\');
+			if (CodePoint < 0x20)
+			{
+				Out.Append(TEXT("u00"));
+				Out.AppendChar(HexDigits[CodePoint >> 4]);
+				Out.AppendChar(HexDigits[CodePoint & 0xF]);
+			}
+			else
+			{
+				AppendByte(Out, uint8(CodePoint));
+			}
+		}
+	}
+}
+
+void FFirebaseUrlBuilder::Configure(const FString& DatabaseUrl, const FString& ApiKey)
+{
+	FStringView Base = DatabaseUrl;
+	DatabaseQuery.Reset();
+
+	int32 QueryStart = INDEX_NONE;
+	if (Base.FindChar(TEXT('?'), QueryStart))
+	{
+		DatabaseQuery = FString(Base.Mid(QueryStart + 1));
+		Base = Base.Left(QueryStart);
+	}
+	while (Base.EndsWith(TEXT('/')))
+	{
+		Base.LeftChopInline(1);
+	}
+	DatabaseBase = FString(Base);
+
+	AuthKeySuffix.Reset();
+	AuthKeySuffix.Reserve(5 + EncodedLength(ApiKey));
+	AuthKeySuffix.Append(TEXT("?key="));
+	AppendEncoded(AuthKeySuffix, ApiKey);
+}
+
+FString FFirebaseUrlBuilder::Database(FStringView Path, TArrayView<const FFirebaseUrlParam> Params, FStringView AuthToken) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_FirebaseBuildUrl);
+
+	// Size the URL exactly so it is allocated once
+	int32 Length = DatabaseBase.Len() + 1 + 5 + DatabaseQuery.Len() + 1;
+	for (int32 Index = 0; Index < Path.Len(); ++Index)
+	{
+		// Segments are encoded one by one; separators are kept as they are
+		int32 End = Index;
+		while (End < Path.Len() && Path[End] != TEXT('/'))
+		{
+			++End;
+		}
+		Length += EncodedLength(Path.Mid(Index, End - Index)) + 1;
+		Index = End;
+	}
+	for (const FFirebaseUrlParam& Param : Params)
+	{
+		Length += ParamLength(Param) + 1;
+	}
+	if (!AuthToken.IsEmpty())
+	{
+		Length += 6 + EncodedLength(AuthToken);
+	}
+
+	FString Url;
+	Url.Reserve(Length);
+	Url.Append(DatabaseBase);
+
+	bool bWroteSegment = false;
+	int32 Index = 0;
+	while (Index < Path.Len())
+	{
+		int32 End = Index;
+		while (End < Path.Len() && Path[End] != TEXT('/'))
+		{
+			++End;
+		}
+		if (End > Index)
+		{
+			Url.AppendChar(TEXT('/'));
+			AppendEncoded(Url, Path.Mid(Index, End - Index));
+			bWroteSegment = true;
+		}
+		Index = End + 1;
+	}
+	if (!bWroteSegment)
+	{
+		Url.AppendChar(TEXT('/'));
+	}
+	Url.Append(TEXT(".json"));
+
+	TCHAR Separator = TEXT('?');
+	if (!DatabaseQuery.IsEmpty())
+	{
+		Url.AppendChar(Separator);
+		Url.Append(DatabaseQuery);
+		Separator = TEXT('&');
+	}
+	for (const FFirebaseUrlParam& Param : Params)
+	{
+		if (!Param.Name.IsEmpty())
+		{
+			Url.AppendChar(Separator);
+			AppendParam(Url, Param);
+			Separator = TEXT('&');
+		}
+	}
+	if (!AuthToken.IsEmpty())
+	{
+		Url.AppendChar(Separator);
+		Url.Append(TEXT("auth="));
+		AppendEncoded(Url, AuthToken);
+	}
+	return Url;
+}
+
+void FFirebaseUrlBuilder::SetAuthEmulator(const FString& EmulatorUrl)
+{
+	AuthEmulatorPrefix = EmulatorUrl;
+	if (!AuthEmulatorPrefix.IsEmpty() && !AuthEmulatorPrefix.EndsWith(TEXT("/")))
+	{
+		AuthEmulatorPrefix.AppendChar(TEXT('/'));
+	}
+}
+
+FString FFirebaseUrlBuilder::Auth(FStringView Endpoint) const
+{
+	if (!AuthEmulatorPrefix.IsEmpty())
+	{
+		int32 SchemeEnd = INDEX_NONE;
+		if (Endpoint.FindChar(TEXT(':'), SchemeEnd) && Endpoint.Mid(SchemeEnd).StartsWith(TEXT("://")))
+		{
+			Endpoint.RightChopInline(SchemeEnd + 3);
+		}
+	}
+
+	FString Url;
+	Url.Reserve(AuthEmulatorPrefix.Len() + Endpoint.Len() + AuthKeySuffix.Len());
+	Url.Append(AuthEmulatorPrefix);
+	Url.Append(Endpoint.GetData(), Endpoint.Len());
+	Url.Append(AuthKeySuffix);
+	return Url;
+}
+
+void FFirebaseUrlBuilder::AppendEncoded(FString& Out, FStringView Text)
+{
+	for (int32 Index = 0; Index < Text.Len();)
+	{
+		FirebaseUrl::AppendCodePoint(Out, FirebaseUrl::NextCodePoint(Text, Index));
+	}
+}
+
+int32 FFirebaseUrlBuilder::EncodedLength(FStringView Text)
+{
+	int32 Length = 0;
+	for (int32 Index = 0; Index < Text.Len();)
+	{
+		Length += FirebaseUrl::CodePointLength(FirebaseUrl::NextCodePoint(Text, Index));
+	}
+	return Length;
+}
+
+int32 FFirebaseUrlBuilder::ParamLength(const FFirebaseUrlParam& Param)
+{
+	const int32 ValueLength = Param.bJsonString ? 3 + FirebaseUrl::JsonStringLength(Param.Value) + 3 : EncodedLength(Param.Value);
+	return EncodedLength(Param.Name) + 1 + ValueLength;
+}
+
+void FFirebaseUrlBuilder::AppendParam(FString& Out, const FFirebaseUrlParam& Param)
+{
+	AppendEncoded(Out, Param.Name);
+	Out.AppendChar(TEXT('='));
+	if (Param.bJsonString)
+	{
+		FirebaseUrl::AppendByte(Out, '"');
+		FirebaseUrl::AppendJsonString(Out, Param.Value);
+		FirebaseUrl::AppendByte(Out, '"');
+	}
+	else
+	{
+		AppendEncoded(Out, Param.Value);
+	}
+}
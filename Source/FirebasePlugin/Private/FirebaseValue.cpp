@@ -0,0 +1,607 @@
+// Copyright. All Rights Reserved.
+
+#include "FirebaseValue.h"
+#include "FirebaseMemory.h"
+#include "FirebaseJsonWriter.h"
+#include "FirebaseJsonEscape.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+/**
+ * Flat, immutable node storage shared by every FFirebaseValue into one
+ * document. A container's children occupy a contiguous range of Children
+ * (sorted by key for maps), so the whole tree costs a handful of arrays
+ * rather than an allocation per node.
+ */
+class FFirebaseValueTree
+{
+public:
+	struct FNode
+	{
+		EFirebaseValueType Type = EFirebaseValueType::Null;
+
+		// Map/array: number of children
+		int32 Count = 0;
+
+		union
+		{
+			bool Bool;
+			int64 Int;
+			double Double;
+
+			// String: index into Strings; map/array: first index into Children
+			int32 First;
+		};
+
+		FNode()
+			: Int(0)
+		{
+		}
+	};
+
+	TArray<FNode> Nodes;
+	TArray<FString> Strings;
+	TArray<int32> Children;
+
+	// String index of each child's key (INDEX_NONE for array elements)
+	TArray<int32> ChildKeys;
+
+	int32 AddNode(EFirebaseValueType Type)
+	{
+		FNode& Node = Nodes.AddDefaulted_GetRef();
+		Node.Type = Type;
+		return Nodes.Num() - 1;
+	}
+
+	void SetNumber(int32 NodeIndex, double Number)
+	{
+		// Whole numbers that a double represents exactly are integers
+		FNode& Node = Nodes[NodeIndex];
+		if (FMath::Abs(Number) <= 9007199254740992.0 && FMath::RoundToDouble(Number) == Number)
+		{
+			Node.Type = EFirebaseValueType::Int;
+			Node.Int = int64(Number);
+		}
+		else
+		{
+			Node.Type = EFirebaseValueType::Double;
+			Node.Double = Number;
+		}
+	}
+
+	/** Reserve the child range of a container before its children are built */
+	int32 ReserveChildren(int32 NodeIndex, int32 Count)
+	{
+		const int32 First = Children.AddUninitialized(Count);
+		ChildKeys.AddUninitialized(Count);
+		Nodes[NodeIndex].First = First;
+		Nodes[NodeIndex].Count = Count;
+		return First;
+	}
+
+	/** Sort a map's children by key so Find can binary search */
+	void SortMap(int32 NodeIndex)
+	{
+		const FNode& Node = Nodes[NodeIndex];
+		TArray<TPair<int32, int32>, TInlineAllocator<32>> Entries;
+		Entries.Reserve(Node.Count);
+		for (int32 Index = 0; Index < Node.Count; ++Index)
+		{
+			Entries.Emplace(ChildKeys[Node.First + Index], Children[Node.First + Index]);
+		}
+
+		Entries.StableSort([this](const TPair<int32, int32>& A, const TPair<int32, int32>& B)
+		{
+			return Strings[A.Key].Compare(Strings[B.Key], ESearchCase::CaseSensitive) < 0;
+		});
+
+		for (int32 Index = 0; Index < Node.Count; ++Index)
+		{
+			ChildKeys[Node.First + Index] = Entries[Index].Key;
+			Children[Node.First + Index] = Entries[Index].Value;
+		}
+	}
+
+	int32 BuildFromTape(const FFirebaseJsonTape::FValue& Value)
+	{
+		switch (Value.GetType())
+		{
+		case EFirebaseJsonTapeType::True:
+		case EFirebaseJsonTapeType::False:
+			{
+				const int32 NodeIndex = AddNode(EFirebaseValueType::Bool);
+				Nodes[NodeIndex].Bool = Value.AsBool();
+				return NodeIndex;
+			}
+
+		case EFirebaseJsonTapeType::Number:
+			{
+				const int32 NodeIndex = AddNode(EFirebaseValueType::Double);
+				SetNumber(NodeIndex, Value.AsNumber());
+				return NodeIndex;
+			}
+
+		case EFirebaseJsonTapeType::String:
+			{
+				const int32 NodeIndex = AddNode(EFirebaseValueType::String);
+				Nodes[NodeIndex].First = Strings.Add(FirebaseJsonEscape::Utf8ToString(Value.AsUtf8()));
+				return NodeIndex;
+			}
+
+		case EFirebaseJsonTapeType::Array:
+			{
+				const int32 NodeIndex = AddNode(EFirebaseValueType::Array);
+				int32 Slot = ReserveChildren(NodeIndex, Value.Num());
+				Value.ForEachElement([this, &Slot](const FFirebaseJsonTape::FValue& Element)
+				{
+					const int32 Child = BuildFromTape(Element);
+					ChildKeys[Slot] = INDEX_NONE;
+					Children[Slot++] = Child;
+					return true;
+				});
+				return NodeIndex;
+			}
+
+		case EFirebaseJsonTapeType::Object:
+			{
+				const int32 NodeIndex = AddNode(EFirebaseValueType::Map);
+				int32 Slot = ReserveChildren(NodeIndex, Value.Num());
+				Value.ForEachField([this, &Slot](FUtf8StringView Key, const FFirebaseJsonTape::FValue& Field)
+				{
+					const int32 KeyIndex = Strings.Add(FirebaseJsonEscape::Utf8ToString(Key));
+					const int32 Child = BuildFromTape(Field);
+					ChildKeys[Slot] = KeyIndex;
+					Children[Slot++] = Child;
+					return true;
+				});
+				SortMap(NodeIndex);
+				return NodeIndex;
+			}
+
+		default:
+			return AddNode(EFirebaseValueType::Null);
+		}
+	}
+
+	int32 BuildFromJsonValue(const TSharedPtr<FJsonValue>& Value)
+	{
+		if (!Value.IsValid())
+		{
+			return AddNode(EFirebaseValueType::Null);
+		}
+
+		switch (Value->Type)
+		{
+		case EJson::Boolean:
+			{
+				const int32 NodeIndex = AddNode(EFirebaseValueType::Bool);
+				Nodes[NodeIndex].Bool = Value->AsBool();
+				return NodeIndex;
+			}
+
+		case EJson::Number:
+			{
+				const int32 NodeIndex = AddNode(EFirebaseValueType::Double);
+				SetNumber(NodeIndex, Value->AsNumber());
+				return NodeIndex;
+			}
+
+		case EJson::String:
+			{
+				const int32 NodeIndex = AddNode(EFirebaseValueType::String);
+				Nodes[NodeIndex].First = Strings.Add(Value->AsString());
+				return NodeIndex;
+			}
+
+		case EJson::Array:
+			{
+				const TArray<TSharedPtr<FJsonValue>>& Elements = Value->AsArray();
+				const int32 NodeIndex = AddNode(EFirebaseValueType::Array);
+				const int32 First = ReserveChildren(NodeIndex, Elements.Num());
+				for (int32 Index = 0; Index < Elements.Num(); ++Index)
+				{
+					const int32 Child = BuildFromJsonValue(Elements[Index]);
+					ChildKeys[First + Index] = INDEX_NONE;
+					Children[First + Index] = Child;
+				}
+				return NodeIndex;
+			}
+
+		case EJson::Object:
+			{
+				const TSharedPtr<FJsonObject> Object = Value->AsObject();
+				const int32 NodeIndex = AddNode(EFirebaseValueType::Map);
+				int32 Slot = ReserveChildren(NodeIndex, Object->Values.Num());
+				for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : Object->Values)
+				{
+					const int32 KeyIndex = Strings.Add(Pair.Key);
+					const int32 Child = BuildFromJsonValue(Pair.Value);
+					ChildKeys[Slot] = KeyIndex;
+					Children[Slot++] = Child;
+				}
+				SortMap(NodeIndex);
+				return NodeIndex;
+			}
+
+		default:
+			return AddNode(EFirebaseValueType::Null);
+		}
+	}
+};
+
+// === CONSTRUCTION ===
+
+FFirebaseValue FFirebaseValue::FromTape(const FFirebaseJsonTape::FValue& Value)
+{
+	if (!Value.IsValid())
+	{
+		return FFirebaseValue();
+	}
+
+	TSharedRef<FFirebaseValueTree, ESPMode::ThreadSafe> Tree = MakeShared<FFirebaseValueTree, ESPMode::ThreadSafe>();
+	const int32 Root = Tree->BuildFromTape(Value);
+	return FFirebaseValue(Tree, Root);
+}
+
+FFirebaseValue FFirebaseValue::FromJsonValue(const TSharedPtr<FJsonValue>& Value)
+{
+	LLM_SCOPE_BYTAG(Firebase_Json);
+	if (!Value.IsValid())
+	{
+		return FFirebaseValue();
+	}
+
+	TSharedRef<FFirebaseValueTree, ESPMode::ThreadSafe> Tree = MakeShared<FFirebaseValueTree, ESPMode::ThreadSafe>();
+	const int32 Root = Tree->BuildFromJsonValue(Value);
+	return FFirebaseValue(Tree, Root);
+}
+
+FFirebaseValue FFirebaseValue::FromPayload(const FFirebasePayload& Payload)
+{
+	LLM_SCOPE_BYTAG(Firebase_Json);
+	FFirebaseJsonTape Tape;
+	return Tape.Parse(Payload) ? FromTape(Tape.GetRoot()) : FFirebaseValue();
+}
+
+FFirebaseValue FFirebaseValue::FromJsonString(const FString& Json)
+{
+	return FromPayload(FFirebasePayload::FromString(Json));
+}
+
+// === ACCESSORS ===
+
+EFirebaseValueType FFirebaseValue::GetType() const
+{
+	return Tree.IsValid() ? Tree->Nodes[Node].Type : EFirebaseValueType::Null;
+}
+
+bool FFirebaseValue::AsBool() const
+{
+	if (!Tree.IsValid())
+	{
+		return false;
+	}
+
+	const FFirebaseValueTree::FNode& Data = Tree->Nodes[Node];
+	switch (Data.Type)
+	{
+	case EFirebaseValueType::Bool:
+		return Data.Bool;
+	case EFirebaseValueType::Int:
+		return Data.Int != 0;
+	case EFirebaseValueType::Double:
+		return Data.Double != 0.0;
+	case EFirebaseValueType::String:
+		return Tree->Strings[Data.First].Equals(TEXT("true"), ESearchCase::IgnoreCase);
+	default:
+		return false;
+	}
+}
+
+int64 FFirebaseValue::AsInt() const
+{
+	if (!Tree.IsValid())
+	{
+		return 0;
+	}
+
+	const FFirebaseValueTree::FNode& Data = Tree->Nodes[Node];
+	switch (Data.Type)
+	{
+	case EFirebaseValueType::Bool:
+		return Data.Bool ? 1 : 0;
+	case EFirebaseValueType::Int:
+		return Data.Int;
+	case EFirebaseValueType::Double:
+		return int64(FMath::Clamp(FMath::RoundToDouble(Data.Double), -9223372036854775808.0, 9223372036854774784.0));
+	case EFirebaseValueType::String:
+		{
+			int64 Number = 0;
+			LexFromString(Number, *Tree->Strings[Data.First]);
+			return Number;
+		}
+	default:
+		return 0;
+	}
+}
+
+double FFirebaseValue::AsDouble() const
+{
+	if (!Tree.IsValid())
+	{
+		return 0.0;
+	}
+
+	const FFirebaseValueTree::FNode& Data = Tree->Nodes[Node];
+	switch (Data.Type)
+	{
+	case EFirebaseValueType::Bool:
+		return Data.Bool ? 1.0 : 0.0;
+	case EFirebaseValueType::Int:
+		return double(Data.Int);
+	case EFirebaseValueType::Double:
+		return Data.Double;
+	case EFirebaseValueType::String:
+		{
+			double Number = 0.0;
+			LexFromString(Number, *Tree->Strings[Data.First]);
+			return Number;
+		}
+	default:
+		return 0.0;
+	}
+}
+
+FStringView FFirebaseValue::AsStringView() const
+{
+	if (GetType() != EFirebaseValueType::String)
+	{
+		return FStringView();
+	}
+	return Tree->Strings[Tree->Nodes[Node].First];
+}
+
+FString FFirebaseValue::AsString() const
+{
+	switch (GetType())
+	{
+	case EFirebaseValueType::Null:
+		return FString();
+	case EFirebaseValueType::Bool:
+		return AsBool() ? TEXT("true") : TEXT("false");
+	case EFirebaseValueType::Int:
+		return LexToString(Tree->Nodes[Node].Int);
+	case EFirebaseValueType::String:
+		return FString(AsStringView());
+	default:
+		// Doubles use the writer's shortest round-trip form; containers are JSON
+		return ToJson();
+	}
+}
+
+int32 FFirebaseValue::Num() const
+{
+	return IsMap() || IsArray() ? Tree->Nodes[Node].Count : 0;
+}
+
+FFirebaseValue FFirebaseValue::Find(FStringView Key) const
+{
+	if (!IsMap())
+	{
+		return FFirebaseValue();
+	}
+
+	const FFirebaseValueTree::FNode& Data = Tree->Nodes[Node];
+	int32 Low = 0;
+	int32 High = Data.Count - 1;
+	while (Low <= High)
+	{
+		const int32 Middle = (Low + High) / 2;
+		const int32 Order = FStringView(Tree->Strings[Tree->ChildKeys[Data.First + Middle]]).Compare(Key, ESearchCase::CaseSensitive);
+		if (Order == 0)
+		{
+			return FFirebaseValue(Tree, Tree->Children[Data.First + Middle]);
+		}
+		if (Order < 0)
+		{
+			Low = Middle + 1;
+		}
+		else
+		{
+			High = Middle - 1;
+		}
+	}
+	return FFirebaseValue();
+}
+
+FFirebaseValue FFirebaseValue::GetElement(int32 Index) const
+{
+	if (Index < 0 || Index >= Num())
+	{
+		return FFirebaseValue();
+	}
+	return FFirebaseValue(Tree, Tree->Children[Tree->Nodes[Node].First + Index]);
+}
+
+FStringView FFirebaseValue::GetKey(int32 Index) const
+{
+	if (!IsMap() || Index < 0 || Index >= Num())
+	{
+		return FStringView();
+	}
+	return Tree->Strings[Tree->ChildKeys[Tree->Nodes[Node].First + Index]];
+}
+
+FFirebaseValue FFirebaseValue::FindPath(FStringView Path) const
+{
+	FFirebaseValue Current = *this;
+	while (!Path.IsEmpty() && !Current.IsNull())
+	{
+		int32 Slash = INDEX_NONE;
+		const FStringView Segment = Path.FindChar(TEXT('/'), Slash) ? Path.Left(Slash) : Path;
+		Path = Slash != INDEX_NONE ? Path.Mid(Slash + 1) : FStringView();
+		if (Segment.IsEmpty())
+		{
+			continue;
+		}
+
+		if (Current.IsArray())
+		{
+			int32 Index = INDEX_NONE;
+			if (!LexTryParseString(Index, *FString(Segment)))
+			{
+				return FFirebaseValue();
+			}
+			Current = Current.GetElement(Index);
+		}
+		else
+		{
+			Current = Current.Find(Segment);
+		}
+	}
+	return Current;
+}
+
+// === JSON ===
+
+void FFirebaseValue::Write(FFirebaseJsonWriter& Writer) const
+{
+	if (!Tree.IsValid())
+	{
+		Writer.WriteNull();
+		return;
+	}
+
+	const FFirebaseValueTree::FNode& Data = Tree->Nodes[Node];
+	switch (Data.Type)
+	{
+	case EFirebaseValueType::Bool:
+		Writer.WriteBool(Data.Bool);
+		break;
+	case EFirebaseValueType::Int:
+		Writer.WriteInt(Data.Int);
+		break;
+	case EFirebaseValueType::Double:
+		Writer.WriteDouble(Data.Double);
+		break;
+	case EFirebaseValueType::String:
+		Writer.WriteString(FStringView(Tree->Strings[Data.First]));
+		break;
+	case EFirebaseValueType::Array:
+		Writer.BeginArray();
+		for (int32 Index = 0; Index < Data.Count; ++Index)
+		{
+			GetElement(Index).Write(Writer);
+		}
+		Writer.EndArray();
+		break;
+	case EFirebaseValueType::Map:
+		Writer.BeginObject();
+		for (int32 Index = 0; Index < Data.Count; ++Index)
+		{
+			Writer.WriteKey(GetKey(Index));
+			GetElement(Index).Write(Writer);
+		}
+		Writer.EndObject();
+		break;
+	default:
+		Writer.WriteNull();
+		break;
+	}
+}
+
+FString FFirebaseValue::ToJson() const
+{
+	FFirebaseJsonWriter Writer;
+	Write(Writer);
+	return Writer.ToString();
+}
+
+// === BLUEPRINT LIBRARY ===
+
+FFirebaseValue UFirebaseValueLibrary::ParseValue(const FString& Json)
+{
+	return FFirebaseValue::FromJsonString(Json);
+}
+
+EFirebaseValueType UFirebaseValueLibrary::GetValueType(const FFirebaseValue& Value)
+{
+	return Value.GetType();
+}
+
+bool UFirebaseValueLibrary::IsNull(const FFirebaseValue& Value)
+{
+	return Value.IsNull();
+}
+
+bool UFirebaseValueLibrary::AsBool(const FFirebaseValue& Value)
+{
+	return Value.AsBool();
+}
+
+int64 UFirebaseValueLibrary::AsInt(const FFirebaseValue& Value)
+{
+	return Value.AsInt();
+}
+
+double UFirebaseValueLibrary::AsFloat(const FFirebaseValue& Value)
+{
+	return Value.AsDouble();
+}
+
+FString UFirebaseValueLibrary::AsString(const FFirebaseValue& Value)
+{
+	return Value.AsString();
+}
+
+bool UFirebaseValueLibrary::GetField(const FFirebaseValue& Value, const FString& Key, FFirebaseValue& OutValue)
+{
+	OutValue = Value.Find(Key);
+	return !OutValue.IsNull();
+}
+
+bool UFirebaseValueLibrary::GetAtPath(const FFirebaseValue& Value, const FString& Path, FFirebaseValue& OutValue)
+{
+	OutValue = Value.FindPath(Path);
+	return !OutValue.IsNull();
+}
+
+int32 UFirebaseValueLibrary::Num(const FFirebaseValue& Value)
+{
+	return Value.Num();
+}
+
+FFirebaseValue UFirebaseValueLibrary::GetElement(const FFirebaseValue& Value, int32 Index)
+{
+	return Value.GetElement(Index);
+}
+
+TArray<FFirebaseValue> UFirebaseValueLibrary::GetElements(const FFirebaseValue& Value)
+{
+	TArray<FFirebaseValue> Elements;
+	Elements.Reserve(Value.Num());
+	for (int32 Index = 0; Index < Value.Num(); ++Index)
+	{
+		Elements.Add(Value.GetElement(Index));
+	}
+	return Elements;
+}
+
+TArray<FString> UFirebaseValueLibrary::GetKeys(const FFirebaseValue& Value)
+{
+	TArray<FString> Keys;
+	if (Value.IsMap())
+	{
+		Keys.Reserve(Value.Num());
+		for (int32 Index = 0; Index < Value.Num(); ++Index)
+		{
+			Keys.Emplace(Value.GetKey(Index));
+		}
+	}
+	return Keys;
+}
+
+FString UFirebaseValueLibrary::ToJsonString(const FFirebaseValue& Value)
+{
+	return Value.ToJson();
+}
@@ -0,0 +1,149 @@
+// Copyright. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "FirebasePendingOperations.h"
+
+/**
+ * The pending-operation table behind UFirebaseDatabase and UFirebaseAuth.
+ *
+ * Android SDK results arrive as (OperationId, result) pairs and the timeout
+ * tick collects whatever is overdue; these tests drive the same Add, Complete
+ * and CollectExpired calls with explicit clock values, so they run on any
+ * platform and do not depend on wall-clock time.
+ * Run with: Automation RunTests Firebase.PendingOperations
+ */
+namespace FirebasePendingOperationsTest
+{
+	/** Stands in for a pending callback: the path it was registered for */
+	struct FOperation
+	{
+		FString Path;
+	};
+
+	using FTable = TFirebasePendingOperations<FOperation>;
+
+	static FOperation MakeOperation(const TCHAR* Path)
+	{
+		return FOperation{ Path };
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFirebasePendingOperationsCompleteTest, "Firebase.PendingOperations.CompletesMatchingId",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FFirebasePendingOperationsCompleteTest::RunTest(const FString& Parameters)
+{
+	using namespace FirebasePendingOperationsTest;
+
+	FTable Table;
+	Table.Configure(16, 30.0);
+
+	const int64 IdA = Table.Add(MakeOperation(TEXT("players/a")), 0.0);
+	const int64 IdB = Table.Add(MakeOperation(TEXT("players/b")), 0.0);
+	const int64 IdC = Table.Add(MakeOperation(TEXT("players/c")), 0.0);
+	TestTrue(TEXT("Operations get distinct valid ids"), IdA != FTable::InvalidId && IdB != FTable::InvalidId && IdC != FTable::InvalidId
+		&& IdA != IdB && IdB != IdC && IdA != IdC);
+
+	FOperation Completed;
+	TestTrue(TEXT("Result for B completes B"), Table.Complete(IdB, Completed));
+	TestEqual(TEXT("Completed operation is B"), Completed.Path, FString(TEXT("players/b")));
+	TestEqual(TEXT("A and C are still pending"), Table.Num(), 2);
+
+	TestFalse(TEXT("A second result for B is ignored"), Table.Complete(IdB, Completed));
+	TestFalse(TEXT("A result for an unknown id is ignored"), Table.Complete(IdC + 100, Completed));
+	TestEqual(TEXT("Ignored results leave the table unchanged"), Table.Num(), 2);
+
+	TestTrue(TEXT("Result for A completes A"), Table.Complete(IdA, Completed));
+	TestEqual(TEXT("Completed operation is A"), Completed.Path, FString(TEXT("players/a")));
+	TestTrue(TEXT("Result for C completes C"), Table.Complete(IdC, Completed));
+	TestEqual(TEXT("Completed operation is C"), Completed.Path, FString(TEXT("players/c")));
+	TestEqual(TEXT("Table is empty"), Table.Num(), 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFirebasePendingOperationsTimeoutTest, "Firebase.PendingOperations.ExpiresOnTick",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FFirebasePendingOperationsTimeoutTest::RunTest(const FString& Parameters)
+{
+	using namespace FirebasePendingOperationsTest;
+
+	FTable Table;
+	Table.Configure(16, 10.0);
+
+	const int64 Short = Table.Add(MakeOperation(TEXT("short")), 100.0, 1.0);
+	const int64 Default = Table.Add(MakeOperation(TEXT("default")), 100.0);
+	const int64 Never = Table.Add(MakeOperation(TEXT("never")), 100.0, 0.0);
+	const int64 Answered = Table.Add(MakeOperation(TEXT("answered")), 100.0, 1.0);
+
+	FOperation Completed;
+	TestTrue(TEXT("Answered operation completes before its deadline"), Table.Complete(Answered, Completed));
+
+	TArray<TPair<int64, FOperation>> Expired;
+	Table.CollectExpired(100.5, Expired);
+	TestEqual(TEXT("Nothing expires before its deadline"), Expired.Num(), 0);
+
+	Table.CollectExpired(101.0, Expired);
+	TestEqual(TEXT("Only the short operation expires at its deadline"), Expired.Num(), 1);
+	if (Expired.Num() == 1)
+	{
+		TestEqual(TEXT("Expired id"), Expired[0].Key, Short);
+		TestEqual(TEXT("Expired operation"), Expired[0].Value.Path, FString(TEXT("short")));
+	}
+	TestFalse(TEXT("A late result for an expired operation is ignored"), Table.Complete(Short, Completed));
+
+	Expired.Reset();
+	Table.CollectExpired(1000.0, Expired);
+	TestEqual(TEXT("The default timeout applies"), Expired.Num(), 1);
+	if (Expired.Num() == 1)
+	{
+		TestEqual(TEXT("Expired id"), Expired[0].Key, Default);
+	}
+
+	TestEqual(TEXT("An operation without a timeout stays pending"), Table.Num(), 1);
+	TestTrue(TEXT("It still completes when its result arrives"), Table.Complete(Never, Completed));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFirebasePendingOperationsLimitTest, "Firebase.PendingOperations.RefusesBeyondMax",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FFirebasePendingOperationsLimitTest::RunTest(const FString& Parameters)
+{
+	using namespace FirebasePendingOperationsTest;
+
+	constexpr int32 MaxPendingOperations = 4;
+
+	FTable Table;
+	Table.Configure(MaxPendingOperations, 30.0);
+
+	TArray<int64> Ids;
+	for (int32 Index = 0; Index < MaxPendingOperations; ++Index)
+	{
+		Ids.Add(Table.Add(MakeOperation(TEXT("players")), 0.0));
+	}
+	TestFalse(TEXT("Operations up to the limit are accepted"), Ids.Contains(FTable::InvalidId));
+	TestTrue(TEXT("Table reports full"), Table.IsFull());
+
+	TestEqual(TEXT("Registration beyond the limit is refused"), Table.Add(MakeOperation(TEXT("players")), 0.0), FTable::InvalidId);
+	TestEqual(TEXT("Refused registration is not tracked"), Table.Num(), MaxPendingOperations);
+
+	FOperation Completed;
+	Table.Complete(Ids[0], Completed);
+	TestNotEqual(TEXT("Completing an operation frees a slot"), Table.Add(MakeOperation(TEXT("players")), 0.0), FTable::InvalidId);
+
+	TArray<TPair<int64, FOperation>> Removed;
+	Table.Reset(Removed);
+	TestEqual(TEXT("Reset hands back every pending operation"), Removed.Num(), MaxPendingOperations);
+	TestEqual(TEXT("Table is empty after reset"), Table.Num(), 0);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
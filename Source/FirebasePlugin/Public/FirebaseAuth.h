@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "FirebaseRestAPI.h"
+#include "FirebasePendingOperations.h"
 #include "FirebaseAuth.generated.h"
 
 /**
@@ -210,10 +211,20 @@ public:
 	// === INTERNAL METHODS ===
 
 	/** Called from Java when auth operation completes */
-	static void OnAuthResultReceived(bool bSuccess, const FString& UserId, 
+	static void OnAuthResultReceived(int64 OperationId, bool bSuccess, const FString& UserId, 
 		const FString& Email, const FString& DisplayName, 
 		const FString& ErrorMessage, const FString& AuthToken);
 
+	/** 
+	 * Register callback for operation
+	 * Fails the callback immediately if too many operations are pending.
+	 * @return Operation ID to pass to Java, or 0 if the operation must not be started
+	 */
+	static int64 RegisterCallback(const FOnFirebaseAuthComplete& Callback);
+
+	/** Number of operations waiting for a result */
+	static int32 GetPendingOperationCount();
+
 	/** Get REST API instance (for non-Android platforms) */
 	static UFirebaseRestAPI* GetRestAPI();
 
@@ -222,17 +233,14 @@ public:
 
 private:
 	/** Store callbacks for async operations */
-	static TMap<FString, FOnFirebaseAuthComplete> PendingCallbacks;
-	
-	/** Current operation ID counter */
-	static int32 CurrentOperationId;
+	static TFirebasePendingOperations<FOnFirebaseAuthComplete> PendingOperations;
+
+	/** Ticker that fails operations whose result never arrived */
+	static FTSTicker::FDelegateHandle PendingOperationsTicker;
 
 	/** REST API instance for cross-platform support */
 	static UFirebaseRestAPI* RestAPIInstance;
 
-	/** Generate unique operation ID */
-	static FString GenerateOperationId();
-
-	/** Register callback for operation */
-	static void RegisterCallback(const FString& OperationId, const FOnFirebaseAuthComplete& Callback);
+	/** Fail timed out operations */
+	static bool TickPendingOperations(float DeltaTime);
 };
@@ -0,0 +1,104 @@
+// Copyright. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FirebaseBufferPool.generated.h"
+
+/**
+ * Counters for the shared byte buffer pool
+ */
+USTRUCT(BlueprintType)
+struct FIREBASEPLUGIN_API FFirebaseBufferPoolStats
+{
+	GENERATED_BODY()
+
+	/** Buffers handed out */
+	UPROPERTY(BlueprintReadOnly, Category = "Firebase|BufferPool")
+	int64 Acquired = 0;
+
+	/** Buffers handed out from the pool without allocating */
+	UPROPERTY(BlueprintReadOnly, Category = "Firebase|BufferPool")
+	int64 Reused = 0;
+
+	/** Buffers that had to be allocated */
+	UPROPERTY(BlueprintReadOnly, Category = "Firebase|BufferPool")
+	int64 Allocated = 0;
+
+	/** Buffers given back and kept for reuse */
+	UPROPERTY(BlueprintReadOnly, Category = "Firebase|BufferPool")
+	int64 Recycled = 0;
+
+	/** Buffers given back and freed (outside the size classes or over budget) */
+	UPROPERTY(BlueprintReadOnly, Category = "Firebase|BufferPool")
+	int64 Discarded = 0;
+
+	/** Buffers currently waiting in the pool */
+	UPROPERTY(BlueprintReadOnly, Category = "Firebase|BufferPool")
+	int32 PooledBuffers = 0;
+
+	/** Bytes currently held by the pool */
+	UPROPERTY(BlueprintReadOnly, Category = "Firebase|BufferPool")
+	int64 PooledBytes = 0;
+
+	/** Most bytes the pool may hold */
+	UPROPERTY(BlueprintReadOnly, Category = "Firebase|BufferPool")
+	int64 MaxPooledBytes = 0;
+};
+
+/**
+ * Process-wide pool of byte buffers for request bodies and payloads.
+ *
+ * Buffers are grouped in power-of-two size classes from 256 bytes to 1 MB.
+ * Acquire returns an empty buffer whose capacity is at least the requested
+ * size, taken from the matching class when one is free; Release puts it
+ * back. Payloads built with FFirebasePayload::FromUtf8 return their buffer
+ * here when the last copy goes away, so steady-state traffic keeps cycling
+ * the same few allocations. Buffers above the largest class, and anything
+ * that would push the pool past its byte budget or the plugin-wide memory
+ * budget (FFirebaseMemory), are simply freed.
+ *
+ * Thread-safe; payloads are often released on worker threads.
+ */
+class FIREBASEPLUGIN_API FFirebaseBufferPool
+{
+public:
+	static FFirebaseBufferPool& Get();
+
+	/** Empty buffer with room for at least MinCapacity bytes */
+	TArray<uint8> Acquire(int32 MinCapacity);
+
+	/** Give a buffer back; its contents are discarded */
+	void Release(TArray<uint8>&& Buffer);
+
+	/** Most bytes kept for reuse; 0 disables pooling. Shrinking trims the pool. */
+	void SetMaxPooledBytes(int64 InMaxPooledBytes);
+
+	/** Free every pooled buffer */
+	void Trim();
+
+	/** Free at least Bytes of pooled buffers, largest first; returns the bytes freed */
+	int64 Evict(int64 Bytes);
+
+	FFirebaseBufferPoolStats GetStats() const;
+
+private:
+	FFirebaseBufferPool();
+
+	static constexpr int32 MinClassShift = 8;
+	static constexpr int32 MaxClassShift = 20;
+	static constexpr int32 NumClasses = MaxClassShift - MinClassShift + 1;
+
+	/** Smallest class whose buffers hold Size bytes, or INDEX_NONE if too large */
+	static int32 GetAcquireClass(int32 Size);
+
+	/** Largest class a buffer of this capacity can serve, or INDEX_NONE */
+	static int32 GetReleaseClass(int32 Capacity);
+
+	/** Free pooled buffers, largest first, until at most MaxBytes remain */
+	void TrimTo(int64 MaxBytes);
+
+	mutable FCriticalSection Lock;
+	TArray<TArray<uint8>> FreeBuffers[NumClasses];
+	FFirebaseBufferPoolStats Stats;
+};
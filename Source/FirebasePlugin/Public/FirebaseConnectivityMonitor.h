@@ -0,0 +1,85 @@
+// Copyright. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Delegate fired when the REST connection state changes
+ */
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnFirebaseConnectivityChanged, bool /*bConnected*/);
+
+/**
+ * Tracks whether the Realtime Database is reachable.
+ *
+ * State is driven by transport outcomes: any HTTP response means the server
+ * is reachable, repeated network failures mean it is not. While offline the
+ * owner sends a cheap probe whenever ShouldProbe() says so: periodically with
+ * exponential backoff when auto-reconnect is on, and otherwise only after
+ * GoOnline or RequestProbe.
+ */
+class FIREBASEPLUGIN_API FFirebaseConnectivityMonitor
+{
+public:
+	enum class EState : uint8
+	{
+		Unknown,
+		Online,
+		Offline
+	};
+
+	/** Tune failure threshold and probe schedule */
+	void Configure(int32 InFailuresBeforeOffline, float InProbeIntervalSeconds, float InMaxProbeIntervalSeconds);
+
+	/** A request got an HTTP response (of any status) */
+	void ReportResponse(double Now);
+
+	/** A request failed without reaching the server */
+	void ReportNetworkFailure(double Now);
+
+	/** GoOffline/GoOnline: force the connection down regardless of transport state */
+	void SetManualOffline(bool bOffline);
+
+	/** Whether the app asked to stay offline */
+	bool IsManualOffline() const { return bManualOffline; }
+
+	/** Connected as far as the app is concerned (known reachable and not forced offline) */
+	bool IsConnected() const { return !bManualOffline && State == EState::Online; }
+
+	/** Whether queued work should be held back */
+	bool ShouldPauseRequests() const { return bManualOffline || State == EState::Offline; }
+
+	/** Raw transport state */
+	EState GetState() const { return State; }
+
+	/** Ask for a probe even without periodic probing, e.g. because requests are held; at most one per probe interval */
+	void RequestProbe() { bProbeRequested = true; }
+
+	/**
+	 * Whether a probe should be sent now
+	 * @param bPeriodic Follow the backoff schedule (auto-reconnect); otherwise only requested probes are due
+	 */
+	bool ShouldProbe(double Now, bool bPeriodic) const;
+
+	/** Record that a probe was sent and schedule the next one */
+	void OnProbeSent(double Now);
+
+	/** Fired whenever IsConnected() changes */
+	FOnFirebaseConnectivityChanged& OnConnectivityChanged() { return ConnectivityChangedEvent; }
+
+private:
+	void SetState(EState NewState, double Now);
+	void BroadcastIfChanged(bool bWasConnected);
+
+	EState State = EState::Unknown;
+	bool bManualOffline = false;
+	int32 ConsecutiveFailures = 0;
+	int32 FailuresBeforeOffline = 2;
+	float ProbeIntervalSeconds = 2.0f;
+	float MaxProbeIntervalSeconds = 30.0f;
+	float CurrentProbeIntervalSeconds = 2.0f;
+	double NextProbeTime = 0.0;
+	double LastProbeTime = 0.0;
+	bool bProbeRequested = false;
+	FOnFirebaseConnectivityChanged ConnectivityChangedEvent;
+};
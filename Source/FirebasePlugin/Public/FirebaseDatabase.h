@@ -5,8 +5,13 @@
 #include "CoreMinimal.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "FirebaseRestAPI.h"
+#include "FirebasePendingOperations.h"
+#include "FirebaseJsonDocument.h"
+#include "FirebaseBufferPool.h"
 #include "FirebaseDatabase.generated.h"
 
+class UFirebaseJsonBuilder;
+
 /**
  * Firebase Database Operation Result
  */
@@ -30,6 +35,12 @@ struct FFirebaseDatabaseResult
 	/** Database path that was accessed */
 	UPROPERTY(BlueprintReadOnly, Category = "Firebase|Database")
 	FString Path;
+
+	/** Raw UTF-8 response body (REST API only); shares the bytes of the HTTP response */
+	FFirebasePayload Payload;
+
+	/** Parsed response body, set when responses are parsed off the game thread */
+	FFirebaseJsonDocumentPtr Document;
 };
 
 /**
@@ -37,11 +48,31 @@ struct FFirebaseDatabaseResult
  */
 DECLARE_DYNAMIC_DELEGATE_OneParam(FOnFirebaseDatabaseComplete, const FFirebaseDatabaseResult&, Result);
 
+/**
+ * Native delegate for database operations that receives the raw UTF-8 body
+ * (the error message on failure)
+ */
+DECLARE_DELEGATE_TwoParams(FOnFirebaseDatabaseRawComplete, bool /*bSuccess*/, const FFirebasePayload& /*Data*/);
+
 /**
  * Delegate for database value change callbacks (real-time updates)
  */
 DECLARE_DYNAMIC_DELEGATE_TwoParams(FOnFirebaseDatabaseValueChanged, const FString&, Path, const FString&, Data);
 
+/**
+ * Delegate for connection state changes
+ */
+DECLARE_DYNAMIC_DELEGATE_OneParam(FOnFirebaseConnectionStateChanged, bool, bConnected);
+
+/**
+ * Database operation waiting for its result from the Android SDK
+ */
+struct FFirebasePendingDatabaseOperation
+{
+	FOnFirebaseDatabaseComplete Callback;
+	FString Path;
+};
+
 /**
  * Firebase Realtime Database Blueprint Function Library
  */
@@ -75,6 +106,54 @@ public:
 	static void UpdateValue(const FString& Path, const FString& JsonData, 
 		const FOnFirebaseDatabaseComplete& OnComplete);
 
+	/** 
+	 * Set data at a path from a JSON builder (overwrites existing data)
+	 * Over REST the builder's UTF-8 buffer is sent as-is, without an FString round trip.
+	 * @param Path Database path
+	 * @param Builder Builder holding the object to write
+	 * @param OnComplete Callback when operation completes
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Firebase|Database|Write", 
+		meta = (DisplayName = "Set Value From Builder"))
+	static void SetValueFromBuilder(const FString& Path, UFirebaseJsonBuilder* Builder, 
+		const FOnFirebaseDatabaseComplete& OnComplete);
+
+	/** 
+	 * Update data at a path from a JSON builder (merges with existing data)
+	 * @param Path Database path
+	 * @param Builder Builder holding the fields to update
+	 * @param OnComplete Callback when operation completes
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Firebase|Database|Write", 
+		meta = (DisplayName = "Update Value From Builder"))
+	static void UpdateValueFromBuilder(const FString& Path, UFirebaseJsonBuilder* Builder, 
+		const FOnFirebaseDatabaseComplete& OnComplete);
+
+	/** 
+	 * Set data at a path from any struct (overwrites existing data)
+	 * Members are written under their property names, with no JSON string in between.
+	 * @param Path Database path
+	 * @param Value Struct to write
+	 * @param OnComplete Callback when operation completes
+	 */
+	UFUNCTION(BlueprintCallable, CustomThunk, Category = "Firebase|Database|Write", 
+		meta = (DisplayName = "Set Struct", CustomStructureParam = "Value"))
+	static void K2_SetStruct(const FString& Path, const int32& Value, 
+		const FOnFirebaseDatabaseComplete& OnComplete);
+	DECLARE_FUNCTION(execK2_SetStruct);
+
+	/** 
+	 * Update data at a path from any struct (merges with existing data)
+	 * @param Path Database path
+	 * @param Value Struct whose members are written
+	 * @param OnComplete Callback when operation completes
+	 */
+	UFUNCTION(BlueprintCallable, CustomThunk, Category = "Firebase|Database|Write", 
+		meta = (DisplayName = "Update Struct", CustomStructureParam = "Value"))
+	static void K2_UpdateStruct(const FString& Path, const int32& Value, 
+		const FOnFirebaseDatabaseComplete& OnComplete);
+	DECLARE_FUNCTION(execK2_UpdateStruct);
+
 	/** 
 	 * Push new data to a list (generates unique key)
 	 * @param Path Database path
@@ -110,6 +189,7 @@ public:
 
 	/** 
 	 * Listen for data changes at a specific path (real-time updates)
+	 * On the REST API the path is polled; polling pauses while the callback's actor is hidden or off screen.
 	 * @param Path Database path
 	 * @param OnValueChanged Callback when data changes
 	 */
@@ -203,6 +283,22 @@ public:
 		meta = (DisplayName = "Is Connected"))
 	static bool IsConnected();
 
+	/** 
+	 * Get notified whenever the connection to Firebase goes up or down (REST API only)
+	 * @param OnChanged Callback with the new connection state
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Firebase|Database|Connection", 
+		meta = (DisplayName = "Bind Connection State Changed"))
+	static void BindConnectionStateChanged(const FOnFirebaseConnectionStateChanged& OnChanged);
+
+	/** 
+	 * Stop connection state notifications for a callback
+	 * @param OnChanged Callback previously passed to Bind Connection State Changed
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Firebase|Database|Connection", 
+		meta = (DisplayName = "Unbind Connection State Changed"))
+	static void UnbindConnectionStateChanged(const FOnFirebaseConnectionStateChanged& OnChanged);
+
 	// === UTILITY FUNCTIONS ===
 
 	/** 
@@ -213,6 +309,21 @@ public:
 		meta = (DisplayName = "Generate Push ID"))
 	static FString GeneratePushId();
 
+	/** 
+	 * Get the state of the client-side rate limiter (REST API only)
+	 * @return One entry per configured rate limit rule
+	 */
+	UFUNCTION(BlueprintPure, Category = "Firebase|Database|Utility", 
+		meta = (DisplayName = "Get Rate Limiter Stats"))
+	static TArray<FFirebaseRateLimiterStats> GetRateLimiterStats();
+
+	/** 
+	 * Get the counters of the pool that recycles request and payload buffers
+	 * @return Pool statistics; Reused close to Acquired means traffic is not allocating
+	 */
+	UFUNCTION(BlueprintPure, Category = "Firebase|Database|Utility", 
+		meta = (DisplayName = "Get Buffer Pool Stats"))
+	static FFirebaseBufferPoolStats GetBufferPoolStats();
 
 
 	// === HELPER FUNCTIONS FOR JSON ===
@@ -268,6 +379,7 @@ public:
 
 	/** 
 	 * Parse JSON string and get value by key
+	 * Parses the string on every call; prefer Get Result JSON Value for operation results.
 	 * @param JsonString JSON string to parse
 	 * @param Key Key to retrieve
 	 * @param OutValue Retrieved value as string
@@ -277,6 +389,89 @@ public:
 		meta = (DisplayName = "Get JSON Value"))
 	static bool GetJsonValue(const FString& JsonString, const FString& Key, FString& OutValue);
 
+	/** 
+	 * Get value by key from an operation result
+	 * Uses the pre-parsed document when available instead of parsing Data again.
+	 * @param Result Result of a database operation
+	 * @param Key Key to retrieve
+	 * @param OutValue Retrieved value as string
+	 * @return True if key was found
+	 */
+	UFUNCTION(BlueprintPure, Category = "Firebase|Database|JSON", 
+		meta = (DisplayName = "Get Result JSON Value"))
+	static bool GetResultJsonValue(const FFirebaseDatabaseResult& Result, const FString& Key, FString& OutValue);
+
+	/**
+	 * Typed value of an operation result
+	 * The value is built once per result and shared, so navigating it with the
+	 * Firebase Value nodes never parses again. Without off-thread parsing the
+	 * first call parses Data; keep the value in a variable rather than calling
+	 * this repeatedly.
+	 * @param Result Result of a database operation
+	 * @return The value, or Null if the result holds no valid JSON
+	 */
+	UFUNCTION(BlueprintPure, Category = "Firebase|Database|JSON",
+		meta = (DisplayName = "Get Result Value"))
+	static FFirebaseValue GetResultValue(const FFirebaseDatabaseResult& Result);
+
+	/** 
+	 * Get a nested value by slash-separated path, e.g. "players/abc/score"
+	 * Scans the JSON text without parsing it into objects and stops at the value.
+	 * @param JsonString JSON string to scan
+	 * @param Path Path to the value; numeric segments index arrays
+	 * @param OutValue Retrieved value as string
+	 * @return True if the path was found
+	 */
+	UFUNCTION(BlueprintPure, Category = "Firebase|Database|JSON", 
+		meta = (DisplayName = "Get JSON Value At Path"))
+	static bool GetJsonValueAtPath(const FString& JsonString, const FString& Path, FString& OutValue);
+
+	/** 
+	 * Get several nested values in a single scan of the JSON text
+	 * @param JsonString JSON string to scan
+	 * @param Paths Slash-separated paths to retrieve
+	 * @param OutValues Values in the order of Paths (empty where a path was not found)
+	 * @return Number of paths found
+	 */
+	UFUNCTION(BlueprintPure, Category = "Firebase|Database|JSON", 
+		meta = (DisplayName = "Get JSON Values At Paths"))
+	static int32 GetJsonValuesAtPaths(const FString& JsonString, const TArray<FString>& Paths, TArray<FString>& OutValues);
+
+	/** 
+	 * Get a nested value by path from an operation result
+	 * Scans the raw UTF-8 payload when available, so Data is not converted or parsed.
+	 * @param Result Result of a database operation
+	 * @param Path Slash-separated path to the value
+	 * @param OutValue Retrieved value as string
+	 * @return True if the path was found
+	 */
+	UFUNCTION(BlueprintPure, Category = "Firebase|Database|JSON", 
+		meta = (DisplayName = "Get Result JSON Value At Path"))
+	static bool GetResultJsonValueAtPath(const FFirebaseDatabaseResult& Result, const FString& Path, FString& OutValue);
+
+	/** 
+	 * Get several nested values from an operation result in a single scan
+	 * @param Result Result of a database operation
+	 * @param Paths Slash-separated paths to retrieve
+	 * @param OutValues Values in the order of Paths (empty where a path was not found)
+	 * @return Number of paths found
+	 */
+	UFUNCTION(BlueprintPure, Category = "Firebase|Database|JSON", 
+		meta = (DisplayName = "Get Result JSON Values At Paths"))
+	static int32 GetResultJsonValuesAtPaths(const FFirebaseDatabaseResult& Result, const TArray<FString>& Paths, TArray<FString>& OutValues);
+
+	/** 
+	 * Read a database result into a struct (use after Get Value)
+	 * Members missing from the result keep their default value.
+	 * @param Result Result of a read operation
+	 * @param OutValue Struct to fill
+	 * @return True if the result was read without type mismatches
+	 */
+	UFUNCTION(BlueprintCallable, CustomThunk, Category = "Firebase|Database|JSON", 
+		meta = (DisplayName = "Get Result Struct", CustomStructureParam = "OutValue"))
+	static bool K2_GetResultStruct(const FFirebaseDatabaseResult& Result, int32& OutValue);
+	DECLARE_FUNCTION(execK2_GetResultStruct);
+
 	// === SERVER TIMESTAMP HELPERS ===
 
 	/** 
@@ -306,33 +501,108 @@ public:
 		meta = (DisplayName = "Timestamp To Date String"))
 	static FString TimestampToDateString(int64 TimestampMs);
 
+	// === RAW PAYLOAD OPERATIONS (C++ only, REST API) ===
+
+	/** Set data at a path from a UTF-8 JSON payload */
+	static void SetValueRaw(const FString& Path, const FFirebasePayload& JsonData, const FOnFirebaseDatabaseRawComplete& OnComplete);
+
+	/** Update data at a path from a UTF-8 JSON payload */
+	static void UpdateValueRaw(const FString& Path, const FFirebasePayload& JsonData, const FOnFirebaseDatabaseRawComplete& OnComplete);
+
+	/** Read data at a path without converting the body to FString */
+	static void GetValueRaw(const FString& Path, const FOnFirebaseDatabaseRawComplete& OnComplete);
+
+	/** Set data from a UTF-8 body: sent as-is over REST, converted to FString for the Android SDK */
+	static void SetValuePayload(const FString& Path, const FFirebasePayload& JsonData, const FOnFirebaseDatabaseComplete& OnComplete);
+
+	/** Update data from a UTF-8 body: sent as-is over REST, converted to FString for the Android SDK */
+	static void UpdateValuePayload(const FString& Path, const FFirebasePayload& JsonData, const FOnFirebaseDatabaseComplete& OnComplete);
+
+	// === STRUCT OPERATIONS (C++) ===
+
+	/** Set data at a path from a struct; see FFirebaseStructCodec for the encoding */
+	static void SetStruct(const FString& Path, const UScriptStruct* Struct, const void* Data, const FOnFirebaseDatabaseComplete& OnComplete);
+
+	/** Update data at a path from a struct */
+	static void UpdateStruct(const FString& Path, const UScriptStruct* Struct, const void* Data, const FOnFirebaseDatabaseComplete& OnComplete);
+
+	/**
+	 * Read a path into a default-initialized instance of Struct (REST API).
+	 * Data is null if the request failed; on a type mismatch bSuccess is false
+	 * but Data still holds every member that could be read.
+	 */
+	static void GetStruct(const FString& Path, const UScriptStruct* Struct, TFunction<void(bool bSuccess, const void* Data, const FString& Error)> OnComplete);
+
+	/** Fill Data from a result; false on failure or type mismatch */
+	static bool GetResultStruct(const FFirebaseDatabaseResult& Result, const UScriptStruct* Struct, void* Data);
+
+	template <typename StructType>
+	static void SetStruct(const FString& Path, const StructType& Value, const FOnFirebaseDatabaseComplete& OnComplete)
+	{
+		SetStruct(Path, StructType::StaticStruct(), &Value, OnComplete);
+	}
+
+	template <typename StructType>
+	static void UpdateStruct(const FString& Path, const StructType& Value, const FOnFirebaseDatabaseComplete& OnComplete)
+	{
+		UpdateStruct(Path, StructType::StaticStruct(), &Value, OnComplete);
+	}
+
+	template <typename StructType>
+	static void GetStruct(const FString& Path, TFunction<void(bool bSuccess, const StructType& Value)> OnComplete)
+	{
+		GetStruct(Path, StructType::StaticStruct(), [OnComplete = MoveTemp(OnComplete)](bool bSuccess, const void* Data, const FString& Error)
+		{
+			OnComplete(bSuccess, Data ? *static_cast<const StructType*>(Data) : StructType());
+		});
+	}
+
+	template <typename StructType>
+	static bool GetResultStruct(const FFirebaseDatabaseResult& Result, StructType& OutValue)
+	{
+		return GetResultStruct(Result, StructType::StaticStruct(), &OutValue);
+	}
+
 	// === INTERNAL METHODS ===
 
 	/** Called from Java when database operation completes */
-	static void OnDatabaseResultReceived(bool bSuccess, const FString& Path, 
+	static void OnDatabaseResultReceived(int64 OperationId, bool bSuccess, const FString& Path, 
 		const FString& Data, const FString& ErrorMessage);
 
+	/** 
+	 * Register callback for operation
+	 * Fails the callback immediately if too many operations are pending.
+	 * @return Operation ID to pass to Java, or 0 if the operation must not be started
+	 */
+	static int64 RegisterCallback(const FOnFirebaseDatabaseComplete& Callback, const FString& Path);
+
+	/** Number of operations waiting for a result */
+	static int32 GetPendingOperationCount();
+
 	/** Called from Java when database value changes */
 	static void OnDatabaseValueChanged(const FString& Path, const FString& Data);
 
 private:
 	/** Store callbacks for async operations */
-	static TMap<FString, FOnFirebaseDatabaseComplete> PendingCallbacks;
+	static TFirebasePendingOperations<FFirebasePendingDatabaseOperation> PendingOperations;
+
+	/** Ticker that fails operations whose result never arrived */
+	static FTSTicker::FDelegateHandle PendingOperationsTicker;
 	
 	/** Store listeners for value changes */
 	static TMap<FString, FOnFirebaseDatabaseValueChanged> ValueListeners;
 
-	/** Current operation ID counter */
-	static int32 CurrentOperationId;
-
 	/** REST API instance for cross-platform support */
 	static UFirebaseRestAPI* RestAPIInstance;
 
-	/** Generate unique operation ID */
-	static FString GenerateOperationId();
+	/** Store listeners for connection state changes */
+	static TArray<FOnFirebaseConnectionStateChanged> ConnectionStateListeners;
+
+	/** Forward REST connectivity changes to Blueprint listeners */
+	static void OnRestConnectivityChanged(bool bConnected);
 
-	/** Register callback for operation */
-	static void RegisterCallback(const FString& OperationId, const FOnFirebaseDatabaseComplete& Callback);
+	/** Fail timed out operations */
+	static bool TickPendingOperations(float DeltaTime);
 
 	/** Register listener for path */
 	static void RegisterListener(const FString& Path, const FOnFirebaseDatabaseValueChanged& Listener);
@@ -340,6 +610,18 @@ private:
 	/** Get REST API instance (for non-Android platforms) */
 	static UFirebaseRestAPI* GetRestAPI();
 
+	/** Get REST API instance for a raw request, failing the callback if there is none */
+	static UFirebaseRestAPI* GetRestAPIForRawRequest(const FOnFirebaseDatabaseRawComplete& OnComplete);
+
+	/** Current ID token of the signed-in user (empty if none) */
+	static FString GetRestAuthToken();
+
+	/** Build a REST callback that completes a Blueprint delegate on the game thread */
+	static FFirebaseRestPayloadCallback MakeRestResultCallback(const FOnFirebaseDatabaseComplete& OnComplete, const FString& Path);
+
+	/** Build a REST callback that completes a raw delegate on the game thread */
+	static FFirebaseRestPayloadCallback MakeRawResultCallback(const FOnFirebaseDatabaseRawComplete& OnComplete);
+
 	/** Check if should use REST API (non-Android or forced) */
 	static bool ShouldUseRestAPI();
 };
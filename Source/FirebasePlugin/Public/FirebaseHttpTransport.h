@@ -0,0 +1,106 @@
+// Copyright. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Interfaces/IHttpRequest.h"
+#include "FirebasePayload.h"
+
+/**
+ * One HTTP request as the REST layer issues it
+ */
+struct FIREBASEPLUGIN_API FFirebaseHttpRequest
+{
+	FString Verb = TEXT("GET");
+	FString Url;
+	TArray<TPair<FString, FString>> Headers;
+
+	/** UTF-8 body; shared, not copied, by transports that can take it as is */
+	FFirebasePayload Body;
+
+	/** Seconds before the request fails; 0 uses the transport's default */
+	float TimeoutSeconds = 0.0f;
+
+	/** Add a header or replace its value */
+	void SetHeader(const FString& Name, const FString& Value);
+
+	/** Header value, or null (names compare case-insensitively) */
+	const FString* FindHeader(const TCHAR* Name) const;
+};
+
+/**
+ * Outcome of a request
+ */
+struct FIREBASEPLUGIN_API FFirebaseHttpResponse
+{
+	/** False when no HTTP response arrived (connection failure, timeout, cancellation) */
+	bool bSucceeded = false;
+
+	/** HTTP status; 0 when bSucceeded is false */
+	int32 Code = 0;
+
+	TArray<TPair<FString, FString>> Headers;
+	FFirebasePayload Body;
+
+	/** Seconds from Send until the headers arrived, on the transport's clock; negative if unknown */
+	float TimeToFirstByteSeconds = -1.0f;
+
+	/** Seconds from Send until the body was complete, on the transport's clock; negative if unknown */
+	float ElapsedSeconds = -1.0f;
+
+	/** Header value, or empty (names compare case-insensitively) */
+	FString GetHeader(const TCHAR* Name) const;
+
+	/** Got a 2xx answer */
+	bool IsOk() const { return bSucceeded && Code >= 200 && Code < 300; }
+
+	/** Response for a request that never reached the server */
+	static FFirebaseHttpResponse Failed() { return FFirebaseHttpResponse(); }
+};
+
+/** Called exactly once per request */
+using FFirebaseHttpCallback = TFunction<void(const FFirebaseHttpResponse& Response)>;
+
+/** Identifies a request for Cancel; 0 is never used */
+using FFirebaseHttpRequestId = uint64;
+
+/**
+ * Sends the REST layer's HTTP requests.
+ *
+ * UFirebaseRestAPI talks only to this interface, so the network can be
+ * replaced by FFirebaseInMemoryTransport (or a decorator around either) in
+ * tests and benchmarks. Transports are used from the game thread and call
+ * back on it.
+ */
+class FIREBASEPLUGIN_API IFirebaseHttpTransport
+{
+public:
+	virtual ~IFirebaseHttpTransport() = default;
+
+	/**
+	 * Start a request
+	 * @param OnComplete Runs exactly once on the game thread, possibly before Send returns
+	 * @return ID to pass to Cancel
+	 */
+	virtual FFirebaseHttpRequestId Send(FFirebaseHttpRequest&& Request, FFirebaseHttpCallback&& OnComplete) = 0;
+
+	/** Abandon a request; its callback runs with a failed response unless it already ran */
+	virtual void Cancel(FFirebaseHttpRequestId RequestId) = 0;
+};
+
+/**
+ * Transport over the engine's HTTP module, used unless another one is set
+ */
+class FIREBASEPLUGIN_API FFirebaseHttpModuleTransport : public IFirebaseHttpTransport, public TSharedFromThis<FFirebaseHttpModuleTransport>
+{
+public:
+	/** Shared instance used by every UFirebaseRestAPI without an explicit transport */
+	static TSharedRef<FFirebaseHttpModuleTransport> Get();
+
+	virtual FFirebaseHttpRequestId Send(FFirebaseHttpRequest&& Request, FFirebaseHttpCallback&& OnComplete) override;
+	virtual void Cancel(FFirebaseHttpRequestId RequestId) override;
+
+private:
+	TMap<FFirebaseHttpRequestId, FHttpRequestPtr> InFlight;
+	FFirebaseHttpRequestId NextRequestId = 1;
+};
@@ -0,0 +1,87 @@
+// Copyright. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FirebaseHttpTransport.h"
+#include "FirebaseResponseSchedule.h"
+
+/**
+ * Transport that answers requests in memory, without any network.
+ *
+ * A handler turns each request into a response. Responses are delivered
+ * synchronously inside Send when their delay is zero; otherwise they wait
+ * on a virtual clock that only moves when Advance() is called, so tests and
+ * benchmarks decide exactly when (and in which order) requests complete.
+ * SetRealTime(true) drives that clock from the core ticker instead.
+ */
+class FIREBASEPLUGIN_API FFirebaseInMemoryTransport : public IFirebaseHttpTransport
+{
+public:
+	/** Produces the response for a request */
+	using FHandler = TFunction<FFirebaseHttpResponse(const FFirebaseHttpRequest& Request)>;
+
+	//~ Begin IFirebaseHttpTransport Interface
+	virtual FFirebaseHttpRequestId Send(FFirebaseHttpRequest&& Request, FFirebaseHttpCallback&& OnComplete) override;
+	virtual void Cancel(FFirebaseHttpRequestId RequestId) override;
+	//~ End IFirebaseHttpTransport Interface
+
+	/** Answer requests with Handler; without one every request gets a 404 */
+	void SetHandler(FHandler InHandler) { Handler = MoveTemp(InHandler); }
+
+	/** Answer requests whose URL starts with UrlPrefix with Handler; the longest matching prefix wins over SetHandler */
+	void AddRoute(const FString& UrlPrefix, FHandler RouteHandler);
+
+	/** Delay applied to every response (seconds of virtual time) */
+	void SetDefaultDelay(double Seconds) { DefaultDelay = FMath::Max(Seconds, 0.0); }
+
+	/** Delays for the next requests, in order; once used up, the default delay applies again */
+	void ScriptDelays(TArrayView<const double> Delays);
+
+	/** Move the virtual clock forward and deliver every response that is now due, in due order; returns how many were delivered */
+	int32 Advance(double Seconds) { return Schedule.Advance(Seconds); }
+
+	/** Deliver every pending response now, in due order */
+	int32 Flush() { return Schedule.Flush(); }
+
+	/** Advance the clock by the core ticker's delta time */
+	void SetRealTime(bool bEnabled) { Schedule.SetRealTime(bEnabled); }
+
+	/** Current virtual time in seconds */
+	double GetTime() const { return Schedule.GetTime(); }
+
+	/** Responses waiting for their delivery time */
+	int32 GetNumPending() const { return Schedule.Num(); }
+
+	/** Requests sent since the last ClearLog (only kept while bRecordRequests is set) */
+	const TArray<FFirebaseHttpRequest>& GetSentRequests() const { return SentRequests; }
+	void ClearLog() { SentRequests.Reset(); }
+
+	/** Keep a copy of every request for GetSentRequests */
+	bool bRecordRequests = true;
+
+	/** Total requests sent */
+	int64 GetNumSent() const { return NumSent; }
+
+	/** Handler that always returns the same status and body */
+	static FHandler Respond(int32 Code, const FFirebasePayload& Body);
+
+	/** Response with a JSON body */
+	static FFirebaseHttpResponse MakeResponse(int32 Code, const FFirebasePayload& Body);
+
+private:
+	const FHandler* FindHandler(const FString& Url) const;
+
+	FHandler Handler;
+	TArray<TPair<FString, FHandler>> Routes;
+
+	TArray<double> ScriptedDelays;
+	int32 NextScriptedDelay = 0;
+	double DefaultDelay = 0.0;
+
+	FFirebaseResponseSchedule Schedule;
+
+	TArray<FFirebaseHttpRequest> SentRequests;
+	int64 NumSent = 0;
+	FFirebaseHttpRequestId NextRequestId = 1;
+};
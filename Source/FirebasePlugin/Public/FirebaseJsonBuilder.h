@@ -0,0 +1,107 @@
+// Copyright. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "FirebaseJsonWriter.h"
+#include "FirebaseJsonBuilder.generated.h"
+
+/**
+ * Blueprint JSON builder backed by FFirebaseJsonWriter.
+ *
+ * Starts with an open root object. Set* functions add members to the
+ * current object, Add* functions append elements to the current array, and
+ * End closes the innermost nested object or array. Every call appends to one
+ * UTF-8 buffer, so building a large object costs a single growing
+ * allocation instead of a string per field. Setters return the builder so
+ * calls can be chained.
+ */
+UCLASS(BlueprintType)
+class FIREBASEPLUGIN_API UFirebaseJsonBuilder : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UFirebaseJsonBuilder();
+
+	/** Create an empty builder */
+	UFUNCTION(BlueprintCallable, Category = "Firebase|Database|JSON",
+		meta = (DisplayName = "Create JSON Builder"))
+	static UFirebaseJsonBuilder* CreateJsonBuilder();
+
+	/** Clear the builder so it can be reused; the buffer is kept */
+	UFUNCTION(BlueprintCallable, Category = "Firebase|Database|JSON")
+	UFirebaseJsonBuilder* Reset();
+
+	// === OBJECT MEMBERS ===
+
+	UFUNCTION(BlueprintCallable, Category = "Firebase|Database|JSON")
+	UFirebaseJsonBuilder* SetString(const FString& Key, const FString& Value);
+
+	UFUNCTION(BlueprintCallable, Category = "Firebase|Database|JSON")
+	UFirebaseJsonBuilder* SetInt(const FString& Key, int64 Value);
+
+	UFUNCTION(BlueprintCallable, Category = "Firebase|Database|JSON")
+	UFirebaseJsonBuilder* SetFloat(const FString& Key, double Value);
+
+	UFUNCTION(BlueprintCallable, Category = "Firebase|Database|JSON")
+	UFirebaseJsonBuilder* SetBool(const FString& Key, bool Value);
+
+	UFUNCTION(BlueprintCallable, Category = "Firebase|Database|JSON")
+	UFirebaseJsonBuilder* SetNull(const FString& Key);
+
+	/** Add a member whose value is already JSON (e.g. from another builder); not validated, but empty writes null */
+	UFUNCTION(BlueprintCallable, Category = "Firebase|Database|JSON",
+		meta = (DisplayName = "Set JSON"))
+	UFirebaseJsonBuilder* SetJson(const FString& Key, const FString& Json);
+
+	/** Open a nested object; following Set* calls write into it until End */
+	UFUNCTION(BlueprintCallable, Category = "Firebase|Database|JSON")
+	UFirebaseJsonBuilder* BeginObject(const FString& Key);
+
+	/** Open a nested array; following Add* calls append to it until End */
+	UFUNCTION(BlueprintCallable, Category = "Firebase|Database|JSON")
+	UFirebaseJsonBuilder* BeginArray(const FString& Key);
+
+	// === ARRAY ELEMENTS ===
+
+	UFUNCTION(BlueprintCallable, Category = "Firebase|Database|JSON")
+	UFirebaseJsonBuilder* AddString(const FString& Value);
+
+	UFUNCTION(BlueprintCallable, Category = "Firebase|Database|JSON")
+	UFirebaseJsonBuilder* AddInt(int64 Value);
+
+	UFUNCTION(BlueprintCallable, Category = "Firebase|Database|JSON")
+	UFirebaseJsonBuilder* AddFloat(double Value);
+
+	UFUNCTION(BlueprintCallable, Category = "Firebase|Database|JSON")
+	UFirebaseJsonBuilder* AddBool(bool Value);
+
+	/** Append an object element; following Set* calls write into it until End */
+	UFUNCTION(BlueprintCallable, Category = "Firebase|Database|JSON")
+	UFirebaseJsonBuilder* AddObject();
+
+	/** Close the innermost nested object or array */
+	UFUNCTION(BlueprintCallable, Category = "Firebase|Database|JSON")
+	UFirebaseJsonBuilder* End();
+
+	// === OUTPUT ===
+
+	/** JSON text; nested objects and arrays still open are closed in the output */
+	UFUNCTION(BlueprintPure, Category = "Firebase|Database|JSON",
+		meta = (DisplayName = "To JSON String"))
+	FString ToJsonString() const;
+
+	/** UTF-8 body for the raw database functions, without going through FString */
+	FFirebasePayload ToPayload() const { return Writer.ToPayload(); }
+
+	/** Underlying writer for native code */
+	FFirebaseJsonWriter& GetWriter() { return Writer; }
+
+private:
+	bool CheckInObject(const TCHAR* Function) const;
+	bool CheckInArray(const TCHAR* Function) const;
+
+	FFirebaseJsonWriter Writer;
+};
@@ -0,0 +1,74 @@
+// Copyright. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonValue.h"
+#include "FirebasePayload.h"
+#include "FirebaseJsonTape.h"
+#include "FirebaseValue.h"
+
+class FFirebaseJsonDocument;
+enum class EFirebaseJsonParser : uint8;
+
+/** Shared, immutable parsed document */
+typedef TSharedPtr<const FFirebaseJsonDocument, ESPMode::ThreadSafe> FFirebaseJsonDocumentPtr;
+
+/**
+ * Immutable parsed JSON response.
+ *
+ * Parsed once (optionally on a worker thread) and then shared by every
+ * consumer of a result, so field lookups never deserialize the body again.
+ * The raw payload is kept alongside the tree. Documents parsed with the tape
+ * backend answer field lookups from the tape and only build the FJsonValue
+ * tree when GetRoot() is first called.
+ */
+class FIREBASEPLUGIN_API FFirebaseJsonDocument
+{
+public:
+	/** Parse a payload on the calling thread with the parser chosen in settings */
+	static FFirebaseJsonDocumentPtr Parse(const FFirebasePayload& Payload);
+
+	/** Parse a payload on the calling thread with a specific parser */
+	static FFirebaseJsonDocumentPtr Parse(const FFirebasePayload& Payload, EFirebaseJsonParser Parser);
+
+	/** Parse a payload on a worker thread and hand the document to the game thread */
+	static void ParseAsync(const FFirebasePayload& Payload, TUniqueFunction<void(FFirebaseJsonDocumentPtr)>&& OnParsed);
+
+	/** Whether the payload was valid JSON */
+	bool IsValid() const;
+
+	/** Raw body the document was parsed from */
+	const FFirebasePayload& GetPayload() const { return Payload; }
+
+	/** Root value; shared by all readers and must not be modified */
+	TSharedPtr<FJsonValue> GetRoot() const;
+
+	/** Tape of a document parsed with the tape backend, otherwise null */
+	const FFirebaseJsonTape* GetTape() const { return Tape.Get(); }
+
+	/** Typed view of the document; built on first call and shared afterwards */
+	FFirebaseValue GetValue() const;
+
+	/** Top-level field of an object document, or null */
+	TSharedPtr<FJsonValue> GetField(const FString& Key) const;
+
+	/** Top-level field formatted the same way as UFirebaseDatabase::GetJsonValue */
+	bool GetFieldAsString(const FString& Key, FString& OutValue) const;
+
+	/** Strings and scalars as text, objects and arrays as JSON */
+	static FString ValueToString(const TSharedPtr<FJsonValue>& Value);
+
+private:
+	FFirebasePayload Payload;
+	TSharedPtr<FFirebaseJsonTape, ESPMode::ThreadSafe> Tape;
+
+	// Built lazily from the tape on first GetRoot()
+	mutable TSharedPtr<FJsonValue> Root;
+	mutable FCriticalSection RootLock;
+
+	// Built lazily on first GetValue()
+	mutable FFirebaseValue Value;
+	mutable bool bValueBuilt = false;
+	mutable FCriticalSection ValueLock;
+};
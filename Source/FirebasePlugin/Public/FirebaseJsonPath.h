@@ -0,0 +1,30 @@
+// Copyright. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Extracts values at slash-separated paths ("players/abc/score") from raw
+ * UTF-8 JSON without building a DOM.
+ *
+ * The text is walked once. Subtrees no requested path enters are skipped
+ * byte by byte without being parsed, nothing is allocated while scanning,
+ * and the walk stops as soon as every path has been found. Numeric segments
+ * also index arrays. Skipped subtrees are not validated.
+ */
+class FIREBASEPLUGIN_API FFirebaseJsonPath
+{
+public:
+	/** Raw JSON text of the value at Path (an empty path is the whole document) */
+	static bool FindRaw(FUtf8StringView Json, FStringView Path, FUtf8StringView& OutValue);
+
+	/**
+	 * Raw JSON text of several values in one pass. OutValues matches Paths;
+	 * entries that were not found are empty. Returns the number found.
+	 */
+	static int32 FindRaw(FUtf8StringView Json, TConstArrayView<FString> Paths, TArray<FUtf8StringView>& OutValues);
+
+	/** Format raw JSON text the way GetJsonValue does: strings unescaped, scalars as text, objects and arrays as JSON */
+	static FString FormatValue(FUtf8StringView RawValue);
+};
@@ -0,0 +1,139 @@
+// Copyright. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonValue.h"
+#include "FirebasePayload.h"
+
+/**
+ * Kind of value stored at a tape position
+ */
+enum class EFirebaseJsonTapeType : uint8
+{
+	Null = 'n',
+	True = 't',
+	False = 'f',
+	Number = 'd',
+	String = '"',
+	Object = '{',
+	ObjectEnd = '}',
+	Array = '[',
+	ArrayEnd = ']'
+};
+
+/**
+ * Compact read-only JSON DOM for large snapshots.
+ *
+ * Parsing makes two passes over the UTF-8 payload. The first classifies the
+ * input 64 bytes at a time with SIMD compares (AVX2 or SSE2 on x64, NEON on
+ * ARM, a scalar loop elsewhere) and records the offset of every structural
+ * character, string and scalar. The second walks those offsets and fills a
+ * flat array of 64-bit words. Containers store the index of their matching
+ * end, so whole subtrees are skipped in O(1). Strings without escapes point
+ * straight into the payload; only escaped strings are decoded into a side
+ * buffer. Nothing is allocated per value.
+ */
+class FIREBASEPLUGIN_API FFirebaseJsonTape
+{
+public:
+	/**
+	 * Handle to one value on a tape. Cheap to copy; valid while the tape lives.
+	 */
+	class FIREBASEPLUGIN_API FValue
+	{
+	public:
+		FValue() = default;
+
+		/** Whether this handle refers to a value */
+		bool IsValid() const { return Tape != nullptr; }
+
+		/** Kind of value */
+		EFirebaseJsonTapeType GetType() const;
+
+		bool IsNull() const { return GetType() == EFirebaseJsonTapeType::Null; }
+		bool IsBool() const { return GetType() == EFirebaseJsonTapeType::True || GetType() == EFirebaseJsonTapeType::False; }
+		bool IsNumber() const { return GetType() == EFirebaseJsonTapeType::Number; }
+		bool IsString() const { return GetType() == EFirebaseJsonTapeType::String; }
+		bool IsObject() const { return GetType() == EFirebaseJsonTapeType::Object; }
+		bool IsArray() const { return GetType() == EFirebaseJsonTapeType::Array; }
+
+		/** Boolean value (false for other kinds) */
+		bool AsBool() const { return GetType() == EFirebaseJsonTapeType::True; }
+
+		/** Numeric value (0 for other kinds) */
+		double AsNumber() const;
+
+		/** Unescaped UTF-8 text of a string (empty for other kinds) */
+		FUtf8StringView AsUtf8() const;
+
+		/** String transcoded to UTF-16 (allocates) */
+		FString AsString() const;
+
+		/** Member of an object by exact key, or an invalid value */
+		FValue FindField(FUtf8StringView Key) const;
+
+		/** Visit object members in order; return false from the visitor to stop */
+		void ForEachField(TFunctionRef<bool(FUtf8StringView Key, const FValue& Value)> Visitor) const;
+
+		/** Visit array elements in order; return false from the visitor to stop */
+		void ForEachElement(TFunctionRef<bool(const FValue& Element)> Visitor) const;
+
+		/** Number of members or elements (0 for scalars) */
+		int32 Num() const;
+
+		/** Build an FJsonValue tree for this value (allocates per node) */
+		TSharedPtr<FJsonValue> ToJsonValue() const;
+
+	private:
+		friend class FFirebaseJsonTape;
+
+		FValue(const FFirebaseJsonTape* InTape, int32 InIndex)
+			: Tape(InTape)
+			, Index(InIndex)
+		{
+		}
+
+		/** Tape index of the value after this one */
+		int32 GetNextIndex() const;
+
+		const FFirebaseJsonTape* Tape = nullptr;
+		int32 Index = 0;
+	};
+
+	/**
+	 * Parse a UTF-8 payload. The tape keeps the payload alive because strings
+	 * reference it. bAllowSimd = false forces the scalar scanner.
+	 */
+	bool Parse(const FFirebasePayload& InPayload, bool bAllowSimd = true);
+
+	/** Whether the last Parse succeeded */
+	bool IsValid() const { return bValid; }
+
+	/** Reason the last Parse failed */
+	const FString& GetError() const { return Error; }
+
+	/** Root value, or an invalid value if parsing failed */
+	FValue GetRoot() const;
+
+	/** Payload the tape was parsed from */
+	const FFirebasePayload& GetPayload() const { return Payload; }
+
+	/** Bytes held by the tape itself (the payload is not counted) */
+	SIZE_T GetAllocatedSize() const;
+
+	/** Instruction set the structural scanner uses in this build */
+	static const TCHAR* GetSimdBackendName();
+
+private:
+	bool BuildTape(const TArray<uint32>& Indices);
+	bool ParseString(uint32 Position);
+	bool ParseScalar(uint32 Position);
+	bool Fail(const TCHAR* Reason, uint32 Position);
+
+	FFirebasePayload Payload;
+	TArray<uint64> Words;
+	TArray<uint8> Strings;
+	FString Error;
+	bool bValid = false;
+};
@@ -0,0 +1,94 @@
+// Copyright. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FirebasePayload.h"
+
+/**
+ * Streaming JSON writer that appends UTF-8 straight into one growable buffer.
+ *
+ * Commas and colons are inserted automatically, strings are escaped, and
+ * numbers use the shortest text that reads back to the same value. Reset()
+ * keeps the allocation, so a writer reused for every request stops
+ * allocating once it has seen its largest document. The buffer comes from
+ * FFirebaseBufferPool and goes back to it when the writer is destroyed.
+ */
+class FIREBASEPLUGIN_API FFirebaseJsonWriter
+{
+public:
+	explicit FFirebaseJsonWriter(int32 InitialCapacity = 256);
+	~FFirebaseJsonWriter();
+
+	/** Discard the document but keep the buffer */
+	void Reset();
+
+	void BeginObject();
+	void EndObject();
+	void BeginArray();
+	void EndArray();
+
+	/** Member name; must be followed by exactly one value */
+	void WriteKey(FStringView Key);
+	void WriteKey(FUtf8StringView Key);
+
+	void WriteString(FStringView Value);
+	void WriteString(FUtf8StringView Value);
+	void WriteInt(int64 Value);
+	void WriteDouble(double Value);
+	void WriteFloat(float Value);
+	void WriteBool(bool Value);
+	void WriteNull();
+
+	/** Insert an already serialized value (not validated) */
+	void WriteRawValue(FUtf8StringView Json);
+
+	/** Insert already serialized members ("\"a\":1,\"b\":2") into the current object (not validated) */
+	void WriteRawMembers(FUtf8StringView Members);
+
+	/** Whether the innermost open scope is an object */
+	bool IsInObject() const;
+
+	/** Whether the innermost open scope is an array */
+	bool IsInArray() const;
+
+	/** Number of open objects and arrays */
+	int32 GetDepth() const { return Scopes.Num(); }
+
+	/** Text written so far (open scopes are not closed) */
+	FUtf8StringView GetView() const;
+
+	/** Copy of the document with any open scopes closed; the writer can keep going */
+	FFirebasePayload ToPayload() const;
+
+	/** Close any open scopes and hand the buffer over without copying; the writer is left empty */
+	FFirebasePayload TakePayload();
+
+	/** Document as an FString with any open scopes closed */
+	FString ToString() const;
+
+	/** Shortest text that reads back as Value; non-finite values become null */
+	static int32 FormatDouble(double Value, ANSICHAR (&Out)[32]);
+
+	/** Shortest text that reads back as Value when parsed as a float */
+	static int32 FormatFloat(float Value, ANSICHAR (&Out)[32]);
+
+private:
+	enum EScopeFlags : uint8
+	{
+		ScopeArray = 1 << 0,
+		ScopeHasMembers = 1 << 1
+	};
+
+	void BeforeValue();
+	void AppendAscii(const ANSICHAR* Text, int32 Length);
+	void AppendClosers(TArray<uint8>& Out) const;
+	void AppendEscaped(FStringView Text);
+	void AppendEscaped(FUtf8StringView Text);
+	void AppendEscapedAscii(uint8 Character);
+
+	TArray<uint8> Buffer;
+	TArray<uint8, TInlineAllocator<32>> Scopes;
+	bool bAfterKey = false;
+	int32 InitialCapacity = 0;
+};
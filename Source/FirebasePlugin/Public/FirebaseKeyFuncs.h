@@ -0,0 +1,39 @@
+// Copyright. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * TMap key functions that hash and compare FString keys case-sensitively.
+ *
+ * FString map keys ignore case by default, but database paths and keys do
+ * not: "Players/A" and "players/a" are different nodes.
+ *
+ *   TMap<FString, int32, FDefaultSetAllocator, TFirebaseCaseSensitiveKeyFuncs<int32>> Map;
+ */
+template <typename ValueType>
+struct TFirebaseCaseSensitiveKeyFuncs : BaseKeyFuncs<TPair<FString, ValueType>, FString, /*bInAllowDuplicateKeys=*/ false>
+{
+	using KeyInitType = typename BaseKeyFuncs<TPair<FString, ValueType>, FString, false>::KeyInitType;
+	using ElementInitType = typename BaseKeyFuncs<TPair<FString, ValueType>, FString, false>::ElementInitType;
+
+	static KeyInitType GetSetKey(ElementInitType Element)
+	{
+		return Element.Key;
+	}
+
+	static bool Matches(KeyInitType A, KeyInitType B)
+	{
+		return A.Equals(B, ESearchCase::CaseSensitive);
+	}
+
+	static uint32 GetKeyHash(KeyInitType Key)
+	{
+		return FCrc::StrCrc32(*Key);
+	}
+};
+
+/** FString-keyed map whose keys differ when their case does */
+template <typename ValueType>
+using TFirebaseCaseSensitiveMap = TMap<FString, ValueType, FDefaultSetAllocator, TFirebaseCaseSensitiveKeyFuncs<ValueType>>;
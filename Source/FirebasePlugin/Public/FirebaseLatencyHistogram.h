@@ -0,0 +1,69 @@
+// Copyright. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Percentile summary of a latency histogram, in seconds
+ */
+struct FIREBASEPLUGIN_API FFirebaseLatencySummary
+{
+	uint64 Count = 0;
+	double P50 = 0.0;
+	double P90 = 0.0;
+	double P99 = 0.0;
+	double Max = 0.0;
+	double Mean = 0.0;
+};
+
+/**
+ * Fixed-size log-linear latency histogram.
+ *
+ * Samples are counted in microsecond buckets: exact below 16 us, then 16
+ * buckets per power of two, so a percentile is never more than 1/16 (6.25%)
+ * above the true value. The range ends at 2^27 us (~134 s); slower samples
+ * land in the last bucket but still update the exact maximum. Recording is
+ * a couple of shifts and an increment, and histograms of the same shape can
+ * be merged, so rolling windows and per-key breakdowns stay cheap.
+ */
+class FIREBASEPLUGIN_API FFirebaseLatencyHistogram
+{
+public:
+	static constexpr int32 SubBucketBits = 4;
+	static constexpr int32 SubBucketCount = 1 << SubBucketBits;
+	static constexpr int32 RangeBits = 27;
+	static constexpr int32 NumBuckets = (RangeBits - SubBucketBits + 1) * SubBucketCount;
+
+	FFirebaseLatencyHistogram();
+
+	/** Count one sample; negative values count as zero */
+	void Record(double Seconds);
+
+	/** Add the samples of another histogram */
+	void Merge(const FFirebaseLatencyHistogram& Other);
+
+	/** Forget every sample */
+	void Reset();
+
+	/** Latency at or below which Percent (0-100) of the samples fall; 0 when empty */
+	double GetPercentile(double Percent) const;
+
+	double GetMax() const { return double(MaxMicros) * 1e-6; }
+	double GetMean() const { return Count > 0 ? double(SumMicros) * 1e-6 / double(Count) : 0.0; }
+	uint64 Num() const { return Count; }
+
+	/** p50/p90/p99/max/mean in one pass */
+	FFirebaseLatencySummary Summarize() const;
+
+private:
+	static int32 GetBucketIndex(uint64 Micros);
+
+	/** Largest value counted by a bucket */
+	static uint64 GetBucketUpperBound(int32 Index);
+
+	uint32 Counts[NumBuckets];
+	uint64 Count = 0;
+	uint64 SumMicros = 0;
+	uint64 MaxMicros = 0;
+};
@@ -0,0 +1,112 @@
+// Copyright. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Logging/LogMacros.h"
+#include <atomic>
+
+struct FFirebaseHttpResponse;
+
+/**
+ * Most verbose LogFirebase level compiled in. Shipping keeps warnings and errors
+ * only, so Log/Verbose lines and their formatting cost nothing there. Define it
+ * in the target's Build.cs to override.
+ */
+#ifndef FIREBASE_LOG_COMPILE_VERBOSITY
+	#if UE_BUILD_SHIPPING
+		#define FIREBASE_LOG_COMPILE_VERBOSITY Warning
+	#else
+		#define FIREBASE_LOG_COMPILE_VERBOSITY All
+	#endif
+#endif
+
+FIREBASEPLUGIN_API DECLARE_LOG_CATEGORY_EXTERN(LogFirebase, Log, FIREBASE_LOG_COMPILE_VERBOSITY);
+
+/**
+ * Helpers for putting server data in log lines
+ */
+struct FIREBASEPLUGIN_API FFirebaseLog
+{
+	/**
+	 * Redacted and truncated copy of a request or response body.
+	 * Limited to Firebase.Log.MaxBodyChars (0 omits the body and logs its length).
+	 */
+	static FString Body(FStringView Text);
+
+	/** Same for a UTF-8 body; only the part that is logged is converted (lengths are in bytes) */
+	static FString Body(FUtf8StringView Text);
+
+	/** Replace token, password and API key values (JSON fields and URL query params) with "<redacted>" */
+	static FString Redact(FStringView Text);
+
+	/** Set LogFirebase to Verbose or Log from UFirebaseSettings::bEnableVerboseLogging */
+	static void ApplySettings();
+};
+
+/**
+ * One completed REST request, as kept by FFirebaseRequestLog.
+ * Fixed size so slots can be overwritten without allocating.
+ */
+struct FFirebaseRequestLogEntry
+{
+	/** FPlatformTime::Seconds() when the response arrived */
+	double Time = 0.0;
+
+	/** FFirebaseTrace correlation id, 0 when tracing is compiled out */
+	uint64 TraceId = 0;
+
+	float ElapsedMs = -1.0f;
+	int32 Status = 0;
+	int32 Bytes = 0;
+	bool bSucceeded = false;
+
+	/** Method or kind ("GET", "AUTH", "POLL") */
+	TCHAR Operation[8] = {};
+
+	/** First path segment or auth endpoint, truncated; never the query string */
+	TCHAR Path[56] = {};
+};
+
+/**
+ * Fixed-size ring of the most recent REST request summaries.
+ *
+ * Recording is lock-free and allocation-free: writers claim a slot with an
+ * atomic counter and publish it through a per-slot sequence number, so
+ * readers (the dump command, the crash handler) copy entries without
+ * blocking the game thread and skip any slot caught mid-write.
+ *
+ * Dump with `Firebase.Log.Dump`; it is also written to the log when the
+ * engine handles a crash.
+ */
+class FIREBASEPLUGIN_API FFirebaseRequestLog
+{
+public:
+	static constexpr int32 Capacity = 256;
+
+	static FFirebaseRequestLog& Get();
+
+	void Record(FStringView Operation, FStringView Path, uint64 TraceId, const FFirebaseHttpResponse& Response);
+
+	/** Copy out the recorded entries, oldest first */
+	void Snapshot(TArray<FFirebaseRequestLogEntry>& OutEntries) const;
+
+	void Dump(FOutputDevice& Ar) const;
+
+	/** Forget every entry (not safe against concurrent Record calls) */
+	void Reset();
+
+private:
+	/** Visit each complete entry, oldest first, without allocating */
+	void ForEachEntry(TFunctionRef<void(const FFirebaseRequestLogEntry&)> Visitor) const;
+
+	struct FSlot
+	{
+		/** 2 * (n + 1) once entry n is written, odd while it is being written */
+		std::atomic<uint64> Sequence{ 0 };
+		FFirebaseRequestLogEntry Entry;
+	};
+
+	FSlot Slots[Capacity];
+	std::atomic<uint64> NextIndex{ 0 };
+};
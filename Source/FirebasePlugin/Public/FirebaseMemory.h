@@ -0,0 +1,119 @@
+// Copyright. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+#include <atomic>
+
+/**
+ * Low Level Memory tracker tags for the plugin. Every allocation made inside
+ * an LLM_SCOPE_BYTAG(Firebase_...) scope is reported under Firebase/<Tag> in
+ * `stat LLMFULL` and LLM CSV captures (run with -LLM).
+ */
+LLM_DECLARE_TAG_API(Firebase, FIREBASEPLUGIN_API);
+
+/** HTTP requests and responses in flight */
+LLM_DECLARE_TAG_API(Firebase_Transport, FIREBASEPLUGIN_API);
+
+/** Payload bytes and the buffer pool */
+LLM_DECLARE_TAG_API(Firebase_Buffers, FIREBASEPLUGIN_API);
+
+/** Parsed documents, values and JSON being built */
+LLM_DECLARE_TAG_API(Firebase_Json, FIREBASEPLUGIN_API);
+
+/** Value, connection and polling listener registries */
+LLM_DECLARE_TAG_API(Firebase_Listeners, FIREBASEPLUGIN_API);
+
+/** Android SDK operations waiting for a result */
+LLM_DECLARE_TAG_API(Firebase_PendingOps, FIREBASEPLUGIN_API);
+
+/** Offline and rate-limit request queues */
+LLM_DECLARE_TAG_API(Firebase_Queues, FIREBASEPLUGIN_API);
+
+/** Metrics, request log and traffic recordings */
+LLM_DECLARE_TAG_API(Firebase_Diagnostics, FIREBASEPLUGIN_API);
+
+/**
+ * Parts of the plugin's memory that count against the budget
+ */
+enum class EFirebaseMemoryCategory : uint8
+{
+	/** Buffers the pool keeps for reuse; evicted first when the budget is tight */
+	Buffers,
+
+	/** Requests held in the offline and rate-limit queues */
+	Queues,
+
+	/** Android SDK operations waiting for a result */
+	PendingOps,
+
+	/** Registered listeners; counted, never refused */
+	Listeners,
+
+	/** Traffic recordings */
+	Diagnostics,
+
+	Num
+};
+
+FIREBASEPLUGIN_API const TCHAR* LexToString(EFirebaseMemoryCategory Category);
+
+/**
+ * Plugin-wide memory accounting and budget.
+ *
+ * Containers that grow with traffic report what they hold here. With a
+ * budget set (UFirebaseSettings::MemoryBudgetKB), growth that would exceed
+ * it first evicts pooled buffers and is then refused: queues and pending-op
+ * tables fail the new request as if they were full, the buffer pool frees
+ * instead of keeping, and a traffic recording stops growing. Listeners are
+ * counted but never refused, since dropping one would lose updates silently.
+ *
+ * Sizes are estimates of the heap each entry keeps alive, not allocator
+ * truth; LLM gives the exact numbers. Thread-safe. `Firebase.Memory.Dump`
+ * prints the breakdown, and `stat Firebase` shows the totals.
+ */
+class FIREBASEPLUGIN_API FFirebaseMemory
+{
+public:
+	static FFirebaseMemory& Get();
+
+	/** Take the budget from UFirebaseSettings */
+	void ApplySettings();
+
+	/** Most bytes the tracked categories may hold together; 0 = unlimited. Shrinking evicts pooled buffers. */
+	void SetBudget(int64 InBudgetBytes);
+	int64 GetBudget() const { return BudgetBytes.load(std::memory_order_relaxed); }
+
+	/**
+	 * Account for Bytes more in Category if they fit in the budget, evicting
+	 * pooled buffers to make room when needed.
+	 * @return False if they do not fit; nothing is accounted then
+	 */
+	bool Reserve(EFirebaseMemoryCategory Category, int64 Bytes);
+
+	/** Like Reserve, but never evicts (for the buffer pool itself) */
+	bool TryReserve(EFirebaseMemoryCategory Category, int64 Bytes);
+
+	/** Account for Bytes unconditionally */
+	void Add(EFirebaseMemoryCategory Category, int64 Bytes);
+
+	/** Give back Bytes accounted with Reserve or Add */
+	void Release(EFirebaseMemoryCategory Category, int64 Bytes);
+
+	int64 GetUsage(EFirebaseMemoryCategory Category) const;
+	int64 GetTotal() const { return TotalBytes.load(std::memory_order_relaxed); }
+
+	/** Times growth was refused since startup */
+	int64 GetRefusals() const { return Refusals.load(std::memory_order_relaxed); }
+
+	void Dump(FOutputDevice& Ar) const;
+
+private:
+	FFirebaseMemory() = default;
+
+	std::atomic<int64> Usage[(int32)EFirebaseMemoryCategory::Num] = {};
+	std::atomic<int64> TotalBytes{ 0 };
+	std::atomic<int64> BudgetBytes{ 0 };
+	std::atomic<int64> Refusals{ 0 };
+};
@@ -0,0 +1,186 @@
+// Copyright. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/RandomStream.h"
+#include "FirebaseHttpTransport.h"
+#include "FirebaseResponseSchedule.h"
+
+/**
+ * Shape of the round-trip latency distribution
+ */
+enum class EFirebaseLatencyDistribution : uint8
+{
+	/** Always LatencySeconds */
+	Constant,
+
+	/** LatencySeconds +/- LatencySpreadSeconds */
+	Uniform,
+
+	/** Mean LatencySeconds, standard deviation LatencySpreadSeconds */
+	Normal,
+
+	/** Median LatencySeconds, log-space sigma LatencyShape; long right tail like real RTTs */
+	LogNormal,
+
+	/** Minimum LatencySeconds, tail index LatencyShape; heavy tail of congested links */
+	Pareto
+};
+
+/**
+ * Degraded network conditions applied by FFirebaseNetworkShaper
+ */
+struct FIREBASEPLUGIN_API FFirebaseNetworkProfile
+{
+	EFirebaseLatencyDistribution LatencyDistribution = EFirebaseLatencyDistribution::Constant;
+
+	/** Round-trip latency (mean, median or minimum, see the distribution) */
+	float LatencySeconds = 0.0f;
+
+	/** Half-width (Uniform) or standard deviation (Normal) */
+	float LatencySpreadSeconds = 0.0f;
+
+	/** Sigma (LogNormal) or tail index (Pareto) */
+	float LatencyShape = 1.0f;
+
+	/** Extra uniform delay in [0, JitterSeconds] per request */
+	float JitterSeconds = 0.0f;
+
+	/** Upper bound of a latency sample */
+	float MaxLatencySeconds = 30.0f;
+
+	/** Link capacity in bytes per second, shared by concurrent requests; 0 is unlimited */
+	int64 UplinkBytesPerSecond = 0;
+	int64 DownlinkBytesPerSecond = 0;
+
+	/** Chance that a request never reaches the server */
+	float RequestLossProbability = 0.0f;
+
+	/** Chance that the server handles a request but its response is lost */
+	float ResponseLossProbability = 0.0f;
+
+	/** When a lost request fails if it set no timeout of its own (the HTTP module's default) */
+	float LossTimeoutSeconds = 30.0f;
+
+	/** Chance that a response is held back by up to ReorderDelaySeconds, letting later ones overtake it */
+	float ReorderProbability = 0.0f;
+	float ReorderDelaySeconds = 0.0f;
+
+	/** Chance that a response body is cut short at a random byte (status and headers stay intact) */
+	float TruncationProbability = 0.0f;
+
+	/** No degradation */
+	static FFirebaseNetworkProfile Ideal() { return FFirebaseNetworkProfile(); }
+
+	/** UMTS/HSPA handset: ~300 ms RTT, 1.6 Mbit/s down, 750 kbit/s up, occasional loss */
+	static FFirebaseNetworkProfile Mobile3G();
+
+	/** LTE handset: ~70 ms RTT, 9 Mbit/s down, 3 Mbit/s up */
+	static FFirebaseNetworkProfile Mobile4G();
+
+	/** Busy shared access point: heavy-tailed latency, 2 Mbit/s, frequent loss and reordering */
+	static FFirebaseNetworkProfile CongestedWiFi();
+
+	/** Every request is lost */
+	static FFirebaseNetworkProfile Offline();
+
+	/** Profile by name ("Ideal", "Mobile3G", "Mobile4G", "CongestedWiFi", "Offline"; case-insensitive) */
+	static bool FindByName(const FString& Name, FFirebaseNetworkProfile& OutProfile);
+};
+
+/**
+ * Counters of what FFirebaseNetworkShaper did to the traffic
+ */
+struct FIREBASEPLUGIN_API FFirebaseNetworkShaperStats
+{
+	int64 Requests = 0;
+	int64 RequestsLost = 0;
+	int64 ResponsesLost = 0;
+	int64 TimedOut = 0;
+	int64 Reordered = 0;
+	int64 Truncated = 0;
+	int64 BytesUp = 0;
+	int64 BytesDown = 0;
+};
+
+/**
+ * Transport decorator that degrades the traffic of another transport.
+ *
+ * Each request gets a sampled round trip, serialises behind earlier
+ * transfers on a bandwidth-limited link and may be lost, delayed out of
+ * order or truncated. Responses are held on a virtual clock (see
+ * FFirebaseResponseSchedule): call Advance() to move it, or SetRealTime(true)
+ * when the inner transport is the real network. Random choices come from a
+ * seeded stream, so a run over FFirebaseInMemoryTransport is reproducible.
+ *
+ * Create with MakeShared; responses of the inner transport only hold a weak
+ * reference to the shaper.
+ */
+class FIREBASEPLUGIN_API FFirebaseNetworkShaper : public IFirebaseHttpTransport, public TSharedFromThis<FFirebaseNetworkShaper>
+{
+public:
+	FFirebaseNetworkShaper(TSharedRef<IFirebaseHttpTransport> InInner, const FFirebaseNetworkProfile& InProfile = FFirebaseNetworkProfile(), int32 Seed = 0);
+
+	//~ Begin IFirebaseHttpTransport Interface
+	virtual FFirebaseHttpRequestId Send(FFirebaseHttpRequest&& Request, FFirebaseHttpCallback&& OnComplete) override;
+	virtual void Cancel(FFirebaseHttpRequestId RequestId) override;
+	//~ End IFirebaseHttpTransport Interface
+
+	/** Conditions for requests sent from now on */
+	void SetProfile(const FFirebaseNetworkProfile& InProfile) { Profile = InProfile; }
+	const FFirebaseNetworkProfile& GetProfile() const { return Profile; }
+
+	/** Restart the random sequence */
+	void SetSeed(int32 Seed) { Random.Initialize(Seed); }
+
+	/** Move the virtual clock forward and deliver the responses now due */
+	int32 Advance(double Seconds) { return Schedule.Advance(Seconds); }
+
+	/** Deliver every held response now */
+	int32 Flush() { return Schedule.Flush(); }
+
+	/** Advance the clock by the core ticker's delta time */
+	void SetRealTime(bool bEnabled) { Schedule.SetRealTime(bEnabled); }
+
+	double GetTime() const { return Schedule.GetTime(); }
+
+	/** Requests sent to the inner transport or held on the clock */
+	int32 GetNumPending() const { return InFlight.Num() + Schedule.Num(); }
+
+	const FFirebaseNetworkShaperStats& GetStats() const { return Stats; }
+	void ResetStats() { Stats = FFirebaseNetworkShaperStats(); }
+
+	/** One round-trip latency sample in seconds */
+	double SampleLatency();
+
+private:
+	struct FInFlightRequest
+	{
+		FFirebaseHttpCallback OnComplete;
+		FFirebaseHttpRequestId InnerId = 0;
+		double SendTime = 0.0;
+		double UploadDoneTime = 0.0;
+		double Deadline = 0.0;
+		double LatencySeconds = 0.0;
+	};
+
+	void OnInnerResponse(FFirebaseHttpRequestId RequestId, const FFirebaseHttpResponse& Response);
+
+	/** Deliver now if due, otherwise hold on the clock */
+	void Deliver(FFirebaseHttpRequestId RequestId, double DueTime, FFirebaseHttpResponse&& Response, FFirebaseHttpCallback&& OnComplete);
+
+	TSharedRef<IFirebaseHttpTransport> Inner;
+	FFirebaseNetworkProfile Profile;
+	FRandomStream Random;
+
+	FFirebaseResponseSchedule Schedule;
+	TMap<FFirebaseHttpRequestId, FInFlightRequest> InFlight;
+	FFirebaseHttpRequestId NextRequestId = 1;
+
+	// Times at which the shared links finish their queued transfers
+	double UplinkFreeTime = 0.0;
+	double DownlinkFreeTime = 0.0;
+
+	FFirebaseNetworkShaperStats Stats;
+};
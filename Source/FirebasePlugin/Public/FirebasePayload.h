@@ -0,0 +1,66 @@
+// Copyright. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Interfaces/IHttpResponse.h"
+
+/**
+ * Immutable UTF-8 JSON payload.
+ *
+ * Copies share the same bytes. A payload created from an HTTP response views
+ * the response content directly and keeps the response alive, so a body is
+ * never copied or transcoded on its way from the wire to native consumers.
+ * Convert with ToString() only where an FString is really required
+ * (Blueprint results, logging).
+ */
+class FIREBASEPLUGIN_API FFirebasePayload
+{
+public:
+	/** Empty payload */
+	FFirebasePayload() = default;
+
+	/** View the body of an HTTP response (no copy) */
+	static FFirebasePayload FromResponse(const FHttpResponsePtr& Response);
+
+	/** Take ownership of UTF-8 bytes; they are handed to FFirebaseBufferPool once no payload uses them */
+	static FFirebasePayload FromUtf8(TArray<uint8>&& Bytes);
+
+	/** Copy UTF-8 bytes */
+	static FFirebasePayload FromUtf8(FUtf8StringView Text);
+
+	/** Transcode an FString once */
+	static FFirebasePayload FromString(const FString& Text);
+
+	/** Pointer to the first byte (not null-terminated) */
+	const uint8* GetData() const { return Data; }
+
+	/** Size in bytes */
+	int32 Num() const { return Size; }
+
+	/** Whether the payload has no bytes */
+	bool IsEmpty() const { return Size == 0; }
+
+	/** Bytes as a view */
+	TArrayView<const uint8> GetBytes() const { return TArrayView<const uint8>(Data, Size); }
+
+	/** Bytes as a UTF-8 string view */
+	FUtf8StringView GetView() const { return FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Data), Size); }
+
+	/** Transcode to UTF-16 (allocates) */
+	FString ToString() const;
+
+	/** Cheap content hash (CRC32 of the bytes) */
+	uint32 GetHash() const;
+
+	/** Byte-wise comparison */
+	bool Equals(const FFirebasePayload& Other) const;
+
+private:
+	// Exactly one owner keeps Data alive
+	FHttpResponsePtr Response;
+	TSharedPtr<const TArray<uint8>, ESPMode::ThreadSafe> Buffer;
+
+	const uint8* Data = nullptr;
+	int32 Size = 0;
+};
@@ -0,0 +1,155 @@
+// Copyright. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FirebaseMemory.h"
+
+/**
+ * Table of in-flight operations keyed by integer id.
+ *
+ * Completion and lookup are O(1). Every operation carries its own deadline;
+ * expired operations are handed back by CollectExpired so the owner can fail
+ * their delegates. The table holds at most MaxOutstanding operations, and
+ * refuses new ones while the plugin's memory budget (FFirebaseMemory) is full.
+ */
+template <typename OperationType>
+class TFirebasePendingOperations
+{
+public:
+	/** Id never handed out for a registered operation */
+	static constexpr int64 InvalidId = 0;
+
+	/** Set the cap on outstanding operations and the default timeout */
+	void Configure(int32 InMaxOutstanding, double InDefaultTimeoutSeconds)
+	{
+		MaxOutstanding = FMath::Max(InMaxOutstanding, 1);
+		DefaultTimeoutSeconds = FMath::Max(InDefaultTimeoutSeconds, 0.0);
+	}
+
+	/** Allocate an id without tracking an operation (for fire-and-forget calls) */
+	int64 AllocateId()
+	{
+		return NextId++;
+	}
+
+	/**
+	 * Track an operation until its result arrives or it times out.
+	 * @param TimeoutSeconds Per-operation timeout, negative uses the default (0 = never)
+	 * @return Operation id, or InvalidId if the table or the memory budget is full
+	 */
+	int64 Add(const OperationType& Operation, double Now, double TimeoutSeconds = -1.0)
+	{
+		if (Entries.Num() >= MaxOutstanding || !FFirebaseMemory::Get().Reserve(EFirebaseMemoryCategory::PendingOps, EntryBytes))
+		{
+			return InvalidId;
+		}
+
+		LLM_SCOPE_BYTAG(Firebase_PendingOps);
+
+		const int64 Id = AllocateId();
+		const double Timeout = TimeoutSeconds < 0.0 ? DefaultTimeoutSeconds : TimeoutSeconds;
+		const double Deadline = Timeout > 0.0 ? Now + Timeout : TNumericLimits<double>::Max();
+
+		Entries.Add(Id, FEntry{ Operation, Deadline });
+		if (Timeout > 0.0)
+		{
+			Deadlines.HeapPush(FDeadline{ Deadline, Id });
+		}
+		return Id;
+	}
+
+	/**
+	 * Remove exactly the matching operation.
+	 * @return True if the id was pending (OutOperation is then set)
+	 */
+	bool Complete(int64 Id, OperationType& OutOperation)
+	{
+		FEntry Entry;
+		if (!Entries.RemoveAndCopyValue(Id, Entry))
+		{
+			return false;
+		}
+
+		OutOperation = MoveTemp(Entry.Operation);
+		FFirebaseMemory::Get().Release(EFirebaseMemoryCategory::PendingOps, EntryBytes);
+		CompactDeadlines();
+		return true;
+	}
+
+	/** Remove every operation whose deadline has passed, oldest first */
+	void CollectExpired(double Now, TArray<TPair<int64, OperationType>>& OutExpired)
+	{
+		while (Deadlines.Num() > 0 && Deadlines.HeapTop().Time <= Now)
+		{
+			FDeadline Top;
+			Deadlines.HeapPop(Top);
+
+			// Entries completed earlier leave stale deadlines behind
+			FEntry Entry;
+			if (Entries.RemoveAndCopyValue(Top.Id, Entry))
+			{
+				FFirebaseMemory::Get().Release(EFirebaseMemoryCategory::PendingOps, EntryBytes);
+				OutExpired.Emplace(Top.Id, MoveTemp(Entry.Operation));
+			}
+		}
+	}
+
+	/** Remove every operation (e.g. on shutdown) */
+	void Reset(TArray<TPair<int64, OperationType>>& OutRemoved)
+	{
+		for (TPair<int64, FEntry>& Pair : Entries)
+		{
+			OutRemoved.Emplace(Pair.Key, MoveTemp(Pair.Value.Operation));
+		}
+		FFirebaseMemory::Get().Release(EFirebaseMemoryCategory::PendingOps, EntryBytes * Entries.Num());
+		Entries.Reset();
+		Deadlines.Reset();
+	}
+
+	/** Number of outstanding operations */
+	int32 Num() const { return Entries.Num(); }
+
+	/** Whether the table can accept another operation */
+	bool IsFull() const { return Entries.Num() >= MaxOutstanding; }
+
+private:
+	struct FEntry
+	{
+		OperationType Operation;
+		double Deadline = 0.0;
+	};
+
+	struct FDeadline
+	{
+		double Time = 0.0;
+		int64 Id = InvalidId;
+
+		bool operator<(const FDeadline& Other) const { return Time < Other.Time; }
+	};
+
+	/** Estimated bytes per operation: its map entry and deadline; captured delegate state is not included */
+	static constexpr int64 EntryBytes = sizeof(TPair<int64, FEntry>) + sizeof(FDeadline);
+
+	/** Drop stale deadlines once they dominate the heap so memory stays bounded */
+	void CompactDeadlines()
+	{
+		if (Deadlines.Num() <= 2 * Entries.Num() + 64)
+		{
+			return;
+		}
+
+		Deadlines.RemoveAllSwap([this](const FDeadline& Deadline)
+		{
+			const FEntry* Entry = Entries.Find(Deadline.Id);
+			return !Entry || Entry->Deadline != Deadline.Time;
+		});
+		Deadlines.Heapify();
+	}
+
+	TMap<int64, FEntry> Entries;
+	TArray<FDeadline> Deadlines;
+	int64 NextId = 1;
+	int32 MaxOutstanding = 256;
+	double DefaultTimeoutSeconds = 30.0;
+};
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
+#include "Containers/Ticker.h"
 
 /**
  * Firebase Plugin Module
@@ -21,4 +22,8 @@ private:
 	
 	/** Unregister plugin settings */
 	void UnregisterSettings();
+
+	FDelegateHandle MemoryTrimHandle;
+	FTSTicker::FDelegateHandle StatsTickHandle;
+	FDelegateHandle SystemErrorHandle;
 };
@@ -0,0 +1,203 @@
+// Copyright. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FirebaseRestTypes.h"
+#include "FirebaseRateLimiter.generated.h"
+
+/**
+ * Operation types a rate limit rule applies to
+ */
+UENUM(BlueprintType)
+enum class EFirebaseRateLimitOperation : uint8
+{
+	Any UMETA(DisplayName = "Any"),
+	Read UMETA(DisplayName = "Read (GET)"),
+	Write UMETA(DisplayName = "Write (PUT/PATCH/POST)"),
+	Delete UMETA(DisplayName = "Delete")
+};
+
+/**
+ * What happens to requests that exceed their limit
+ */
+UENUM(BlueprintType)
+enum class EFirebaseRateLimitOverflow : uint8
+{
+	/** Queue the request; back-to-back writes to the same path are merged and only the latest is sent */
+	Coalesce UMETA(DisplayName = "Coalesce (Keep Latest)"),
+	/** Queue every request and send them in order as the limit allows */
+	Queue UMETA(DisplayName = "Queue"),
+	/** Fail the request immediately */
+	Reject UMETA(DisplayName = "Reject")
+};
+
+/**
+ * Token bucket rule for a database path prefix
+ */
+USTRUCT(BlueprintType)
+struct FIREBASEPLUGIN_API FFirebaseRateLimitRule
+{
+	GENERATED_BODY()
+
+	/** Path prefix this rule applies to (empty matches every path) */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Firebase|RateLimit")
+	FString PathPrefix;
+
+	/** Operation type this rule applies to */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Firebase|RateLimit")
+	EFirebaseRateLimitOperation Operation = EFirebaseRateLimitOperation::Write;
+
+	/** Sustained requests per second */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Firebase|RateLimit",
+		meta = (ClampMin = "0.01"))
+	float RequestsPerSecond = 10.0f;
+
+	/** Requests that may be sent back-to-back before throttling starts */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Firebase|RateLimit",
+		meta = (ClampMin = "1"))
+	int32 BurstSize = 20;
+
+	/** Handling of requests over the limit */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Firebase|RateLimit")
+	EFirebaseRateLimitOverflow Overflow = EFirebaseRateLimitOverflow::Coalesce;
+
+	/** Requests held back before further requests are rejected */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Firebase|RateLimit",
+		meta = (ClampMin = "1"))
+	int32 MaxQueuedRequests = 256;
+};
+
+/**
+ * Live state of one rate limit rule
+ */
+USTRUCT(BlueprintType)
+struct FIREBASEPLUGIN_API FFirebaseRateLimiterStats
+{
+	GENERATED_BODY()
+
+	/** Path prefix of the rule */
+	UPROPERTY(BlueprintReadOnly, Category = "Firebase|RateLimit")
+	FString PathPrefix;
+
+	/** Operation type of the rule */
+	UPROPERTY(BlueprintReadOnly, Category = "Firebase|RateLimit")
+	EFirebaseRateLimitOperation Operation = EFirebaseRateLimitOperation::Any;
+
+	/** Tokens currently available */
+	UPROPERTY(BlueprintReadOnly, Category = "Firebase|RateLimit")
+	float AvailableTokens = 0.0f;
+
+	/** Requests waiting for a token */
+	UPROPERTY(BlueprintReadOnly, Category = "Firebase|RateLimit")
+	int32 QueuedRequests = 0;
+
+	/** Requests sent through this rule */
+	UPROPERTY(BlueprintReadOnly, Category = "Firebase|RateLimit")
+	int64 SentRequests = 0;
+
+	/** Requests that had to wait for a token */
+	UPROPERTY(BlueprintReadOnly, Category = "Firebase|RateLimit")
+	int64 ThrottledRequests = 0;
+
+	/** Requests merged into a newer queued request */
+	UPROPERTY(BlueprintReadOnly, Category = "Firebase|RateLimit")
+	int64 CoalescedRequests = 0;
+
+	/** Requests failed because of the limit */
+	UPROPERTY(BlueprintReadOnly, Category = "Firebase|RateLimit")
+	int64 RejectedRequests = 0;
+};
+
+/**
+ * A database request that has not been sent yet
+ */
+struct FIREBASEPLUGIN_API FFirebaseQueuedRequest
+{
+	FString Path;
+	FString Method;
+	FString Url;
+	FFirebasePayload Body;
+	FFirebaseRestPayloadCallback Callback;
+
+	/** Time the request entered the pipeline (FPlatformTime::Seconds) */
+	double EnqueueTime = 0.0;
+
+	/** Correlation id of the request's trace events */
+	uint64 TraceId = 0;
+
+	/** Callbacks of older requests that were merged into this one */
+	TArray<FFirebaseRestPayloadCallback> CoalescedCallbacks;
+
+	/** Bytes counted against FFirebaseMemory while the request waits in a queue */
+	int64 ReservedBytes = 0;
+
+	/** Heap the request keeps alive (strings, body, merged callbacks) */
+	SIZE_T GetAllocatedSize() const;
+
+	/** Count the request against the memory budget as it enters a queue; false if the budget is full */
+	bool ReserveMemory();
+
+	/** Stop counting it as it leaves its queue */
+	void ReleaseMemory();
+};
+
+/**
+ * Client-side token bucket limiter keyed by path prefix and operation type
+ */
+class FIREBASEPLUGIN_API FFirebaseRateLimiter
+{
+public:
+	~FFirebaseRateLimiter();
+
+	enum class EAdmitResult : uint8
+	{
+		/** A token was taken; send the request now */
+		Send,
+		/** The request was queued or merged into a queued request */
+		Deferred,
+		/** The request must be failed */
+		Rejected
+	};
+
+	/** Replace all rules (queued requests of removed rules are released) */
+	void SetRules(const TArray<FFirebaseRateLimitRule>& InRules, TArray<FFirebaseQueuedRequest>& OutReleased);
+
+	/** Whether any rule is configured */
+	bool HasRules() const { return Buckets.Num() > 0; }
+
+	/**
+	 * Try to admit a request. On Deferred the request has been moved into the limiter.
+	 * Requests that would have to wait are also rejected while the memory budget is full.
+	 */
+	EAdmitResult Admit(FFirebaseQueuedRequest& Request, double Now);
+
+	/** Move queued requests whose bucket has refilled into OutReady, in queue order */
+	void Tick(double Now, TArray<FFirebaseQueuedRequest>& OutReady);
+
+	/** Whether any request is waiting for a token */
+	bool HasQueuedRequests() const;
+
+	/** Snapshot of every rule */
+	TArray<FFirebaseRateLimiterStats> GetStats(double Now) const;
+
+	/** Classify an HTTP method */
+	static EFirebaseRateLimitOperation GetOperationType(const FString& Method);
+
+private:
+	struct FBucket
+	{
+		FFirebaseRateLimitRule Rule;
+		double Tokens = 0.0;
+		double LastRefillTime = 0.0;
+		TArray<FFirebaseQueuedRequest> Queue;
+		FFirebaseRateLimiterStats Stats;
+	};
+
+	TArray<FBucket> Buckets;
+
+	int32 FindBucket(const FString& Path, EFirebaseRateLimitOperation Operation) const;
+	static void Refill(FBucket& Bucket, double Now);
+	static bool TryCoalesce(FBucket& Bucket, FFirebaseQueuedRequest& Request);
+	static FFirebasePayload MergePatchBodies(const FFirebasePayload& OlderBody, const FFirebasePayload& NewerBody);
+};
@@ -0,0 +1,60 @@
+// Copyright. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "FirebaseHttpTransport.h"
+
+/**
+ * Responses waiting for their delivery time on a virtual clock.
+ *
+ * The clock only moves when Advance() is called (or every frame with
+ * SetRealTime), so test transports decide exactly when, and in which order,
+ * requests complete. Responses due at the same time keep the order they
+ * were scheduled in.
+ */
+class FIREBASEPLUGIN_API FFirebaseResponseSchedule
+{
+public:
+	~FFirebaseResponseSchedule();
+
+	/** Deliver Response to OnComplete once the clock reaches DueTime */
+	void Add(FFirebaseHttpRequestId RequestId, double DueTime, FFirebaseHttpResponse&& Response, FFirebaseHttpCallback&& OnComplete);
+
+	/** Drop a scheduled response; its callback is handed back if OutOnComplete is given */
+	bool Remove(FFirebaseHttpRequestId RequestId, FFirebaseHttpCallback* OutOnComplete = nullptr);
+
+	/** Move the clock forward and deliver every response that is now due; returns how many were delivered */
+	int32 Advance(double Seconds);
+
+	/** Deliver every scheduled response now, in due order */
+	int32 Flush();
+
+	/** Advance the clock by the core ticker's delta time */
+	void SetRealTime(bool bEnabled);
+
+	/** Current virtual time in seconds */
+	double GetTime() const { return Now; }
+
+	/** Responses not delivered yet */
+	int32 Num() const { return Pending.Num(); }
+
+private:
+	struct FEntry
+	{
+		FFirebaseHttpRequestId RequestId = 0;
+		double DueTime = 0.0;
+		uint64 Sequence = 0;
+		FFirebaseHttpResponse Response;
+		FFirebaseHttpCallback OnComplete;
+	};
+
+	/** Take the earliest entry due by Until */
+	bool PopDue(double Until, FEntry& OutEntry);
+
+	TArray<FEntry> Pending;
+	double Now = 0.0;
+	uint64 NextSequence = 0;
+	FTSTicker::FDelegateHandle TickHandle;
+};
@@ -5,9 +5,78 @@
 #include "CoreMinimal.h"
 #include "Http.h"
 #include "Dom/JsonObject.h"
+#include "Containers/Ticker.h"
+#include "FirebaseRestTypes.h"
+#include "FirebaseRateLimiter.h"
+#include "FirebaseConnectivityMonitor.h"
+#include "FirebaseUrlBuilder.h"
+#include "FirebaseHttpTransport.h"
+#include "FirebaseKeyFuncs.h"
 #include "FirebaseRestAPI.generated.h"
 
-DECLARE_DELEGATE_TwoParams(FFirebaseRestCallback, bool /*bSuccess*/, const FString& /*Response*/);
+class UFirebaseSettings;
+struct FFirebaseRequestKey;
+struct FFirebasePollingListener;
+
+/**
+ * Tuning for hedged reads (duplicate GETs for slow responses)
+ */
+struct FIREBASEPLUGIN_API FFirebaseHedgingConfig
+{
+	/** Hedging is opt-in */
+	bool bEnabled = false;
+
+	/** Percentile of recent read latencies after which a hedge is sent */
+	float DelayPercentile = 95.0f;
+
+	/** Delay used until enough latency samples have been collected */
+	float InitialDelaySeconds = 0.5f;
+
+	/** Lower bound for the hedge delay */
+	float MinDelaySeconds = 0.05f;
+
+	/** Maximum hedges as a percentage of reads */
+	float BudgetPercent = 5.0f;
+};
+
+/**
+ * Counters for hedged reads
+ */
+struct FIREBASEPLUGIN_API FFirebaseHedgingStats
+{
+	/** Reads that were eligible for hedging */
+	int64 Reads = 0;
+
+	/** Duplicate requests that were actually sent */
+	int64 HedgesSent = 0;
+
+	/** Reads where the duplicate answered first */
+	int64 HedgeWins = 0;
+
+	/** Hedges skipped because the budget was exhausted */
+	int64 HedgesDeniedByBudget = 0;
+
+	/** Current hedge delay in seconds */
+	float CurrentDelaySeconds = 0.0f;
+};
+
+/**
+ * Tuning for polling listeners
+ */
+struct FIREBASEPLUGIN_API FFirebasePollingConfig
+{
+	/** Interval a new listener starts with */
+	float InitialIntervalSeconds = 5.0f;
+
+	/** Fastest polling rate, used while the value keeps changing */
+	float MinIntervalSeconds = 1.0f;
+
+	/** Slowest polling rate, approached while the value stays the same */
+	float MaxIntervalSeconds = 30.0f;
+
+	/** Skip polls while the owning actor is hidden or off screen */
+	bool bPauseWhenOwnerNotRendered = true;
+};
 
 /**
  * Firebase REST API wrapper for cross-platform support
@@ -25,6 +94,9 @@ public:
 	// Initialize with Firebase configuration
 	void Initialize(const FString& InApiKey, const FString& InProjectId, const FString& InDatabaseUrl);
 
+	// Apply tunables (hedging, rate limits, connectivity) from plugin settings
+	void ConfigureFromSettings(const UFirebaseSettings* Settings);
+
 	// === AUTHENTICATION REST API ===
 
 	/** Sign up with email and password */
@@ -95,6 +167,24 @@ public:
 	/** Query with equal to */
 	void QueryEqualTo(const FString& Path, const FString& Value, const FString& AuthToken, FFirebaseRestCallback Callback);
 
+	// === DATABASE REST API (UTF-8 payloads) ===
+	// Bodies travel as UTF-8 from caller to socket and from socket to callback without FString conversion.
+
+	/** Set value at path */
+	void SetValue(const FString& Path, const FFirebasePayload& JsonValue, const FString& AuthToken, FFirebaseRestPayloadCallback Callback);
+
+	/** Get value at path */
+	void GetValue(const FString& Path, const FString& AuthToken, FFirebaseRestPayloadCallback Callback);
+
+	/** Update value at path (partial update) */
+	void UpdateValue(const FString& Path, const FFirebasePayload& JsonValue, const FString& AuthToken, FFirebaseRestPayloadCallback Callback);
+
+	/** Delete value at path */
+	void DeleteValue(const FString& Path, const FString& AuthToken, FFirebaseRestPayloadCallback Callback);
+
+	/** Push new child to path */
+	void PushValue(const FString& Path, const FFirebasePayload& JsonValue, const FString& AuthToken, FFirebaseRestPayloadCallback Callback);
+
 	// === HELPER FUNCTIONS ===
 
 	/** Get current ID token (cached) */
@@ -119,12 +209,94 @@ public:
 	 */
 	void GetTrustedServerTime(FFirebaseRestCallback Callback);
 
+	// === HEDGED READS ===
+
+	/** Replace the hedging configuration */
+	void SetHedgingConfig(const FFirebaseHedgingConfig& InConfig);
+
+	/** Get the hedging configuration */
+	const FFirebaseHedgingConfig& GetHedgingConfig() const { return HedgingConfig; }
+
+	/** Get hedging counters */
+	FFirebaseHedgingStats GetHedgingStats() const;
+
+	// === RATE LIMITING ===
+
+	/** Replace the client-side rate limit rules (empty disables limiting) */
+	void SetRateLimitRules(const TArray<FFirebaseRateLimitRule>& Rules);
+
+	/** Get the state of every rate limit rule */
+	TArray<FFirebaseRateLimiterStats> GetRateLimiterStats() const;
+
+	// === CONNECTIVITY ===
+
+	/** Probe the database while its state is unknown or down (only the database instance does this) */
+	void StartConnectivityMonitoring();
+
+	/** True once the database has answered and the connection was not forced offline */
+	bool IsConnected() const { return Connectivity.IsConnected(); }
+
+	/** Resume sending database requests (and probing) after GoOffline */
+	void GoOnline();
+
+	/** Hold database requests until GoOnline is called */
+	void GoOffline();
+
+	/** Fired whenever IsConnected() changes */
+	FOnFirebaseConnectivityChanged& OnConnectivityChanged() { return Connectivity.OnConnectivityChanged(); }
+
+	/** Number of database requests held while offline */
+	int32 GetOfflineQueueLength() const { return OfflineQueue.Num(); }
+
+	// === POLLING LISTENERS ===
+
+	/** Token used by requests that have no caller to supply one */
+	void SetAuthTokenProvider(const FFirebaseRestTokenProvider& InProvider) { AuthTokenProvider = InProvider; }
+
+	/**
+	 * Poll a path and report its value whenever it changes.
+	 * Replaces any existing listener on the same path.
+	 * @param Owner Object the listener belongs to; polling pauses while it is not relevant and stops once it is destroyed
+	 * @param OnChanged Called with the new value (also once for the initial value)
+	 */
+	void StartPolling(const FString& Path, const UObject* Owner, FFirebaseRestPayloadCallback OnChanged);
+
+	/** Stop polling a path */
+	void StopPolling(const FString& Path);
+
+	/** Replace the polling configuration */
+	void SetPollingConfig(const FFirebasePollingConfig& InConfig);
+
+	/** Number of active polling listeners */
+	int32 GetPollingListenerCount() const { return PollingListeners.Num(); }
+
+	// === TRANSPORT ===
+
+	/** Send all requests through InTransport (e.g. FFirebaseInMemoryTransport); null restores the HTTP module */
+	void SetTransport(TSharedPtr<IFirebaseHttpTransport> InTransport) { Transport = MoveTemp(InTransport); }
+
+	/** Transport requests are currently sent through */
+	TSharedRef<IFirebaseHttpTransport> GetTransport() const;
+
+	/** Send auth requests to an emulator (e.g. http://127.0.0.1:9099); empty restores the live endpoints */
+	void SetAuthEmulator(const FString& EmulatorUrl) { UrlBuilder.SetAuthEmulator(EmulatorUrl); }
+
+	//~ Begin UObject Interface
+	virtual void BeginDestroy() override;
+	//~ End UObject Interface
+
 private:
 	// Configuration
 	FString ApiKey;
 	FString ProjectId;
 	FString DatabaseUrl;
 
+	// Encoded URL prefixes, cached at Initialize
+	FFirebaseUrlBuilder UrlBuilder;
+
+	// Null uses FFirebaseHttpModuleTransport
+	TSharedPtr<IFirebaseHttpTransport> Transport;
+
 	// Cached authentication data
 	FString CachedIdToken;
 	FString CachedRefreshToken;
@@ -143,8 +315,59 @@ private:
 
 	// Helper functions
 	void SendAuthRequest(const FString& Endpoint, const TSharedPtr<FJsonObject>& JsonPayload, FFirebaseRestCallback Callback, bool bCacheTokens = false);
-	void SendDatabaseRequest(const FString& Path, const FString& Method, const FString& JsonBody, const FString& AuthToken, const FString& QueryParams, FFirebaseRestCallback Callback);
-	FString BuildDatabaseUrl(const FString& Path, const FString& QueryParams = TEXT("")) const;
+	void SendDatabaseRequest(const FString& Path, const FString& Method, const FFirebasePayload& JsonBody, const FString& AuthToken, TArrayView<const FFirebaseUrlParam> QueryParams, FFirebaseRestPayloadCallback Callback);
+	void SubmitDatabaseRequest(FFirebaseQueuedRequest& Request);
+	void DispatchDatabaseRequest(const FFirebaseQueuedRequest& Request);
+	void SendHedgedDatabaseRequest(const FString& Url, const FFirebaseRequestKey& StatsKey, uint64 TraceId, FFirebaseRestPayloadCallback Callback);
+	static FFirebaseHttpRequest MakeDatabaseRequest(const FString& Url, const FString& Method, const FFirebasePayload& JsonBody);
+	static void CompleteDatabaseRequest(const FFirebaseHttpResponse& Response, const FFirebaseRestPayloadCallback& Callback, const FFirebaseRequestKey& StatsKey, uint64 TraceId);
 	void CacheAuthResponse(const FString& Response);
 	TSharedPtr<FJsonObject> ParseJsonResponse(const FString& Response) const;
+
+	// Polling helpers
+	void TickPolling(double Now);
+	void SendPoll(const TSharedRef<FFirebasePollingListener>& Listener);
+	bool IsPollingOwnerRelevant(const FFirebasePollingListener& Listener) const;
+
+	// Polling state
+	FFirebasePollingConfig PollingConfig;
+	TFirebaseCaseSensitiveMap<TSharedRef<FFirebasePollingListener>> PollingListeners;
+	FFirebaseRestTokenProvider AuthTokenProvider;
+
+	// Periodic work (rate limiter drain, offline queue, probes, polling)
+	bool Tick(float DeltaTime);
+	FTSTicker::FDelegateHandle TickHandle;
+
+	// Client-side rate limiting
+	FFirebaseRateLimiter RateLimiter;
+
+	// Connectivity helpers
+	bool ShouldHoldRequests() const;
+	void ReportTransportOutcome(bool bGotResponse);
+	void SendConnectivityProbe();
+	void UpdateOfflineQueue(double Now);
+
+	// Connectivity state
+	FFirebaseConnectivityMonitor Connectivity;
+	TArray<FFirebaseQueuedRequest> OfflineQueue;
+	bool bMonitorConnectivity = false;
+	bool bProbeInFlight = false;
+	bool bAutoReconnect = true;
+	bool bPauseRequestsWhileOffline = true;
+	float OfflineQueueTimeoutSeconds = 60.0f;
+	int32 MaxOfflineQueuedRequests = 256;
+
+	// Hedging helpers
+	float GetHedgeDelay() const;
+	bool TryConsumeHedgeBudget();
+	void RecordReadLatency(double Seconds);
+
+	// Hedging state
+	FFirebaseHedgingConfig HedgingConfig;
+	FFirebaseHedgingStats HedgingStats;
+	TArray<float> ReadLatencySamples;
+	int32 NextLatencySample = 0;
+	int32 SamplesSinceDelayUpdate = 0;
+	float CachedHedgeDelay = 0.0f;
+	float HedgeTokens = 0.0f;
 };
@@ -0,0 +1,21 @@
+// Copyright. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FirebasePayload.h"
+
+/**
+ * Callback for REST API requests
+ */
+DECLARE_DELEGATE_TwoParams(FFirebaseRestCallback, bool /*bSuccess*/, const FString& /*Response*/);
+
+/**
+ * Callback for REST API requests that receives the raw UTF-8 body
+ */
+DECLARE_DELEGATE_TwoParams(FFirebaseRestPayloadCallback, bool /*bSuccess*/, const FFirebasePayload& /*Response*/);
+
+/**
+ * Supplies the current ID token for requests issued without a caller (e.g. polling)
+ */
+DECLARE_DELEGATE_RetVal(FString, FFirebaseRestTokenProvider);
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
+#include "FirebaseRateLimiter.h"
 #include "FirebaseSettings.generated.h"
 
 /**
@@ -40,6 +41,18 @@ enum class EFirebaseDatabaseRegion : uint8
 	Asia_Southeast UMETA(DisplayName = "Asia Southeast (asia-southeast1)")
 };
 
+/**
+ * JSON parser used for database responses
+ */
+UENUM(BlueprintType)
+enum class EFirebaseJsonParser : uint8
+{
+	/** Engine FJsonSerializer; builds an FJsonValue tree */
+	Standard UMETA(DisplayName = "Standard (FJsonSerializer)"),
+	/** SIMD structural scan into a compact tape; FJsonValue trees are only built on demand */
+	Tape UMETA(DisplayName = "SIMD Tape")
+};
+
 /**
  * Firebase Plugin Settings
  */
@@ -97,6 +110,11 @@ public:
 		EditCondition = "ConfigurationMethod == EFirebaseConfigMethod::ManualInput"))
 	FString DatabaseUrl;
 
+	/** Send REST auth requests to a local emulator instead of Google (e.g. http://127.0.0.1:9099); empty uses the live endpoints */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Firebase|Project", 
+		meta = (DisplayName = "Auth Emulator URL"))
+	FString AuthEmulatorUrl;
+
 	/** Firebase Storage Bucket */
 	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Firebase|Project", 
 		meta = (DisplayName = "Storage Bucket",
@@ -157,11 +175,41 @@ public:
 		meta = (DisplayName = "Cache Size (MB)", EditCondition = "bEnableOfflinePersistence", ClampMin = "1", ClampMax = "100"))
 	int32 CacheSizeMB = 10;
 
-	/** Enable automatic reconnection */
+	/** Probe a lost REST connection periodically; when off, it is only checked after Go Online or while requests are held */
 	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Firebase|Database", 
 		meta = (DisplayName = "Auto Reconnect", EditCondition = "bEnableRealtimeDatabase"))
 	bool bAutoReconnect = true;
 
+	/** Hold REST database requests while the connection is down and send them in order once it is back */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Firebase|Database",
+		meta = (DisplayName = "Pause Requests While Offline", EditCondition = "bEnableRealtimeDatabase"))
+	bool bPauseRequestsWhileOffline = true;
+
+	/** Consecutive network failures before the REST connection is considered down */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Firebase|Database",
+		meta = (DisplayName = "Offline After Failures", EditCondition = "bEnableRealtimeDatabase", ClampMin = "1", ClampMax = "10"))
+	int32 ConnectivityFailureThreshold = 2;
+
+	/** First delay between reconnection probes; doubles after every failed probe (seconds) */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Firebase|Database",
+		meta = (DisplayName = "Reconnect Probe Interval (Seconds)", EditCondition = "bAutoReconnect", ClampMin = "0.5", ClampMax = "60.0"))
+	float ConnectivityProbeIntervalSeconds = 2.0f;
+
+	/** Upper bound for the delay between reconnection probes (seconds) */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Firebase|Database",
+		meta = (DisplayName = "Max Reconnect Probe Interval (Seconds)", EditCondition = "bAutoReconnect", ClampMin = "1.0", ClampMax = "600.0"))
+	float ConnectivityMaxProbeIntervalSeconds = 30.0f;
+
+	/** Fail requests that have been held offline for longer than this (seconds, 0 = never) */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Firebase|Database",
+		meta = (DisplayName = "Offline Request Timeout (Seconds)", EditCondition = "bPauseRequestsWhileOffline", ClampMin = "0.0", ClampMax = "3600.0"))
+	float OfflineQueueTimeoutSeconds = 60.0f;
+
+	/** Maximum number of requests held while offline; further requests fail immediately */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Firebase|Database",
+		meta = (DisplayName = "Max Offline Requests", EditCondition = "bPauseRequestsWhileOffline", ClampMin = "1", ClampMax = "10000"))
+	int32 MaxOfflineQueuedRequests = 256;
+
 	// === SECURITY & PRIVACY ===
 
 	/** Enable SSL/TLS Certificate Pinning */
@@ -176,7 +224,7 @@ public:
 
 	// === DEBUG SETTINGS ===
 
-	/** Enable verbose logging */
+	/** Raise LogFirebase to Verbose (per-request detail); shipping builds compile Verbose out */
 	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Firebase|Debug", 
 		meta = (DisplayName = "Enable Verbose Logging"))
 	bool bEnableVerboseLogging = false;
@@ -199,6 +247,94 @@ public:
 		EditCondition = "bUseRestApiForNonAndroid", ClampMin = "1.0", ClampMax = "60.0"))
 	float RestApiPollingInterval = 5.0f;
 
+	/** Polling speeds up towards this interval while a listened value keeps changing (seconds) */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Firebase|Platform", 
+		meta = (DisplayName = "REST API Min Polling Interval (Seconds)", 
+		EditCondition = "bUseRestApiForNonAndroid", ClampMin = "0.5", ClampMax = "60.0"))
+	float RestApiMinPollingInterval = 1.0f;
+
+	/** Polling slows down towards this interval while a listened value stays the same (seconds) */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Firebase|Platform", 
+		meta = (DisplayName = "REST API Max Polling Interval (Seconds)", 
+		EditCondition = "bUseRestApiForNonAndroid", ClampMin = "1.0", ClampMax = "600.0"))
+	float RestApiMaxPollingInterval = 30.0f;
+
+	/** Skip polls for listeners bound to an actor that is hidden or has not been rendered recently */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Firebase|Platform", 
+		meta = (DisplayName = "Pause Polling For Off-Screen Owners", EditCondition = "bUseRestApiForNonAndroid"))
+	bool bPausePollingWhenOwnerNotRendered = true;
+
+	/** Fail Android SDK operations whose result has not arrived after this many seconds (0 = never) */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Firebase|Platform", 
+		meta = (DisplayName = "Pending Operation Timeout (Seconds)", ClampMin = "0.0", ClampMax = "600.0"))
+	float PendingOperationTimeoutSeconds = 30.0f;
+
+	/** Maximum number of Android SDK operations waiting for a result; further calls fail immediately */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Firebase|Platform", 
+		meta = (DisplayName = "Max Pending Operations", ClampMin = "1", ClampMax = "10000"))
+	int32 MaxPendingOperations = 256;
+
+	// === PERFORMANCE SETTINGS ===
+
+	/** Send a duplicate GET when a REST read is slower than usual (first response wins) */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Firebase|Performance",
+		meta = (DisplayName = "Enable Hedged Reads", EditCondition = "bUseRestApiForNonAndroid"))
+	bool bEnableHedgedReads = false;
+
+	/** Latency percentile of recent reads after which a hedge request is sent */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Firebase|Performance",
+		meta = (DisplayName = "Hedge Delay Percentile", EditCondition = "bEnableHedgedReads",
+		ClampMin = "50.0", ClampMax = "99.9"))
+	float HedgeDelayPercentile = 95.0f;
+
+	/** Hedge delay used until enough read latencies have been observed (seconds) */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Firebase|Performance",
+		meta = (DisplayName = "Hedge Initial Delay (Seconds)", EditCondition = "bEnableHedgedReads",
+		ClampMin = "0.01", ClampMax = "10.0"))
+	float HedgeInitialDelaySeconds = 0.5f;
+
+	/** Never hedge earlier than this, even if reads are usually very fast (seconds) */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Firebase|Performance",
+		meta = (DisplayName = "Hedge Minimum Delay (Seconds)", EditCondition = "bEnableHedgedReads",
+		ClampMin = "0.0", ClampMax = "10.0"))
+	float HedgeMinDelaySeconds = 0.05f;
+
+	/** Maximum extra read load caused by hedging, as a percentage of reads */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Firebase|Performance",
+		meta = (DisplayName = "Hedge Budget (%)", EditCondition = "bEnableHedgedReads",
+		ClampMin = "0.0", ClampMax = "50.0"))
+	float HedgeBudgetPercent = 5.0f;
+
+	/** Parse REST database responses on a worker thread; results then carry a pre-parsed document */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Firebase|Performance",
+		meta = (DisplayName = "Parse Responses Off Game Thread", EditCondition = "bUseRestApiForNonAndroid"))
+	bool bParseResponsesOffGameThread = false;
+
+	/** Parser for database responses; the tape parser is faster on large snapshots */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Firebase|Performance",
+		meta = (DisplayName = "JSON Parser"))
+	EFirebaseJsonParser JsonParser = EFirebaseJsonParser::Standard;
+
+	/** Limit how fast requests are sent to the Realtime Database from this client */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Firebase|Performance",
+		meta = (DisplayName = "Enable Rate Limiting", EditCondition = "bUseRestApiForNonAndroid"))
+	bool bEnableRateLimiting = false;
+
+	/** Token bucket rules by path prefix and operation type (most specific rule wins) */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Firebase|Performance",
+		meta = (DisplayName = "Rate Limit Rules", EditCondition = "bEnableRateLimiting"))
+	TArray<FFirebaseRateLimitRule> RateLimitRules;
+
+	/** Memory kept for reusing request and payload buffers; 0 frees every buffer after use */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Firebase|Performance",
+		meta = (DisplayName = "Buffer Pool Budget (KB)", ClampMin = "0", ClampMax = "262144"))
+	int32 BufferPoolBudgetKB = 4096;
+
+	/** Memory the plugin's queues, pending operations, listeners, recordings and pooled buffers may hold together; 0 = unlimited */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Firebase|Performance",
+		meta = (DisplayName = "Memory Budget (KB)", ClampMin = "0", ClampMax = "1048576"))
+	int32 MemoryBudgetKB = 0;
+
 	/** Messaging Sender ID (for Cloud Messaging) */
 	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Firebase|Project", 
 		meta = (DisplayName = "Messaging Sender ID",
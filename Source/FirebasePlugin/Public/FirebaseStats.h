@@ -0,0 +1,202 @@
+// Copyright. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "FirebaseLatencyHistogram.h"
+#include "FirebaseKeyFuncs.h"
+
+struct FFirebaseHttpResponse;
+
+DECLARE_STATS_GROUP(TEXT("Firebase"), STATGROUP_Firebase, STATCAT_Advanced);
+
+// Game thread work
+DECLARE_CYCLE_STAT_EXTERN(TEXT("REST Tick"), STAT_FirebaseRestTick, STATGROUP_Firebase, FIREBASEPLUGIN_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Dispatch Database Request"), STAT_FirebaseDispatchRequest, STATGROUP_Firebase, FIREBASEPLUGIN_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Send Auth Request"), STAT_FirebaseSendAuthRequest, STATGROUP_Firebase, FIREBASEPLUGIN_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Complete Request"), STAT_FirebaseCompleteRequest, STATGROUP_Firebase, FIREBASEPLUGIN_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Build URL"), STAT_FirebaseBuildUrl, STATGROUP_Firebase, FIREBASEPLUGIN_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Parse JSON"), STAT_FirebaseParseJson, STATGROUP_Firebase, FIREBASEPLUGIN_API);
+
+// Traffic
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Requests In Flight"), STAT_FirebaseRequestsInFlight, STATGROUP_Firebase, FIREBASEPLUGIN_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Requests Sent"), STAT_FirebaseRequestsSent, STATGROUP_Firebase, FIREBASEPLUGIN_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Responses Received"), STAT_FirebaseResponsesReceived, STATGROUP_Firebase, FIREBASEPLUGIN_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Requests Failed"), STAT_FirebaseRequestsFailed, STATGROUP_Firebase, FIREBASEPLUGIN_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Request Bytes"), STAT_FirebaseRequestBytes, STATGROUP_Firebase, FIREBASEPLUGIN_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Response Bytes"), STAT_FirebaseResponseBytes, STATGROUP_Firebase, FIREBASEPLUGIN_API);
+
+// Memory
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Buffer Pool"), STAT_FirebaseBufferPoolMemory, STATGROUP_Firebase, FIREBASEPLUGIN_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Latency Histograms"), STAT_FirebaseHistogramMemory, STATGROUP_Firebase, FIREBASEPLUGIN_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Request Queues"), STAT_FirebaseQueueMemory, STATGROUP_Firebase, FIREBASEPLUGIN_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Pending Operations"), STAT_FirebasePendingOpsMemory, STATGROUP_Firebase, FIREBASEPLUGIN_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Listeners"), STAT_FirebaseListenerMemory, STATGROUP_Firebase, FIREBASEPLUGIN_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Diagnostics"), STAT_FirebaseDiagnosticsMemory, STATGROUP_Firebase, FIREBASEPLUGIN_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Budgeted Total"), STAT_FirebaseBudgetedMemory, STATGROUP_Firebase, FIREBASEPLUGIN_API);
+
+// Latency percentiles over the last FFirebaseRequestMetrics::WindowSeconds, in milliseconds
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Queue p50 (ms)"), STAT_FirebaseQueueP50, STATGROUP_Firebase, FIREBASEPLUGIN_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Queue p90 (ms)"), STAT_FirebaseQueueP90, STATGROUP_Firebase, FIREBASEPLUGIN_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Queue p99 (ms)"), STAT_FirebaseQueueP99, STATGROUP_Firebase, FIREBASEPLUGIN_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Queue max (ms)"), STAT_FirebaseQueueMax, STATGROUP_Firebase, FIREBASEPLUGIN_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("First Byte p50 (ms)"), STAT_FirebaseFirstByteP50, STATGROUP_Firebase, FIREBASEPLUGIN_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("First Byte p90 (ms)"), STAT_FirebaseFirstByteP90, STATGROUP_Firebase, FIREBASEPLUGIN_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("First Byte p99 (ms)"), STAT_FirebaseFirstByteP99, STATGROUP_Firebase, FIREBASEPLUGIN_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("First Byte max (ms)"), STAT_FirebaseFirstByteMax, STATGROUP_Firebase, FIREBASEPLUGIN_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Transfer p50 (ms)"), STAT_FirebaseTransferP50, STATGROUP_Firebase, FIREBASEPLUGIN_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Transfer p90 (ms)"), STAT_FirebaseTransferP90, STATGROUP_Firebase, FIREBASEPLUGIN_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Transfer p99 (ms)"), STAT_FirebaseTransferP99, STATGROUP_Firebase, FIREBASEPLUGIN_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Transfer max (ms)"), STAT_FirebaseTransferMax, STATGROUP_Firebase, FIREBASEPLUGIN_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Callback p50 (ms)"), STAT_FirebaseCallbackP50, STATGROUP_Firebase, FIREBASEPLUGIN_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Callback p90 (ms)"), STAT_FirebaseCallbackP90, STATGROUP_Firebase, FIREBASEPLUGIN_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Callback p99 (ms)"), STAT_FirebaseCallbackP99, STATGROUP_Firebase, FIREBASEPLUGIN_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Callback max (ms)"), STAT_FirebaseCallbackMax, STATGROUP_Firebase, FIREBASEPLUGIN_API);
+
+// Round trip (first byte + transfer) p99 per operation type, in milliseconds
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("GET p99 (ms)"), STAT_FirebaseGetP99, STATGROUP_Firebase, FIREBASEPLUGIN_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("PUT p99 (ms)"), STAT_FirebasePutP99, STATGROUP_Firebase, FIREBASEPLUGIN_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("PATCH p99 (ms)"), STAT_FirebasePatchP99, STATGROUP_Firebase, FIREBASEPLUGIN_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("POST p99 (ms)"), STAT_FirebasePostP99, STATGROUP_Firebase, FIREBASEPLUGIN_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("DELETE p99 (ms)"), STAT_FirebaseDeleteP99, STATGROUP_Firebase, FIREBASEPLUGIN_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("AUTH p99 (ms)"), STAT_FirebaseAuthP99, STATGROUP_Firebase, FIREBASEPLUGIN_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("POLL p99 (ms)"), STAT_FirebasePollP99, STATGROUP_Firebase, FIREBASEPLUGIN_API);
+
+/**
+ * Stages of a REST request that are timed separately
+ */
+enum class EFirebaseRequestPhase : uint8
+{
+	/** Submitted until handed to the transport (offline queue, rate limiter) */
+	Queue,
+
+	/** Sent until the status line and headers arrived */
+	FirstByte,
+
+	/** First byte until the body was complete */
+	Transfer,
+
+	/** FirstByte + Transfer */
+	RoundTrip,
+
+	/** Running the caller's completion callback */
+	Callback,
+
+	Num
+};
+
+/**
+ * What a request is counted under: its operation type and the first segment of its path
+ */
+struct FIREBASEPLUGIN_API FFirebaseRequestKey
+{
+	FFirebaseRequestKey() = default;
+
+	/** Operation is an HTTP verb, or AUTH/POLL/PROBE; Path is a database path or auth endpoint */
+	FFirebaseRequestKey(const FString& InOperation, FStringView Path);
+
+	FString Operation;
+	FString Prefix;
+};
+
+/**
+ * Running totals of REST traffic since startup (or the last Reset)
+ */
+struct FIREBASEPLUGIN_API FFirebaseRequestTotals
+{
+	int64 Sent = 0;
+	int64 Received = 0;
+	int64 Failed = 0;
+	int64 RequestBytes = 0;
+	int64 ResponseBytes = 0;
+	int32 InFlight = 0;
+};
+
+/**
+ * Latency histograms and byte counters for every REST request.
+ *
+ * UFirebaseRestAPI reports each stage of a request here. Samples go into a
+ * histogram per phase, per operation type and per path prefix; percentiles
+ * cover the current and the previous window of WindowSeconds, so they follow
+ * the live traffic instead of averaging over the whole session. Tick (driven
+ * by the plugin module) publishes the aggregate numbers to STATGROUP_Firebase
+ * for `stat Firebase`; `Firebase.Stats.Dump` prints the full breakdown.
+ *
+ * Game thread only, like the transports that feed it.
+ */
+class FIREBASEPLUGIN_API FFirebaseRequestMetrics
+{
+public:
+	/** Length of one rolling window */
+	static constexpr double WindowSeconds = 10.0;
+
+	/** Distinct path prefixes tracked; later ones are counted under "(other)" */
+	static constexpr int32 MaxPrefixes = 64;
+
+	static FFirebaseRequestMetrics& Get();
+
+	/** Time the request spent waiting before it was sent */
+	void RecordQueued(const FFirebaseRequestKey& Key, double Seconds);
+
+	/** A request went to the transport; returns the send time to pass to RecordResponse */
+	double RecordSent(const FFirebaseRequestKey& Key, int64 Bytes);
+
+	/** The transport answered (or gave up on) a request sent at SentTime */
+	void RecordResponse(const FFirebaseRequestKey& Key, double SentTime, const FFirebaseHttpResponse& Response);
+
+	/** Time spent in the caller's completion callback */
+	void RecordCallback(const FFirebaseRequestKey& Key, double Seconds);
+
+	/** Percentiles of one phase over all requests */
+	FFirebaseLatencySummary GetSummary(EFirebaseRequestPhase Phase) const;
+
+	/** Percentiles of one phase for an operation type ("GET", "AUTH", ...) */
+	FFirebaseLatencySummary GetOperationSummary(const FString& Operation, EFirebaseRequestPhase Phase) const;
+
+	/** Percentiles of one phase for a path prefix ("users", "accounts:signUp", ...) */
+	FFirebaseLatencySummary GetPrefixSummary(const FString& Prefix, EFirebaseRequestPhase Phase) const;
+
+	const FFirebaseRequestTotals& GetTotals() const { return Totals; }
+
+	/** Roll the window when due and publish the stat values */
+	void Tick(double Now);
+
+	/** Print totals and per-phase percentiles for all requests, each operation and each prefix */
+	void Dump(FOutputDevice& Ar) const;
+
+	/** Forget every sample and total (requests in flight stay counted) */
+	void Reset();
+
+	/** Bytes held by the histograms */
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	struct FHistograms
+	{
+		FFirebaseLatencyHistogram Phases[(int32)EFirebaseRequestPhase::Num];
+	};
+
+	struct FWindow
+	{
+		FHistograms All;
+		// Paths are case-sensitive, so "Users" and "users" are separate prefixes
+		TFirebaseCaseSensitiveMap<TUniquePtr<FHistograms>> ByOperation;
+		TFirebaseCaseSensitiveMap<TUniquePtr<FHistograms>> ByPrefix;
+
+		void Reset();
+	};
+
+	void Record(const FFirebaseRequestKey& Key, EFirebaseRequestPhase Phase, double Seconds);
+
+	/** One phase of the histograms Select picks from each window, both windows merged */
+	FFirebaseLatencySummary Summarize(TFunctionRef<const FHistograms*(const FWindow&)> Select, EFirebaseRequestPhase Phase) const;
+
+	void DumpSection(FOutputDevice& Ar, const FString& Title, TFunctionRef<FFirebaseLatencySummary(EFirebaseRequestPhase)> GetPhase) const;
+
+	FWindow Windows[2];
+	int32 CurrentWindow = 0;
+	double WindowStartTime = 0.0;
+
+	FFirebaseRequestTotals Totals;
+};
@@ -0,0 +1,70 @@
+// Copyright. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Class.h"
+#include "FirebasePayload.h"
+#include "FirebaseJsonTape.h"
+
+class FFirebaseJsonWriter;
+
+/**
+ * Converts any USTRUCT to and from database JSON without an FJsonObject in between.
+ *
+ * The first use of a struct compiles a plan: its properties, their JSON
+ * names and how each one is encoded. Plans are cached, so later calls only
+ * walk the plan, writing straight into an FFirebaseJsonWriter and reading
+ * straight from an FFirebaseJsonTape.
+ *
+ * The encoding matches FJsonObjectConverter, so existing data stays readable:
+ * names are case-standardized property names, enums are written by name,
+ * structs with a text export (FDateTime, FGuid, ...) become strings, and
+ * anything without a JSON equivalent goes through ExportText/ImportText.
+ * Transient and deprecated properties are skipped.
+ */
+class FIREBASEPLUGIN_API FFirebaseStructCodec
+{
+public:
+	/** Write Data as a JSON object */
+	static void Write(const UScriptStruct* Struct, const void* Data, FFirebaseJsonWriter& Writer);
+
+	/** Data as a UTF-8 JSON object */
+	static FFirebasePayload ToPayload(const UScriptStruct* Struct, const void* Data);
+
+	/**
+	 * Write the members of NewData that differ from OldData into the open
+	 * object as a multi-path update ("stats/level": 3). Nested structs are
+	 * compared member by member; arrays, sets and maps are sent whole when
+	 * anything in them changed. Returns the number of paths written.
+	 */
+	static int32 WriteChanges(const UScriptStruct* Struct, const void* OldData, const void* NewData,
+		FFirebaseJsonWriter& Writer, TArray<FString>* OutPaths = nullptr);
+
+	/**
+	 * Fill Data from a JSON object. Members missing from the JSON (the
+	 * database drops nulls and empty containers) keep their current value.
+	 * Members whose JSON has the wrong type are skipped; the first one is
+	 * reported through OutError and the call returns false, but every other
+	 * member is still read.
+	 */
+	static bool Read(const UScriptStruct* Struct, void* Data, const FFirebaseJsonTape::FValue& Value, FString* OutError = nullptr);
+
+	/** Parse Payload and fill Data from it */
+	static bool FromPayload(const UScriptStruct* Struct, void* Data, const FFirebasePayload& Payload, FString* OutError = nullptr);
+
+	template <typename StructType>
+	static FFirebasePayload ToPayload(const StructType& Value)
+	{
+		return ToPayload(StructType::StaticStruct(), &Value);
+	}
+
+	template <typename StructType>
+	static bool FromPayload(const FFirebasePayload& Payload, StructType& OutValue, FString* OutError = nullptr)
+	{
+		return FromPayload(StructType::StaticStruct(), &OutValue, Payload, OutError);
+	}
+
+	/** JSON member name used for a property */
+	static FString GetJsonKey(const FProperty* Property);
+};
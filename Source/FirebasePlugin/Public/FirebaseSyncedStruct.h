@@ -0,0 +1,131 @@
+// Copyright. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "UObject/StructOnScope.h"
+#include "FirebaseDatabase.h"
+#include "FirebaseSyncedStruct.generated.h"
+
+/**
+ * A struct bound to a database path that writes only what changed.
+ *
+ * The handle keeps the working value plus a shadow copy of what the
+ * database is known to hold. Commit compares the two member by member and
+ * sends a single multi-path PATCH with just the changed leaves (nested
+ * structs are descended into; arrays, sets and maps go as a whole). The
+ * shadow advances only when the write succeeds, so a failed commit is
+ * retried by the next one. Only one commit is in flight at a time; commits
+ * made meanwhile are merged into one follow-up write.
+ *
+ * The shadow starts as a copy of the initial value, i.e. the initial value
+ * is assumed to match the database. Call Refresh to load the stored value
+ * instead.
+ *
+ * The values live outside reflected properties, so the handle reports the
+ * struct type and every object they reference to the garbage collector
+ * itself (AddReferencedObjects).
+ */
+UCLASS(BlueprintType)
+class FIREBASEPLUGIN_API UFirebaseSyncedStruct : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	/** Create a handle for Path holding a copy of Value */
+	UFUNCTION(BlueprintCallable, CustomThunk, Category = "Firebase|Database|Synced Struct",
+		meta = (DisplayName = "Create Synced Struct", CustomStructureParam = "Value"))
+	static UFirebaseSyncedStruct* K2_CreateSyncedStruct(const FString& Path, const int32& Value);
+	DECLARE_FUNCTION(execK2_CreateSyncedStruct);
+
+	/** Replace the working value; the struct type must match the one the handle was created with */
+	UFUNCTION(BlueprintCallable, CustomThunk, Category = "Firebase|Database|Synced Struct",
+		meta = (DisplayName = "Set Synced Value", CustomStructureParam = "Value"))
+	void K2_SetValue(const int32& Value);
+	DECLARE_FUNCTION(execK2_SetValue);
+
+	/** Copy of the working value */
+	UFUNCTION(BlueprintCallable, CustomThunk, Category = "Firebase|Database|Synced Struct",
+		meta = (DisplayName = "Get Synced Value", CustomStructureParam = "OutValue"))
+	bool K2_GetValue(int32& OutValue) const;
+	DECLARE_FUNCTION(execK2_GetValue);
+
+	/** Send the changed members; completes immediately if nothing changed */
+	UFUNCTION(BlueprintCallable, Category = "Firebase|Database|Synced Struct")
+	void Commit(const FOnFirebaseDatabaseComplete& OnComplete);
+
+	/** Load the stored value into both the working value and the shadow */
+	UFUNCTION(BlueprintCallable, Category = "Firebase|Database|Synced Struct")
+	void Refresh(const FOnFirebaseDatabaseComplete& OnComplete);
+
+	/** Whether the working value differs from the last committed value */
+	UFUNCTION(BlueprintPure, Category = "Firebase|Database|Synced Struct")
+	bool HasChanges() const;
+
+	/** Database paths (relative to the handle's path) that the next commit would write */
+	UFUNCTION(BlueprintPure, Category = "Firebase|Database|Synced Struct")
+	TArray<FString> GetChangedPaths() const;
+
+	UFUNCTION(BlueprintPure, Category = "Firebase|Database|Synced Struct")
+	FString GetPath() const { return Path; }
+
+	// === C++ ===
+
+	/** Create a handle for Path holding a copy of Data */
+	static UFirebaseSyncedStruct* Create(const FString& Path, const UScriptStruct* Struct, const void* Data);
+
+	template <typename StructType>
+	static UFirebaseSyncedStruct* Create(const FString& Path, const StructType& Value)
+	{
+		return Create(Path, StructType::StaticStruct(), &Value);
+	}
+
+	const UScriptStruct* GetStruct() const;
+
+	/** Working value; edit it in place and Commit */
+	void* GetMutableData() { return Current.IsValid() ? Current->GetStructMemory() : nullptr; }
+
+	template <typename StructType>
+	StructType* GetMutable()
+	{
+		return GetStruct() == StructType::StaticStruct() ? static_cast<StructType*>(GetMutableData()) : nullptr;
+	}
+
+	/** Copy Data into the working value; false if Struct does not match */
+	bool SetValue(const UScriptStruct* Struct, const void* Data);
+
+	static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
+
+private:
+	UFUNCTION()
+	void HandleCommitComplete(const FFirebaseDatabaseResult& Result);
+
+	UFUNCTION()
+	void HandleRefreshComplete(const FFirebaseDatabaseResult& Result);
+
+	void SendCommit();
+	bool IsValidHandle() const { return ValueStruct != nullptr && Current.IsValid(); }
+
+	FString Path;
+
+	/** Type of the values; held here because FStructOnScope only keeps it weakly */
+	UPROPERTY()
+	TObjectPtr<const UScriptStruct> ValueStruct;
+
+	/** Value being edited */
+	TSharedPtr<FStructOnScope> Current;
+
+	/** Value the database is known to hold */
+	TSharedPtr<FStructOnScope> Shadow;
+
+	/** Value sent by the commit in flight */
+	TSharedPtr<FStructOnScope> InFlight;
+
+	/** Callbacks of the commit in flight, and of commits waiting for it */
+	TArray<FOnFirebaseDatabaseComplete> InFlightCallbacks;
+	TArray<FOnFirebaseDatabaseComplete> QueuedCallbacks;
+	bool bCommitInFlight = false;
+
+	TArray<FOnFirebaseDatabaseComplete> RefreshCallbacks;
+};
@@ -0,0 +1,126 @@
+// Copyright. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+struct FFirebaseHttpResponse;
+
+#define FIREBASE_TRACE_ENABLED (UE_TRACE_ENABLED && !UE_BUILD_SHIPPING)
+
+#if FIREBASE_TRACE_ENABLED
+UE_TRACE_CHANNEL_EXTERN(FirebaseChannel, FIREBASEPLUGIN_API);
+#endif
+
+/**
+ * Where a traced request runs
+ */
+enum class EFirebaseTraceOrigin : uint8
+{
+	/** UFirebaseRestAPI over an IFirebaseHttpTransport; ids come from FFirebaseTrace::NewRequestId */
+	Rest,
+
+	/** Android SDK through JNI; ids are the pending-operation ids */
+	Jni
+};
+
+/**
+ * Stages of a request, in the order they normally happen
+ */
+enum class EFirebaseTraceStage : uint8
+{
+	/** The caller issued the request */
+	Enqueue,
+
+	/** Left the offline queue / rate limiter */
+	Scheduled,
+
+	/** Handed to the transport, or the JNI call returned */
+	Sent,
+
+	/** Response headers arrived (back-dated from the transport's timing) */
+	FirstByte,
+
+	/** Response complete, or the Java result arrived */
+	Complete,
+
+	/** Body parsed and transcoded for the caller */
+	Parsed,
+
+	/** Game thread callback started / finished */
+	CallbackBegin,
+	CallbackEnd
+};
+
+/**
+ * Firebase events for Unreal Insights, on the FirebaseChannel trace channel.
+ *
+ * Each request logs a Firebase.RequestBegin event (origin, id, operation, path,
+ * request bytes) when issued, then a Firebase.RequestStage event per stage
+ * with the same origin and id. A request can have more than one callback
+ * span: UFirebaseRestAPI's completion callback and, for UFirebaseDatabase
+ * calls, the Blueprint delegate it defers to a later game thread task.
+ * Callback spans also appear as "FirebaseCallback" CPU timers so their
+ * game thread cost shows next to the frame they ran in. REST responses
+ * slower than Firebase.Trace.SlowRequestMs add a bookmark.
+ *
+ * Enable with -trace=default,firebase (or `Trace.Enable Firebase`). Compiled
+ * out in shipping builds and without UE_TRACE_ENABLED.
+ */
+struct FIREBASEPLUGIN_API FFirebaseTrace
+{
+#if FIREBASE_TRACE_ENABLED
+	/** Correlation id for a REST request; never 0 */
+	static uint64 NewRequestId();
+
+	/** Log the request's identity and its Enqueue stage */
+	static void Request(EFirebaseTraceOrigin Origin, uint64 RequestId, const TCHAR* Operation, FStringView Path, int64 Bytes);
+
+	/** Log one stage; Cycle 0 stamps the current time */
+	static void Stage(EFirebaseTraceOrigin Origin, uint64 RequestId, EFirebaseTraceStage InStage, int64 Bytes = 0, int32 Status = 0, uint64 Cycle = 0);
+
+	/** Log FirstByte and Complete for a REST response (and a bookmark if it was slow) */
+	static void Response(uint64 RequestId, const FFirebaseHttpResponse& Response, const TCHAR* Operation, FStringView Path);
+
+	/** Request whose callback is running on this thread, or 0 */
+	static uint64 GetCurrentRequestId();
+
+	static bool IsEnabled();
+#else
+	static uint64 NewRequestId() { return 0; }
+	static void Request(EFirebaseTraceOrigin, uint64, const TCHAR*, FStringView, int64) {}
+	static void Stage(EFirebaseTraceOrigin, uint64, EFirebaseTraceStage, int64 = 0, int32 = 0, uint64 = 0) {}
+	static void Response(uint64, const FFirebaseHttpResponse&, const TCHAR*, FStringView) {}
+	static uint64 GetCurrentRequestId() { return 0; }
+	static bool IsEnabled() { return false; }
+#endif
+};
+
+/**
+ * Logs CallbackBegin/CallbackEnd around a callback and makes its request current
+ */
+class FIREBASEPLUGIN_API FFirebaseTraceCallbackScope
+{
+public:
+#if FIREBASE_TRACE_ENABLED
+	FFirebaseTraceCallbackScope(EFirebaseTraceOrigin InOrigin, uint64 InRequestId);
+	~FFirebaseTraceCallbackScope();
+
+private:
+	EFirebaseTraceOrigin Origin;
+	uint64 RequestId;
+	uint64 PreviousRequestId;
+#else
+	FFirebaseTraceCallbackScope(EFirebaseTraceOrigin, uint64) {}
+#endif
+};
+
+#if FIREBASE_TRACE_ENABLED
+#define FIREBASE_TRACE_CALLBACK_SCOPE(Origin, RequestId) \
+	FFirebaseTraceCallbackScope PREPROCESSOR_JOIN(FirebaseTraceCallbackScope, __LINE__)(Origin, RequestId); \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(FirebaseCallback, FirebaseChannel)
+#else
+#define FIREBASE_TRACE_CALLBACK_SCOPE(Origin, RequestId)
+#endif
@@ -0,0 +1,143 @@
+// Copyright. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FirebaseKeyFuncs.h"
+#include <atomic>
+
+/**
+ * Kind of call captured by FFirebaseTrafficRecorder
+ */
+enum class EFirebaseTrafficOp : uint8
+{
+	Get,
+	Set,
+	Update,
+	Push,
+	Delete,
+
+	/** A filtered read; the filter itself is not kept */
+	Query,
+
+	Transaction,
+
+	/** ListenForValueChanges / StopListening */
+	Listen,
+	StopListen,
+
+	/** Any auth request; the path holds the endpoint ("accounts:signUp") or Android call name */
+	Auth,
+
+	Num
+};
+
+FIREBASEPLUGIN_API const TCHAR* LexToString(EFirebaseTrafficOp Op);
+
+/**
+ * One captured call
+ */
+struct FFirebaseTrafficEvent
+{
+	/** Seconds since the recording started */
+	double Time = 0.0;
+
+	EFirebaseTrafficOp Op = EFirebaseTrafficOp::Get;
+
+	/** Index into FFirebaseTrafficCapture::Paths */
+	int32 PathIndex = 0;
+
+	/** Request body size; the body itself is never recorded */
+	uint32 Bytes = 0;
+};
+
+/**
+ * A recorded session: the order, timing and payload sizes of database and
+ * auth calls, without any of their data.
+ *
+ * Saved as a small binary file: a header, the distinct paths once, then each
+ * event as a variable-length time delta (microseconds), op, path index and
+ * byte count. An hour of steady traffic is typically a few hundred KB.
+ */
+struct FIREBASEPLUGIN_API FFirebaseTrafficCapture
+{
+	static constexpr uint32 FileMagic = 0x52544246; // "FBTR"
+	static constexpr uint32 FileVersion = 1;
+
+	TArray<FString> Paths;
+	TArray<FFirebaseTrafficEvent> Events;
+
+	/** Time of the last event */
+	double GetDuration() const { return Events.Num() > 0 ? Events.Last().Time : 0.0; }
+
+	void Serialize(FArchive& Ar);
+
+	bool SaveToFile(const FString& Filename) const;
+	bool LoadFromFile(const FString& Filename);
+
+	void Reset();
+};
+
+/**
+ * Captures UFirebaseDatabase / UFirebaseAuth traffic from a play session for
+ * later replay by the FirebaseTrafficReplay commandlet (FirebaseEmulator module).
+ *
+ * Database requests and auth calls are recorded where they are issued, on both
+ * the REST and the Android SDK paths; listeners are recorded as Listen /
+ * StopListen rather than as the polls they cause. Record is a single relaxed
+ * load when not recording. The recording counts against the plugin memory
+ * budget (FFirebaseMemory); once that is reached, further calls are dropped.
+ *
+ * Start with -FirebaseRecordTraffic[=File] (saved on exit) or the
+ * Firebase.Traffic.Record / Firebase.Traffic.Stop console commands. Files go
+ * to Saved/Firebase/Traffic by default.
+ */
+class FIREBASEPLUGIN_API FFirebaseTrafficRecorder
+{
+public:
+	static FFirebaseTrafficRecorder& Get();
+
+	/** Start a new recording, discarding any unsaved one */
+	void Start();
+
+	/** Stop recording and save to Filename (a timestamped default when empty); false if saving failed */
+	bool Stop(const FString& Filename = FString());
+
+	bool IsRecording() const { return bRecording.load(std::memory_order_relaxed); }
+
+	void Record(EFirebaseTrafficOp Op, FStringView Path, int64 Bytes);
+
+	/** Record a database request by its REST method */
+	void RecordMethod(FStringView Method, FStringView Path, int64 Bytes, bool bHasQuery);
+
+	/** Copy of what has been recorded so far */
+	FFirebaseTrafficCapture GetCapture() const;
+
+	/** Saved/Firebase/Traffic/Traffic-<timestamp>.fbtraffic */
+	static FString MakeDefaultFilename();
+
+	/** Start recording if the command line asks for it; the module calls this at startup */
+	void StartFromCommandLine();
+
+	/** Save a recording started from the command line; the module calls this at shutdown */
+	void StopFromCommandLine();
+
+private:
+	std::atomic<bool> bRecording{ false };
+
+	mutable FCriticalSection Lock;
+	FFirebaseTrafficCapture Capture;
+	/** Index of each distinct path in Capture.Paths; paths differing in case are distinct */
+	TFirebaseCaseSensitiveMap<int32> PathIndices;
+	double StartTime = 0.0;
+
+	/** Bytes of the recording reserved with FFirebaseMemory */
+	int64 AccountedBytes = 0;
+
+	/** Calls not recorded because the memory budget was reached */
+	int32 DroppedEvents = 0;
+
+	/** -FirebaseRecordTraffic=File, or empty for the default name */
+	FString CommandLineFilename;
+	bool bStartedFromCommandLine = false;
+};
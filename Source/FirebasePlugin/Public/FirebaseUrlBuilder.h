@@ -0,0 +1,72 @@
+// Copyright. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * One query parameter of a database URL
+ */
+struct FFirebaseUrlParam
+{
+	FStringView Name;
+	FStringView Value;
+
+	/** Send the value as a JSON string ("value"), as orderBy/startAt/endAt/equalTo expect */
+	bool bJsonString = false;
+};
+
+/**
+ * Builds REST URLs from prefixes encoded once at configuration time.
+ *
+ * Database paths are split on "/" and each segment is percent-encoded, so
+ * keys with spaces, "?", "%", "&" or non-ASCII characters address the node
+ * they name instead of breaking the URL. Query values are encoded the same
+ * way. Every URL is written into one string reserved at its exact final
+ * length, so building it costs a single allocation.
+ */
+class FIREBASEPLUGIN_API FFirebaseUrlBuilder
+{
+public:
+	/**
+	 * Cache the database base URL and the API key suffix. A query string on
+	 * the database URL (e.g. "?ns=my-project" for the emulator) is kept and
+	 * sent with every database request.
+	 */
+	void Configure(const FString& DatabaseUrl, const FString& ApiKey);
+
+	/** <database>/<path>.json?<params>&auth=<token>; empty parameters are skipped */
+	FString Database(FStringView Path, TArrayView<const FFirebaseUrlParam> Params = TArrayView<const FFirebaseUrlParam>(), FStringView AuthToken = FStringView()) const;
+
+	/**
+	 * Route auth requests through an emulator: https://<host>/<path> becomes
+	 * <emulator>/<host>/<path>, the layout the Firebase Auth emulator serves.
+	 * Empty restores the live endpoints.
+	 */
+	void SetAuthEmulator(const FString& EmulatorUrl);
+
+	/** <endpoint>?key=<api key> */
+	FString Auth(FStringView Endpoint) const;
+
+	/** Percent-encode everything but RFC 3986 unreserved characters (UTF-8 for non-ASCII) */
+	static void AppendEncoded(FString& Out, FStringView Text);
+
+	/** Length of Text after AppendEncoded */
+	static int32 EncodedLength(FStringView Text);
+
+private:
+	static int32 ParamLength(const FFirebaseUrlParam& Param);
+	static void AppendParam(FString& Out, const FFirebaseUrlParam& Param);
+
+	// Database URL without a trailing slash or query
+	FString DatabaseBase;
+
+	// Query carried by the configured database URL, without the "?"
+	FString DatabaseQuery;
+
+	// "?key=<encoded api key>"
+	FString AuthKeySuffix;
+
+	// Emulator URL with a trailing slash, or empty
+	FString AuthEmulatorPrefix;
+};
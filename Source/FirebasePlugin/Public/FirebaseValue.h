@@ -0,0 +1,194 @@
+// Copyright. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "Dom/JsonValue.h"
+#include "FirebasePayload.h"
+#include "FirebaseJsonTape.h"
+#include "FirebaseValue.generated.h"
+
+class FFirebaseJsonWriter;
+class FFirebaseValueTree;
+
+/**
+ * Kind of value held by an FFirebaseValue
+ */
+UENUM(BlueprintType)
+enum class EFirebaseValueType : uint8
+{
+	Null,
+	Bool,
+	Int,
+	Double,
+	String,
+	Map,
+	Array
+};
+
+/**
+ * Typed database value.
+ *
+ * A handle to one node of an immutable tree that is built once per parsed
+ * result and shared by every handle into it. Copying a value, reading a
+ * field or walking an array only copies the handle; nothing is parsed again
+ * and strings are not duplicated until a Blueprint asks for one.
+ *
+ * Numbers that are whole and within 2^53 are reported as Int, others as
+ * Double (the database stores every number as a double). Map keys are
+ * sorted, so lookups are binary searches.
+ */
+USTRUCT(BlueprintType)
+struct FIREBASEPLUGIN_API FFirebaseValue
+{
+	GENERATED_BODY()
+
+	FFirebaseValue() = default;
+
+	/** Parse a UTF-8 JSON body; Null if it is not valid JSON */
+	static FFirebaseValue FromPayload(const FFirebasePayload& Payload);
+
+	/** Parse JSON text; Null if it is not valid JSON */
+	static FFirebaseValue FromJsonString(const FString& Json);
+
+	/** Build from a value on a parsed tape */
+	static FFirebaseValue FromTape(const FFirebaseJsonTape::FValue& Value);
+
+	/** Build from an FJsonValue tree */
+	static FFirebaseValue FromJsonValue(const TSharedPtr<FJsonValue>& Value);
+
+	EFirebaseValueType GetType() const;
+
+	bool IsNull() const { return GetType() == EFirebaseValueType::Null; }
+	bool IsNumber() const { return GetType() == EFirebaseValueType::Int || GetType() == EFirebaseValueType::Double; }
+	bool IsMap() const { return GetType() == EFirebaseValueType::Map; }
+	bool IsArray() const { return GetType() == EFirebaseValueType::Array; }
+
+	/** Booleans; numbers are true when non-zero, strings when "true" */
+	bool AsBool() const;
+
+	/** Numbers (doubles are rounded), numeric strings and booleans */
+	int64 AsInt() const;
+
+	/** Numbers, numeric strings and booleans */
+	double AsDouble() const;
+
+	/** Text of a string without copying it (empty for other kinds) */
+	FStringView AsStringView() const;
+
+	/** Strings as-is, scalars as text, maps and arrays as JSON */
+	FString AsString() const;
+
+	/** Number of map entries or array elements */
+	int32 Num() const;
+
+	/** Map entry by key, or Null */
+	FFirebaseValue Find(FStringView Key) const;
+
+	/** Array element, or the map entry at that position in key order; Null if out of range */
+	FFirebaseValue GetElement(int32 Index) const;
+
+	/** Key of the map entry at Index in key order */
+	FStringView GetKey(int32 Index) const;
+
+	/** Nested value by "/"-separated path ("players/abc/score"); numeric segments index arrays */
+	FFirebaseValue FindPath(FStringView Path) const;
+
+	/** Append the value as JSON */
+	void Write(FFirebaseJsonWriter& Writer) const;
+
+	/** The value as compact JSON */
+	FString ToJson() const;
+
+private:
+	FFirebaseValue(const TSharedPtr<const FFirebaseValueTree, ESPMode::ThreadSafe>& InTree, int32 InNode)
+		: Tree(InTree)
+		, Node(InNode)
+	{
+	}
+
+	TSharedPtr<const FFirebaseValueTree, ESPMode::ThreadSafe> Tree;
+	int32 Node = INDEX_NONE;
+};
+
+/**
+ * Blueprint accessors for FFirebaseValue
+ */
+UCLASS()
+class FIREBASEPLUGIN_API UFirebaseValueLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	/** Parse a JSON string into a typed value */
+	UFUNCTION(BlueprintPure, Category = "Firebase|Database|Value",
+		meta = (DisplayName = "Parse Firebase Value"))
+	static FFirebaseValue ParseValue(const FString& Json);
+
+	UFUNCTION(BlueprintPure, Category = "Firebase|Database|Value",
+		meta = (DisplayName = "Get Value Type"))
+	static EFirebaseValueType GetValueType(const FFirebaseValue& Value);
+
+	UFUNCTION(BlueprintPure, Category = "Firebase|Database|Value",
+		meta = (DisplayName = "Is Null"))
+	static bool IsNull(const FFirebaseValue& Value);
+
+	UFUNCTION(BlueprintPure, Category = "Firebase|Database|Value",
+		meta = (DisplayName = "To Bool"))
+	static bool AsBool(const FFirebaseValue& Value);
+
+	UFUNCTION(BlueprintPure, Category = "Firebase|Database|Value",
+		meta = (DisplayName = "To Integer64"))
+	static int64 AsInt(const FFirebaseValue& Value);
+
+	UFUNCTION(BlueprintPure, Category = "Firebase|Database|Value",
+		meta = (DisplayName = "To Float"))
+	static double AsFloat(const FFirebaseValue& Value);
+
+	/** Strings as-is, scalars as text, maps and arrays as JSON */
+	UFUNCTION(BlueprintPure, Category = "Firebase|Database|Value",
+		meta = (DisplayName = "To String"))
+	static FString AsString(const FFirebaseValue& Value);
+
+	/**
+	 * Map entry by key
+	 * @return True if the key exists
+	 */
+	UFUNCTION(BlueprintPure, Category = "Firebase|Database|Value",
+		meta = (DisplayName = "Get Field"))
+	static bool GetField(const FFirebaseValue& Value, const FString& Key, FFirebaseValue& OutValue);
+
+	/**
+	 * Nested value by path ("players/abc/score"); numeric segments index arrays
+	 * @return True if the path exists
+	 */
+	UFUNCTION(BlueprintPure, Category = "Firebase|Database|Value",
+		meta = (DisplayName = "Get Value At Path"))
+	static bool GetAtPath(const FFirebaseValue& Value, const FString& Path, FFirebaseValue& OutValue);
+
+	/** Number of map entries or array elements */
+	UFUNCTION(BlueprintPure, Category = "Firebase|Database|Value",
+		meta = (DisplayName = "Length"))
+	static int32 Num(const FFirebaseValue& Value);
+
+	/** Array element, or map entry in key order */
+	UFUNCTION(BlueprintPure, Category = "Firebase|Database|Value",
+		meta = (DisplayName = "Get Element"))
+	static FFirebaseValue GetElement(const FFirebaseValue& Value, int32 Index);
+
+	/** Array elements, or map entries in key order */
+	UFUNCTION(BlueprintPure, Category = "Firebase|Database|Value",
+		meta = (DisplayName = "Get Elements"))
+	static TArray<FFirebaseValue> GetElements(const FFirebaseValue& Value);
+
+	/** Map keys in sorted order */
+	UFUNCTION(BlueprintPure, Category = "Firebase|Database|Value",
+		meta = (DisplayName = "Get Keys"))
+	static TArray<FString> GetKeys(const FFirebaseValue& Value);
+
+	/** The value as compact JSON */
+	UFUNCTION(BlueprintPure, Category = "Firebase|Database|Value",
+		meta = (DisplayName = "To JSON String"))
+	static FString ToJsonString(const FFirebaseValue& Value);
+};